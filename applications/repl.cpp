@@ -1,6 +1,7 @@
 #include <bdlb_arrayutil.h>
 #include <bdlb_variant.h>
 #include <bdld_datum.h>
+#include <bdlmt_threadpool.h>
 #include <bsl_cstddef.h>
 #include <bsl_iomanip.h>
 #include <bsl_iostream.h>
@@ -9,6 +10,8 @@
 #include <bsl_string_view.h>
 #include <bsl_vector.h>
 #include <bslma_default.h>
+#include <bslmt_threadattributes.h>
+#include <bslmt_threadutil.h>
 #include <bsls_assert.h>
 #include <lspcore_arithmeticutil.h>
 #include <lspcore_builtinprocedures.h>
@@ -25,7 +28,9 @@ namespace {
 
 namespace bdlb  = BloombergLP::bdlb;
 namespace bdld  = BloombergLP::bdld;
+namespace bdlmt = BloombergLP::bdlmt;
 namespace bslma = BloombergLP::bslma;
+namespace bslmt = BloombergLP::bslmt;
 
 bool lessThan(const bdld::Datum& left, const bdld::Datum& right) {
     BSLS_ASSERT_OPT(left.isInteger());
@@ -106,6 +111,15 @@ int interpreter() {
     lspcore::Parser      parser(lexer, typeOffset, allocator);
     lspcore::Interpreter interpreter(typeOffset, allocator);
 
+    // Threads are started on demand, and exit after being idle for a second.
+    bdlmt::ThreadPool threadPool(bslmt::ThreadAttributes(),
+                                 0,
+                                 bslmt::ThreadUtil::hardwareConcurrency(),
+                                 1000);
+    if (threadPool.start() == 0) {
+        interpreter.setThreadPool(&threadPool);
+    }
+
     int rc;
     struct Entry {
         const char*                              name;
@@ -116,6 +130,10 @@ int interpreter() {
         { "*", &lspcore::ArithmeticUtil::multiply },
         { "/", &lspcore::ArithmeticUtil::divide },
         { "=", &lspcore::ArithmeticUtil::equal },
+        { "<", &lspcore::ArithmeticUtil::less },
+        { "<=", &lspcore::ArithmeticUtil::lessOrEqual },
+        { ">", &lspcore::ArithmeticUtil::greater },
+        { ">=", &lspcore::ArithmeticUtil::greaterOrEqual },
         { "pair?", &lspcore::BuiltinProcedures::isPair },
         { "pair", &lspcore::BuiltinProcedures::pair },
         { "pair-first", &lspcore::BuiltinProcedures::pairFirst },
@@ -126,9 +144,120 @@ int interpreter() {
         { "apply", &lspcore::BuiltinProcedures::apply },
         { "raise", &lspcore::BuiltinProcedures::raise },
         { "set", &lspcore::BuiltinProcedures::set },
+        { "btree-set", &lspcore::BuiltinProcedures::bTreeSet },
         { "set-contains?", &lspcore::BuiltinProcedures::setContains },
         { "set-insert", &lspcore::BuiltinProcedures::setInsert },
-        { "set-remove", &lspcore::BuiltinProcedures::setRemove }
+        { "set-remove", &lspcore::BuiltinProcedures::setRemove },
+        { "set-union", &lspcore::BuiltinProcedures::setUnion },
+        { "set-intersection", &lspcore::BuiltinProcedures::setIntersection },
+        { "set-difference", &lspcore::BuiltinProcedures::setDifference },
+        { "set-subset?", &lspcore::BuiltinProcedures::isSubset },
+        { "set-size", &lspcore::BuiltinProcedures::setSize },
+        { "set-nth", &lspcore::BuiltinProcedures::setNth },
+        { "set-rank", &lspcore::BuiltinProcedures::setRank },
+        { "set-count-range", &lspcore::BuiltinProcedures::setCountRange },
+        { "set-range", &lspcore::BuiltinProcedures::setRange },
+        { "set-fold", &lspcore::BuiltinProcedures::setFold },
+        { "set-find", &lspcore::BuiltinProcedures::setFind },
+        { "set-seq", &lspcore::BuiltinProcedures::setSequence },
+        { "set-seq-empty?", &lspcore::BuiltinProcedures::isSetSequenceEmpty },
+        { "set-seq-first", &lspcore::BuiltinProcedures::setSequenceFirst },
+        { "set-seq-rest", &lspcore::BuiltinProcedures::setSequenceRest },
+        { "set-transient", &lspcore::BuiltinProcedures::setTransient },
+        { "set-insert!", &lspcore::BuiltinProcedures::setInsertInPlace },
+        { "set-remove!", &lspcore::BuiltinProcedures::setRemoveInPlace },
+        { "persist!", &lspcore::BuiltinProcedures::persist },
+        { "hash-map", &lspcore::BuiltinProcedures::hashMap },
+        { "hash-map-contains?", &lspcore::BuiltinProcedures::hashMapContains },
+        { "hash-map-get", &lspcore::BuiltinProcedures::hashMapGet },
+        { "hash-map-insert", &lspcore::BuiltinProcedures::hashMapInsert },
+        { "hash-map-remove", &lspcore::BuiltinProcedures::hashMapRemove },
+        { "hash-set", &lspcore::BuiltinProcedures::hashSet },
+        { "hash-set-contains?", &lspcore::BuiltinProcedures::hashSetContains },
+        { "hash-set-insert", &lspcore::BuiltinProcedures::hashSetInsert },
+        { "hash-set-remove", &lspcore::BuiltinProcedures::hashSetRemove },
+        { "int-set", &lspcore::BuiltinProcedures::intSet },
+        { "int-set-contains?", &lspcore::BuiltinProcedures::intSetContains },
+        { "int-set-insert", &lspcore::BuiltinProcedures::intSetInsert },
+        { "int-set-remove", &lspcore::BuiltinProcedures::intSetRemove },
+        { "int-set-union", &lspcore::BuiltinProcedures::intSetUnion },
+        { "int-set-intersection",
+          &lspcore::BuiltinProcedures::intSetIntersection },
+        { "int-set-difference",
+          &lspcore::BuiltinProcedures::intSetDifference },
+        { "int-set-range", &lspcore::BuiltinProcedures::intSetRange },
+        { "int-map", &lspcore::BuiltinProcedures::intMap },
+        { "int-map-contains?", &lspcore::BuiltinProcedures::intMapContains },
+        { "int-map-get", &lspcore::BuiltinProcedures::intMapGet },
+        { "int-map-insert", &lspcore::BuiltinProcedures::intMapInsert },
+        { "int-map-remove", &lspcore::BuiltinProcedures::intMapRemove },
+        { "int-map-merge", &lspcore::BuiltinProcedures::intMapMerge },
+        { "int-map-range", &lspcore::BuiltinProcedures::intMapRange },
+        { "rrb-vector", &lspcore::BuiltinProcedures::rrbVector },
+        { "array->rrb", &lspcore::BuiltinProcedures::arrayToRrbVector },
+        { "rrb->array", &lspcore::BuiltinProcedures::rrbVectorToArray },
+        { "rrb-size", &lspcore::BuiltinProcedures::rrbVectorSize },
+        { "rrb-nth", &lspcore::BuiltinProcedures::rrbVectorNth },
+        { "rrb-assoc", &lspcore::BuiltinProcedures::rrbVectorAssoc },
+        { "rrb-push", &lspcore::BuiltinProcedures::rrbVectorPush },
+        { "rrb-concat", &lspcore::BuiltinProcedures::rrbVectorConcat },
+        { "rrb-slice", &lspcore::BuiltinProcedures::rrbVectorSlice },
+        { "deque", &lspcore::BuiltinProcedures::deque },
+        { "deque-size", &lspcore::BuiltinProcedures::dequeSize },
+        { "deque-empty?", &lspcore::BuiltinProcedures::dequeIsEmpty },
+        { "deque-front", &lspcore::BuiltinProcedures::dequeFront },
+        { "deque-back", &lspcore::BuiltinProcedures::dequeBack },
+        { "deque-nth", &lspcore::BuiltinProcedures::dequeNth },
+        { "deque-push-front", &lspcore::BuiltinProcedures::dequePushFront },
+        { "deque-push-back", &lspcore::BuiltinProcedures::dequePushBack },
+        { "deque-pop-front", &lspcore::BuiltinProcedures::dequePopFront },
+        { "deque-pop-back", &lspcore::BuiltinProcedures::dequePopBack },
+        { "deque-concat", &lspcore::BuiltinProcedures::dequeConcat },
+        { "deque-split", &lspcore::BuiltinProcedures::dequeSplit },
+        { "packed-int32", &lspcore::BuiltinProcedures::packedInt32 },
+        { "packed-int64", &lspcore::BuiltinProcedures::packedInt64 },
+        { "packed-double", &lspcore::BuiltinProcedures::packedDouble },
+        { "array->packed", &lspcore::BuiltinProcedures::arrayToPacked },
+        { "packed->array", &lspcore::BuiltinProcedures::packedToArray },
+        { "packed-length", &lspcore::BuiltinProcedures::packedLength },
+        { "packed-ref", &lspcore::BuiltinProcedures::packedRef },
+        { "packed+", &lspcore::BuiltinProcedures::packedAdd },
+        { "packed-", &lspcore::BuiltinProcedures::packedSubtract },
+        { "packed*", &lspcore::BuiltinProcedures::packedMultiply },
+        { "packed/", &lspcore::BuiltinProcedures::packedDivide },
+        { "packed<", &lspcore::BuiltinProcedures::packedLess },
+        { "packed<=", &lspcore::BuiltinProcedures::packedLessOrEqual },
+        { "packed=", &lspcore::BuiltinProcedures::packedEqual },
+        { "packed>=", &lspcore::BuiltinProcedures::packedGreaterOrEqual },
+        { "packed>", &lspcore::BuiltinProcedures::packedGreater },
+        { "packed-sum", &lspcore::BuiltinProcedures::packedSum },
+        { "packed-min", &lspcore::BuiltinProcedures::packedMin },
+        { "packed-max", &lspcore::BuiltinProcedures::packedMax },
+        { "packed-dot", &lspcore::BuiltinProcedures::packedDot },
+        { "packed-scan", &lspcore::BuiltinProcedures::packedScan },
+        { "rope", &lspcore::BuiltinProcedures::rope },
+        { "rope-append", &lspcore::BuiltinProcedures::ropeAppend },
+        { "rope-length", &lspcore::BuiltinProcedures::ropeLength },
+        { "rope-ref", &lspcore::BuiltinProcedures::ropeRef },
+        { "rope-slice", &lspcore::BuiltinProcedures::ropeSlice },
+        { "rope->string", &lspcore::BuiltinProcedures::ropeToString },
+        { "substring", &lspcore::BuiltinProcedures::substring },
+        { "string-split", &lspcore::BuiltinProcedures::stringSplit },
+        { "bytes-slice", &lspcore::BuiltinProcedures::bytesSlice },
+        { "hash-table", &lspcore::BuiltinProcedures::hashTable },
+        { "hash-ref", &lspcore::BuiltinProcedures::hashRef },
+        { "hash-set!", &lspcore::BuiltinProcedures::hashSetInPlace },
+        { "hash-update!", &lspcore::BuiltinProcedures::hashUpdateInPlace },
+        { "hash-count", &lspcore::BuiltinProcedures::hashCount },
+        { "vector", &lspcore::BuiltinProcedures::mutableVector },
+        { "make-vector", &lspcore::BuiltinProcedures::makeMutableVector },
+        { "vector-length", &lspcore::BuiltinProcedures::mutableVectorLength },
+        { "vector-ref", &lspcore::BuiltinProcedures::mutableVectorRef },
+        { "vector-set!",
+          &lspcore::BuiltinProcedures::mutableVectorSetInPlace },
+        { "vector-push!",
+          &lspcore::BuiltinProcedures::mutableVectorPushInPlace },
+        { "vector-freeze", &lspcore::BuiltinProcedures::mutableVectorFreeze }
     };
 
     for (const Entry* entry = procedures;
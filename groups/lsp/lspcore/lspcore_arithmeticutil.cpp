@@ -1,19 +1,17 @@
 #include <bdlb_arrayutil.h>
-#include <bdlb_bitutil.h>
 #include <bdld_datummaker.h>
 #include <bdldfp_decimal.h>
-#include <bdldfp_decimalutil.h>
 #include <bsl_algorithm.h>
-#include <bsl_cmath.h>
 #include <bsl_functional.h>
 #include <bsl_limits.h>
 #include <bsl_numeric.h>
+#include <bsl_sstream.h>
 #include <bsl_utility.h>
 #include <bslmf_assert.h>
 #include <bsls_assert.h>
 #include <bsls_types.h>
 #include <lspcore_arithmeticutil.h>
-#include <math.h>  // isnan
+#include <lspcore_numberutil.h>
 
 using namespace BloombergLP;
 
@@ -43,10 +41,22 @@ double the<double>(const bdld::Datum& datum) {
     return datum.theDouble();
 }
 
+// Return the value of the specified 'datum' as a 'NUMBER'. The behavior is
+// undefined unless 'datum' is a 'NUMBER' or an 'int'. This is how arguments of
+// mixed type are converted to their common type as they are used, rather than
+// by rewriting the arguments beforehand.
+template <typename NUMBER>
+NUMBER as(const bdld::Datum& datum) {
+    if (datum.isInteger()) {
+        return NUMBER(datum.theInteger());
+    }
+    return the<NUMBER>(datum);
+}
+
 template <template <typename> class OPERATOR, typename NUMBER>
 struct Operator {
     NUMBER operator()(NUMBER soFar, const bdld::Datum& number) const {
-        return OPERATOR<NUMBER>()(soFar, the<NUMBER>(number));
+        return OPERATOR<NUMBER>()(soFar, as<NUMBER>(number));
     }
 };
 
@@ -144,11 +154,24 @@ Classification classify(Bits types) {
 }
 
 Classification classify(const bsl::vector<bdld::Datum>& data) {
-    Bits types = 0;
-    for (bsl::size_t i = 0; i < data.size(); ++i) {
-        types |= Bits(1) << data[i].type();
+    // Accumulate the type bits four elements at a time into independent
+    // masks, so that examining one element need not wait for the '|=' of the
+    // previous one. This matters for large argument lists, e.g. those of
+    // '(apply + numbers)'.
+    Bits                     types[4] = { 0, 0, 0, 0 };
+    const bdld::Datum*       iter     = data.data();
+    const bdld::Datum* const end      = iter + data.size();
+    for (; end - iter >= 4; iter += 4) {
+        types[0] |= Bits(1) << iter[0].type();
+        types[1] |= Bits(1) << iter[1].type();
+        types[2] |= Bits(1) << iter[2].type();
+        types[3] |= Bits(1) << iter[3].type();
     }
-    return classify(types);
+    for (; iter != end; ++iter) {
+        types[0] |= Bits(1) << iter->type();
+    }
+
+    return classify(types[0] | types[1] | types[2] | types[3]);
 }
 
 template <typename NUMBER>
@@ -170,12 +193,12 @@ void homogeneousSubtract(bsl::vector<bdld::Datum>& argsAndOutput,
 
     NUMBER result;
     if (argsAndOutput.size() == 1) {
-        result = -the<NUMBER>(argsAndOutput[0]);
+        result = -as<NUMBER>(argsAndOutput[0]);
     }
     else {
         result = bsl::accumulate(argsAndOutput.begin() + 1,
                                  argsAndOutput.end(),
-                                 the<NUMBER>(argsAndOutput[0]),
+                                 as<NUMBER>(argsAndOutput[0]),
                                  Operator<bsl::minus, NUMBER>());
     }
 
@@ -202,12 +225,12 @@ void homogeneousDivide(bsl::vector<bdld::Datum>& argsAndOutput,
 
     NUMBER result;
     if (argsAndOutput.size() == 1) {
-        result = the<NUMBER>(argsAndOutput[0]);
+        result = as<NUMBER>(argsAndOutput[0]);
     }
     else {
         result = bsl::accumulate(argsAndOutput.begin() + 1,
                                  argsAndOutput.end(),
-                                 the<NUMBER>(argsAndOutput[0]),
+                                 as<NUMBER>(argsAndOutput[0]),
                                  Operator<bsl::divides, NUMBER>());
     }
 
@@ -215,55 +238,17 @@ void homogeneousDivide(bsl::vector<bdld::Datum>& argsAndOutput,
     argsAndOutput[0] = bdld::DatumMaker(allocator)(result);
 }
 
-template <typename OUTPUT>
-class NumericConvert {
-    bdld::DatumMaker d_make;
-
-  public:
-    explicit NumericConvert(bslma::Allocator* allocator)
-    : d_make(allocator) {
-    }
-
-    bdld::Datum operator()(const bdld::Datum& datum) const {
-        if (datum.type() == bdld::Datum::e_INTEGER) {
-            OUTPUT number(datum.theInteger());
-            return d_make(number);
-        }
-
-        return datum;
-    }
-};
-
-// TODO: document
-bdld::Datum::DataType normalizeTypes(bsl::vector<bdld::Datum>& data,
-                                     bslma::Allocator*         allocator) {
+// Return the type to which the specified 'data' are converted by arithmetic:
+// their common type if they are 'int' and one other number type, or their
+// type if they all have the same type. Throw an error if any of 'data' is not
+// a number, or if they have incompatible number types. Note that 'data' are
+// not modified; each 'int' is converted as it is used (see 'as').
+bdld::Datum::DataType commonType(const bsl::vector<bdld::Datum>& data,
+                                 bslma::Allocator*               allocator) {
     Classification result = classify(data);
 
     switch (result.kind) {
         case Classification::e_COMMON_TYPE:
-            switch (result.type) {
-                case bdld::Datum::e_INTEGER64:
-                    bsl::transform(
-                        data.begin(),
-                        data.end(),
-                        data.begin(),
-                        NumericConvert<bsls::Types::Int64>(allocator));
-                    break;
-                case bdld::Datum::e_DOUBLE:
-                    bsl::transform(data.begin(),
-                                   data.end(),
-                                   data.begin(),
-                                   NumericConvert<double>(allocator));
-                    break;
-                default:
-                    BSLS_ASSERT(result.type == bdld::Datum::e_DECIMAL64);
-                    bsl::transform(
-                        data.begin(),
-                        data.end(),
-                        data.begin(),
-                        NumericConvert<bdldfp::Decimal64>(allocator));
-            }
-        // fall through
         case Classification::e_SAME_TYPE:
             return result.type;
         case Classification::e_ERROR_INCOMPATIBLE_NUMBER_TYPES:
@@ -281,166 +266,74 @@ bdld::Datum::DataType normalizeTypes(bsl::vector<bdld::Datum>& data,
     }
 }
 
-int divideFives(bsl::uint64_t* ptr) {
-    BSLS_ASSERT(ptr);
-    bsl::uint64_t& value = *ptr;
-    BSLS_ASSERT(value != 0);
+// The following relations are satisfied by the result of a three-way
+// comparison of two numbers. See 'compareAdjacent'.
 
-    int count;
-    for (count = 0; value % 5 == 0; ++count) {
-        value /= 5;
+struct IsEqual {
+    bool operator()(int comparison) const {
+        return comparison == 0;
     }
+};
 
-    return count;
-}
-
-bool notEqual(double binary, bdldfp::Decimal64 decimal) {
-    // Ladies and gentlemen, I present to you the least efficient equality
-    // predicate ever devised.
-    //
-    // The plan is to divide out the factors of 2 and 5 from the significands
-    // of 'binary' and 'decimal'. Since the radix of 'binary' is 2 and the
-    // radix of 'decimal' is 10 (which is 2*5), we can then compare the reduced
-    // significands and the exponents.
-    //
-    // One optimization is possible for "find the factors of two in the
-    // significand." For nonzero values, we can count the number of trailing
-    // zero bits (that's the number of factors of two) and then shift right
-    // that many bits.
-    //
-    // Factors of five we'll have to do the hard way, but we need check the
-    // powers of five only if the powers of two happen to be equal.
-
-    // 'bsl::uint64_t' and 'bsls::Types::Uint64' can be different types, and
-    // the compiler will complain about aliasing. Here I just pick one and
-    // copy to the other where necessary.
-    typedef bsl::uint64_t Uint64;
-
-    bsls::Types::Uint64 decimalMantissaArg;  // long vs. long long ugh...
-    int                 decimalSign;         // -1 or +1
-    int                 decimalExponent;
-    switch (
-        const int kind = bdldfp::DecimalUtil::decompose(
-            &decimalSign, &decimalMantissaArg, &decimalExponent, decimal)) {
-        case FP_NAN:
-            return true;
-        case FP_INFINITE:
-            return binary !=
-                   bsl::numeric_limits<double>::infinity() * decimalSign;
-        case FP_SUBNORMAL:
-            // same handling as in the 'FP_NORMAL' case ('default', below)
-            break;
-        case FP_ZERO:
-            return binary != 0;
-        default:
-            (void)kind;
-            BSLS_ASSERT(kind == FP_NORMAL);
+struct IsLess {
+    bool operator()(int comparison) const {
+        return comparison < 0;
     }
+};
 
-    Uint64 decimalMantissa = decimalMantissaArg;  // long vs. long long ugh...
-
-    // Skip the calculations below if the values have different signs.
-    const int binarySign = binary < 0 ? -1 : 1;
-    if (decimalSign != binarySign) {
-        return true;
+struct IsLessOrEqual {
+    bool operator()(int comparison) const {
+        return comparison <= 0;
     }
+};
 
-    // To decompose the binary floating point value, we use the standard
-    // library function 'frexp' followed by a multiplication to guarantee an
-    // integer-valued significand. This multiplication will not lose precision.
-    int          binaryExponent;
-    const double binaryNormalizedSignificand =
-        std::frexp(binary, &binaryExponent);
-    if (binaryNormalizedSignificand == 0 ||
-        isnan(binaryNormalizedSignificand) ||
-        binaryNormalizedSignificand ==
-            std::numeric_limits<double>::infinity() ||
-        binaryNormalizedSignificand ==
-            -std::numeric_limits<double>::infinity()) {
-        return true;
+struct IsGreater {
+    bool operator()(int comparison) const {
+        return comparison > 0;
     }
+};
 
-    const int precision = 53;
-    Uint64    binaryMantissa =
-        binaryNormalizedSignificand * (Uint64(1) << (precision - 1));
-    binaryExponent -= precision - 1;
-
-    BSLS_ASSERT(binaryMantissa != 0);
-    BSLS_ASSERT(decimalMantissa != 0);
-
-    const int binaryUnset =
-        bdlb::BitUtil::numTrailingUnsetBits(binaryMantissa);
-    const int binaryTwos = binaryExponent + binaryUnset;
-
-    const int decimalUnset =
-        bdlb::BitUtil::numTrailingUnsetBits(decimalMantissa);
-    const int decimalTwos = decimalExponent + decimalUnset;
-
-    if (binaryTwos != decimalTwos) {
-        return true;
+struct IsGreaterOrEqual {
+    bool operator()(int comparison) const {
+        return comparison >= 0;
     }
+};
 
-    binaryMantissa >>= binaryUnset;
-    decimalMantissa >>= decimalUnset;
-
-    const int binaryFives  = divideFives(&binaryMantissa);
-    const int decimalFives = decimalExponent + divideFives(&decimalMantissa);
-
-    return binaryFives != decimalFives || binaryMantissa != decimalMantissa;
-}
-
-class NotEqual {
-    bslma::Allocator* d_allocator_p;
-
-  public:
-    explicit NotEqual(bslma::Allocator* allocator)
-    : d_allocator_p(allocator) {
+// Return whether every pair of adjacent arguments satisfies 'RELATION' when
+// compared by 'NumberUtil::compare', except that any comparison involving
+// not-a-number is false. Throw an error mentioning the specified
+// 'description' if there are no arguments or if any is not a number.
+template <typename RELATION>
+void compareAdjacent(const char*                           description,
+                     const NativeProcedureUtil::Arguments& args) {
+    const bsl::vector<bdld::Datum>& operands = *args.argsAndOutput;
+    if (operands.empty()) {
+        bsl::ostringstream error;
+        error << description << " requires at least one operand";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+    if (classify(operands).kind == Classification::e_ERROR_NON_NUMERIC_TYPE) {
+        bsl::ostringstream error;
+        error << description << " requires all numeric operands";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
     }
 
-    bool operator()(const bdld::Datum& left, const bdld::Datum& right) const {
-        if (left.type() == right.type()) {
-            return left != right;
-        }
-
-#define TYPE_PAIR(LEFT, RIGHT) \
-    ((bsl::uint64_t(LEFT) << 32) | bsl::uint64_t(RIGHT))
-
-        switch (TYPE_PAIR(left.type(), right.type())) {
-            case TYPE_PAIR(bdld::Datum::e_INTEGER, bdld::Datum::e_INTEGER64):
-                return left.theInteger() != right.theInteger64();
-            case TYPE_PAIR(bdld::Datum::e_INTEGER64, bdld::Datum::e_INTEGER):
-                return right.theInteger() != left.theInteger64();
-            case TYPE_PAIR(bdld::Datum::e_INTEGER, bdld::Datum::e_DOUBLE):
-                return left.theInteger() != right.theDouble();
-            case TYPE_PAIR(bdld::Datum::e_DOUBLE, bdld::Datum::e_INTEGER):
-                return right.theInteger() != left.theDouble();
-            case TYPE_PAIR(bdld::Datum::e_INTEGER, bdld::Datum::e_DECIMAL64):
-                return bdldfp::Decimal64(left.theInteger()) !=
-                       right.theDecimal64();
-            case TYPE_PAIR(bdld::Datum::e_DECIMAL64, bdld::Datum::e_INTEGER):
-                return bdldfp::Decimal64(right.theInteger()) !=
-                       left.theDecimal64();
-            case TYPE_PAIR(bdld::Datum::e_DOUBLE, bdld::Datum::e_DECIMAL64):
-                return notEqual(left.theDouble(), right.theDecimal64());
-            case TYPE_PAIR(bdld::Datum::e_DECIMAL64, bdld::Datum::e_DOUBLE):
-                return notEqual(right.theDouble(), left.theDecimal64());
-            default: {
-                bsl::ostringstream error;
-                error << "Numbers have incompatible types: " << left << " and "
-                      << right;
-                throw bdld::Datum::createError(-1, error.str(), d_allocator_p);
-            }
-        }
-
-#undef TYPE_PAIR
+    bool result = true;
+    for (bsl::size_t i = 1; result && i < operands.size(); ++i) {
+        result = !NumberUtil::isNan(operands[i - 1]) &&
+                 !NumberUtil::isNan(operands[i]) &&
+                 RELATION()(NumberUtil::compare(operands[i - 1], operands[i]));
     }
-};
+
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = bdld::Datum::createBoolean(result);
+}
 
 }  // namespace
 
 #define DISPATCH(FUNCTION)                                                \
     switch (bdld::Datum::DataType type =                                  \
-                normalizeTypes(*args.argsAndOutput, args.allocator)) {    \
+                commonType(*args.argsAndOutput, args.allocator)) {        \
         case bdld::Datum::e_INTEGER:                                      \
             return FUNCTION<int>(*args.argsAndOutput, args.allocator);    \
         case bdld::Datum::e_INTEGER64:                                    \
@@ -484,33 +377,24 @@ void ArithmeticUtil::divide(const NativeProcedureUtil::Arguments& args) {
 #undef DISPATCH
 
 void ArithmeticUtil::equal(const NativeProcedureUtil::Arguments& args) {
-    if (args.argsAndOutput->empty()) {
-        throw bdld::Datum::createError(
-            -1,
-            "equality comparison requires at least one operand",
-            args.allocator);
-    }
-    if (classify(*args.argsAndOutput).kind ==
-        Classification::e_ERROR_NON_NUMERIC_TYPE) {
-        throw bdld::Datum::createError(
-            -1,
-            "equality comparison requires all numeric operands",
-            args.allocator);
-    }
+    compareAdjacent<IsEqual>("equality comparison", args);
+}
 
-    bool result;
-    if (args.argsAndOutput->size() == 1) {
-        result = true;
-    }
-    else {
-        result = std::adjacent_find(args.argsAndOutput->begin(),
-                                    args.argsAndOutput->end(),
-                                    NotEqual(args.allocator)) ==
-                 args.argsAndOutput->end();
-    }
+void ArithmeticUtil::less(const NativeProcedureUtil::Arguments& args) {
+    compareAdjacent<IsLess>("ordering comparison", args);
+}
 
-    args.argsAndOutput->resize(1);
-    args.argsAndOutput->front() = bdld::Datum::createBoolean(result);
+void ArithmeticUtil::lessOrEqual(const NativeProcedureUtil::Arguments& args) {
+    compareAdjacent<IsLessOrEqual>("ordering comparison", args);
+}
+
+void ArithmeticUtil::greater(const NativeProcedureUtil::Arguments& args) {
+    compareAdjacent<IsGreater>("ordering comparison", args);
+}
+
+void ArithmeticUtil::greaterOrEqual(
+    const NativeProcedureUtil::Arguments& args) {
+    compareAdjacent<IsGreaterOrEqual>("ordering comparison", args);
 }
 
 }  // namespace lspcore
@@ -0,0 +1,440 @@
+#include <bsls_assert.h>
+#include <lspcore_base64util.h>
+#include <lspcore_cpuutil.h>
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+#include <immintrin.h>
+#endif
+
+using namespace BloombergLP;
+
+namespace lspcore {
+namespace {
+
+const char k_ALPHABET[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// 'k_SEXTETS[c]' is the six bit value of the base64 character 'c', or
+// 'k_INVALID' if 'c' is not in the alphabet. Since every valid value is less
+// than 'k_INVALID', a group of characters can be checked all at once by
+// testing the bitwise OR of their values.
+const unsigned char k_INVALID = 64;
+
+const unsigned char k_SEXTETS[256] = {
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 62, 64, 64, 64, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 64, 64, 64, 64, 64, 64,
+    64,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 64, 64, 64, 64, 64,
+    64, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64
+};
+
+// Encode the three bytes at the specified 'input' as four characters at the
+// specified 'output'.
+void encodeTriplet(char* output, const unsigned char* input) {
+    output[0] = k_ALPHABET[input[0] >> 2];
+    output[1] = k_ALPHABET[((input[0] & 0x3) << 4) | (input[1] >> 4)];
+    output[2] = k_ALPHABET[((input[1] & 0xF) << 2) | (input[2] >> 6)];
+    output[3] = k_ALPHABET[input[2] & 0x3F];
+}
+
+// Decode the four characters at the specified 'input' into three bytes at the
+// specified 'output'. Return zero on success, or a nonzero value if any of
+// the characters is not in the alphabet.
+int decodeQuad(char* output, const char* input) {
+    const unsigned a = k_SEXTETS[static_cast<unsigned char>(input[0])];
+    const unsigned b = k_SEXTETS[static_cast<unsigned char>(input[1])];
+    const unsigned c = k_SEXTETS[static_cast<unsigned char>(input[2])];
+    const unsigned d = k_SEXTETS[static_cast<unsigned char>(input[3])];
+    if ((a | b | c | d) & k_INVALID) {
+        return 1;
+    }
+
+    const unsigned bits = (a << 18) | (b << 12) | (c << 6) | d;
+    output[0]           = char(bits >> 16);
+    output[1]           = char(bits >> 8);
+    output[2]           = char(bits);
+    return 0;
+}
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+// The vectorized implementations below follow Wojciech Muła and Daniel
+// Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions"
+// (2018). Each 32-bit lane holds three bytes of binary or four characters of
+// base64. The "unpack" step spreads three bytes into four bytes of six bits
+// each, and the "pack" step does the reverse. Translation between six bit
+// values and characters is done with byte-wise comparisons and table
+// lookups ('pshufb').
+
+// Return the four sextets of each 32-bit lane of the specified 'input', whose
+// bytes have already been shuffled into the order '[1, 0, 2, 1]' of the
+// original three bytes.
+LSPCORE_CPUUTIL_TARGET("ssse3")
+__m128i unpack(__m128i input) {
+    const __m128i ac =
+        _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)),
+                        _mm_set1_epi32(0x04000040));
+    const __m128i bd =
+        _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)),
+                        _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(ac, bd);
+}
+
+// Return the characters of the alphabet for each of the sextets in the
+// specified 'values'. First map each sextet to the index of its contiguous
+// range of characters ("A-Z", "a-z", "0-9", "+", "/"), and then look up the
+// offset from the sextet to the character for that range.
+// Return, for each index computed by 'toCharacters', the offset from a
+// sextet to its character.
+LSPCORE_CPUUTIL_TARGET("ssse3")
+__m128i characterOffsets() {
+    return _mm_setr_epi8('a' - 26,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '+' - 62,
+                         '/' - 63,
+                         'A',
+                         0,
+                         0);
+}
+
+LSPCORE_CPUUTIL_TARGET("ssse3")
+__m128i toCharacters(__m128i values) {
+    __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    range         = _mm_or_si128(
+        range,
+        _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values),
+                      _mm_set1_epi8(13)));
+    return _mm_add_epi8(values, _mm_shuffle_epi8(characterOffsets(), range));
+}
+
+// Return the sextets for each of the characters in the specified 'input',
+// and load into the specified 'valid' a mask of which characters are in the
+// alphabet. Bytes not in the alphabet, including those with the high bit
+// set, match none of the signed comparisons below.
+LSPCORE_CPUUTIL_TARGET("ssse3")
+__m128i toSextets(__m128i* valid, __m128i input) {
+#define IN_RANGE(LOW, HIGH)                                                 \
+    _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8((LOW)-1)),           \
+                  _mm_cmpgt_epi8(_mm_set1_epi8((HIGH) + 1), input))
+
+    const __m128i upper = IN_RANGE('A', 'Z');
+    const __m128i lower = IN_RANGE('a', 'z');
+    const __m128i digit = IN_RANGE('0', '9');
+    const __m128i plus  = _mm_cmpeq_epi8(input, _mm_set1_epi8('+'));
+    const __m128i slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+#undef IN_RANGE
+
+    *valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), digit),
+                          _mm_or_si128(plus, slash));
+
+    const __m128i offsets = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')),
+                     _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+        _mm_or_si128(
+            _mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+            _mm_or_si128(_mm_and_si128(plus, _mm_set1_epi8(62 - '+')),
+                         _mm_and_si128(slash, _mm_set1_epi8(63 - '/')))));
+    return _mm_add_epi8(input, offsets);
+}
+
+// Return the shuffle that gathers the three bytes at the bottom of each 32-bit
+// lane, most significant first, into the low twelve bytes.
+LSPCORE_CPUUTIL_TARGET("ssse3")
+__m128i packOrder() {
+    return _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+}
+
+// Return the shuffle that arranges each group of three bytes into the order
+// expected by 'unpack'.
+LSPCORE_CPUUTIL_TARGET("ssse3")
+__m128i unpackOrder() {
+    return _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+}
+
+// Return the three bytes packed from the four sextets of each 32-bit lane of
+// the specified 'values', in the low twelve bytes of the result.
+LSPCORE_CPUUTIL_TARGET("ssse3")
+__m128i pack(__m128i values) {
+    const __m128i pairs =
+        _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i triplets = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(triplets, packOrder());
+}
+
+// Encode twelve bytes at a time from the specified '*input' to the specified
+// '*output', advancing both, for as long as there are at least sixteen bytes
+// before the specified 'end'.
+LSPCORE_CPUUTIL_TARGET("ssse3")
+void encodeSsse3(char**                output,
+                 const unsigned char** input,
+                 const unsigned char*  end) {
+    const __m128i order = unpackOrder();
+    for (; end - *input >= 16; *input += 12, *output += 16) {
+        const __m128i bytes = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(*input)), order);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(*output),
+                         toCharacters(unpack(bytes)));
+    }
+}
+
+// Decode sixteen characters at a time from the specified '*input' to the
+// specified '*output', advancing both, for as long as there are at least
+// twenty characters before the specified 'end' (so that the four bytes
+// written past the decoded twelve will be overwritten later). Return zero on
+// success, or a nonzero value if a character not in the alphabet is found.
+LSPCORE_CPUUTIL_TARGET("ssse3")
+int decodeSsse3(char** output, const char** input, const char* end) {
+    for (; end - *input >= 20; *input += 16, *output += 12) {
+        __m128i       valid;
+        const __m128i values = toSextets(
+            &valid,
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(*input)));
+        if (_mm_movemask_epi8(valid) != 0xFFFF) {
+            return 1;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(*output), pack(values));
+    }
+    return 0;
+}
+
+// The AVX2 versions of the above operate on two independent 128-bit lanes.
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+__m256i unpack(__m256i input) {
+    const __m256i ac = _mm256_mulhi_epu16(
+        _mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)),
+        _mm256_set1_epi32(0x04000040));
+    const __m256i bd = _mm256_mullo_epi16(
+        _mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)),
+        _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(ac, bd);
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+__m256i toCharacters(__m256i values) {
+    __m256i range = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+    range         = _mm256_or_si256(
+        range,
+        _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), values),
+                         _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(
+        values,
+        _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(characterOffsets()),
+                            range));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+__m256i toSextets(__m256i* valid, __m256i input) {
+#define IN_RANGE(LOW, HIGH)                                                 \
+    _mm256_and_si256(                                                       \
+        _mm256_cmpgt_epi8(input, _mm256_set1_epi8((LOW)-1)),               \
+        _mm256_cmpgt_epi8(_mm256_set1_epi8((HIGH) + 1), input))
+
+    const __m256i upper = IN_RANGE('A', 'Z');
+    const __m256i lower = IN_RANGE('a', 'z');
+    const __m256i digit = IN_RANGE('0', '9');
+    const __m256i plus  = _mm256_cmpeq_epi8(input, _mm256_set1_epi8('+'));
+    const __m256i slash = _mm256_cmpeq_epi8(input, _mm256_set1_epi8('/'));
+#undef IN_RANGE
+
+    *valid = _mm256_or_si256(
+        _mm256_or_si256(_mm256_or_si256(upper, lower), digit),
+        _mm256_or_si256(plus, slash));
+
+    const __m256i offsets = _mm256_or_si256(
+        _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')),
+                        _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))),
+        _mm256_or_si256(
+            _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')),
+            _mm256_or_si256(
+                _mm256_and_si256(plus, _mm256_set1_epi8(62 - '+')),
+                _mm256_and_si256(slash, _mm256_set1_epi8(63 - '/')))));
+    return _mm256_add_epi8(input, offsets);
+}
+
+// Return the twenty-four bytes packed from the sextets in the specified
+// 'values', in the low twenty-four bytes of the result.
+LSPCORE_CPUUTIL_TARGET("avx2")
+__m256i pack(__m256i values) {
+    const __m256i pairs =
+        _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    const __m256i triplets =
+        _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    const __m256i lanes    = _mm256_shuffle_epi8(
+        triplets, _mm256_broadcastsi128_si256(packOrder()));
+    // Each lane now has twelve bytes at its beginning. Bring them together.
+    return _mm256_permutevar8x32_epi32(
+        lanes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+}
+
+// Encode twenty-four bytes at a time, for as long as there are at least
+// twenty-eight bytes before the specified 'end' (each lane loads sixteen).
+LSPCORE_CPUUTIL_TARGET("avx2")
+void encodeAvx2(char**                output,
+                const unsigned char** input,
+                const unsigned char*  end) {
+    const __m256i order = _mm256_broadcastsi128_si256(unpackOrder());
+    for (; end - *input >= 28; *input += 24, *output += 32) {
+        const __m128i low =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(*input));
+        const __m128i high =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(*input + 12));
+        const __m256i bytes = _mm256_shuffle_epi8(
+            _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1),
+            order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(*output),
+                            toCharacters(unpack(bytes)));
+    }
+}
+
+// Decode thirty-two characters at a time, for as long as there are at least
+// forty-four characters before the specified 'end' (so that the eight bytes
+// written past the decoded twenty-four will be overwritten later).
+LSPCORE_CPUUTIL_TARGET("avx2")
+int decodeAvx2(char** output, const char** input, const char* end) {
+    for (; end - *input >= 44; *input += 32, *output += 24) {
+        __m256i       valid;
+        const __m256i values = toSextets(
+            &valid,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(*input)));
+        if (_mm256_movemask_epi8(valid) != -1) {
+            return 1;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(*output),
+                            pack(values));
+    }
+    return 0;
+}
+#endif
+
+}  // namespace
+
+bsl::size_t Base64Util::encodedLength(bsl::size_t size) {
+    return (size + 2) / 3 * 4;
+}
+
+bsl::size_t Base64Util::maxDecodedLength(bsl::size_t length) {
+    return length / 4 * 3;
+}
+
+void Base64Util::encode(char* output, const char* input, bsl::size_t size) {
+    BSLS_ASSERT(output || size == 0);
+    BSLS_ASSERT(input || size == 0);
+
+    const unsigned char* in  = reinterpret_cast<const unsigned char*>(input);
+    const unsigned char* end = in + size;
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    if (CpuUtil::hasAvx2()) {
+        encodeAvx2(&output, &in, end);
+    }
+    if (CpuUtil::hasSsse3()) {
+        encodeSsse3(&output, &in, end);
+    }
+#endif
+
+    for (; end - in >= 3; in += 3, output += 4) {
+        encodeTriplet(output, in);
+    }
+
+    switch (end - in) {
+        case 2:
+            output[0] = k_ALPHABET[in[0] >> 2];
+            output[1] = k_ALPHABET[((in[0] & 0x3) << 4) | (in[1] >> 4)];
+            output[2] = k_ALPHABET[(in[1] & 0xF) << 2];
+            output[3] = '=';
+            break;
+        case 1:
+            output[0] = k_ALPHABET[in[0] >> 2];
+            output[1] = k_ALPHABET[(in[0] & 0x3) << 4];
+            output[2] = '=';
+            output[3] = '=';
+            break;
+        default:
+            BSLS_ASSERT(end == in);
+    }
+}
+
+int Base64Util::decode(char*        output,
+                       bsl::size_t* decodedSize,
+                       const char*  input,
+                       bsl::size_t  length) {
+    BSLS_ASSERT(output || length == 0);
+    BSLS_ASSERT(decodedSize);
+    BSLS_ASSERT(input || length == 0);
+
+    if (length % 4) {
+        return 1;
+    }
+
+    if (length == 0) {
+        *decodedSize = 0;
+        return 0;
+    }
+
+    // The last four characters might contain padding, and so are handled
+    // separately from the others.
+    char* const       begin = output;
+    const char* const last  = input + length - 4;
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    if (CpuUtil::hasAvx2() && decodeAvx2(&output, &input, last)) {
+        return 2;
+    }
+    if (CpuUtil::hasSsse3() && decodeSsse3(&output, &input, last)) {
+        return 3;
+    }
+#endif
+
+    for (; input != last; input += 4, output += 3) {
+        if (decodeQuad(output, input)) {
+            return 4;
+        }
+    }
+
+    // "xy==" is one byte, "xyz=" is two, and "xyzw" is three. In the first
+    // two cases, the bits that don't fit into the bytes must be zero.
+    const int padding =
+        (input[3] == '=') + (input[2] == '=' && input[3] == '=');
+    const char quad[] = { input[0],
+                          input[1],
+                          padding == 2 ? 'A' : input[2],
+                          padding >= 1 ? 'A' : input[3] };
+    char       bytes[3];
+    if (decodeQuad(bytes, quad)) {
+        return 5;
+    }
+
+    const int remaining = 3 - padding;
+    if (padding && bytes[remaining]) {
+        return 6;
+    }
+    for (int i = 0; i < remaining; ++i) {
+        *output++ = bytes[i];
+    }
+
+    *decodedSize = output - begin;
+    return 0;
+}
+
+}  // namespace lspcore
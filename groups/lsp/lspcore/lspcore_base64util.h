@@ -0,0 +1,42 @@
+#ifndef INCLUDED_LSPCORE_BASE64UTIL
+#define INCLUDED_LSPCORE_BASE64UTIL
+
+#include <bsl_cstddef.h>
+
+namespace lspcore {
+
+// 'Base64Util' encodes and decodes the standard base64 alphabet of RFC 4648
+// ("A-Z", "a-z", "0-9", "+", "/", with "=" padding). Where the processor
+// supports them, SSSE3 or AVX2 instructions are used for the bulk of the
+// work, with a table driven implementation for the remainder.
+struct Base64Util {
+    // Return the number of characters in the base64 encoding of the
+    // specified 'size' bytes, including padding.
+    static bsl::size_t encodedLength(bsl::size_t size);
+
+    // Return the maximum number of bytes that the specified 'length'
+    // characters of base64 could decode into.
+    static bsl::size_t maxDecodedLength(bsl::size_t length);
+
+    // Write the base64 encoding of the specified 'size' bytes at the
+    // specified 'input' to the specified 'output', which must have room for
+    // 'encodedLength(size)' characters.
+    static void encode(char* output, const char* input, bsl::size_t size);
+
+    // Write the bytes encoded by the specified 'length' characters at the
+    // specified 'input' to the specified 'output', which must have room for
+    // 'maxDecodedLength(length)' bytes, and load into the specified
+    // 'decodedSize' the number of bytes written. Return zero on success, or
+    // a nonzero value if 'input' is not in canonical form. The canonical form
+    // is a multiple of four characters from the alphabet, where only the
+    // last one or two may be "=", and where the bits discarded by padding are
+    // zero. Note that the contents of 'output' are unspecified on failure.
+    static int decode(char*        output,
+                      bsl::size_t* decodedSize,
+                      const char*  input,
+                      bsl::size_t  length);
+};
+
+}  // namespace lspcore
+
+#endif
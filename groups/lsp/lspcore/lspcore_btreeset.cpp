@@ -0,0 +1,464 @@
+#include <bsl_algorithm.h>
+#include <bsl_new.h>
+#include <bsl_vector.h>
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+#include <lspcore_btreeset.h>
+#include <lspcore_listutil.h>
+#include <lspcore_userdefinedtypes.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+// Path Copying
+// ============
+// Nodes are never modified once built. Every operation that changes a node
+// copies it into a 'BTreeSetBuilder', modifies the copy, and then builds a new
+// node from the copy. A builder has room for one more value than a node may
+// hold, so that an insertion can overflow a node, after which the builder is
+// split into two nodes and the middle value moves up into the parent. A
+// removal can leave a node with fewer than 'k_MIN_VALUES' values, after which
+// the parent rebalances it by borrowing a value from a sibling, or by merging
+// it with a sibling.
+class BTreeSetBuilder {
+  public:
+    enum { k_CAPACITY = BTreeSet::k_MAX_VALUES + 1 };
+
+    bdld::Datum     values[k_CAPACITY];
+    const BTreeSet* children[k_CAPACITY + 1];
+    int             count;
+    int             height;
+
+    explicit BTreeSetBuilder(int height)
+    : count(0)
+    , height(height) {
+    }
+
+    explicit BTreeSetBuilder(const BTreeSet& node)
+    : count(node.count())
+    , height(node.height()) {
+        bsl::copy(node.values(), node.values() + count, values);
+        if (height) {
+            bsl::copy(node.children(), node.children() + count + 1, children);
+        }
+    }
+
+    // Insert the specified 'value' before the value at the specified
+    // 'valueIndex' and, unless this is a leaf, the specified 'child' before
+    // the child at the specified 'childIndex'.
+    void insert(int                valueIndex,
+                const bdld::Datum& value,
+                int                childIndex,
+                const BTreeSet*    child) {
+        BSLS_ASSERT(count < k_CAPACITY);
+
+        bsl::copy_backward(
+            values + valueIndex, values + count, values + count + 1);
+        values[valueIndex] = value;
+        if (height) {
+            bsl::copy_backward(children + childIndex,
+                               children + count + 1,
+                               children + count + 2);
+            children[childIndex] = child;
+        }
+        ++count;
+    }
+
+    // Remove the value at the specified 'valueIndex' and, unless this is a
+    // leaf, the child at the specified 'childIndex'.
+    void erase(int valueIndex, int childIndex) {
+        BSLS_ASSERT(count > 0);
+
+        bsl::copy(
+            values + valueIndex + 1, values + count, values + valueIndex);
+        if (height) {
+            bsl::copy(children + childIndex + 1,
+                      children + count + 1,
+                      children + childIndex);
+        }
+        --count;
+    }
+
+    // Append the specified 'separator' and then the values and children of
+    // the specified 'node'.
+    void append(const bdld::Datum& separator, const BTreeSet& node) {
+        BSLS_ASSERT(count + 1 + node.count() <= k_CAPACITY);
+
+        values[count] = separator;
+        bsl::copy(
+            node.values(), node.values() + node.count(), values + count + 1);
+        if (height) {
+            bsl::copy(node.children(),
+                      node.children() + node.count() + 1,
+                      children + count + 1);
+        }
+        count += 1 + node.count();
+    }
+
+    // Return a new node containing the values in the range
+    // '[begin, end)' and, unless this is a leaf, the children in the range
+    // '[begin, end + 1)'.
+    const BTreeSet* build(int               begin,
+                          int               end,
+                          bslma::Allocator* allocator) const {
+        BSLS_ASSERT(end - begin <= BTreeSet::k_MAX_VALUES);
+
+        const int         size = end - begin;
+        const bsl::size_t bytes =
+            BTreeSet::childrenOffset(size) +
+            (height ? (size + 1) * sizeof(const BTreeSet*) : 0);
+        char* const memory =
+            static_cast<char*>(allocator->allocate(bytes));
+        BTreeSet* const node = new (memory) BTreeSet(size, height);
+
+        bsl::copy(values + begin,
+                  values + end,
+                  reinterpret_cast<bdld::Datum*>(memory +
+                                                 BTreeSet::valuesOffset()));
+        if (height) {
+            bsl::copy(children + begin,
+                      children + end + 1,
+                      reinterpret_cast<const BTreeSet**>(
+                          memory + BTreeSet::childrenOffset(size)));
+        }
+
+        return node;
+    }
+
+    const BTreeSet* build(bslma::Allocator* allocator) const {
+        return build(0, count, allocator);
+    }
+};
+
+namespace {
+
+// Return the index of the first value in the specified 'node' that is not
+// before the specified 'value'.
+int lowerBound(const BTreeSet&             node,
+               const bdld::Datum&          value,
+               const BTreeSet::Comparator& before) {
+    int low  = 0;
+    int high = node.count();
+    while (low < high) {
+        const int middle = low + (high - low) / 2;
+        if (before(node.value(middle), value)) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+// Return whether the value at the specified 'index' in the specified 'node',
+// where 'index' is the 'lowerBound' of the specified 'value', is equivalent
+// to 'value'.
+bool isAt(const BTreeSet&             node,
+          int                         index,
+          const bdld::Datum&          value,
+          const BTreeSet::Comparator& before) {
+    return index < node.count() && !before(value, node.value(index));
+}
+
+// The result of inserting into a subtree is either one node, 'left', or, if
+// that node overflowed, two nodes, 'left' and 'right', separated by 'middle'.
+struct InsertResult {
+    const BTreeSet* left;
+    bdld::Datum     middle;
+    const BTreeSet* right;
+};
+
+void finishInsert(InsertResult*          result,
+                  const BTreeSetBuilder& builder,
+                  bslma::Allocator*      allocator) {
+    if (builder.count <= BTreeSet::k_MAX_VALUES) {
+        result->left  = builder.build(allocator);
+        result->right = 0;
+        return;
+    }
+
+    const int middle = builder.count / 2;
+    result->left     = builder.build(0, middle, allocator);
+    result->middle   = builder.values[middle];
+    result->right    = builder.build(middle + 1, builder.count, allocator);
+}
+
+void insertNew(InsertResult*               result,
+               const BTreeSet&             node,
+               const bdld::Datum&          value,
+               const BTreeSet::Comparator& before,
+               bslma::Allocator*           allocator) {
+    const int       index = lowerBound(node, value, before);
+    BTreeSetBuilder builder(node);
+
+    if (node.isLeaf()) {
+        builder.insert(index, value, 0, 0);
+    }
+    else {
+        InsertResult child;
+        insertNew(&child, *node.child(index), value, before, allocator);
+        builder.children[index] = child.left;
+        if (child.right) {
+            builder.insert(index, child.middle, index + 1, child.right);
+        }
+    }
+
+    finishInsert(result, builder, allocator);
+}
+
+// Restore the minimum number of values in the child at the specified 'index'
+// of the specified 'parent', if it has too few, by moving a value to it from
+// a sibling that can spare one, or otherwise by merging it with a sibling.
+void rebalance(BTreeSetBuilder*  parent,
+               int               index,
+               bslma::Allocator* allocator) {
+    const BTreeSet& child = *parent->children[index];
+    if (child.count() >= BTreeSet::k_MIN_VALUES) {
+        return;
+    }
+
+    if (index > 0 &&
+        parent->children[index - 1]->count() > BTreeSet::k_MIN_VALUES) {
+        // Rotate right: the last value of the left sibling moves up into the
+        // parent, and the separator moves down to the front of 'child'.
+        BTreeSetBuilder left(*parent->children[index - 1]);
+        BTreeSetBuilder right(child);
+        right.insert(0,
+                     parent->values[index - 1],
+                     0,
+                     left.height ? left.children[left.count] : 0);
+        parent->values[index - 1] = left.values[left.count - 1];
+        left.erase(left.count - 1, left.count);
+        parent->children[index - 1] = left.build(allocator);
+        parent->children[index]     = right.build(allocator);
+        return;
+    }
+
+    if (index < parent->count &&
+        parent->children[index + 1]->count() > BTreeSet::k_MIN_VALUES) {
+        // Rotate left: the first value of the right sibling moves up into the
+        // parent, and the separator moves down to the back of 'child'.
+        BTreeSetBuilder left(child);
+        BTreeSetBuilder right(*parent->children[index + 1]);
+        left.insert(left.count,
+                    parent->values[index],
+                    left.count + 1,
+                    right.height ? right.children[0] : 0);
+        parent->values[index] = right.values[0];
+        right.erase(0, 0);
+        parent->children[index]     = left.build(allocator);
+        parent->children[index + 1] = right.build(allocator);
+        return;
+    }
+
+    // Neither sibling can spare a value, so merge 'child' with one of them.
+    // The result has at most '2 * k_MIN_VALUES' values, which fits.
+    const int       first = index > 0 ? index - 1 : index;
+    BTreeSetBuilder merged(*parent->children[first]);
+    merged.append(parent->values[first], *parent->children[first + 1]);
+    parent->erase(first, first + 1);
+    parent->children[first] = merged.build(allocator);
+}
+
+// Return the specified 'node' without its greatest value, and load that value
+// into the specified 'greatest'. The returned node might have too few values.
+const BTreeSet* removeGreatest(const BTreeSet&   node,
+                               bdld::Datum*      greatest,
+                               bslma::Allocator* allocator) {
+    BTreeSetBuilder builder(node);
+    if (node.isLeaf()) {
+        *greatest = node.value(node.count() - 1);
+        builder.erase(node.count() - 1, 0);
+        return builder.build(allocator);
+    }
+
+    const int last = node.count();
+    builder.children[last] =
+        removeGreatest(*node.child(last), greatest, allocator);
+    rebalance(&builder, last, allocator);
+    return builder.build(allocator);
+}
+
+// Return the specified 'node' without the value equivalent to the specified
+// 'value', which must be present. The returned node might have too few
+// values.
+const BTreeSet* removeExisting(const BTreeSet&             node,
+                               const bdld::Datum&          value,
+                               const BTreeSet::Comparator& before,
+                               bslma::Allocator*           allocator) {
+    const int       index = lowerBound(node, value, before);
+    BTreeSetBuilder builder(node);
+
+    if (node.isLeaf()) {
+        BSLS_ASSERT(isAt(node, index, value, before));
+        builder.erase(index, 0);
+        return builder.build(allocator);
+    }
+
+    if (isAt(node, index, value, before)) {
+        // Replace the value with its in-order predecessor, which is the
+        // greatest value in the subtree to its left.
+        builder.children[index] = removeGreatest(
+            *node.child(index), &builder.values[index], allocator);
+    }
+    else {
+        builder.children[index] =
+            removeExisting(*node.child(index), value, before, allocator);
+    }
+
+    rebalance(&builder, index, allocator);
+    return builder.build(allocator);
+}
+
+}  // namespace
+
+BTreeSet::BTreeSet(int count, int height)
+: d_count(count)
+, d_height(height) {
+}
+
+BTreeSet::Cursor::Cursor(const BTreeSet* set)
+: d_depth(0) {
+    if (set) {
+        pushLeftSpine(set);
+    }
+}
+
+void BTreeSet::Cursor::pushLeftSpine(const BTreeSet* node) {
+    for (;;) {
+        BSLS_ASSERT(d_depth < k_MAX_HEIGHT);
+
+        Frame& frame = d_stack[d_depth++];
+        frame.node   = node;
+        frame.index  = 0;
+        if (node->isLeaf()) {
+            return;
+        }
+        node = node->child(0);
+    }
+}
+
+const bdld::Datum& BTreeSet::Cursor::value() const {
+    BSLS_ASSERT(!done());
+
+    const Frame& top = d_stack[d_depth - 1];
+    return top.node->value(top.index);
+}
+
+void BTreeSet::Cursor::advance() {
+    BSLS_ASSERT(!done());
+
+    // The successor of a value in an inner node is the least value in the
+    // subtree to its right. The successor of the last value in a leaf is the
+    // next unvisited value among its ancestors.
+    Frame&    top   = d_stack[d_depth - 1];
+    const int index = top.index++;
+    if (!top.node->isLeaf()) {
+        pushLeftSpine(top.node->child(index + 1));
+        return;
+    }
+
+    while (d_depth && d_stack[d_depth - 1].index ==
+                          d_stack[d_depth - 1].node->count()) {
+        --d_depth;
+    }
+}
+
+const BTreeSet* BTreeSet::insert(const BTreeSet*    set,
+                                 const bdld::Datum& value,
+                                 const Comparator&  before,
+                                 bslma::Allocator*  allocator) {
+    if (!set) {
+        BTreeSetBuilder builder(0);
+        builder.insert(0, value, 0, 0);
+        return builder.build(allocator);
+    }
+
+    if (contains(set, value, before)) {
+        return set;
+    }
+
+    InsertResult result;
+    insertNew(&result, *set, value, before, allocator);
+    if (!result.right) {
+        return result.left;
+    }
+
+    // The root split, so the tree grows a new root.
+    BTreeSetBuilder root(set->height() + 1);
+    root.values[0]   = result.middle;
+    root.children[0] = result.left;
+    root.children[1] = result.right;
+    root.count       = 1;
+    return root.build(allocator);
+}
+
+bool BTreeSet::contains(const BTreeSet*    set,
+                        const bdld::Datum& value,
+                        const Comparator&  before) {
+    while (set) {
+        const int index = lowerBound(*set, value, before);
+        if (isAt(*set, index, value, before)) {
+            return true;
+        }
+        if (set->isLeaf()) {
+            return false;
+        }
+        set = set->child(index);
+    }
+
+    return false;
+}
+
+const BTreeSet* BTreeSet::remove(const BTreeSet*    set,
+                                 const bdld::Datum& value,
+                                 const Comparator&  before,
+                                 bslma::Allocator*  allocator) {
+    if (!contains(set, value, before)) {
+        return set;
+    }
+
+    const BTreeSet* root = removeExisting(*set, value, before, allocator);
+    if (root->count()) {
+        return root;
+    }
+
+    // The root is empty, so the tree shrinks by one level.
+    return root->isLeaf() ? 0 : root->child(0);
+}
+
+bdld::Datum BTreeSet::toList(const BTreeSet*   set,
+                             int               typeOffset,
+                             bslma::Allocator* allocator) {
+    bsl::vector<bdld::Datum> elements;
+    for (Cursor cursor(set); !cursor.done(); cursor.advance()) {
+        elements.push_back(cursor.value());
+    }
+
+    return ListUtil::createList(elements, typeOffset, allocator);
+}
+
+bool BTreeSet::isBTreeSet(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && datum.theUdt().type() ==
+                                UserDefinedTypes::e_BTREE_SET + typeOffset;
+}
+
+const BTreeSet* BTreeSet::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+const BTreeSet* BTreeSet::access(const bdld::DatumUdt& udt) {
+    return static_cast<const BTreeSet*>(udt.data());
+}
+
+bdld::Datum BTreeSet::create(const BTreeSet* set, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(set)),
+        UserDefinedTypes::e_BTREE_SET + typeOffset);
+}
+
+}  // namespace lspcore
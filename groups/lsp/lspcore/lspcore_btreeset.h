@@ -0,0 +1,161 @@
+#ifndef INCLUDED_LSPCORE_BTREESET
+#define INCLUDED_LSPCORE_BTREESET
+
+// A B-tree set is an immutable B-tree (https://en.wikipedia.org/wiki/B-tree)
+// of distinct values. It has the same interface and the same semantics as
+// 'Set', but rather than one value per node, each node holds a sorted array
+// of between 'k_MIN_VALUES' and 'k_MAX_VALUES' values (only the root may have
+// fewer). A lookup in a set of ten million elements visits five or six nodes,
+// each of which is searched in contiguous memory, instead of the two dozen
+// scattered nodes of the equivalent 'Set'. An update copies only the nodes on
+// the path from the root to the affected leaf, so the old and new sets share
+// the rest of their nodes.
+//
+// A B-tree set is represented as a pointer to its root 'BTreeSet' node. A
+// null pointer denotes an empty set. As with 'Set', the comparator 'before'
+// is an additional argument to functions that need it.
+
+#include <bdld_datum.h>
+#include <bsl_cstddef.h>
+#include <bsl_functional.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+class BTreeSet {
+  public:
+    enum { k_MIN_VALUES = 16, k_MAX_VALUES = 2 * k_MIN_VALUES };
+
+  private:
+    // A node is allocated together with its values, which are followed by
+    // its children if it is not a leaf. See 'BTreeSet::valuesOffset'.
+    int d_count;   // number of values
+    int d_height;  // zero for leaves
+
+    BTreeSet(int count, int height);
+
+    static bsl::size_t valuesOffset();
+    static bsl::size_t childrenOffset(int count);
+
+    friend class BTreeSetBuilder;
+
+  public:
+    // 'Cursor' visits the elements of a 'BTreeSet' in order without
+    // allocating memory.
+    class Cursor {
+        enum { k_MAX_HEIGHT = 24 };
+
+        struct Frame {
+            const BTreeSet* node;
+            int             index;
+        };
+
+        Frame d_stack[k_MAX_HEIGHT];
+        int   d_depth;
+
+        void pushLeftSpine(const BTreeSet*);
+
+      public:
+        explicit Cursor(const BTreeSet* set);
+
+        bool               done() const;
+        const bdld::Datum& value() const;
+        void               advance();
+    };
+
+    int  count() const;
+    int  height() const;
+    bool isLeaf() const;
+
+    const bdld::Datum* values() const;
+    const bdld::Datum& value(int index) const;
+
+    // The behavior is undefined if 'isLeaf()'.
+    const BTreeSet* const* children() const;
+    const BTreeSet*        child(int index) const;
+
+    typedef bsl::function<bool(const bdld::Datum&, const bdld::Datum&)>
+        Comparator;
+
+    static const BTreeSet* insert(const BTreeSet*    set,
+                                  const bdld::Datum& value,
+                                  const Comparator&  before,
+                                  bslma::Allocator*);
+
+    static bool contains(const BTreeSet*    set,
+                         const bdld::Datum& value,
+                         const Comparator&  before);
+
+    static const BTreeSet* remove(const BTreeSet*    set,
+                                  const bdld::Datum& value,
+                                  const Comparator&  before,
+                                  bslma::Allocator*);
+
+    // Return a list of the elements of the specified 'set' in order.
+    static bdld::Datum toList(const BTreeSet* set,
+                              int             typeOffset,
+                              bslma::Allocator*);
+
+    static bool isBTreeSet(const bdld::Datum&, int typeOffset);
+
+    static const BTreeSet* access(const bdld::Datum&);
+    static const BTreeSet* access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(const BTreeSet* set, int typeOffset);
+};
+
+inline bsl::size_t BTreeSet::valuesOffset() {
+    const bsl::size_t alignment = alignof(bdld::Datum);
+    return (sizeof(BTreeSet) + alignment - 1) / alignment * alignment;
+}
+
+inline bsl::size_t BTreeSet::childrenOffset(int count) {
+    const bsl::size_t alignment = alignof(const BTreeSet*);
+    const bsl::size_t offset    = valuesOffset() + count * sizeof(bdld::Datum);
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+inline int BTreeSet::count() const {
+    return d_count;
+}
+
+inline int BTreeSet::height() const {
+    return d_height;
+}
+
+inline bool BTreeSet::isLeaf() const {
+    return d_height == 0;
+}
+
+inline const bdld::Datum* BTreeSet::values() const {
+    return reinterpret_cast<const bdld::Datum*>(
+        reinterpret_cast<const char*>(this) + valuesOffset());
+}
+
+inline const bdld::Datum& BTreeSet::value(int index) const {
+    return values()[index];
+}
+
+inline const BTreeSet* const* BTreeSet::children() const {
+    return reinterpret_cast<const BTreeSet* const*>(
+        reinterpret_cast<const char*>(this) + childrenOffset(d_count));
+}
+
+inline const BTreeSet* BTreeSet::child(int index) const {
+    return children()[index];
+}
+
+inline bool BTreeSet::Cursor::done() const {
+    return d_depth == 0;
+}
+
+}  // namespace lspcore
+
+#endif
@@ -1,18 +1,29 @@
 #include <bdlb_arrayutil.h>
+#include <bdld_datumbinaryref.h>
 #include <bsl_cstddef.h>
-#include <bsl_queue.h>
+#include <bsl_limits.h>
+#include <bsl_new.h>
 #include <bsl_sstream.h>
-#include <bsl_utility.h>
-#include <lspcore_arithmeticutil.h>
+#include <lspcore_btreeset.h>
 #include <lspcore_builtinprocedures.h>
 #include <lspcore_datumutil.h>
+#include <lspcore_deque.h>
+#include <lspcore_hashmap.h>
+#include <lspcore_hashtable.h>
 #include <lspcore_interpreter.h>
+#include <lspcore_inttrie.h>
 #include <lspcore_listutil.h>
+#include <lspcore_mutablevector.h>
 #include <lspcore_nativeprocedureutil.h>
+#include <lspcore_packedvector.h>
 #include <lspcore_pair.h>
 #include <lspcore_printutil.h>
 #include <lspcore_procedure.h>
+#include <lspcore_rope.h>
+#include <lspcore_rrbvector.h>
 #include <lspcore_set.h>
+#include <lspcore_setsequence.h>
+#include <lspcore_stringutil.h>
 #include <lspcore_symbolutil.h>
 
 using namespace BloombergLP;
@@ -91,184 +102,6 @@ void BuiltinProcedures::isNull(const NativeProcedureUtil::Arguments& args) {
     args.argsAndOutput->front() = result;
 }
 
-// helpers for 'BuiltinProcedures::equal'
-namespace {
-
-class NotEqual {
-    const NativeProcedureUtil::Arguments* d_context_p;
-
-  public:
-    explicit NotEqual(const NativeProcedureUtil::Arguments& context)
-    : d_context_p(&context) {
-    }
-
-    bool operator()(const bdld::Datum& left, const bdld::Datum& right) const {
-#define TYPE_PAIR(LEFT, RIGHT) \
-    ((bsl::uint64_t(LEFT) << 32) | bsl::uint64_t(RIGHT))
-
-        switch (TYPE_PAIR(left.type(), right.type())) {
-            // numeric cases
-            case TYPE_PAIR(bdld::Datum::e_INTEGER, bdld::Datum::e_INTEGER64):
-            case TYPE_PAIR(bdld::Datum::e_INTEGER64, bdld::Datum::e_INTEGER):
-            case TYPE_PAIR(bdld::Datum::e_INTEGER, bdld::Datum::e_DOUBLE):
-            case TYPE_PAIR(bdld::Datum::e_DOUBLE, bdld::Datum::e_INTEGER):
-            case TYPE_PAIR(bdld::Datum::e_INTEGER, bdld::Datum::e_DECIMAL64):
-            case TYPE_PAIR(bdld::Datum::e_DECIMAL64, bdld::Datum::e_INTEGER):
-            case TYPE_PAIR(bdld::Datum::e_DOUBLE, bdld::Datum::e_DECIMAL64):
-            case TYPE_PAIR(bdld::Datum::e_DECIMAL64, bdld::Datum::e_DOUBLE):
-
-            case TYPE_PAIR(bdld::Datum::e_DECIMAL64, bdld::Datum::e_DECIMAL64):
-            case TYPE_PAIR(bdld::Datum::e_DOUBLE, bdld::Datum::e_DOUBLE):
-            case TYPE_PAIR(bdld::Datum::e_INTEGER, bdld::Datum::e_INTEGER):
-            case TYPE_PAIR(bdld::Datum::e_INTEGER64, bdld::Datum::e_INTEGER64):
-
-            case TYPE_PAIR(bdld::Datum::e_INTEGER64, bdld::Datum::e_DOUBLE):
-            case TYPE_PAIR(bdld::Datum::e_DOUBLE, bdld::Datum::e_INTEGER64):
-            case TYPE_PAIR(bdld::Datum::e_INTEGER64, bdld::Datum::e_DECIMAL64):
-            case TYPE_PAIR(bdld::Datum::e_DECIMAL64,
-                           bdld::Datum::e_INTEGER64): {
-                // defer to '!ArithmeticUtil::equal(...)'
-                bsl::vector<bdld::Datum> args;
-                args.push_back(left);
-                args.push_back(right);
-
-                NativeProcedureUtil::Arguments subcontext = *d_context_p;
-                subcontext.argsAndOutput                  = &args;
-
-                ArithmeticUtil::equal(subcontext);
-                return subcontext.argsAndOutput->front() ==
-                       bdld::Datum::createBoolean(false);
-            }
-            // types for which the operator defined in `bdld::Datum` suffices
-            case TYPE_PAIR(bdld::Datum::e_STRING, bdld::Datum::e_STRING):
-            case TYPE_PAIR(bdld::Datum::e_BOOLEAN, bdld::Datum::e_BOOLEAN):
-            case TYPE_PAIR(bdld::Datum::e_ERROR, bdld::Datum::e_ERROR):
-            case TYPE_PAIR(bdld::Datum::e_DATE, bdld::Datum::e_DATE):
-            case TYPE_PAIR(bdld::Datum::e_TIME, bdld::Datum::e_TIME):
-            case TYPE_PAIR(bdld::Datum::e_DATETIME, bdld::Datum::e_DATETIME):
-            case TYPE_PAIR(bdld::Datum::e_DATETIME_INTERVAL,
-                           bdld::Datum::e_DATETIME_INTERVAL):
-            case TYPE_PAIR(bdld::Datum::e_BINARY, bdld::Datum::e_BINARY):
-                return left != right;
-            // types that we drill down into
-            case TYPE_PAIR(bdld::Datum::e_ARRAY, bdld::Datum::e_ARRAY):
-                return (*this)(left.theArray(), right.theArray());
-            case TYPE_PAIR(bdld::Datum::e_MAP, bdld::Datum::e_MAP):
-                return mapsNotEqual(left.theMap(), right.theMap());
-            case TYPE_PAIR(bdld::Datum::e_INT_MAP, bdld::Datum::e_INT_MAP):
-                return mapsNotEqual(left.theIntMap(), right.theIntMap());
-            case TYPE_PAIR(bdld::Datum::e_USERDEFINED,
-                           bdld::Datum::e_USERDEFINED):
-                return (*this)(left.theUdt(), right.theUdt());
-            default:
-                return true;
-        }
-
-#undef TYPE_PAIR
-    }
-
-    bool operator()(const bdld::DatumArrayRef& left,
-                    const bdld::DatumArrayRef& right) const {
-        bsl::size_t length = left.length();
-        if (right.length() != length) {
-            return true;
-        }
-
-        for (bsl::size_t i = 0; i < length; ++i) {
-            if ((*this)(left[i], right[i])) {
-                return true;
-            }
-        }
-
-        return false;
-    }
-
-    template <typename MapRef>
-    bool mapsNotEqual(const MapRef& left, const MapRef& right) const {
-        const bsl::size_t size = left.size();
-        if (right.size() != size) {
-            return true;
-        }
-
-        for (bsl::size_t i = 0; i < size; ++i) {
-            if (left[i].key() != right[i].key() ||
-                (*this)(left[i].value(), right[i].value())) {
-                return true;
-            }
-        }
-
-        return false;
-    }
-
-    bool operator()(const bdld::DatumUdt& left,
-                    const bdld::DatumUdt& right) const {
-        if (left.type() != right.type()) {
-            return true;
-        }
-
-        switch (left.type() - d_context_p->typeOffset) {
-            case UserDefinedTypes::e_PAIR:
-                return (*this)(Pair::access(left), Pair::access(right));
-            case UserDefinedTypes::e_SYMBOL:
-                // TODO: This is safe, but I still feel I messed up symbols.
-                // Maybe what I need is to leave symbols as symbols, and then
-                // have a separate 'ResolvedSymbol' type.
-                return SymbolUtil::name(left) != SymbolUtil::name(right);
-            case UserDefinedTypes::e_PROCEDURE:
-            case UserDefinedTypes::e_NATIVE_PROCEDURE:
-            case UserDefinedTypes::e_BUILTIN:
-            default:
-                return left.data() == right.data();
-        }
-    }
-
-    bool operator()(const Pair& left, const Pair& right) const {
-        // In general, 'left' and 'right' can be arbitrarily large binary
-        // trees. Do a breadth-first traversal of them in tandem.
-        bsl::queue<bsl::pair<const Pair*, const Pair*> > queue;
-        queue.push(bsl::make_pair(&left, &right));
-
-        do {
-            const Pair& left  = *queue.front().first;
-            const Pair& right = *queue.front().second;
-
-            // This is a bit arcane, but the idea is that we're running the
-            // same block of code twice: once for each Pair's '.first' and then
-            // again for each Pair's '.second'. The data member to access is
-            // abstracted out using a data member pointer, 'member'. So, this
-            // code loops over the two cases: involving '.first' and then
-            // involving '.second'.
-            bdld::Datum Pair::*const members[] = { &Pair::first,
-                                                   &Pair::second };
-            for (bdld::Datum Pair::*const* memberIter = members;
-                 memberIter != bdlb::ArrayUtil::end(members);
-                 ++memberIter) {
-                bdld::Datum Pair::*const member = *memberIter;
-
-                if (Pair::isPair(left.*member, d_context_p->typeOffset)) {
-                    if (Pair::isPair(right.*member, d_context_p->typeOffset)) {
-                        queue.push(
-                            bsl::make_pair(&Pair::access(left.*member),
-                                           &Pair::access(right.*member)));
-                    }
-                    else {
-                        return true;
-                    }
-                }
-                else if ((*this)(left.first, right.first)) {
-                    return true;
-                }
-            }
-
-            queue.pop();
-        } while (!queue.empty());
-
-        return false;
-    }
-};
-
-}  // namespace
-
 void BuiltinProcedures::equal(const NativeProcedureUtil::Arguments& args) {
     bsl::vector<bdld::Datum>& argsVec = *args.argsAndOutput;
 
@@ -279,9 +112,13 @@ void BuiltinProcedures::equal(const NativeProcedureUtil::Arguments& args) {
         return;
     }
 
-    const bdld::Datum result = bdld::Datum::createBoolean(
-        bsl::adjacent_find(argsVec.begin(), argsVec.end(), NotEqual(args)) ==
-        argsVec.end());
+    bool allEqual = true;
+    for (bsl::size_t i = 1; allEqual && i < argsVec.size(); ++i) {
+        allEqual =
+            DatumUtil::equal(argsVec[i - 1], argsVec[i], args.typeOffset);
+    }
+
+    const bdld::Datum result = bdld::Datum::createBoolean(allEqual);
     argsVec.resize(1);
     argsVec.front() = result;
 }
@@ -334,16 +171,32 @@ void BuiltinProcedures::raise(const NativeProcedureUtil::Arguments& args) {
 
 void BuiltinProcedures::set(const NativeProcedureUtil::Arguments& args) {
     // Return a 'Set' of the arguments.
-    const Set*            set = 0;
+    const DatumUtil::LessThan before(args.typeOffset);
+
+    const bsl::vector<bdld::Datum>& elements = *args.argsAndOutput;
+    const bdld::Datum* const        begin    = elements.data();
+    const Set* const                set      = Set::fromRange(
+        begin, begin + elements.size(), before, args.allocator);
+
+    const bdld::Datum result = Set::create(set, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::bTreeSet(const NativeProcedureUtil::Arguments& args) {
+    // Return a 'BTreeSet' of the arguments. Of the other set procedures,
+    // only "set-contains?", "set-insert", and "set-remove" accept a B-tree
+    // set. The rest accept only a 'Set', and report an error otherwise.
+    const BTreeSet*       set = 0;
     const Set::Comparator before =
         DatumUtil::lessThanComparator(args.typeOffset);
 
-    const bsl::vector<bdld::Datum> elements = *args.argsAndOutput;
+    const bsl::vector<bdld::Datum>& elements = *args.argsAndOutput;
     for (bsl::size_t i = 0; i < elements.size(); ++i) {
-        set = Set::insert(set, elements[i], before, args.allocator);
+        set = BTreeSet::insert(set, elements[i], before, args.allocator);
     }
 
-    const bdld::Datum result = Set::create(set, args.typeOffset);
+    const bdld::Datum result = BTreeSet::create(set, args.typeOffset);
     args.argsAndOutput->resize(1);
     args.argsAndOutput->front() = result;
 }
@@ -352,36 +205,76 @@ void BuiltinProcedures::setContains(
     const NativeProcedureUtil::Arguments& args) {
     enforceArity("set-contains?", 2, args);
 
-    const Set*            set   = Set::access((*args.argsAndOutput)[0]);
-    const bdld::Datum&    value = (*args.argsAndOutput)[1];
-    const Set::Comparator before =
-        DatumUtil::lessThanComparator(args.typeOffset);
+    const bdld::Datum&        setDatum = (*args.argsAndOutput)[0];
+    const bdld::Datum&        value    = (*args.argsAndOutput)[1];
+    const DatumUtil::LessThan before(args.typeOffset);
 
-    const bdld::Datum result =
-        bdld::Datum::createBoolean(Set::contains(set, value, before));
+    bool contains;
+    if (BTreeSet::isBTreeSet(setDatum, args.typeOffset)) {
+        contains =
+            BTreeSet::contains(BTreeSet::access(setDatum), value, before);
+    }
+    else if (Set::Transient::isTransient(setDatum, args.typeOffset)) {
+        contains = Set::contains(
+            Set::Transient::access(setDatum)->set(), value, before);
+    }
+    else if (Set::isSet(setDatum, args.typeOffset)) {
+        contains = Set::contains(Set::access(setDatum), value, before);
+    }
+    else {
+        throw bdld::Datum::createError(
+            -1,
+            "first argument to \"set-contains?\" must be a set",
+            args.allocator);
+    }
+    const bdld::Datum result = bdld::Datum::createBoolean(contains);
     args.argsAndOutput->resize(1);
     args.argsAndOutput->front() = result;
 }
 
 namespace {
 
-void setInsertOrRemove(
-    bsl::string_view name,
-    const Set* (*function)(
-        const Set*,
-        const bdld::Datum&,
-        const bsl::function<bool(const bdld::Datum&, const bdld::Datum&)>&,
-        bslma::Allocator*),
-    const NativeProcedureUtil::Arguments& args) {
+typedef const Set* SetFunction(const Set*,
+                               const bdld::Datum&,
+                               const DatumUtil::LessThan&,
+                               bslma::Allocator*);
+
+typedef const BTreeSet* BTreeSetFunction(const BTreeSet*,
+                                         const bdld::Datum&,
+                                         const BTreeSet::Comparator&,
+                                         bslma::Allocator*);
+
+// Apply the specified 'setFunction' or, if the set argument is a 'BTreeSet',
+// the specified 'bTreeSetFunction', to the arguments in the specified 'args'.
+void setInsertOrRemove(bsl::string_view                      name,
+                       SetFunction*                          setFunction,
+                       BTreeSetFunction*                     bTreeSetFunction,
+                       const NativeProcedureUtil::Arguments& args) {
     enforceArity(name, 2, args);
 
-    const Set*            set   = Set::access((*args.argsAndOutput)[0]);
-    const bdld::Datum&    value = (*args.argsAndOutput)[1];
-    const Set::Comparator before =
-        DatumUtil::lessThanComparator(args.typeOffset);
-
-    set                      = function(set, value, before, args.allocator);
-    const bdld::Datum result = Set::create(set, args.typeOffset);
+    const bdld::Datum&        setDatum = (*args.argsAndOutput)[0];
+    const bdld::Datum&        value    = (*args.argsAndOutput)[1];
+    const DatumUtil::LessThan before(args.typeOffset);
+
+    bdld::Datum result;
+    if (BTreeSet::isBTreeSet(setDatum, args.typeOffset)) {
+        result = BTreeSet::create(bTreeSetFunction(BTreeSet::access(setDatum),
+                                                   value,
+                                                   before,
+                                                   args.allocator),
+                                  args.typeOffset);
+    }
+    else if (Set::isSet(setDatum, args.typeOffset)) {
+        result = Set::create(
+            setFunction(Set::access(setDatum), value, before, args.allocator),
+            args.typeOffset);
+    }
+    else {
+        // A transient is modified by "set-insert!" and "set-remove!" instead.
+        bsl::ostringstream error;
+        error << "first argument to \"" << name << "\" must be a set";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
     args.argsAndOutput->resize(1);
     args.argsAndOutput->front() = result;
 }
@@ -389,11 +282,2205 @@ void setInsertOrRemove(
 }  // namespace
 
 void BuiltinProcedures::setInsert(const NativeProcedureUtil::Arguments& args) {
-    setInsertOrRemove("set-insert", &Set::insert, args);
+    setInsertOrRemove("set-insert", &Set::insert, &BTreeSet::insert, args);
 }
 
 void BuiltinProcedures::setRemove(const NativeProcedureUtil::Arguments& args) {
-    setInsertOrRemove("set-remove", &Set::remove, args);
+    setInsertOrRemove("set-remove", &Set::remove, &BTreeSet::remove, args);
+}
+
+namespace {
+
+// Return the set referred to by the specified 'datum', which is an argument
+// to the procedure having the specified 'name'. Throw an error if 'datum' is
+// not a 'Set'.
+const Set* accessSet(bsl::string_view                      name,
+                     const bdld::Datum&                    datum,
+                     const NativeProcedureUtil::Arguments& args) {
+    if (!Set::isSet(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "arguments to \"" << name << "\" must be sets";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return Set::access(datum);
+}
+
+// Return an integer 'bdld::Datum' having the specified 'count', which is an
+// 'int' unless 'count' is too large.
+bdld::Datum createCount(bsl::size_t                           count,
+                        const NativeProcedureUtil::Arguments& args) {
+    if (count <= bsl::size_t(bsl::numeric_limits<int>::max())) {
+        return bdld::Datum::createInteger(int(count));
+    }
+
+    return bdld::Datum::createInteger64(bsls::Types::Int64(count),
+                                        args.allocator);
+}
+
+typedef const Set* SetOperation(const Set*,
+                                const Set*,
+                                const DatumUtil::LessThan&,
+                                bslma::Allocator*,
+                                bdlmt::ThreadPool*);
+
+// Return to the specified 'args' the result of combining its arguments from
+// left to right using the specified 'operation', or the empty set if there
+// are no arguments. Throw an error if there are fewer than the specified
+// 'minArity' arguments.
+void foldSets(bsl::string_view                      name,
+              SetOperation*                         operation,
+              bsl::size_t                           minArity,
+              const NativeProcedureUtil::Arguments& args) {
+    const bsl::vector<bdld::Datum>& arguments = *args.argsAndOutput;
+    if (arguments.size() < minArity) {
+        bsl::ostringstream error;
+        error << "procedure \"" << name << "\" takes at least " << minArity
+              << " arguments, but was invoked with " << arguments.size();
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    const DatumUtil::LessThan before(args.typeOffset);
+    const Set*                result = 0;
+    if (!arguments.empty()) {
+        result = accessSet(name, arguments[0], args);
+    }
+    for (bsl::size_t i = 1; i < arguments.size(); ++i) {
+        result = operation(result,
+                           accessSet(name, arguments[i], args),
+                           before,
+                           args.allocator,
+                           args.interpreter->threadPool());
+    }
+
+    const bdld::Datum resultDatum = Set::create(result, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = resultDatum;
+}
+
+}  // namespace
+
+void BuiltinProcedures::setUnion(const NativeProcedureUtil::Arguments& args) {
+    foldSets("set-union", &Set::unite, 0, args);
+}
+
+void BuiltinProcedures::setIntersection(
+    const NativeProcedureUtil::Arguments& args) {
+    foldSets("set-intersection", &Set::intersect, 1, args);
+}
+
+void BuiltinProcedures::setDifference(
+    const NativeProcedureUtil::Arguments& args) {
+    // (set-difference a b c) is the elements of 'a' that are in neither 'b'
+    // nor 'c'.
+    foldSets("set-difference", &Set::subtract, 1, args);
+}
+
+void BuiltinProcedures::isSubset(const NativeProcedureUtil::Arguments& args) {
+    enforceArity("set-subset?", 2, args);
+
+    const Set* const subset =
+        accessSet("set-subset?", (*args.argsAndOutput)[0], args);
+    const Set* const superset =
+        accessSet("set-subset?", (*args.argsAndOutput)[1], args);
+    const DatumUtil::LessThan before(args.typeOffset);
+
+    const bdld::Datum result =
+        bdld::Datum::createBoolean(Set::isSubset(subset, superset, before));
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::setSize(const NativeProcedureUtil::Arguments& args) {
+    // 'set' may also be a transient set.
+    enforceArity("set-size", 1, args);
+
+    const bdld::Datum& setDatum = args.argsAndOutput->front();
+    const Set* const   set =
+        Set::Transient::isTransient(setDatum, args.typeOffset)
+            ? Set::Transient::access(setDatum)->set()
+            : accessSet("set-size", setDatum, args);
+
+    args.argsAndOutput->front() = createCount(Set::size(set), args);
+}
+
+void BuiltinProcedures::setNth(const NativeProcedureUtil::Arguments& args) {
+    // (set-nth set index) is the element of 'set' at the zero-based 'index'
+    // in order, e.g. (set-nth s (- (set-size s) 1)) is the greatest element.
+    enforceArity("set-nth", 2, args);
+
+    const Set* const set =
+        accessSet("set-nth", (*args.argsAndOutput)[0], args);
+    const bdld::Datum& indexDatum = (*args.argsAndOutput)[1];
+    if (!indexDatum.isInteger() && !indexDatum.isInteger64()) {
+        throw bdld::Datum::createError(
+            -1,
+            "second argument to \"set-nth\" must be some kind of integer",
+            args.allocator);
+    }
+
+    const bsls::Types::Int64 index = indexDatum.isInteger()
+                                         ? indexDatum.theInteger()
+                                         : indexDatum.theInteger64();
+    if (index < 0 || index >= bsls::Types::Int64(Set::size(set))) {
+        bsl::ostringstream error;
+        error << "set index out of range (" << index << ")";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    const bdld::Datum result = Set::nth(set, bsl::size_t(index));
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::setRank(const NativeProcedureUtil::Arguments& args) {
+    // (set-rank set value) is the number of elements of 'set' before 'value'.
+    enforceArity("set-rank", 2, args);
+
+    const Set* const set =
+        accessSet("set-rank", (*args.argsAndOutput)[0], args);
+    const bdld::Datum&        value = (*args.argsAndOutput)[1];
+    const DatumUtil::LessThan before(args.typeOffset);
+
+    const bdld::Datum result =
+        createCount(Set::rank(set, value, before), args);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::setCountRange(
+    const NativeProcedureUtil::Arguments& args) {
+    // (set-count-range set low high) is the number of elements of 'set' that
+    // are at least 'low' and before 'high'.
+    enforceArity("set-count-range", 3, args);
+
+    const Set* const set =
+        accessSet("set-count-range", (*args.argsAndOutput)[0], args);
+    const bdld::Datum&        low  = (*args.argsAndOutput)[1];
+    const bdld::Datum&        high = (*args.argsAndOutput)[2];
+    const DatumUtil::LessThan before(args.typeOffset);
+
+    const bdld::Datum result =
+        createCount(Set::countInRange(set, low, high, before), args);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::setRange(const NativeProcedureUtil::Arguments& args) {
+    // (set-range set low high) is a set of the elements of 'set' that are at
+    // least 'low' and before 'high'. It shares most of its nodes with 'set'.
+    enforceArity("set-range", 3, args);
+
+    const Set* const set =
+        accessSet("set-range", (*args.argsAndOutput)[0], args);
+    const bdld::Datum&        low  = (*args.argsAndOutput)[1];
+    const bdld::Datum&        high = (*args.argsAndOutput)[2];
+    const DatumUtil::LessThan before(args.typeOffset);
+
+    const bdld::Datum result = Set::create(
+        Set::range(set, low, high, before, args.allocator), args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+namespace {
+
+// Throw an error unless the specified 'datum', which is an argument to the
+// procedure having the specified 'name', is a procedure or a native
+// procedure.
+void enforceProcedure(bsl::string_view                      name,
+                      const bdld::Datum&                    datum,
+                      const NativeProcedureUtil::Arguments& args) {
+    if (!Procedure::isProcedure(datum, args.typeOffset) &&
+        !NativeProcedureUtil::isNativeProcedure(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "first argument to \"" << name << "\" must be a procedure";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+}
+
+// Return the result of invoking the specified 'procedure' with each element
+// visited by the specified 'cursor' and the result of the previous
+// invocation, beginning with the specified 'initial'. This works for both
+// 'Set::Cursor' and 'SetSequence::Cursor'.
+template <typename Cursor>
+bdld::Datum foldElements(Cursor                                cursor,
+                         const bdld::Datum&                    procedure,
+                         const bdld::Datum&                    initial,
+                         const NativeProcedureUtil::Arguments& args) {
+    bdld::Datum result = initial;
+    for (; !cursor.done(); cursor.advance()) {
+        const bdld::Datum arguments[] = { cursor.value(), result };
+        result = args.interpreter->invoke(
+            procedure, arguments, 2, *args.environment);
+    }
+    return result;
+}
+
+// Return the first element visited by the specified 'cursor' for which the
+// specified 'predicate' does not return false, or return false if there is
+// none. This works for both 'Set::Cursor' and 'SetSequence::Cursor'.
+template <typename Cursor>
+bdld::Datum findElement(Cursor                                cursor,
+                        const bdld::Datum&                    predicate,
+                        const NativeProcedureUtil::Arguments& args) {
+    const bdld::Datum no = bdld::Datum::createBoolean(false);
+    for (; !cursor.done(); cursor.advance()) {
+        if (args.interpreter->invoke(
+                predicate, &cursor.value(), 1, *args.environment) != no) {
+            return cursor.value();
+        }
+    }
+    return no;
+}
+
+// Return the set sequence referred to by the specified 'datum', which is an
+// argument to the procedure having the specified 'name'. Throw an error if
+// 'datum' is not a set sequence, or if it is empty and the specified
+// 'allowEmpty' is 'false'.
+const SetSequence* accessSetSequence(
+    bsl::string_view                      name,
+    const bdld::Datum&                    datum,
+    bool                                  allowEmpty,
+    const NativeProcedureUtil::Arguments& args) {
+    if (!SetSequence::isSetSequence(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "argument to \"" << name << "\" must be a set sequence";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    const SetSequence* const sequence = SetSequence::access(datum);
+    if (!sequence && !allowEmpty) {
+        bsl::ostringstream error;
+        error << "argument to \"" << name << "\" must not be empty";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return sequence;
+}
+
+}  // namespace
+
+void BuiltinProcedures::setFold(const NativeProcedureUtil::Arguments& args) {
+    // (set-fold procedure initial set) invokes (procedure element result)
+    // for each element of 'set' in order, where 'result' is 'initial' at
+    // first and then the result of the previous invocation, and returns the
+    // last result. 'set' may also be a set sequence. No list of the elements
+    // is built.
+    enforceArity("set-fold", 3, args);
+
+    const bdld::Datum& procedure = (*args.argsAndOutput)[0];
+    const bdld::Datum& initial   = (*args.argsAndOutput)[1];
+    const bdld::Datum& set       = (*args.argsAndOutput)[2];
+    enforceProcedure("set-fold", procedure, args);
+
+    bdld::Datum result;
+    if (SetSequence::isSetSequence(set, args.typeOffset)) {
+        result = foldElements(SetSequence::Cursor(SetSequence::access(set)),
+                              procedure,
+                              initial,
+                              args);
+    }
+    else {
+        result = foldElements(Set::Cursor(accessSet("set-fold", set, args)),
+                              procedure,
+                              initial,
+                              args);
+    }
+
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::setFind(const NativeProcedureUtil::Arguments& args) {
+    // (set-find predicate set) is the least element of 'set' for which
+    // 'predicate' does not return false, or is false if there is none. Later
+    // elements are not visited. 'set' may also be a set sequence.
+    enforceArity("set-find", 2, args);
+
+    const bdld::Datum& predicate = (*args.argsAndOutput)[0];
+    const bdld::Datum& set       = (*args.argsAndOutput)[1];
+    enforceProcedure("set-find", predicate, args);
+
+    bdld::Datum result;
+    if (SetSequence::isSetSequence(set, args.typeOffset)) {
+        result = findElement(
+            SetSequence::Cursor(SetSequence::access(set)), predicate, args);
+    }
+    else {
+        result = findElement(
+            Set::Cursor(accessSet("set-find", set, args)), predicate, args);
+    }
+
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::setSequence(
+    const NativeProcedureUtil::Arguments& args) {
+    // (set-seq set) is a lazy sequence of the elements of 'set' in order.
+    enforceArity("set-seq", 1, args);
+
+    const Set* const set =
+        accessSet("set-seq", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = SetSequence::create(
+        SetSequence::fromSet(set, args.allocator), args.typeOffset);
+}
+
+void BuiltinProcedures::isSetSequenceEmpty(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("set-seq-empty?", 1, args);
+
+    const SetSequence* const sequence = accessSetSequence(
+        "set-seq-empty?", args.argsAndOutput->front(), true, args);
+
+    args.argsAndOutput->front() = bdld::Datum::createBoolean(!sequence);
+}
+
+void BuiltinProcedures::setSequenceFirst(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("set-seq-first", 1, args);
+
+    const SetSequence* const sequence = accessSetSequence(
+        "set-seq-first", args.argsAndOutput->front(), false, args);
+
+    args.argsAndOutput->front() = sequence->first();
+}
+
+void BuiltinProcedures::setSequenceRest(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("set-seq-rest", 1, args);
+
+    const SetSequence* const sequence = accessSetSequence(
+        "set-seq-rest", args.argsAndOutput->front(), false, args);
+
+    args.argsAndOutput->front() = SetSequence::create(
+        SetSequence::rest(sequence, args.allocator), args.typeOffset);
+}
+
+namespace {
+
+// Return the transient set referred to by the specified 'datum', which is the
+// first argument to the procedure having the specified 'name'. Throw an error
+// if 'datum' is not a transient set, or if it has been persisted and the
+// specified 'allowPersisted' is 'false'.
+Set::Transient* accessTransient(
+    bsl::string_view                      name,
+    const bdld::Datum&                    datum,
+    bool                                  allowPersisted,
+    const NativeProcedureUtil::Arguments& args) {
+    if (!Set::Transient::isTransient(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "first argument to \"" << name
+              << "\" must be a transient set";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    Set::Transient* const transient = Set::Transient::access(datum);
+    if (transient->isPersisted() && !allowPersisted) {
+        bsl::ostringstream error;
+        error << "transient set passed to \"" << name
+              << "\" has already been persisted";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return transient;
+}
+
+}  // namespace
+
+void BuiltinProcedures::setTransient(
+    const NativeProcedureUtil::Arguments& args) {
+    // (set-transient) is an empty transient set, and (set-transient set) is
+    // a transient set having the elements of 'set', which is not modified.
+    // (set-insert! transient value) and (set-remove! transient value) modify
+    // the transient in place and return it, and (persist! transient) returns
+    // its elements as a set. Building a set this way allocates one node per
+    // element, rather than one per element per level of the tree.
+    const bsl::size_t arity = args.argsAndOutput->size();
+    if (arity > 1) {
+        throw bdld::Datum::createError(
+            -1,
+            "procedure \"set-transient\" takes zero or one arguments",
+            args.allocator);
+    }
+
+    const Set* const set =
+        arity ? accessSet("set-transient", args.argsAndOutput->front(), args)
+              : 0;
+
+    Set::Transient* const transient =
+        new (*args.allocator) Set::Transient(set, args.allocator);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() =
+        Set::Transient::create(transient, args.typeOffset);
+}
+
+void BuiltinProcedures::setInsertInPlace(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("set-insert!", 2, args);
+
+    const bdld::Datum&    transientDatum = (*args.argsAndOutput)[0];
+    Set::Transient* const transient =
+        accessTransient("set-insert!", transientDatum, false, args);
+    transient->insert((*args.argsAndOutput)[1],
+                      DatumUtil::LessThan(args.typeOffset));
+
+    args.argsAndOutput->resize(1);
+}
+
+void BuiltinProcedures::setRemoveInPlace(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("set-remove!", 2, args);
+
+    const bdld::Datum&    transientDatum = (*args.argsAndOutput)[0];
+    Set::Transient* const transient =
+        accessTransient("set-remove!", transientDatum, false, args);
+    transient->remove((*args.argsAndOutput)[1],
+                      DatumUtil::LessThan(args.typeOffset));
+
+    args.argsAndOutput->resize(1);
+}
+
+void BuiltinProcedures::persist(const NativeProcedureUtil::Arguments& args) {
+    // Persisting a transient set more than once returns the same set each
+    // time.
+    enforceArity("persist!", 1, args);
+
+    Set::Transient* const transient =
+        accessTransient("persist!", args.argsAndOutput->front(), true, args);
+
+    args.argsAndOutput->front() =
+        Set::create(transient->persist(), args.typeOffset);
+}
+
+namespace {
+
+// Return the hash map referred to by the specified 'datum', which is the
+// specified 'position'th argument to the procedure having the specified
+// 'name'. Throw an error if 'datum' is not a hash map, or a hash set if the
+// specified 'isSet' is 'true'.
+const HashMap* accessHashMap(bsl::string_view                      name,
+                             const bdld::Datum&                    datum,
+                             bool                                  isSet,
+                             const NativeProcedureUtil::Arguments& args) {
+    if (isSet ? !HashMap::isHashSet(datum, args.typeOffset)
+              : !HashMap::isHashMap(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "first argument to \"" << name << "\" must be a "
+              << (isSet ? "hash set" : "hash map");
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return HashMap::access(datum);
+}
+
+}  // namespace
+
+void BuiltinProcedures::hashMap(const NativeProcedureUtil::Arguments& args) {
+    // Return a 'HashMap' of the arguments, which alternate between keys and
+    // values, e.g. (hash-map "one" 1 "two" 2). Later values replace earlier
+    // values having the same key.
+    const bsl::vector<bdld::Datum>& elements = *args.argsAndOutput;
+    if (elements.size() % 2) {
+        throw bdld::Datum::createError(
+            -1,
+            "procedure \"hash-map\" takes an even number of arguments",
+            args.allocator);
+    }
+
+    const HashMap* map = 0;
+    for (bsl::size_t i = 0; i < elements.size(); i += 2) {
+        map = HashMap::insert(map,
+                              elements[i],
+                              elements[i + 1],
+                              args.typeOffset,
+                              args.allocator);
+    }
+
+    const bdld::Datum result = HashMap::createMap(map, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::hashMapContains(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("hash-map-contains?", 2, args);
+
+    const HashMap* map = accessHashMap(
+        "hash-map-contains?", (*args.argsAndOutput)[0], false, args);
+    const bdld::Datum& key = (*args.argsAndOutput)[1];
+
+    const bdld::Datum result = bdld::Datum::createBoolean(
+        HashMap::contains(map, key, args.typeOffset));
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::hashMapGet(
+    const NativeProcedureUtil::Arguments& args) {
+    // (hash-map-get map key) returns the value associated with 'key', or
+    // raises an error if there is none. (hash-map-get map key default)
+    // returns 'default' instead of raising an error.
+    const bsl::size_t size = args.argsAndOutput->size();
+    if (size != 2 && size != 3) {
+        bsl::ostringstream error;
+        error << "procedure \"hash-map-get\" takes 2 or 3 arguments, but was "
+                 "invoked with "
+              << size;
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    const HashMap* map =
+        accessHashMap("hash-map-get", (*args.argsAndOutput)[0], false, args);
+    const bdld::Datum& key = (*args.argsAndOutput)[1];
+
+    const bdld::Datum* const value = HashMap::find(map, key, args.typeOffset);
+    if (!value && size == 2) {
+        throw bdld::Datum::createError(
+            -1, "key not found in \"hash-map-get\"", args.allocator);
+    }
+
+    const bdld::Datum result = value ? *value : (*args.argsAndOutput)[2];
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::hashMapInsert(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("hash-map-insert", 3, args);
+
+    const HashMap* map = accessHashMap(
+        "hash-map-insert", (*args.argsAndOutput)[0], false, args);
+    const bdld::Datum& key   = (*args.argsAndOutput)[1];
+    const bdld::Datum& value = (*args.argsAndOutput)[2];
+
+    map = HashMap::insert(map, key, value, args.typeOffset, args.allocator);
+    const bdld::Datum result = HashMap::createMap(map, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::hashMapRemove(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("hash-map-remove", 2, args);
+
+    const HashMap* map = accessHashMap(
+        "hash-map-remove", (*args.argsAndOutput)[0], false, args);
+    const bdld::Datum& key = (*args.argsAndOutput)[1];
+
+    map = HashMap::remove(map, key, args.typeOffset, args.allocator);
+    const bdld::Datum result = HashMap::createMap(map, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::hashSet(const NativeProcedureUtil::Arguments& args) {
+    // Return a 'HashMap' whose keys are the arguments, as a hash set.
+    const bsl::vector<bdld::Datum>& elements = *args.argsAndOutput;
+    const HashMap*                  set      = 0;
+    for (bsl::size_t i = 0; i < elements.size(); ++i) {
+        if (!HashMap::contains(set, elements[i], args.typeOffset)) {
+            set = HashMap::insert(set,
+                                  elements[i],
+                                  bdld::Datum::createNull(),
+                                  args.typeOffset,
+                                  args.allocator);
+        }
+    }
+
+    const bdld::Datum result = HashMap::createSet(set, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::hashSetContains(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("hash-set-contains?", 2, args);
+
+    const HashMap* set = accessHashMap(
+        "hash-set-contains?", (*args.argsAndOutput)[0], true, args);
+    const bdld::Datum& value = (*args.argsAndOutput)[1];
+
+    const bdld::Datum result = bdld::Datum::createBoolean(
+        HashMap::contains(set, value, args.typeOffset));
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::hashSetInsert(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("hash-set-insert", 2, args);
+
+    const HashMap* set = accessHashMap(
+        "hash-set-insert", (*args.argsAndOutput)[0], true, args);
+    const bdld::Datum& value = (*args.argsAndOutput)[1];
+
+    // Inserting an element that's already present would copy a path through
+    // the trie for nothing, so check first, as 'Set::insert' does.
+    if (!HashMap::contains(set, value, args.typeOffset)) {
+        set = HashMap::insert(set,
+                              value,
+                              bdld::Datum::createNull(),
+                              args.typeOffset,
+                              args.allocator);
+    }
+
+    const bdld::Datum result = HashMap::createSet(set, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::hashSetRemove(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("hash-set-remove", 2, args);
+
+    const HashMap* set = accessHashMap(
+        "hash-set-remove", (*args.argsAndOutput)[0], true, args);
+    const bdld::Datum& value = (*args.argsAndOutput)[1];
+
+    set = HashMap::remove(set, value, args.typeOffset, args.allocator);
+    const bdld::Datum result = HashMap::createSet(set, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+namespace {
+
+// Return the int set, or the int map if the specified 'isMap' is 'true',
+// referred to by the specified 'datum', which is an argument to the
+// procedure having the specified 'name'. Throw an error if 'datum' is not of
+// that type.
+const IntTrie* accessIntTrie(bsl::string_view                      name,
+                             const bdld::Datum&                    datum,
+                             bool                                  isMap,
+                             const NativeProcedureUtil::Arguments& args) {
+    if (isMap ? !IntTrie::isIntMap(datum, args.typeOffset)
+              : !IntTrie::isIntSet(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "procedure \"" << name << "\" expects "
+              << (isMap ? "an int map" : "an int set");
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return IntTrie::access(datum);
+}
+
+// Return the integer value of the specified 'datum', which is an argument to
+// the procedure having the specified 'name'. Throw an error if 'datum' is
+// not an 'int' or an 'Int64'.
+bsls::Types::Int64 accessKey(bsl::string_view                      name,
+                             const bdld::Datum&                    datum,
+                             const NativeProcedureUtil::Arguments& args) {
+    bsls::Types::Int64 key;
+    if (IntTrie::toKey(&key, datum)) {
+        bsl::ostringstream error;
+        error << "procedure \"" << name << "\" requires integer keys";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return key;
+}
+
+void returnIntTrie(const IntTrie*                        trie,
+                   bool                                  isMap,
+                   const NativeProcedureUtil::Arguments& args) {
+    const bdld::Datum result = isMap
+                                   ? IntTrie::createMap(trie, args.typeOffset)
+                                   : IntTrie::createSet(trie, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+typedef const IntTrie* IntTrieOperation(const IntTrie*,
+                                        const IntTrie*,
+                                        bslma::Allocator*);
+
+// Return to the specified 'args' the result of combining its arguments, which
+// are int sets, or int maps if the specified 'isMap' is 'true', from left to
+// right using the specified 'operation', or an empty set or map if there are
+// no arguments. Throw an error if there are fewer than the specified
+// 'minArity' arguments.
+void foldIntTries(bsl::string_view                      name,
+                  IntTrieOperation*                     operation,
+                  bool                                  isMap,
+                  bsl::size_t                           minArity,
+                  const NativeProcedureUtil::Arguments& args) {
+    const bsl::vector<bdld::Datum>& arguments = *args.argsAndOutput;
+    if (arguments.size() < minArity) {
+        bsl::ostringstream error;
+        error << "procedure \"" << name << "\" takes at least " << minArity
+              << " arguments, but was invoked with " << arguments.size();
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    const IntTrie* result = 0;
+    if (!arguments.empty()) {
+        result = accessIntTrie(name, arguments[0], isMap, args);
+    }
+    for (bsl::size_t i = 1; i < arguments.size(); ++i) {
+        result = operation(result,
+                           accessIntTrie(name, arguments[i], isMap, args),
+                           args.allocator);
+    }
+
+    returnIntTrie(result, isMap, args);
+}
+
+// Return the union of the specified 'left' and 'right' int maps, where the
+// values of 'right' replace those of 'left'.
+const IntTrie* mergeIntMaps(const IntTrie*    left,
+                            const IntTrie*    right,
+                            bslma::Allocator* allocator) {
+    return IntTrie::unite(right, left, allocator);
+}
+
+// Return to the specified 'args' the elements (or entries) of its first
+// argument whose keys are at least its second argument and less than its
+// third argument.
+void intTrieRange(bsl::string_view                      name,
+                  bool                                  isMap,
+                  const NativeProcedureUtil::Arguments& args) {
+    enforceArity(name, 3, args);
+
+    const bsl::vector<bdld::Datum>& arguments = *args.argsAndOutput;
+    const IntTrie* trie = accessIntTrie(name, arguments[0], isMap, args);
+    const bsls::Types::Int64 low  = accessKey(name, arguments[1], args);
+    const bsls::Types::Int64 high = accessKey(name, arguments[2], args);
+
+    returnIntTrie(
+        IntTrie::range(trie, low, high, args.allocator), isMap, args);
+}
+
+}  // namespace
+
+void BuiltinProcedures::intSet(const NativeProcedureUtil::Arguments& args) {
+    // Return an int set of the arguments, which must be integers.
+    const bsl::vector<bdld::Datum>& elements = *args.argsAndOutput;
+    const IntTrie*                  set      = 0;
+    for (bsl::size_t i = 0; i < elements.size(); ++i) {
+        set = IntTrie::insert(
+            set, accessKey("int-set", elements[i], args), args.allocator);
+    }
+
+    returnIntTrie(set, false, args);
+}
+
+void BuiltinProcedures::intSetContains(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("int-set-contains?", 2, args);
+
+    const IntTrie* set = accessIntTrie(
+        "int-set-contains?", (*args.argsAndOutput)[0], false, args);
+    const bsls::Types::Int64 key =
+        accessKey("int-set-contains?", (*args.argsAndOutput)[1], args);
+
+    const bdld::Datum result =
+        bdld::Datum::createBoolean(IntTrie::contains(set, key));
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::intSetInsert(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("int-set-insert", 2, args);
+
+    const IntTrie* set = accessIntTrie(
+        "int-set-insert", (*args.argsAndOutput)[0], false, args);
+    const bsls::Types::Int64 key =
+        accessKey("int-set-insert", (*args.argsAndOutput)[1], args);
+
+    returnIntTrie(IntTrie::insert(set, key, args.allocator), false, args);
+}
+
+void BuiltinProcedures::intSetRemove(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("int-set-remove", 2, args);
+
+    const IntTrie* set = accessIntTrie(
+        "int-set-remove", (*args.argsAndOutput)[0], false, args);
+    const bsls::Types::Int64 key =
+        accessKey("int-set-remove", (*args.argsAndOutput)[1], args);
+
+    returnIntTrie(IntTrie::remove(set, key, args.allocator), false, args);
+}
+
+void BuiltinProcedures::intSetUnion(
+    const NativeProcedureUtil::Arguments& args) {
+    foldIntTries("int-set-union", &IntTrie::unite, false, 0, args);
+}
+
+void BuiltinProcedures::intSetIntersection(
+    const NativeProcedureUtil::Arguments& args) {
+    foldIntTries("int-set-intersection", &IntTrie::intersect, false, 1, args);
+}
+
+void BuiltinProcedures::intSetDifference(
+    const NativeProcedureUtil::Arguments& args) {
+    foldIntTries("int-set-difference", &IntTrie::subtract, false, 1, args);
+}
+
+void BuiltinProcedures::intSetRange(
+    const NativeProcedureUtil::Arguments& args) {
+    // (int-set-range set low high) is the elements of 'set' that are at
+    // least 'low' and less than 'high'.
+    intTrieRange("int-set-range", false, args);
+}
+
+void BuiltinProcedures::intMap(const NativeProcedureUtil::Arguments& args) {
+    // Return an int map of the arguments, which alternate between integer
+    // keys and values, e.g. (int-map 1 "one" 2 "two"). Later values replace
+    // earlier values having the same key.
+    const bsl::vector<bdld::Datum>& elements = *args.argsAndOutput;
+    if (elements.size() % 2) {
+        throw bdld::Datum::createError(
+            -1,
+            "procedure \"int-map\" takes an even number of arguments",
+            args.allocator);
+    }
+
+    const IntTrie* map = 0;
+    for (bsl::size_t i = 0; i < elements.size(); i += 2) {
+        map = IntTrie::insert(map,
+                              accessKey("int-map", elements[i], args),
+                              elements[i + 1],
+                              args.allocator);
+    }
+
+    returnIntTrie(map, true, args);
+}
+
+void BuiltinProcedures::intMapContains(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("int-map-contains?", 2, args);
+
+    const IntTrie* map = accessIntTrie(
+        "int-map-contains?", (*args.argsAndOutput)[0], true, args);
+    const bsls::Types::Int64 key =
+        accessKey("int-map-contains?", (*args.argsAndOutput)[1], args);
+
+    const bdld::Datum result =
+        bdld::Datum::createBoolean(IntTrie::find(map, key) != 0);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::intMapGet(const NativeProcedureUtil::Arguments& args) {
+    // (int-map-get map key) returns the value associated with 'key', or
+    // raises an error if there is none. (int-map-get map key default)
+    // returns 'default' instead of raising an error.
+    const bsl::size_t size = args.argsAndOutput->size();
+    if (size != 2 && size != 3) {
+        bsl::ostringstream error;
+        error << "procedure \"int-map-get\" takes 2 or 3 arguments, but was "
+                 "invoked with "
+              << size;
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    const IntTrie* map =
+        accessIntTrie("int-map-get", (*args.argsAndOutput)[0], true, args);
+    const bsls::Types::Int64 key =
+        accessKey("int-map-get", (*args.argsAndOutput)[1], args);
+
+    const bdld::Datum* const value = IntTrie::find(map, key);
+    if (!value && size == 2) {
+        throw bdld::Datum::createError(
+            -1, "key not found in \"int-map-get\"", args.allocator);
+    }
+
+    const bdld::Datum result = value ? *value : (*args.argsAndOutput)[2];
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::intMapInsert(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("int-map-insert", 3, args);
+
+    const IntTrie* map = accessIntTrie(
+        "int-map-insert", (*args.argsAndOutput)[0], true, args);
+    const bsls::Types::Int64 key =
+        accessKey("int-map-insert", (*args.argsAndOutput)[1], args);
+    const bdld::Datum& value = (*args.argsAndOutput)[2];
+
+    returnIntTrie(
+        IntTrie::insert(map, key, value, args.allocator), true, args);
+}
+
+void BuiltinProcedures::intMapRemove(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("int-map-remove", 2, args);
+
+    const IntTrie* map = accessIntTrie(
+        "int-map-remove", (*args.argsAndOutput)[0], true, args);
+    const bsls::Types::Int64 key =
+        accessKey("int-map-remove", (*args.argsAndOutput)[1], args);
+
+    returnIntTrie(IntTrie::removeKey(map, key, args.allocator), true, args);
+}
+
+void BuiltinProcedures::intMapMerge(
+    const NativeProcedureUtil::Arguments& args) {
+    // (int-map-merge a b c) has the entries of all of 'a', 'b', and 'c',
+    // where later maps take precedence, as with repeated keys in 'int-map'.
+    foldIntTries("int-map-merge", &mergeIntMaps, true, 0, args);
+}
+
+void BuiltinProcedures::intMapRange(
+    const NativeProcedureUtil::Arguments& args) {
+    intTrieRange("int-map-range", true, args);
+}
+
+namespace {
+
+// Return the RRB vector referred to by the specified 'datum', which is the
+// first argument to the procedure having the specified 'name'. Throw an error
+// if 'datum' is not an RRB vector.
+const RrbVector* accessRrbVector(bsl::string_view                      name,
+                                 const bdld::Datum&                    datum,
+                                 const NativeProcedureUtil::Arguments& args) {
+    if (!RrbVector::isRrbVector(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "first argument to \"" << name << "\" must be an RRB vector";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return RrbVector::access(datum);
+}
+
+// Return the value of the specified 'datum', which is an index argument to
+// the procedure having the specified 'name'. Throw an error if 'datum' is not
+// an integer, or if it is negative or not less than the specified 'limit'.
+bsl::size_t accessIndex(bsl::string_view                      name,
+                        const bdld::Datum&                    datum,
+                        bsl::size_t                           limit,
+                        const NativeProcedureUtil::Arguments& args) {
+    if (!datum.isInteger() && !datum.isInteger64()) {
+        bsl::ostringstream error;
+        error << "index argument to \"" << name
+              << "\" must be some kind of integer";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    const bsls::Types::Int64 index =
+        datum.isInteger() ? datum.theInteger() : datum.theInteger64();
+    if (index < 0 || index >= bsls::Types::Int64(limit)) {
+        bsl::ostringstream error;
+        error << "vector index out of range (" << index << ")";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return bsl::size_t(index);
+}
+
+void returnRrbVector(const RrbVector*                      vector,
+                     const NativeProcedureUtil::Arguments& args) {
+    const bdld::Datum result = RrbVector::create(vector, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+}  // namespace
+
+void BuiltinProcedures::rrbVector(const NativeProcedureUtil::Arguments& args) {
+    // Return an 'RrbVector' of the arguments. An RRB vector, like an array,
+    // can be invoked with an index, e.g. ((rrb-vector 9 8 7) 1) is 8.
+    const bsl::vector<bdld::Datum>& elements = *args.argsAndOutput;
+    const bdld::Datum* const        begin    = elements.data();
+
+    returnRrbVector(
+        RrbVector::fromRange(begin, begin + elements.size(), args.allocator),
+        args);
+}
+
+void BuiltinProcedures::arrayToRrbVector(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("array->rrb", 1, args);
+
+    const bdld::Datum& array = args.argsAndOutput->front();
+    if (!array.isArray()) {
+        throw bdld::Datum::createError(
+            -1, "argument to \"array->rrb\" must be an array", args.allocator);
+    }
+
+    const bdld::DatumArrayRef elements = array.theArray();
+    returnRrbVector(RrbVector::fromRange(elements.data(),
+                                         elements.data() + elements.length(),
+                                         args.allocator),
+                    args);
+}
+
+void BuiltinProcedures::rrbVectorToArray(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("rrb->array", 1, args);
+
+    const RrbVector* const vector =
+        accessRrbVector("rrb->array", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = RrbVector::toArray(vector, args.allocator);
+}
+
+void BuiltinProcedures::rrbVectorSize(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("rrb-size", 1, args);
+
+    const RrbVector* const vector =
+        accessRrbVector("rrb-size", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = createCount(RrbVector::size(vector), args);
+}
+
+void BuiltinProcedures::rrbVectorNth(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("rrb-nth", 2, args);
+
+    const RrbVector* const vector =
+        accessRrbVector("rrb-nth", (*args.argsAndOutput)[0], args);
+    const bsl::size_t index = accessIndex(
+        "rrb-nth", (*args.argsAndOutput)[1], RrbVector::size(vector), args);
+
+    const bdld::Datum result = RrbVector::nth(vector, index);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::rrbVectorAssoc(
+    const NativeProcedureUtil::Arguments& args) {
+    // (rrb-assoc vector index value) is 'vector' with 'value' at 'index'.
+    enforceArity("rrb-assoc", 3, args);
+
+    const RrbVector* const vector =
+        accessRrbVector("rrb-assoc", (*args.argsAndOutput)[0], args);
+    const bsl::size_t index = accessIndex(
+        "rrb-assoc", (*args.argsAndOutput)[1], RrbVector::size(vector), args);
+
+    returnRrbVector(RrbVector::assoc(vector,
+                                     index,
+                                     (*args.argsAndOutput)[2],
+                                     args.allocator),
+                    args);
+}
+
+void BuiltinProcedures::rrbVectorPush(
+    const NativeProcedureUtil::Arguments& args) {
+    // (rrb-push vector value) is 'vector' with 'value' appended.
+    enforceArity("rrb-push", 2, args);
+
+    const RrbVector* const vector =
+        accessRrbVector("rrb-push", (*args.argsAndOutput)[0], args);
+
+    returnRrbVector(
+        RrbVector::push(vector, (*args.argsAndOutput)[1], args.allocator),
+        args);
+}
+
+void BuiltinProcedures::rrbVectorConcat(
+    const NativeProcedureUtil::Arguments& args) {
+    // (rrb-concat a b c) has the elements of 'a', then 'b', then 'c'.
+    const bsl::vector<bdld::Datum>& vectors = *args.argsAndOutput;
+    const RrbVector*                result  = 0;
+    for (bsl::size_t i = 0; i < vectors.size(); ++i) {
+        if (!RrbVector::isRrbVector(vectors[i], args.typeOffset)) {
+            throw bdld::Datum::createError(
+                -1,
+                "arguments to \"rrb-concat\" must be RRB vectors",
+                args.allocator);
+        }
+        result = RrbVector::concatenate(
+            result, RrbVector::access(vectors[i]), args.allocator);
+    }
+
+    returnRrbVector(result, args);
+}
+
+void BuiltinProcedures::rrbVectorSlice(
+    const NativeProcedureUtil::Arguments& args) {
+    // (rrb-slice vector begin end) has the elements of 'vector' from index
+    // 'begin' up to but not including index 'end'.
+    enforceArity("rrb-slice", 3, args);
+
+    const RrbVector* const vector =
+        accessRrbVector("rrb-slice", (*args.argsAndOutput)[0], args);
+    const bsl::size_t size  = RrbVector::size(vector);
+    const bsl::size_t end   =
+        accessIndex("rrb-slice", (*args.argsAndOutput)[2], size + 1, args);
+    const bsl::size_t begin =
+        accessIndex("rrb-slice", (*args.argsAndOutput)[1], end + 1, args);
+
+    returnRrbVector(RrbVector::slice(vector, begin, end, args.allocator),
+                    args);
+}
+
+namespace {
+
+// Return the deque referred to by the specified 'datum', which is the first
+// argument to the procedure having the specified 'name'. Throw an error if
+// 'datum' is not a deque.
+const Deque* accessDeque(bsl::string_view                      name,
+                         const bdld::Datum&                    datum,
+                         const NativeProcedureUtil::Arguments& args) {
+    if (!Deque::isDeque(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "first argument to \"" << name << "\" must be a deque";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return Deque::access(datum);
+}
+
+// Return the deque that is the only argument to the procedure having the
+// specified 'name'. Throw an error if there is not exactly one argument, if
+// it is not a deque, or if it is empty.
+const Deque* accessNonemptyDeque(bsl::string_view                      name,
+                                 const NativeProcedureUtil::Arguments& args) {
+    enforceArity(name, 1, args);
+
+    const Deque* const deque =
+        accessDeque(name, args.argsAndOutput->front(), args);
+    if (!deque) {
+        bsl::ostringstream error;
+        error << "argument to \"" << name << "\" must not be empty";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return deque;
+}
+
+void returnDeque(const Deque*                          deque,
+                 const NativeProcedureUtil::Arguments& args) {
+    const bdld::Datum result = Deque::create(deque, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+}  // namespace
+
+void BuiltinProcedures::deque(const NativeProcedureUtil::Arguments& args) {
+    // Return a 'Deque' of the arguments.
+    const bsl::vector<bdld::Datum>& elements = *args.argsAndOutput;
+    const bdld::Datum* const        begin    = elements.data();
+
+    returnDeque(
+        Deque::fromRange(begin, begin + elements.size(), args.allocator),
+        args);
+}
+
+void BuiltinProcedures::dequeSize(const NativeProcedureUtil::Arguments& args) {
+    enforceArity("deque-size", 1, args);
+
+    const Deque* const deque =
+        accessDeque("deque-size", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = createCount(Deque::size(deque), args);
+}
+
+void BuiltinProcedures::dequeIsEmpty(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("deque-empty?", 1, args);
+
+    const Deque* const deque =
+        accessDeque("deque-empty?", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = bdld::Datum::createBoolean(deque == 0);
+}
+
+void BuiltinProcedures::dequeFront(
+    const NativeProcedureUtil::Arguments& args) {
+    const Deque* const deque = accessNonemptyDeque("deque-front", args);
+
+    args.argsAndOutput->front() = Deque::front(deque);
+}
+
+void BuiltinProcedures::dequeBack(const NativeProcedureUtil::Arguments& args) {
+    const Deque* const deque = accessNonemptyDeque("deque-back", args);
+
+    args.argsAndOutput->front() = Deque::back(deque);
+}
+
+void BuiltinProcedures::dequeNth(const NativeProcedureUtil::Arguments& args) {
+    enforceArity("deque-nth", 2, args);
+
+    const Deque* const deque =
+        accessDeque("deque-nth", (*args.argsAndOutput)[0], args);
+    const bsl::size_t index = accessIndex(
+        "deque-nth", (*args.argsAndOutput)[1], Deque::size(deque), args);
+
+    const bdld::Datum result = Deque::nth(deque, index);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::dequePushFront(
+    const NativeProcedureUtil::Arguments& args) {
+    // (deque-push-front deque value) is 'deque' with 'value' prepended.
+    enforceArity("deque-push-front", 2, args);
+
+    const Deque* const deque =
+        accessDeque("deque-push-front", (*args.argsAndOutput)[0], args);
+
+    returnDeque(
+        Deque::pushFront(deque, (*args.argsAndOutput)[1], args.allocator),
+        args);
+}
+
+void BuiltinProcedures::dequePushBack(
+    const NativeProcedureUtil::Arguments& args) {
+    // (deque-push-back deque value) is 'deque' with 'value' appended.
+    enforceArity("deque-push-back", 2, args);
+
+    const Deque* const deque =
+        accessDeque("deque-push-back", (*args.argsAndOutput)[0], args);
+
+    returnDeque(
+        Deque::pushBack(deque, (*args.argsAndOutput)[1], args.allocator),
+        args);
+}
+
+void BuiltinProcedures::dequePopFront(
+    const NativeProcedureUtil::Arguments& args) {
+    const Deque* const deque = accessNonemptyDeque("deque-pop-front", args);
+
+    returnDeque(Deque::popFront(deque, args.allocator), args);
+}
+
+void BuiltinProcedures::dequePopBack(
+    const NativeProcedureUtil::Arguments& args) {
+    const Deque* const deque = accessNonemptyDeque("deque-pop-back", args);
+
+    returnDeque(Deque::popBack(deque, args.allocator), args);
+}
+
+void BuiltinProcedures::dequeConcat(
+    const NativeProcedureUtil::Arguments& args) {
+    // (deque-concat a b c) has the elements of 'a', then 'b', then 'c'.
+    const bsl::vector<bdld::Datum>& deques = *args.argsAndOutput;
+    const Deque*                    result = 0;
+    for (bsl::size_t i = 0; i < deques.size(); ++i) {
+        if (!Deque::isDeque(deques[i], args.typeOffset)) {
+            throw bdld::Datum::createError(
+                -1,
+                "arguments to \"deque-concat\" must be deques",
+                args.allocator);
+        }
+        result = Deque::concatenate(
+            result, Deque::access(deques[i]), args.allocator);
+    }
+
+    returnDeque(result, args);
+}
+
+void BuiltinProcedures::dequeSplit(
+    const NativeProcedureUtil::Arguments& args) {
+    // (deque-split deque index) is a pair whose car has the elements of
+    // 'deque' before 'index', and whose cdr has the rest.
+    enforceArity("deque-split", 2, args);
+
+    const Deque* const deque =
+        accessDeque("deque-split", (*args.argsAndOutput)[0], args);
+    const bsl::size_t index = accessIndex(
+        "deque-split", (*args.argsAndOutput)[1], Deque::size(deque) + 1, args);
+
+    const bsl::pair<const Deque*, const Deque*> halves =
+        Deque::split(deque, index, args.allocator);
+    const bdld::Datum result =
+        Pair::create(Deque::create(halves.first, args.typeOffset),
+                     Deque::create(halves.second, args.typeOffset),
+                     args.typeOffset,
+                     args.allocator);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+namespace {
+
+// Return the packed vector referred to by the specified 'datum', which is the
+// first argument to the procedure having the specified 'name'. Throw an error
+// if 'datum' is not a packed vector.
+const PackedVector& accessPackedVector(
+    bsl::string_view                      name,
+    const bdld::Datum&                    datum,
+    const NativeProcedureUtil::Arguments& args) {
+    if (!PackedVector::isPackedVector(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "first argument to \"" << name
+              << "\" must be a packed vector";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return PackedVector::access(datum);
+}
+
+// Load into the specified 'left' and 'right' the two arguments to the
+// procedure having the specified 'name'. Either argument may be a number
+// instead of a packed vector, in which case it is converted to a vector of
+// length one having the element type of the other argument. Throw an error
+// if there are not two arguments, if neither is a packed vector, if the
+// element types differ, or if the lengths differ and neither is one.
+void accessOperands(const PackedVector**                  left,
+                    const PackedVector**                  right,
+                    bsl::string_view                      name,
+                    const NativeProcedureUtil::Arguments& args) {
+    enforceArity(name, 2, args);
+
+    const bdld::Datum* const operands = args.argsAndOutput->data();
+    const bool isLeftPacked =
+        PackedVector::isPackedVector(operands[0], args.typeOffset);
+    const bool isRightPacked =
+        PackedVector::isPackedVector(operands[1], args.typeOffset);
+    if (!isLeftPacked && !isRightPacked) {
+        bsl::ostringstream error;
+        error << "at least one argument to \"" << name
+              << "\" must be a packed vector";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    int rc = 0;
+    if (isLeftPacked) {
+        *left = &PackedVector::access(operands[0]);
+    }
+    else {
+        rc = PackedVector::fromRange(left,
+                                     PackedVector::access(operands[1]).type(),
+                                     operands,
+                                     operands + 1,
+                                     args.allocator);
+    }
+
+    if (isRightPacked) {
+        *right = &PackedVector::access(operands[1]);
+    }
+    else {
+        rc = PackedVector::fromRange(right,
+                                     (*left)->type(),
+                                     operands + 1,
+                                     operands + 2,
+                                     args.allocator);
+    }
+
+    if (rc) {
+        bsl::ostringstream error;
+        error << "number argument to \"" << name
+              << "\" cannot be represented as the element type of the packed"
+                 " vector";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    if ((*left)->type() != (*right)->type()) {
+        bsl::ostringstream error;
+        error << "arguments to \"" << name
+              << "\" must have the same element type";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    if ((*left)->length() != (*right)->length() && (*left)->length() != 1 &&
+        (*right)->length() != 1) {
+        bsl::ostringstream error;
+        error << "arguments to \"" << name
+              << "\" must have the same length, or one must have length one";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+}
+
+void returnPackedVector(const PackedVector&                   vector,
+                        const NativeProcedureUtil::Arguments& args) {
+    const bdld::Datum result = PackedVector::create(vector, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+// Return a packed vector of the specified 'type' whose elements are the
+// arguments to the procedure having the specified 'name'. Throw an error if
+// any argument cannot be represented exactly as 'type'.
+void packedFromArguments(bsl::string_view                      name,
+                         PackedVector::ElementType             type,
+                         const NativeProcedureUtil::Arguments& args) {
+    const bsl::vector<bdld::Datum>& elements = *args.argsAndOutput;
+    const bdld::Datum* const        begin    = elements.data();
+
+    const PackedVector* vector;
+    if (PackedVector::fromRange(
+            &vector, type, begin, begin + elements.size(), args.allocator)) {
+        bsl::ostringstream error;
+        error << "arguments to \"" << name
+              << "\" must be numbers that it can represent exactly";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    returnPackedVector(*vector, args);
+}
+
+void applyOperation(bsl::string_view                      name,
+                    PackedVector::Operation               operation,
+                    const NativeProcedureUtil::Arguments& args) {
+    const PackedVector* left;
+    const PackedVector* right;
+    accessOperands(&left, &right, name, args);
+
+    const PackedVector* result;
+    if (PackedVector::apply(
+            &result, operation, *left, *right, args.allocator)) {
+        bsl::ostringstream error;
+        error << "integer division by zero in \"" << name << "\"";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    returnPackedVector(*result, args);
+}
+
+void applyComparison(bsl::string_view                      name,
+                     PackedVector::Comparison              comparison,
+                     const NativeProcedureUtil::Arguments& args) {
+    const PackedVector* left;
+    const PackedVector* right;
+    accessOperands(&left, &right, name, args);
+
+    returnPackedVector(
+        *PackedVector::compareEach(comparison, *left, *right, args.allocator),
+        args);
+}
+
+// Return the packed vector that is the only argument to the procedure having
+// the specified 'name'. Throw an error if there is not exactly one argument,
+// if it is not a packed vector, or if it is empty.
+const PackedVector& accessNonemptyPackedVector(
+    bsl::string_view                      name,
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity(name, 1, args);
+
+    const PackedVector& vector =
+        accessPackedVector(name, args.argsAndOutput->front(), args);
+    if (vector.length() == 0) {
+        bsl::ostringstream error;
+        error << "argument to \"" << name << "\" must not be empty";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return vector;
+}
+
+}  // namespace
+
+void BuiltinProcedures::packedInt32(
+    const NativeProcedureUtil::Arguments& args) {
+    // Return a 'PackedVector' of the arguments, which must be 'int'.
+    packedFromArguments("packed-int32", PackedVector::e_INT32, args);
+}
+
+void BuiltinProcedures::packedInt64(
+    const NativeProcedureUtil::Arguments& args) {
+    // Return a 'PackedVector' of the arguments, which must be integers.
+    packedFromArguments("packed-int64", PackedVector::e_INT64, args);
+}
+
+void BuiltinProcedures::packedDouble(
+    const NativeProcedureUtil::Arguments& args) {
+    // Return a 'PackedVector' of the arguments, which must be doubles or
+    // 'int'.
+    packedFromArguments("packed-double", PackedVector::e_DOUBLE, args);
+}
+
+void BuiltinProcedures::arrayToPacked(
+    const NativeProcedureUtil::Arguments& args) {
+    // (array->packed array) is a packed vector of the numbers in 'array',
+    // whose element type is the narrowest that represents all of them.
+    enforceArity("array->packed", 1, args);
+
+    const bdld::Datum& array = args.argsAndOutput->front();
+    if (!array.isArray()) {
+        throw bdld::Datum::createError(
+            -1,
+            "argument to \"array->packed\" must be an array",
+            args.allocator);
+    }
+
+    const bdld::DatumArrayRef elements = array.theArray();
+    const bdld::Datum* const  begin    = elements.data();
+    const bdld::Datum* const  end      = begin + elements.length();
+    PackedVector::ElementType type;
+    const PackedVector*       vector;
+    if (PackedVector::inferType(&type, begin, end) ||
+        PackedVector::fromRange(&vector, type, begin, end, args.allocator)) {
+        throw bdld::Datum::createError(
+            -1,
+            "argument to \"array->packed\" must contain only numbers of "
+            "one element type",
+            args.allocator);
+    }
+
+    returnPackedVector(*vector, args);
+}
+
+void BuiltinProcedures::packedToArray(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("packed->array", 1, args);
+
+    const PackedVector& vector =
+        accessPackedVector("packed->array", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() =
+        PackedVector::toArray(vector, args.allocator);
+}
+
+void BuiltinProcedures::packedLength(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("packed-length", 1, args);
+
+    const PackedVector& vector =
+        accessPackedVector("packed-length", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = createCount(vector.length(), args);
+}
+
+void BuiltinProcedures::packedRef(const NativeProcedureUtil::Arguments& args) {
+    enforceArity("packed-ref", 2, args);
+
+    const PackedVector& vector =
+        accessPackedVector("packed-ref", (*args.argsAndOutput)[0], args);
+    const bsl::size_t index = accessIndex(
+        "packed-ref", (*args.argsAndOutput)[1], vector.length(), args);
+
+    const bdld::Datum result =
+        PackedVector::element(vector, index, args.allocator);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::packedAdd(const NativeProcedureUtil::Arguments& args) {
+    // (packed+ a b) is the elementwise sum of 'a' and 'b', either of which
+    // may instead be a number to add to every element of the other.
+    applyOperation("packed+", PackedVector::e_ADD, args);
+}
+
+void BuiltinProcedures::packedSubtract(
+    const NativeProcedureUtil::Arguments& args) {
+    applyOperation("packed-", PackedVector::e_SUBTRACT, args);
+}
+
+void BuiltinProcedures::packedMultiply(
+    const NativeProcedureUtil::Arguments& args) {
+    applyOperation("packed*", PackedVector::e_MULTIPLY, args);
+}
+
+void BuiltinProcedures::packedDivide(
+    const NativeProcedureUtil::Arguments& args) {
+    // Integer division truncates toward zero.
+    applyOperation("packed/", PackedVector::e_DIVIDE, args);
+}
+
+void BuiltinProcedures::packedLess(
+    const NativeProcedureUtil::Arguments& args) {
+    // (packed< a b) is a packed vector of 32-bit integers that are one where
+    // the element of 'a' is less than that of 'b', and zero elsewhere.
+    applyComparison("packed<", PackedVector::e_LESS, args);
+}
+
+void BuiltinProcedures::packedLessOrEqual(
+    const NativeProcedureUtil::Arguments& args) {
+    applyComparison("packed<=", PackedVector::e_LESS_OR_EQUAL, args);
+}
+
+void BuiltinProcedures::packedEqual(
+    const NativeProcedureUtil::Arguments& args) {
+    applyComparison("packed=", PackedVector::e_EQUAL, args);
+}
+
+void BuiltinProcedures::packedGreaterOrEqual(
+    const NativeProcedureUtil::Arguments& args) {
+    applyComparison("packed>=", PackedVector::e_GREATER_OR_EQUAL, args);
+}
+
+void BuiltinProcedures::packedGreater(
+    const NativeProcedureUtil::Arguments& args) {
+    applyComparison("packed>", PackedVector::e_GREATER, args);
+}
+
+void BuiltinProcedures::packedSum(const NativeProcedureUtil::Arguments& args) {
+    enforceArity("packed-sum", 1, args);
+
+    const PackedVector& vector =
+        accessPackedVector("packed-sum", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = PackedVector::sum(vector, args.allocator);
+}
+
+void BuiltinProcedures::packedMin(const NativeProcedureUtil::Arguments& args) {
+    const PackedVector& vector =
+        accessNonemptyPackedVector("packed-min", args);
+
+    args.argsAndOutput->front() =
+        PackedVector::minimum(vector, args.allocator);
+}
+
+void BuiltinProcedures::packedMax(const NativeProcedureUtil::Arguments& args) {
+    const PackedVector& vector =
+        accessNonemptyPackedVector("packed-max", args);
+
+    args.argsAndOutput->front() =
+        PackedVector::maximum(vector, args.allocator);
+}
+
+void BuiltinProcedures::packedDot(const NativeProcedureUtil::Arguments& args) {
+    enforceArity("packed-dot", 2, args);
+
+    const PackedVector& left =
+        accessPackedVector("packed-dot", (*args.argsAndOutput)[0], args);
+    const bdld::Datum& other = (*args.argsAndOutput)[1];
+    if (!PackedVector::isPackedVector(other, args.typeOffset)) {
+        throw bdld::Datum::createError(
+            -1,
+            "second argument to \"packed-dot\" must be a packed vector",
+            args.allocator);
+    }
+
+    const PackedVector& right = PackedVector::access(other);
+    if (left.type() != right.type() || left.length() != right.length()) {
+        throw bdld::Datum::createError(
+            -1,
+            "arguments to \"packed-dot\" must have the same element type and "
+            "the same length",
+            args.allocator);
+    }
+
+    const bdld::Datum result = PackedVector::dot(left, right, args.allocator);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::packedScan(
+    const NativeProcedureUtil::Arguments& args) {
+    // (packed-scan vector) is the running sum of the elements of 'vector'.
+    enforceArity("packed-scan", 1, args);
+
+    const PackedVector& vector =
+        accessPackedVector("packed-scan", args.argsAndOutput->front(), args);
+
+    returnPackedVector(*PackedVector::prefixSum(vector, args.allocator), args);
+}
+
+namespace {
+
+// Return the rope referred to by the specified 'datum', which is the first
+// argument to the procedure having the specified 'name'. Throw an error if
+// 'datum' is not a rope.
+const Rope* accessRope(bsl::string_view                      name,
+                       const bdld::Datum&                    datum,
+                       const NativeProcedureUtil::Arguments& args) {
+    if (!Rope::isRope(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "first argument to \"" << name << "\" must be a rope";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return Rope::access(datum);
+}
+
+// Return a rope of the characters of the specified 'rope' followed by those
+// of the specified 'piece', which is an argument to the procedure having the
+// specified 'name'. Throw an error if 'piece' is neither a string nor a rope.
+const Rope* appendPiece(bsl::string_view                      name,
+                        const Rope*                           rope,
+                        const bdld::Datum&                    piece,
+                        const NativeProcedureUtil::Arguments& args) {
+    if (piece.isString()) {
+        return Rope::append(rope, piece.theString(), args.allocator);
+    }
+    if (Rope::isRope(piece, args.typeOffset)) {
+        return Rope::concatenate(rope, Rope::access(piece), args.allocator);
+    }
+
+    bsl::ostringstream error;
+    error << "arguments to \"" << name << "\" must be strings or ropes";
+    throw bdld::Datum::createError(-1, error.str(), args.allocator);
+}
+
+void returnRope(const Rope* rope, const NativeProcedureUtil::Arguments& args) {
+    const bdld::Datum result = Rope::create(rope, args.typeOffset);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+}  // namespace
+
+void BuiltinProcedures::rope(const NativeProcedureUtil::Arguments& args) {
+    // (rope "foo" "bar") is a rope of the characters "foobar". Arguments can
+    // be strings or ropes.
+    const bsl::vector<bdld::Datum>& pieces = *args.argsAndOutput;
+    const Rope*                     result = 0;
+    for (bsl::size_t i = 0; i < pieces.size(); ++i) {
+        result = appendPiece("rope", result, pieces[i], args);
+    }
+
+    returnRope(result, args);
+}
+
+void BuiltinProcedures::ropeAppend(
+    const NativeProcedureUtil::Arguments& args) {
+    // (rope-append rope "foo" "bar") has the characters of 'rope' followed by
+    // "foobar". Appending to the most recent rope built from a given rope
+    // doesn't copy any of the characters already in it.
+    const bsl::vector<bdld::Datum>& pieces = *args.argsAndOutput;
+    if (pieces.empty()) {
+        throw bdld::Datum::createError(
+            -1,
+            "procedure \"rope-append\" takes at least 1 argument",
+            args.allocator);
+    }
+
+    const Rope* result = accessRope("rope-append", pieces[0], args);
+    for (bsl::size_t i = 1; i < pieces.size(); ++i) {
+        result = appendPiece("rope-append", result, pieces[i], args);
+    }
+
+    returnRope(result, args);
+}
+
+void BuiltinProcedures::ropeLength(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("rope-length", 1, args);
+
+    const Rope* const rope =
+        accessRope("rope-length", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = createCount(Rope::length(rope), args);
+}
+
+void BuiltinProcedures::ropeRef(const NativeProcedureUtil::Arguments& args) {
+    // (rope-ref rope index) is a string of the one character of 'rope' at
+    // 'index'.
+    enforceArity("rope-ref", 2, args);
+
+    const Rope* const rope =
+        accessRope("rope-ref", (*args.argsAndOutput)[0], args);
+    const bsl::size_t index = accessIndex(
+        "rope-ref", (*args.argsAndOutput)[1], Rope::length(rope), args);
+
+    const char character = Rope::at(rope, index);
+    const bdld::Datum result =
+        bdld::Datum::copyString(&character, 1, args.allocator);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::ropeSlice(const NativeProcedureUtil::Arguments& args) {
+    // (rope-slice rope begin end) has the characters of 'rope' from index
+    // 'begin' up to but not including index 'end'.
+    enforceArity("rope-slice", 3, args);
+
+    const Rope* const rope =
+        accessRope("rope-slice", (*args.argsAndOutput)[0], args);
+    const bsl::size_t length = Rope::length(rope);
+    const bsl::size_t end    =
+        accessIndex("rope-slice", (*args.argsAndOutput)[2], length + 1, args);
+    const bsl::size_t begin  =
+        accessIndex("rope-slice", (*args.argsAndOutput)[1], end + 1, args);
+
+    returnRope(Rope::slice(rope, begin, end, args.allocator), args);
+}
+
+void BuiltinProcedures::ropeToString(
+    const NativeProcedureUtil::Arguments& args) {
+    // (rope->string rope) is a string of the characters of 'rope'.
+    enforceArity("rope->string", 1, args);
+
+    const Rope* const rope =
+        accessRope("rope->string", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = Rope::toString(rope, args.allocator);
+}
+
+namespace {
+
+// Return a string of the specified 'length' bytes beginning at the specified
+// 'begin', which are part of the specified 'string'. The interpreter never
+// frees the storage of a string while the program runs, so the result refers
+// to the bytes of 'string' instead of copying them, unless 'string' is short
+// enough that 'bdld::Datum' stores its bytes within the 'string' object
+// itself. Such an object might be an argument that is about to be
+// overwritten by the result of the procedure, so then the bytes are copied.
+bdld::Datum createSubstring(const bdld::Datum& string,
+                            const char*        begin,
+                            bsl::size_t        length,
+                            bslma::Allocator*  allocator) {
+    const char* const object = reinterpret_cast<const char*>(&string);
+    if (begin >= object && begin < object + sizeof string) {
+        return bdld::Datum::copyString(begin, length, allocator);
+    }
+
+    return bdld::Datum::createStringRef(begin, length, allocator);
+}
+
+}  // namespace
+
+void BuiltinProcedures::substring(const NativeProcedureUtil::Arguments& args) {
+    // (substring string begin end) has the bytes of 'string' from index
+    // 'begin' up to but not including index 'end'. It shares the bytes of
+    // 'string' unless 'string' is short.
+    enforceArity("substring", 3, args);
+
+    const bdld::Datum& string = (*args.argsAndOutput)[0];
+    if (!string.isString()) {
+        throw bdld::Datum::createError(
+            -1,
+            "first argument to \"substring\" must be a string",
+            args.allocator);
+    }
+
+    const bsl::string_view text  = string.theString();
+    const bsl::size_t      end   = accessIndex(
+        "substring", (*args.argsAndOutput)[2], text.size() + 1, args);
+    const bsl::size_t      begin =
+        accessIndex("substring", (*args.argsAndOutput)[1], end + 1, args);
+
+    const bdld::Datum result = createSubstring(
+        string, text.data() + begin, end - begin, args.allocator);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::stringSplit(
+    const NativeProcedureUtil::Arguments& args) {
+    // (string-split string delimiter) is a list of the pieces of 'string'
+    // between occurrences of 'delimiter', e.g. (string-split "a,b,,c" ",") is
+    // ("a" "b" "" "c"). The pieces share the bytes of 'string' unless
+    // 'string' is short.
+    enforceArity("string-split", 2, args);
+
+    const bdld::Datum& string    = (*args.argsAndOutput)[0];
+    const bdld::Datum& delimiter = (*args.argsAndOutput)[1];
+    if (!string.isString() || !delimiter.isString()) {
+        throw bdld::Datum::createError(
+            -1,
+            "arguments to \"string-split\" must be strings",
+            args.allocator);
+    }
+    if (delimiter.theString().empty()) {
+        throw bdld::Datum::createError(
+            -1,
+            "delimiter argument to \"string-split\" must not be empty",
+            args.allocator);
+    }
+
+    const bsl::string_view   text      = string.theString();
+    const bsl::string_view   separator = delimiter.theString();
+    bsl::vector<bdld::Datum> pieces(args.allocator);
+    bsl::size_t              begin     = 0;
+    for (;;) {
+        const bsl::size_t end = StringUtil::find(text, separator, begin);
+        if (end == bsl::string_view::npos) {
+            break;
+        }
+        pieces.push_back(createSubstring(
+            string, text.data() + begin, end - begin, args.allocator));
+        begin = end + separator.size();
+    }
+    pieces.push_back(createSubstring(
+        string, text.data() + begin, text.size() - begin, args.allocator));
+
+    const bdld::Datum result =
+        ListUtil::createList(pieces, args.typeOffset, args.allocator);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::bytesSlice(
+    const NativeProcedureUtil::Arguments& args) {
+    // (bytes-slice binary begin end) has the bytes of 'binary' from index
+    // 'begin' up to but not including index 'end'. 'bdld::Datum' has no way
+    // to refer to binary data that it doesn't own, so the bytes are copied,
+    // but only those in the slice.
+    enforceArity("bytes-slice", 3, args);
+
+    const bdld::Datum& binary = (*args.argsAndOutput)[0];
+    if (!binary.isBinary()) {
+        throw bdld::Datum::createError(
+            -1,
+            "first argument to \"bytes-slice\" must be binary",
+            args.allocator);
+    }
+
+    const bdld::DatumBinaryRef bytes = binary.theBinary();
+    const bsl::size_t          end   = accessIndex(
+        "bytes-slice", (*args.argsAndOutput)[2], bytes.size() + 1, args);
+    const bsl::size_t          begin =
+        accessIndex("bytes-slice", (*args.argsAndOutput)[1], end + 1, args);
+
+    const bdld::Datum result = bdld::Datum::copyBinary(
+        static_cast<const char*>(bytes.data()) + begin,
+        end - begin,
+        args.allocator);
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+namespace {
+
+// Return the hash table referred to by the specified 'datum', which is the
+// first argument to the procedure having the specified 'name'. Throw an error
+// if 'datum' is not a hash table.
+HashTable* accessHashTable(bsl::string_view                      name,
+                           const bdld::Datum&                    datum,
+                           const NativeProcedureUtil::Arguments& args) {
+    if (!HashTable::isHashTable(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "first argument to \"" << name << "\" must be a hash table";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return HashTable::access(datum);
+}
+
+}  // namespace
+
+void BuiltinProcedures::hashTable(const NativeProcedureUtil::Arguments& args) {
+    // (hash-table key value ...) is a new hash table associating each 'key'
+    // with the 'value' that follows it. (hash-set! table key value) and
+    // (hash-update! table key procedure) modify 'table' in place and return
+    // it.
+    const bsl::vector<bdld::Datum>& arguments = *args.argsAndOutput;
+    if (arguments.size() % 2) {
+        throw bdld::Datum::createError(
+            -1,
+            "procedure \"hash-table\" takes an even number of arguments",
+            args.allocator);
+    }
+
+    HashTable* const table =
+        new (*args.allocator) HashTable(args.typeOffset, args.allocator);
+    for (bsl::size_t i = 0; i < arguments.size(); i += 2) {
+        table->insert(
+            arguments[i], table->hash(arguments[i]), arguments[i + 1]);
+    }
+
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = HashTable::create(table, args.typeOffset);
+}
+
+void BuiltinProcedures::hashRef(const NativeProcedureUtil::Arguments& args) {
+    // (hash-ref table key) is the value associated with 'key' in 'table', and
+    // (hash-ref table key default) is 'default' if there is none.
+    const bsl::size_t arity = args.argsAndOutput->size();
+    if (arity != 2 && arity != 3) {
+        throw bdld::Datum::createError(
+            -1,
+            "procedure \"hash-ref\" takes two or three arguments",
+            args.allocator);
+    }
+
+    const HashTable* const table =
+        accessHashTable("hash-ref", (*args.argsAndOutput)[0], args);
+    const bdld::Datum&       key   = (*args.argsAndOutput)[1];
+    const bdld::Datum* const value = table->find(key, table->hash(key));
+    if (!value && arity == 2) {
+        bsl::ostringstream error;
+        error << "key not found in hash table: ";
+        PrintUtil::print(error, key, args.typeOffset);
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    const bdld::Datum result = value ? *value : (*args.argsAndOutput)[2];
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::hashSetInPlace(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("hash-set!", 3, args);
+
+    HashTable* const table =
+        accessHashTable("hash-set!", (*args.argsAndOutput)[0], args);
+    const bdld::Datum& key = (*args.argsAndOutput)[1];
+    table->insert(key, table->hash(key), (*args.argsAndOutput)[2]);
+
+    args.argsAndOutput->resize(1);
+}
+
+void BuiltinProcedures::hashUpdateInPlace(
+    const NativeProcedureUtil::Arguments& args) {
+    // (hash-update! table key procedure) associates 'key' with the result of
+    // invoking 'procedure' with the value associated with 'key', and
+    // (hash-update! table key procedure default) uses 'default' as the value
+    // if there is none, e.g. (hash-update! counts word (λ (n) (+ n 1)) 0).
+    const bsl::size_t arity = args.argsAndOutput->size();
+    if (arity != 3 && arity != 4) {
+        throw bdld::Datum::createError(
+            -1,
+            "procedure \"hash-update!\" takes three or four arguments",
+            args.allocator);
+    }
+
+    HashTable* const table =
+        accessHashTable("hash-update!", (*args.argsAndOutput)[0], args);
+    const bdld::Datum        key   = (*args.argsAndOutput)[1];
+    const bsl::size_t        hash  = table->hash(key);
+    const bdld::Datum* const value = table->find(key, hash);
+    if (!value && arity == 3) {
+        bsl::ostringstream error;
+        error << "key not found in hash table: ";
+        PrintUtil::print(error, key, args.typeOffset);
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    // 'procedure' might modify 'table', so 'value' is copied first, and 'key'
+    // is looked up again afterward (using the same hash).
+    const bdld::Datum current = value ? *value : (*args.argsAndOutput)[3];
+    const bdld::Datum updated = args.interpreter->invoke(
+        (*args.argsAndOutput)[2], &current, 1, *args.environment);
+    table->insert(key, hash, updated);
+
+    args.argsAndOutput->resize(1);
+}
+
+void BuiltinProcedures::hashCount(const NativeProcedureUtil::Arguments& args) {
+    enforceArity("hash-count", 1, args);
+
+    const HashTable* const table =
+        accessHashTable("hash-count", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = createCount(table->size(), args);
+}
+
+namespace {
+
+// Return the mutable vector referred to by the specified 'datum', which is
+// the first argument to the procedure having the specified 'name'. Throw an
+// error if 'datum' is not a mutable vector.
+MutableVector* accessMutableVector(
+    bsl::string_view                      name,
+    const bdld::Datum&                    datum,
+    const NativeProcedureUtil::Arguments& args) {
+    if (!MutableVector::isMutableVector(datum, args.typeOffset)) {
+        bsl::ostringstream error;
+        error << "first argument to \"" << name
+              << "\" must be a mutable vector";
+        throw bdld::Datum::createError(-1, error.str(), args.allocator);
+    }
+
+    return MutableVector::access(datum);
+}
+
+}  // namespace
+
+void BuiltinProcedures::mutableVector(
+    const NativeProcedureUtil::Arguments& args) {
+    // (vector value ...) is a new mutable vector of the 'value' arguments.
+    // (vector-push! vector value) and (vector-set! vector index value) modify
+    // 'vector' in place and return it.
+    MutableVector* const vector =
+        new (*args.allocator) MutableVector(args.allocator);
+    for (bsl::size_t i = 0; i < args.argsAndOutput->size(); ++i) {
+        vector->push((*args.argsAndOutput)[i]);
+    }
+
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() =
+        MutableVector::create(vector, args.typeOffset);
+}
+
+void BuiltinProcedures::makeMutableVector(
+    const NativeProcedureUtil::Arguments& args) {
+    // (make-vector size fill) is a new mutable vector of 'size' copies of
+    // 'fill', e.g. the table of a dynamic programming algorithm.
+    enforceArity("make-vector", 2, args);
+
+    const bdld::Datum& size = (*args.argsAndOutput)[0];
+    if ((!size.isInteger() || size.theInteger() < 0) &&
+        (!size.isInteger64() || size.theInteger64() < 0)) {
+        throw bdld::Datum::createError(
+            -1,
+            "first argument to \"make-vector\" must be a nonnegative integer",
+            args.allocator);
+    }
+
+    const bsls::Types::Int64 count =
+        size.isInteger() ? size.theInteger() : size.theInteger64();
+    // The size of the vector's storage in bytes, which includes its length,
+    // must fit in a 'bsl::size_t'. A count within that bound can still be
+    // too large to allocate, and that is reported as the same error.
+    const bsls::Types::Uint64 maxCount =
+        bsl::numeric_limits<bsl::size_t>::max() / sizeof(bdld::Datum) - 1;
+    const char* const tooLarge = "make-vector: count too large";
+    if (bsls::Types::Uint64(count) > maxCount) {
+        throw bdld::Datum::createError(-1, tooLarge, args.allocator);
+    }
+
+    const bdld::Datum    fill   = (*args.argsAndOutput)[1];
+    MutableVector* const vector =
+        new (*args.allocator) MutableVector(args.allocator);
+    try {
+        vector->reserve(bsl::size_t(count));
+    }
+    catch (const bsl::bad_alloc&) {
+        throw bdld::Datum::createError(-1, tooLarge, args.allocator);
+    }
+    for (bsls::Types::Int64 i = 0; i < count; ++i) {
+        vector->push(fill);
+    }
+
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() =
+        MutableVector::create(vector, args.typeOffset);
+}
+
+void BuiltinProcedures::mutableVectorLength(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("vector-length", 1, args);
+
+    const MutableVector* const vector = accessMutableVector(
+        "vector-length", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = createCount(vector->size(), args);
+}
+
+void BuiltinProcedures::mutableVectorRef(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("vector-ref", 2, args);
+
+    const MutableVector* const vector =
+        accessMutableVector("vector-ref", (*args.argsAndOutput)[0], args);
+    const bsl::size_t index = accessIndex(
+        "vector-ref", (*args.argsAndOutput)[1], vector->size(), args);
+
+    const bdld::Datum result = (*vector)[index];
+    args.argsAndOutput->resize(1);
+    args.argsAndOutput->front() = result;
+}
+
+void BuiltinProcedures::mutableVectorSetInPlace(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("vector-set!", 3, args);
+
+    MutableVector* const vector =
+        accessMutableVector("vector-set!", (*args.argsAndOutput)[0], args);
+    const bsl::size_t index = accessIndex(
+        "vector-set!", (*args.argsAndOutput)[1], vector->size(), args);
+    vector->set(index, (*args.argsAndOutput)[2]);
+
+    args.argsAndOutput->resize(1);
+}
+
+void BuiltinProcedures::mutableVectorPushInPlace(
+    const NativeProcedureUtil::Arguments& args) {
+    enforceArity("vector-push!", 2, args);
+
+    MutableVector* const vector =
+        accessMutableVector("vector-push!", (*args.argsAndOutput)[0], args);
+    vector->push((*args.argsAndOutput)[1]);
+
+    args.argsAndOutput->resize(1);
+}
+
+void BuiltinProcedures::mutableVectorFreeze(
+    const NativeProcedureUtil::Arguments& args) {
+    // (vector-freeze vector) is an array of the elements of 'vector'. The
+    // array shares the elements of 'vector' until 'vector' is next modified.
+    enforceArity("vector-freeze", 1, args);
+
+    MutableVector* const vector = accessMutableVector(
+        "vector-freeze", args.argsAndOutput->front(), args);
+
+    args.argsAndOutput->front() = vector->freeze();
 }
 
 }  // namespace lspcore
@@ -19,9 +19,127 @@ struct BuiltinProcedures {
     static FUNCTION(raise);
 
     static FUNCTION(set);
+    static FUNCTION(bTreeSet);
     static FUNCTION(setContains);
     static FUNCTION(setInsert);
     static FUNCTION(setRemove);
+    static FUNCTION(setUnion);
+    static FUNCTION(setIntersection);
+    static FUNCTION(setDifference);
+    static FUNCTION(isSubset);
+    static FUNCTION(setSize);
+    static FUNCTION(setNth);
+    static FUNCTION(setRank);
+    static FUNCTION(setCountRange);
+    static FUNCTION(setRange);
+    static FUNCTION(setFold);
+    static FUNCTION(setFind);
+    static FUNCTION(setSequence);
+    static FUNCTION(isSetSequenceEmpty);
+    static FUNCTION(setSequenceFirst);
+    static FUNCTION(setSequenceRest);
+    static FUNCTION(setTransient);
+    static FUNCTION(setInsertInPlace);
+    static FUNCTION(setRemoveInPlace);
+    static FUNCTION(persist);
+
+    static FUNCTION(hashMap);
+    static FUNCTION(hashMapContains);
+    static FUNCTION(hashMapGet);
+    static FUNCTION(hashMapInsert);
+    static FUNCTION(hashMapRemove);
+
+    static FUNCTION(hashSet);
+    static FUNCTION(hashSetContains);
+    static FUNCTION(hashSetInsert);
+    static FUNCTION(hashSetRemove);
+
+    static FUNCTION(intSet);
+    static FUNCTION(intSetContains);
+    static FUNCTION(intSetInsert);
+    static FUNCTION(intSetRemove);
+    static FUNCTION(intSetUnion);
+    static FUNCTION(intSetIntersection);
+    static FUNCTION(intSetDifference);
+    static FUNCTION(intSetRange);
+
+    static FUNCTION(intMap);
+    static FUNCTION(intMapContains);
+    static FUNCTION(intMapGet);
+    static FUNCTION(intMapInsert);
+    static FUNCTION(intMapRemove);
+    static FUNCTION(intMapMerge);
+    static FUNCTION(intMapRange);
+
+    static FUNCTION(rrbVector);
+    static FUNCTION(arrayToRrbVector);
+    static FUNCTION(rrbVectorToArray);
+    static FUNCTION(rrbVectorSize);
+    static FUNCTION(rrbVectorNth);
+    static FUNCTION(rrbVectorAssoc);
+    static FUNCTION(rrbVectorPush);
+    static FUNCTION(rrbVectorConcat);
+    static FUNCTION(rrbVectorSlice);
+
+    static FUNCTION(deque);
+    static FUNCTION(dequeSize);
+    static FUNCTION(dequeIsEmpty);
+    static FUNCTION(dequeFront);
+    static FUNCTION(dequeBack);
+    static FUNCTION(dequeNth);
+    static FUNCTION(dequePushFront);
+    static FUNCTION(dequePushBack);
+    static FUNCTION(dequePopFront);
+    static FUNCTION(dequePopBack);
+    static FUNCTION(dequeConcat);
+    static FUNCTION(dequeSplit);
+
+    static FUNCTION(packedInt32);
+    static FUNCTION(packedInt64);
+    static FUNCTION(packedDouble);
+    static FUNCTION(arrayToPacked);
+    static FUNCTION(packedToArray);
+    static FUNCTION(packedLength);
+    static FUNCTION(packedRef);
+    static FUNCTION(packedAdd);
+    static FUNCTION(packedSubtract);
+    static FUNCTION(packedMultiply);
+    static FUNCTION(packedDivide);
+    static FUNCTION(packedLess);
+    static FUNCTION(packedLessOrEqual);
+    static FUNCTION(packedEqual);
+    static FUNCTION(packedGreaterOrEqual);
+    static FUNCTION(packedGreater);
+    static FUNCTION(packedSum);
+    static FUNCTION(packedMin);
+    static FUNCTION(packedMax);
+    static FUNCTION(packedDot);
+    static FUNCTION(packedScan);
+
+    static FUNCTION(rope);
+    static FUNCTION(ropeAppend);
+    static FUNCTION(ropeLength);
+    static FUNCTION(ropeRef);
+    static FUNCTION(ropeSlice);
+    static FUNCTION(ropeToString);
+
+    static FUNCTION(substring);
+    static FUNCTION(stringSplit);
+    static FUNCTION(bytesSlice);
+
+    static FUNCTION(hashTable);
+    static FUNCTION(hashRef);
+    static FUNCTION(hashSetInPlace);
+    static FUNCTION(hashUpdateInPlace);
+    static FUNCTION(hashCount);
+
+    static FUNCTION(mutableVector);
+    static FUNCTION(makeMutableVector);
+    static FUNCTION(mutableVectorLength);
+    static FUNCTION(mutableVectorRef);
+    static FUNCTION(mutableVectorSetInPlace);
+    static FUNCTION(mutableVectorPushInPlace);
+    static FUNCTION(mutableVectorFreeze);
 
 #undef FUNCTION
 };
@@ -23,7 +23,7 @@ Builtins::Builtin Builtins::fromUdtData(void* udtData) {
     const bsl::intptr_t asInt = reinterpret_cast<bsl::intptr_t>(udtData);
 
     BSLS_ASSERT(asInt >= e_UNDEFINED);
-    BSLS_ASSERT(asInt <= e_QUOTE);
+    BSLS_ASSERT(asInt <= e_UNQUOTE_SPLICING);
 
     return static_cast<Builtin>(asInt);
 }
@@ -47,9 +47,17 @@ bsl::string_view Builtins::name(Builtin builtin) {
             return "set!";
         case e_IF:
             return "if";
-        default:
-            BSLS_ASSERT_OPT(builtin == e_QUOTE);
+        case e_QUOTE:
             return "quote";
+        case e_DEFINE_RECORD:
+            return "define-record";
+        case e_QUASIQUOTE:
+            return "quasiquote";
+        case e_UNQUOTE:
+            return "unquote";
+        default:
+            BSLS_ASSERT_OPT(builtin == e_UNQUOTE_SPLICING);
+            return "unquote-splicing";
     }
 }
 
@@ -14,7 +14,11 @@ struct Builtins {
         e_DEFINE,
         e_SET,  // as in (set! foo bar)
         e_IF,
-        e_QUOTE
+        e_QUOTE,
+        e_DEFINE_RECORD,
+        e_QUASIQUOTE,
+        e_UNQUOTE,
+        e_UNQUOTE_SPLICING
         // don't forget to update the definition of 'fromUdtData' and 'name'
     };
 
@@ -0,0 +1,43 @@
+#include <lspcore_cpuutil.h>
+
+namespace lspcore {
+namespace {
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+// 'Features' queries the processor once, the first time it's needed.
+struct Features {
+    bool ssse3;
+    bool avx2;
+
+    Features() {
+        __builtin_cpu_init();
+        ssse3 = __builtin_cpu_supports("ssse3");
+        avx2  = __builtin_cpu_supports("avx2");
+    }
+};
+
+const Features& features() {
+    static const Features instance;
+    return instance;
+}
+#endif
+
+}  // namespace
+
+bool CpuUtil::hasSsse3() {
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    return features().ssse3;
+#else
+    return false;
+#endif
+}
+
+bool CpuUtil::hasAvx2() {
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    return features().avx2;
+#else
+    return false;
+#endif
+}
+
+}  // namespace lspcore
@@ -0,0 +1,36 @@
+#ifndef INCLUDED_LSPCORE_CPUUTIL
+#define INCLUDED_LSPCORE_CPUUTIL
+
+#include <bsls_platform.h>
+
+// 'LSPCORE_CPUUTIL_X86_TARGETS' is defined when the compiler can generate
+// code for instruction set extensions that were not enabled on the command
+// line, by marking individual functions with, e.g.,
+//
+//     LSPCORE_CPUUTIL_TARGET("avx2") void addAll(...);
+//
+// Such functions may be called only after checking 'CpuUtil', below. Where
+// 'LSPCORE_CPUUTIL_X86_TARGETS' is not defined, only portable code is used.
+#if defined(BSLS_PLATFORM_CPU_X86_64) &&                                    \
+    (defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG))
+#define LSPCORE_CPUUTIL_X86_TARGETS 1
+#define LSPCORE_CPUUTIL_TARGET(FEATURES) __attribute__((target(FEATURES)))
+#endif
+
+namespace lspcore {
+
+struct CpuUtil {
+    // Return whether the processor executing this program supports the
+    // SSSE3 instructions. Return 'false' if the answer is unknown or if
+    // 'LSPCORE_CPUUTIL_X86_TARGETS' is not defined.
+    static bool hasSsse3();
+
+    // Return whether the processor executing this program supports the AVX2
+    // instructions. Return 'false' if the answer is unknown or if
+    // 'LSPCORE_CPUUTIL_X86_TARGETS' is not defined.
+    static bool hasAvx2();
+};
+
+}  // namespace lspcore
+
+#endif
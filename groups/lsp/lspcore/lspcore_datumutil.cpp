@@ -1,9 +1,22 @@
 #include <bdld_datum.h>
 #include <bsl_algorithm.h>
 #include <bsl_cstring.h>
+#include <bsl_limits.h>
+#include <bsls_types.h>
+#include <lspcore_btreeset.h>
 #include <lspcore_datumutil.h>
-#include <lspcore_listutil.h>
+#include <lspcore_deque.h>
+#include <lspcore_hashmap.h>
+#include <lspcore_inttrie.h>
+#include <lspcore_numberutil.h>
+#include <lspcore_packedvector.h>
 #include <lspcore_pair.h>
+#include <lspcore_record.h>
+#include <lspcore_rope.h>
+#include <lspcore_rrbvector.h>
+#include <lspcore_set.h>
+#include <lspcore_setsequence.h>
+#include <lspcore_symbolutil.h>
 #include <lspcore_userdefinedtypes.h>
 
 using namespace BloombergLP;
@@ -11,206 +24,1030 @@ using namespace BloombergLP;
 namespace lspcore {
 namespace {
 
-bool isNumeric(const bdld::Datum& value) {
-    switch (value.type()) {
-        case bdld::Datum::e_INTEGER:
-        case bdld::Datum::e_DOUBLE:
-        case bdld::Datum::e_INTEGER64:
-        case bdld::Datum::e_DECIMAL64:
-            return true;
-        default:
-            return false;
+// Return a negative number, zero, or a positive number if the specified
+// 'left' is less than, equivalent to, or greater than the specified 'right',
+// respectively, according to 'operator<'.
+template <typename Value>
+int compareValues(const Value& left, const Value& right) {
+    if (left < right) {
+        return -1;
+    }
+    if (right < left) {
+        return 1;
     }
+    return 0;
 }
 
-bool intLessThanNumeric(int left, const bdld::Datum& right) {
-    switch (right.type()) {
-        case bdld::Datum::e_INTEGER:
-            return left < right.theInteger();
-        case bdld::Datum::e_DOUBLE:
-            return left < right.theDouble();
-        case bdld::Datum::e_INTEGER64:
-            return left < right.theInteger64();
-        default:
-            BSLS_ASSERT(right.type() == bdld::Datum::e_DECIMAL64);
-            return bdldfp::Decimal64(left) < right.theDecimal64();
+// Return the type by which the specified 'value' is ordered relative to
+// values of other types. All numeric types share a rank, so that, e.g., a
+// string cannot fall between an 'int' and a 'double' that compare by value.
+int typeRank(const bdld::Datum& value) {
+    return NumberUtil::isNumeric(value) ? bdld::Datum::e_INTEGER
+                                        : value.type();
+}
+
+// Return the three-way comparison of the elements of the specified ranges
+// '[left, leftEnd)' and '[right, rightEnd)' in lexicographical order, where
+// elements are compared using the specified 'compare'.
+template <typename Iterator, typename Compare>
+int compareRanges(Iterator       left,
+                  Iterator       leftEnd,
+                  Iterator       right,
+                  Iterator       rightEnd,
+                  const Compare& compare) {
+    for (; left != leftEnd && right != rightEnd; ++left, ++right) {
+        if (const int comparison = compare(*left, *right)) {
+            return comparison;
+        }
     }
+
+    return int(right == rightEnd) - int(left == leftEnd);
 }
 
-bool numericLessThanInt(const bdld::Datum& left, int right) {
-    switch (left.type()) {
-        case bdld::Datum::e_INTEGER:
-            return left.theInteger() < right;
-        case bdld::Datum::e_DOUBLE:
-            return left.theDouble() < right;
-        case bdld::Datum::e_INTEGER64:
-            return left.theInteger64() < right;
+// 'CompareEntries' compares map entries by key and then by value. This works
+// for both 'bdld::DatumMapEntry' and 'bdld::DatumIntMapEntry'.
+class CompareEntries {
+    const DatumUtil::LessThan* d_lessThan_p;
+
+  public:
+    explicit CompareEntries(const DatumUtil::LessThan& lessThan)
+    : d_lessThan_p(&lessThan) {
+    }
+
+    template <typename MapEntry>
+    int operator()(const MapEntry& left, const MapEntry& right) const {
+        if (const int comparison = compareValues(left.key(), right.key())) {
+            return comparison;
+        }
+        return d_lessThan_p->compare(left.value(), right.value());
+    }
+};
+
+// 'CompareElements' adapts 'DatumUtil::LessThan::compare' for use with
+// 'compareRanges'.
+class CompareElements {
+    const DatumUtil::LessThan* d_lessThan_p;
+
+  public:
+    explicit CompareElements(const DatumUtil::LessThan& lessThan)
+    : d_lessThan_p(&lessThan) {
+    }
+
+    int operator()(const bdld::Datum& left, const bdld::Datum& right) const {
+        return d_lessThan_p->compare(left, right);
+    }
+};
+
+// Return the three-way comparison of the list whose first pair is the
+// specified 'left' with the list whose first pair is the specified 'right' in
+// lexicographical order. An improper tail is compared as an element.
+int compareLists(bdld::Datum                left,
+                 bdld::Datum                right,
+                 const DatumUtil::LessThan& lessThan) {
+    for (;;) {
+        if (left.isNull() || right.isNull()) {
+            return int(!left.isNull()) - int(!right.isNull());
+        }
+        if (!Pair::isPair(left, lessThan.typeOffset()) ||
+            !Pair::isPair(right, lessThan.typeOffset())) {
+            return lessThan.compare(left, right);
+        }
+        if (left.theUdt().data() == right.theUdt().data()) {
+            // The rest of the lists are shared.
+            return 0;
+        }
+
+        const Pair& leftPair  = Pair::access(left);
+        const Pair& rightPair = Pair::access(right);
+        if (const int comparison =
+                lessThan.compare(leftPair.first, rightPair.first)) {
+            return comparison;
+        }
+
+        left  = leftPair.second;
+        right = rightPair.second;
+    }
+}
+
+// Return the three-way comparison of the elements visited by the specified
+// 'leftCursor' with those visited by the specified 'rightCursor' in
+// lexicographical order. This works for 'Set::Cursor', 'BTreeSet::Cursor',
+// and 'SetSequence::Cursor'.
+template <typename Cursor>
+int compareSets(Cursor                     leftCursor,
+                Cursor                     rightCursor,
+                const DatumUtil::LessThan& lessThan) {
+    for (; !leftCursor.done() && !rightCursor.done();
+         leftCursor.advance(), rightCursor.advance()) {
+        if (const int comparison =
+                lessThan.compare(leftCursor.value(), rightCursor.value())) {
+            return comparison;
+        }
+    }
+
+    return int(rightCursor.done()) - int(leftCursor.done());
+}
+
+// Return the three-way comparison of the specified int sets or int maps
+// 'left' and 'right' in lexicographical order of their keys and, for maps,
+// values.
+int compareIntTries(const IntTrie*             left,
+                    const IntTrie*             right,
+                    bool                       isMap,
+                    const DatumUtil::LessThan& lessThan) {
+    IntTrie::Cursor leftCursor(left);
+    IntTrie::Cursor rightCursor(right);
+    for (; !leftCursor.done() && !rightCursor.done();
+         leftCursor.advance(), rightCursor.advance()) {
+        if (const int comparison =
+                compareValues(leftCursor.key(), rightCursor.key())) {
+            return comparison;
+        }
+        if (!isMap) {
+            continue;
+        }
+        if (const int comparison = lessThan.compare(leftCursor.value(),
+                                                    rightCursor.value())) {
+            return comparison;
+        }
+    }
+
+    return int(rightCursor.done()) - int(leftCursor.done());
+}
+
+// 'CompareHashEntries' compares 'HashMap' entries by key and then, for maps,
+// by value.
+class CompareHashEntries {
+    const DatumUtil::LessThan* d_lessThan_p;
+    bool                       d_isMap;
+
+  public:
+    CompareHashEntries(const DatumUtil::LessThan& lessThan, bool isMap)
+    : d_lessThan_p(&lessThan)
+    , d_isMap(isMap) {
+    }
+
+    int operator()(const HashMap::Entry& left,
+                   const HashMap::Entry& right) const {
+        if (const int comparison =
+                d_lessThan_p->compare(left.key, right.key)) {
+            return comparison;
+        }
+        return d_isMap ? d_lessThan_p->compare(left.value, right.value) : 0;
+    }
+};
+
+// Return the number of consecutive entries, starting at the specified
+// 'cursor', that have the same hash as its current entry. Such entries share
+// a collision node, unless there is only one of them.
+bsl::size_t runLength(HashMap::Cursor cursor) {
+    const bsl::size_t hash   = cursor.entry().hash;
+    bsl::size_t       length = 0;
+    do {
+        ++length;
+        cursor.advance();
+    } while (!cursor.done() && cursor.entry().hash == hash);
+
+    return length;
+}
+
+// Return the entry whose key is least among those of the specified 'length'
+// entries starting at the specified 'cursor' that are greater than the key
+// of the specified optional 'floor', according to the specified 'lessThan'.
+const HashMap::Entry* nextInRun(HashMap::Cursor            cursor,
+                                bsl::size_t                length,
+                                const HashMap::Entry*      floor,
+                                const DatumUtil::LessThan& lessThan) {
+    const HashMap::Entry* least = 0;
+    for (; length; --length, cursor.advance()) {
+        const HashMap::Entry& entry = cursor.entry();
+        if (floor && lessThan.compare(entry.key, floor->key) <= 0) {
+            continue;
+        }
+        if (!least || lessThan.compare(entry.key, least->key) < 0) {
+            least = &entry;
+        }
+    }
+
+    return least;
+}
+
+// Return the three-way comparison of the runs of entries having the same
+// hash at the specified 'left' and 'right' cursors, which must refer to
+// entries having the same hash, and advance both cursors past their runs.
+// The order of entries within a collision node depends on the history of
+// the map, so the runs are compared by key as if sorted, which takes
+// quadratic time in their lengths, but no memory.
+int compareHashRuns(HashMap::Cursor*           left,
+                    HashMap::Cursor*           right,
+                    bool                       isMap,
+                    const DatumUtil::LessThan& lessThan) {
+    const bsl::size_t leftLength  = runLength(*left);
+    const bsl::size_t rightLength = runLength(*right);
+    const bsl::size_t length      = bsl::min(leftLength, rightLength);
+
+    const CompareHashEntries compareEntries(lessThan, isMap);
+    const HashMap::Entry*    leftEntry  = 0;
+    const HashMap::Entry*    rightEntry = 0;
+    for (bsl::size_t i = 0; i < length; ++i) {
+        leftEntry  = nextInRun(*left, leftLength, leftEntry, lessThan);
+        rightEntry = nextInRun(*right, rightLength, rightEntry, lessThan);
+        if (const int comparison = compareEntries(*leftEntry, *rightEntry)) {
+            return comparison;
+        }
+    }
+    if (const int comparison = compareValues(leftLength, rightLength)) {
+        return comparison;
+    }
+
+    for (bsl::size_t i = 0; i < length; ++i) {
+        left->advance();
+        right->advance();
+    }
+
+    return 0;
+}
+
+// Return the three-way comparison of the specified hash maps or hash sets
+// 'left' and 'right', first by their sizes, and then lexicographically by
+// their entries in the order that a 'HashMap::Cursor' visits them, comparing
+// entries by hash and then by key and value. Maps with the same keys have the
+// same shape, so the order of their entries differs only within collision
+// nodes, which are compared as if sorted. Ordering by structure rather than
+// by address keeps 'LessThan' consistent with 'equal', so that, e.g., equal
+// hash maps are the same element of a 'Set'. This takes linear time, barring
+// collisions, and allocates no memory.
+int compareHashMaps(const HashMap*             left,
+                    const HashMap*             right,
+                    bool                       isMap,
+                    const DatumUtil::LessThan& lessThan) {
+    if (left == right) {
+        return 0;
+    }
+    if (const int comparison =
+            compareValues(HashMap::size(left), HashMap::size(right))) {
+        return comparison;
+    }
+
+    HashMap::Cursor leftCursor(left);
+    HashMap::Cursor rightCursor(right);
+    while (!leftCursor.done() && !rightCursor.done()) {
+        if (const int comparison = compareValues(leftCursor.entry().hash,
+                                                 rightCursor.entry().hash)) {
+            return comparison;
+        }
+        if (const int comparison = compareHashRuns(
+                &leftCursor, &rightCursor, isMap, lessThan)) {
+            return comparison;
+        }
+    }
+
+    return int(rightCursor.done()) - int(leftCursor.done());
+}
+
+// Return the three-way comparison of the specified records 'left' and
+// 'right', first by their types' addresses, and then lexicographically by
+// their slots.
+int compareRecords(const Record&              left,
+                   const Record&              right,
+                   const DatumUtil::LessThan& lessThan) {
+    if (&left.type() != &right.type()) {
+        return compareValues(&left.type(), &right.type());
+    }
+
+    for (bsl::size_t i = 0; i < left.size(); ++i) {
+        if (const int comparison =
+                lessThan.compare(left.slots()[i], right.slots()[i])) {
+            return comparison;
+        }
+    }
+
+    return 0;
+}
+
+int compareUdts(const bdld::Datum&         left,
+                const bdld::Datum&         right,
+                const DatumUtil::LessThan& lessThan) {
+    const bdld::DatumUdt leftUdt  = left.theUdt();
+    const bdld::DatumUdt rightUdt = right.theUdt();
+    if (leftUdt.type() != rightUdt.type()) {
+        return compareValues(leftUdt.type(), rightUdt.type());
+    }
+    if (leftUdt.data() == rightUdt.data()) {
+        // 'left' and 'right' are the same object.
+        return 0;
+    }
+
+    switch (leftUdt.type() - lessThan.typeOffset()) {
+        case UserDefinedTypes::e_PAIR:
+            return compareLists(left, right, lessThan);
+        case UserDefinedTypes::e_SET:
+            return compareSets(Set::Cursor(Set::access(leftUdt)),
+                               Set::Cursor(Set::access(rightUdt)),
+                               lessThan);
+        case UserDefinedTypes::e_BTREE_SET:
+            return compareSets(BTreeSet::Cursor(BTreeSet::access(leftUdt)),
+                               BTreeSet::Cursor(BTreeSet::access(rightUdt)),
+                               lessThan);
+        case UserDefinedTypes::e_SET_SEQUENCE:
+            return compareSets(
+                SetSequence::Cursor(SetSequence::access(leftUdt)),
+                SetSequence::Cursor(SetSequence::access(rightUdt)),
+                lessThan);
+        case UserDefinedTypes::e_RRB_VECTOR:
+            return compareSets(
+                RrbVector::Cursor(RrbVector::access(leftUdt)),
+                RrbVector::Cursor(RrbVector::access(rightUdt)),
+                lessThan);
+        case UserDefinedTypes::e_DEQUE:
+            return compareSets(Deque::Cursor(Deque::access(leftUdt)),
+                               Deque::Cursor(Deque::access(rightUdt)),
+                               lessThan);
+        case UserDefinedTypes::e_PACKED_VECTOR:
+            return PackedVector::compare(PackedVector::access(leftUdt),
+                                         PackedVector::access(rightUdt));
+        case UserDefinedTypes::e_ROPE:
+            return Rope::compare(Rope::access(leftUdt),
+                                 Rope::access(rightUdt));
+        case UserDefinedTypes::e_RECORD:
+            return compareRecords(
+                Record::access(leftUdt), Record::access(rightUdt), lessThan);
+        case UserDefinedTypes::e_INT_SET:
+        case UserDefinedTypes::e_INT_MAP:
+            return compareIntTries(
+                IntTrie::access(leftUdt),
+                IntTrie::access(rightUdt),
+                leftUdt.type() - lessThan.typeOffset() ==
+                    UserDefinedTypes::e_INT_MAP,
+                lessThan);
+        case UserDefinedTypes::e_HASH_MAP:
+        case UserDefinedTypes::e_HASH_SET:
+            return compareHashMaps(
+                HashMap::access(leftUdt),
+                HashMap::access(rightUdt),
+                leftUdt.type() - lessThan.typeOffset() ==
+                    UserDefinedTypes::e_HASH_MAP,
+                lessThan);
+        case UserDefinedTypes::e_SYMBOL:
+            // TODO: by name? uh oh... what about bound symbols
+            // TODO: AUGH I SHOULD JUST UNDO THAT SPACE OPTIMIZATION
+        case UserDefinedTypes::e_PROCEDURE:
+        case UserDefinedTypes::e_NATIVE_PROCEDURE:
+        case UserDefinedTypes::e_BUILTIN:
+        case UserDefinedTypes::e_SET_TRANSIENT:
+        case UserDefinedTypes::e_HASH_TABLE:
+        case UserDefinedTypes::e_MUTABLE_VECTOR:
+        case UserDefinedTypes::e_QUASIQUOTE:
         default:
-            BSLS_ASSERT(right.type() == bdld::Datum::e_DECIMAL64);
-            return left.theDecimal64() < bdldfp::Decimal64(right);
+            // There's no value semantic related ordering, so just order the
+            // representations in memory.
+            return compareValues(leftUdt.data(), rightUdt.data());
     }
 }
 
-class LessThan {
-    int typeOffset;
+class Equal {
+    int d_typeOffset;
 
   public:
-    explicit LessThan(int typeOffset)
-    : typeOffset(typeOffset) {
+    explicit Equal(int typeOffset)
+    : d_typeOffset(typeOffset) {
     }
 
     bool operator()(const bdld::Datum& left, const bdld::Datum& right) const {
-        // The general rule is that 'left' and 'right' are compared first by
-        // their types, and if they have the same type then by their values.
-        // One special case is for comparisons between 'int' and a non-'int'
-        // numeric, e.g. between 'int' and 'double'. In that case, the 'int' is
-        // promoted to the other numeric type and then compared by value.
-        // TODO: Mixing decimal64 and double is a mistake waiting to happen...
-        //
-        // Note that since 'bdld::Datum::e_NIL' is the smallest
-        // 'bdld::Datum::DataType', empty lists and empty maps (null) are less
-        // than their non-empty counterparts, as expected.
-        if (left.isInteger() && isNumeric(right)) {
-            return intLessThanNumeric(left.theInteger(), right);
-        }
-        if (right.isInteger() && isNumeric(left)) {
-            return numericLessThanInt(left, right.theInteger());
-        }
-
-        if (left.type() < right.type()) {
-            return true;
+        if (NumberUtil::isNumeric(left) && NumberUtil::isNumeric(right)) {
+            return NumberUtil::equal(left, right);
         }
-        if (right.type() < left.type()) {
+
+        if (left.type() != right.type()) {
             return false;
         }
 
-        // 'left' and 'right' have the same type. Compare by value.
         switch (left.type()) {
-            case bdld::Datum::e_NIL:
-                return false;
-            case bdld::Datum::e_INTEGER:
-                return left.theInteger() < right.theInteger();
-            case bdld::Datum::e_DOUBLE:
-                return left.theDouble() < right.theDouble();
-            case bdld::Datum::e_STRING:
-                return left.theString() < right.theString();
-            case bdld::Datum::e_BOOLEAN:
-                return int(left.theBoolean()) < int(right.theBoolean());
-            case bdld::Datum::e_ERROR: {
-                const bdld::DatumError leftError  = left.theError();
-                const bdld::DatumError rightError = right.theError();
-                if (leftError.code() == rightError.code()) {
-                    return leftError.message() < rightError.message();
-                }
-                return leftError.code() < rightError.code();
-            }
-            case bdld::Datum::e_DATE:
-                return left.theDate() < right.theDate();
-            case bdld::Datum::e_TIME:
-                return left.theTime() < right.theTime();
-            case bdld::Datum::e_DATETIME:
-                return left.theDatetime() < right.theDatetime();
-            case bdld::Datum::e_DATETIME_INTERVAL:
-                return left.theDatetimeInterval() <
-                       right.theDatetimeInterval();
-            case bdld::Datum::e_INTEGER64:
-                return left.theInteger64() < right.theInteger64();
-            case bdld::Datum::e_USERDEFINED: {
-                const bdld::DatumUdt leftUdt  = left.theUdt();
-                const bdld::DatumUdt rightUdt = right.theUdt();
-                if (leftUdt.type() != rightUdt.type()) {
-                    return leftUdt.type() < rightUdt.type();
-                }
-
-                switch (leftUdt.type() - typeOffset) {
-                    case UserDefinedTypes::e_PAIR:
-                        return ListUtil::lessThan(left, right, *this);
-                    case UserDefinedTypes::e_SET:
-                        // TODO: walky walky
-                    case UserDefinedTypes::e_SYMBOL:
-                        // TODO: by name? uh oh... what about bound symbols
-                        // TODO: AUGH I SHOULD JUST UNDO THAT SPACE
-                        // OPTIMIZATION
-                    case UserDefinedTypes::e_PROCEDURE:
-                    case UserDefinedTypes::e_NATIVE_PROCEDURE:
-                    case UserDefinedTypes::e_BUILTIN:
-                    default:
-                        // There's no value semantic related ordering, so just
-                        // order the representations in memory.
-                        return leftUdt.data() < rightUdt.data();
-                }
+            case bdld::Datum::e_STRING: {
+                const bsl::string_view leftString  = left.theString();
+                const bsl::string_view rightString = right.theString();
+                return leftString.size() == rightString.size() &&
+                       (leftString.data() == rightString.data() ||
+                        leftString == rightString);
             }
+            case bdld::Datum::e_USERDEFINED:
+                return udtEqual(left, right);
             case bdld::Datum::e_ARRAY: {
                 const bdld::DatumArrayRef leftArray  = left.theArray();
                 const bdld::DatumArrayRef rightArray = right.theArray();
+                if (leftArray.length() != rightArray.length()) {
+                    return false;
+                }
+                if (leftArray.data() == rightArray.data()) {
+                    return true;
+                }
 
-                return bsl::lexicographical_compare(
-                    leftArray.data(),
-                    leftArray.data() + leftArray.length(),
-                    rightArray.data(),
-                    rightArray.data() + rightArray.length(),
-                    *this);
+                return bsl::equal(leftArray.data(),
+                                  leftArray.data() + leftArray.length(),
+                                  rightArray.data(),
+                                  *this);
             }
             case bdld::Datum::e_MAP: {
                 const bdld::DatumMapRef leftMap  = left.theMap();
                 const bdld::DatumMapRef rightMap = right.theMap();
-
-                return bsl::lexicographical_compare(
-                    leftMap.data(),
-                    leftMap.data() + leftMap.size(),
-                    rightMap.data(),
-                    rightMap.data() + rightMap.size(),
-                    *this);
-            }
-            case bdld::Datum::e_BINARY: {
-                const bdld::DatumBinaryRef leftBinary  = left.theBinary();
-                const bdld::DatumBinaryRef rightBinary = right.theBinary();
-                bsl::size_t                shorter =
-                    bsl::min(leftBinary.size(), rightBinary.size());
-                const int comparison = bsl::memcmp(
-                    leftBinary.data(), rightBinary.data(), shorter);
-                if (comparison < 0) {
-                    return true;
-                }
-                if (comparison > 0) {
+                if (leftMap.size() != rightMap.size()) {
                     return false;
                 }
-                return leftBinary.size() < shorter;
+                if (leftMap.data() == rightMap.data()) {
+                    return true;
+                }
+
+                return bsl::equal(leftMap.data(),
+                                  leftMap.data() + leftMap.size(),
+                                  rightMap.data(),
+                                  *this);
             }
-            case bdld::Datum::e_DECIMAL64:
-                return left.theDecimal64() < right.theDecimal64();
-            default: {
-                BSLS_ASSERT_OPT(left.type() == bdld::Datum::e_INT_MAP);
+            case bdld::Datum::e_INT_MAP: {
                 const bdld::DatumIntMapRef leftMap  = left.theIntMap();
                 const bdld::DatumIntMapRef rightMap = right.theIntMap();
+                if (leftMap.size() != rightMap.size()) {
+                    return false;
+                }
+                if (leftMap.data() == rightMap.data()) {
+                    return true;
+                }
 
-                return bsl::lexicographical_compare(
-                    leftMap.data(),
-                    leftMap.data() + leftMap.size(),
-                    rightMap.data(),
-                    rightMap.data() + rightMap.size(),
-                    *this);
+                return bsl::equal(leftMap.data(),
+                                  leftMap.data() + leftMap.size(),
+                                  rightMap.data(),
+                                  *this);
             }
+            default:
+                // The remaining types are values without nested 'Datum's, so
+                // the equality operator of 'bdld::Datum' does what we want.
+                return left == right;
         }
     }
 
     // This works for both 'bdld::DatumMapEntry' and 'bdld::DatumIntMapEntry'.
     template <typename MapEntry>
     bool operator()(const MapEntry& left, const MapEntry& right) const {
-        if (left.key() < right.key()) {
+        return left.key() == right.key() &&
+               (*this)(left.value(), right.value());
+    }
+
+  private:
+    bool udtEqual(const bdld::Datum& left, const bdld::Datum& right) const {
+        const bdld::DatumUdt leftUdt  = left.theUdt();
+        const bdld::DatumUdt rightUdt = right.theUdt();
+        if (leftUdt.type() != rightUdt.type()) {
+            return false;
+        }
+        if (leftUdt.data() == rightUdt.data()) {
+            // 'left' and 'right' are the same object.
             return true;
         }
-        if (right.key() < left.key()) {
+
+        switch (leftUdt.type() - d_typeOffset) {
+            case UserDefinedTypes::e_PAIR:
+                return listEqual(left, right);
+            case UserDefinedTypes::e_SET:
+                return setEqual(Set::Cursor(Set::access(leftUdt)),
+                                Set::Cursor(Set::access(rightUdt)));
+            case UserDefinedTypes::e_BTREE_SET:
+                return setEqual(BTreeSet::Cursor(BTreeSet::access(leftUdt)),
+                                BTreeSet::Cursor(BTreeSet::access(rightUdt)));
+            case UserDefinedTypes::e_SET_SEQUENCE:
+                return setEqual(
+                    SetSequence::Cursor(SetSequence::access(leftUdt)),
+                    SetSequence::Cursor(SetSequence::access(rightUdt)));
+            case UserDefinedTypes::e_RRB_VECTOR:
+                return RrbVector::size(RrbVector::access(leftUdt)) ==
+                           RrbVector::size(RrbVector::access(rightUdt)) &&
+                       setEqual(
+                           RrbVector::Cursor(RrbVector::access(leftUdt)),
+                           RrbVector::Cursor(RrbVector::access(rightUdt)));
+            case UserDefinedTypes::e_DEQUE:
+                return Deque::size(Deque::access(leftUdt)) ==
+                           Deque::size(Deque::access(rightUdt)) &&
+                       setEqual(Deque::Cursor(Deque::access(leftUdt)),
+                                Deque::Cursor(Deque::access(rightUdt)));
+            case UserDefinedTypes::e_PACKED_VECTOR:
+                return PackedVector::equal(PackedVector::access(leftUdt),
+                                           PackedVector::access(rightUdt));
+            case UserDefinedTypes::e_ROPE:
+                return Rope::length(Rope::access(leftUdt)) ==
+                           Rope::length(Rope::access(rightUdt)) &&
+                       Rope::compare(Rope::access(leftUdt),
+                                     Rope::access(rightUdt)) == 0;
+            case UserDefinedTypes::e_RECORD:
+                return recordEqual(Record::access(leftUdt),
+                                   Record::access(rightUdt));
+            case UserDefinedTypes::e_SYMBOL:
+                return SymbolUtil::name(leftUdt) == SymbolUtil::name(rightUdt);
+            case UserDefinedTypes::e_HASH_MAP:
+            case UserDefinedTypes::e_HASH_SET:
+                return HashMap::equal(HashMap::access(leftUdt),
+                                      HashMap::access(rightUdt),
+                                      d_typeOffset);
+            case UserDefinedTypes::e_INT_SET:
+            case UserDefinedTypes::e_INT_MAP:
+                return IntTrie::equal(IntTrie::access(leftUdt),
+                                      IntTrie::access(rightUdt),
+                                      d_typeOffset);
+            case UserDefinedTypes::e_PROCEDURE:
+            case UserDefinedTypes::e_NATIVE_PROCEDURE:
+            case UserDefinedTypes::e_BUILTIN:
+            case UserDefinedTypes::e_SET_TRANSIENT:
+            case UserDefinedTypes::e_HASH_TABLE:
+            case UserDefinedTypes::e_MUTABLE_VECTOR:
+            case UserDefinedTypes::e_QUASIQUOTE:
+            default:
+                // There's no value semantic related equality, so only an
+                // object is equal to itself, which we checked above.
+                return false;
+        }
+    }
+
+    // Return whether the specified records 'left' and 'right' have the same
+    // type and equal slots.
+    bool recordEqual(const Record& left, const Record& right) const {
+        if (&left.type() != &right.type()) {
             return false;
         }
-        return (*this)(left.value(), right.value());
+
+        for (bsl::size_t i = 0; i < left.size(); ++i) {
+            if (!(*this)(left.slots()[i], right.slots()[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Return whether the list whose first pair is the specified 'left' has
+    // the same elements as the list whose first pair is the specified
+    // 'right'. Walk the lists iteratively, so that long lists do not exhaust
+    // the stack, and stop early if the lists share a tail.
+    bool listEqual(bdld::Datum left, bdld::Datum right) const {
+        for (;;) {
+            const Pair& leftPair  = Pair::access(left);
+            const Pair& rightPair = Pair::access(right);
+            if (!(*this)(leftPair.first, rightPair.first)) {
+                return false;
+            }
+
+            left  = leftPair.second;
+            right = rightPair.second;
+            if (!Pair::isPair(left, d_typeOffset) ||
+                !Pair::isPair(right, d_typeOffset)) {
+                return (*this)(left, right);
+            }
+            if (left.theUdt().data() == right.theUdt().data()) {
+                // The rest of the lists are shared.
+                return true;
+            }
+        }
+    }
+
+    // Return whether the specified 'leftCursor' and 'rightCursor' visit the
+    // same elements. Note that sets having the same elements need not have
+    // the same shape, so the trees are compared by walking them in order.
+    // This works for 'Set::Cursor', 'BTreeSet::Cursor', and
+    // 'SetSequence::Cursor'.
+    template <typename Cursor>
+    bool setEqual(Cursor leftCursor, Cursor rightCursor) const {
+        for (; !leftCursor.done() && !rightCursor.done();
+             leftCursor.advance(), rightCursor.advance()) {
+            if (!(*this)(leftCursor.value(), rightCursor.value())) {
+                return false;
+            }
+        }
+
+        return leftCursor.done() && rightCursor.done();
+    }
+};
+
+typedef bsls::Types::Uint64 Uint64;
+
+// Return a well-mixed function of the specified 'value'. This is the
+// finalizer of "splitmix64."
+Uint64 mix(Uint64 value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+// Return a hash of the specified 'value' following the specified 'seed', so
+// that the order of combination matters.
+Uint64 combine(Uint64 seed, Uint64 value) {
+    return mix(seed * 0x9e3779b97f4a7c15ULL + value);
+}
+
+Uint64 hashBytes(Uint64 seed, const void* data, bsl::size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    Uint64      hash  = combine(seed, size);
+    for (; size >= sizeof(Uint64); size -= sizeof(Uint64)) {
+        Uint64 word;
+        bsl::memcpy(&word, bytes, sizeof word);
+        hash = combine(hash, word);
+        bytes += sizeof word;
+    }
+    if (size) {
+        Uint64 word = 0;
+        bsl::memcpy(&word, bytes, size);
+        hash = combine(hash, word);
+    }
+    return hash;
+}
+
+class Hash {
+    int d_typeOffset;
+
+  public:
+    explicit Hash(int typeOffset)
+    : d_typeOffset(typeOffset) {
+    }
+
+    // Each type of value begins with a different 'seed', so that, e.g., the
+    // string "" and the empty list do not collide. All numeric types share a
+    // seed, since equal numbers must have the same hash.
+    Uint64 operator()(const bdld::Datum& value) const {
+        const Uint64 seed = value.type();
+
+        switch (value.type()) {
+            case bdld::Datum::e_INTEGER:
+            case bdld::Datum::e_DOUBLE:
+            case bdld::Datum::e_INTEGER64:
+            case bdld::Datum::e_DECIMAL64: {
+                double number = NumberUtil::toDouble(value);
+                if (number == 0) {
+                    number = 0;  // negative zero is zero
+                }
+                else if (number != number) {
+                    number = bsl::numeric_limits<double>::quiet_NaN();
+                }
+                Uint64 bits;
+                bsl::memcpy(&bits, &number, sizeof bits);
+                return combine(bdld::Datum::e_DOUBLE, bits);
+            }
+            case bdld::Datum::e_STRING: {
+                const bsl::string_view string = value.theString();
+                return hashBytes(seed, string.data(), string.size());
+            }
+            case bdld::Datum::e_BOOLEAN:
+                return combine(seed, value.theBoolean());
+            case bdld::Datum::e_ERROR: {
+                const bdld::DatumError error   = value.theError();
+                const bsl::string_view message = error.message();
+                return hashBytes(combine(seed, error.code()),
+                                 message.data(),
+                                 message.size());
+            }
+            case bdld::Datum::e_DATE:
+                return combine(seed, hashDate(value.theDate()));
+            case bdld::Datum::e_TIME:
+                return combine(seed, hashTime(value.theTime()));
+            case bdld::Datum::e_DATETIME: {
+                const bdlt::Datetime datetime = value.theDatetime();
+                return combine(combine(seed, hashDate(datetime.date())),
+                               hashTime(datetime.time()));
+            }
+            case bdld::Datum::e_DATETIME_INTERVAL:
+                return combine(
+                    seed, value.theDatetimeInterval().totalMicroseconds());
+            case bdld::Datum::e_USERDEFINED:
+                return hashUdt(value);
+            case bdld::Datum::e_ARRAY: {
+                const bdld::DatumArrayRef array = value.theArray();
+                Uint64 hash = combine(seed, array.length());
+                for (bsl::size_t i = 0; i < array.length(); ++i) {
+                    hash = combine(hash, (*this)(array[i]));
+                }
+                return hash;
+            }
+            case bdld::Datum::e_MAP: {
+                const bdld::DatumMapRef map  = value.theMap();
+                Uint64                  hash = combine(seed, map.size());
+                for (bsl::size_t i = 0; i < map.size(); ++i) {
+                    const bsl::string_view key = map[i].key();
+                    hash = hashBytes(hash, key.data(), key.size());
+                    hash = combine(hash, (*this)(map[i].value()));
+                }
+                return hash;
+            }
+            case bdld::Datum::e_BINARY: {
+                const bdld::DatumBinaryRef binary = value.theBinary();
+                return hashBytes(seed, binary.data(), binary.size());
+            }
+            case bdld::Datum::e_INT_MAP: {
+                const bdld::DatumIntMapRef map  = value.theIntMap();
+                Uint64                     hash = combine(seed, map.size());
+                for (bsl::size_t i = 0; i < map.size(); ++i) {
+                    hash = combine(hash, map[i].key());
+                    hash = combine(hash, (*this)(map[i].value()));
+                }
+                return hash;
+            }
+            default:
+                BSLS_ASSERT(value.type() == bdld::Datum::e_NIL);
+                return seed;
+        }
+    }
+
+  private:
+    static Uint64 hashDate(const bdlt::Date& date) {
+        return (Uint64(date.year()) << 9) | (date.month() << 5) | date.day();
+    }
+
+    static Uint64 hashTime(const bdlt::Time& time) {
+        return ((((Uint64(time.hour()) * 60 + time.minute()) * 60 +
+                  time.second()) *
+                     1000 +
+                 time.millisecond()) *
+                1000) +
+               time.microsecond();
+    }
+
+    // Return a hash of the elements visited by the specified 'cursor',
+    // beginning with the specified 'seed'. This works for 'Set::Cursor',
+    // 'BTreeSet::Cursor', and 'SetSequence::Cursor'.
+    template <typename Cursor>
+    Uint64 hashSet(Uint64 seed, Cursor cursor) const {
+        for (; !cursor.done(); cursor.advance()) {
+            seed = combine(seed, (*this)(cursor.value()));
+        }
+        return seed;
+    }
+
+    // Return a hash of the keys and, if the specified 'isMap' is 'true',
+    // the values of the specified 'trie', beginning with the specified
+    // 'seed'.
+    Uint64 hashIntTrie(Uint64 seed, const IntTrie* trie, bool isMap) const {
+        for (IntTrie::Cursor cursor(trie); !cursor.done(); cursor.advance()) {
+            seed = combine(seed, Uint64(cursor.key()));
+            if (isMap) {
+                seed = combine(seed, (*this)(cursor.value()));
+            }
+        }
+        return seed;
+    }
+
+    // Return a hash of the element type and elements of the specified
+    // 'vector', beginning with the specified 'seed'. Packed vectors are equal
+    // only to packed vectors of the same element type, so the elements are
+    // hashed as they are stored rather than as in 'operator()'.
+    static Uint64 hashPackedVector(Uint64 seed, const PackedVector& vector) {
+        seed = combine(seed, vector.type());
+        switch (vector.type()) {
+            case PackedVector::e_INT32: {
+                const int* elements = vector.elements<int>();
+                for (bsl::size_t i = 0; i < vector.length(); ++i) {
+                    seed = combine(seed, Uint64(elements[i]));
+                }
+                return seed;
+            }
+            case PackedVector::e_INT64: {
+                const bsls::Types::Int64* elements =
+                    vector.elements<bsls::Types::Int64>();
+                for (bsl::size_t i = 0; i < vector.length(); ++i) {
+                    seed = combine(seed, Uint64(elements[i]));
+                }
+                return seed;
+            }
+            default: {
+                BSLS_ASSERT(vector.type() == PackedVector::e_DOUBLE);
+                const double* elements = vector.elements<double>();
+                for (bsl::size_t i = 0; i < vector.length(); ++i) {
+                    double number = elements[i];
+                    if (number == 0) {
+                        number = 0;  // negative zero is zero
+                    }
+                    Uint64 bits;
+                    bsl::memcpy(&bits, &number, sizeof bits);
+                    seed = combine(seed, bits);
+                }
+                return seed;
+            }
+        }
+    }
+
+    // Return a hash of the characters of the specified 'rope', beginning
+    // with the specified 'seed'. The characters are hashed as 'hashBytes'
+    // would hash them if they were contiguous.
+    static Uint64 hashRope(Uint64 seed, const Rope* rope) {
+        Uint64      hash = combine(seed, Rope::length(rope));
+        Uint64      word = 0;
+        bsl::size_t used = 0;  // bytes of 'word' filled so far
+        for (Rope::Cursor cursor(rope); !cursor.done(); cursor.advance()) {
+            const bsl::string_view& chunk = cursor.chunk();
+            for (bsl::size_t i = 0; i < chunk.size();) {
+                const bsl::size_t count =
+                    bsl::min(chunk.size() - i, sizeof word - used);
+                bsl::memcpy(reinterpret_cast<char*>(&word) + used,
+                            chunk.data() + i,
+                            count);
+                i += count;
+                used += count;
+                if (used == sizeof word) {
+                    hash = combine(hash, word);
+                    word = 0;
+                    used = 0;
+                }
+            }
+        }
+        if (used) {
+            hash = combine(hash, word);
+        }
+        return hash;
+    }
+
+    Uint64 hashUdt(const bdld::Datum& value) const {
+        const bdld::DatumUdt udt  = value.theUdt();
+        const Uint64         seed = combine(bdld::Datum::e_USERDEFINED,
+                                    udt.type());
+
+        switch (udt.type() - d_typeOffset) {
+            case UserDefinedTypes::e_PAIR: {
+                // Hash iteratively along the list, as in 'Equal::listEqual'.
+                Uint64      hash = seed;
+                bdld::Datum list = value;
+                do {
+                    const Pair& pair = Pair::access(list);
+                    hash             = combine(hash, (*this)(pair.first));
+                    list             = pair.second;
+                } while (Pair::isPair(list, d_typeOffset));
+                return combine(hash, (*this)(list));
+            }
+            case UserDefinedTypes::e_SET:
+                return hashSet(seed, Set::Cursor(Set::access(udt)));
+            case UserDefinedTypes::e_BTREE_SET:
+                return hashSet(seed,
+                               BTreeSet::Cursor(BTreeSet::access(udt)));
+            case UserDefinedTypes::e_SET_SEQUENCE:
+                return hashSet(
+                    seed, SetSequence::Cursor(SetSequence::access(udt)));
+            case UserDefinedTypes::e_RRB_VECTOR:
+                return hashSet(seed,
+                               RrbVector::Cursor(RrbVector::access(udt)));
+            case UserDefinedTypes::e_DEQUE:
+                return hashSet(seed, Deque::Cursor(Deque::access(udt)));
+            case UserDefinedTypes::e_PACKED_VECTOR:
+                return hashPackedVector(seed, PackedVector::access(udt));
+            case UserDefinedTypes::e_ROPE:
+                return hashRope(seed, Rope::access(udt));
+            case UserDefinedTypes::e_RECORD: {
+                // Records are equal only to records of the same type.
+                const Record& record = Record::access(udt);
+                Uint64        hash   = combine(
+                    seed,
+                    reinterpret_cast<bsls::Types::UintPtr>(&record.type()));
+                for (bsl::size_t i = 0; i < record.size(); ++i) {
+                    hash = combine(hash, (*this)(record.slots()[i]));
+                }
+                return hash;
+            }
+            case UserDefinedTypes::e_SYMBOL: {
+                const bsl::string_view name =
+                    SymbolUtil::name(udt).theString();
+                return hashBytes(seed, name.data(), name.size());
+            }
+            case UserDefinedTypes::e_HASH_MAP:
+            case UserDefinedTypes::e_HASH_SET:
+                return combine(
+                    seed, HashMap::hash(HashMap::access(udt), d_typeOffset));
+            case UserDefinedTypes::e_INT_SET:
+                return hashIntTrie(seed, IntTrie::access(udt), false);
+            case UserDefinedTypes::e_INT_MAP:
+                return hashIntTrie(seed, IntTrie::access(udt), true);
+            default:
+                // Other user-defined types are equal only to themselves.
+                return combine(seed,
+                               reinterpret_cast<bsls::Types::UintPtr>(
+                                   udt.data()));
+        }
     }
 };
 
 }  // namespace
 
+int DatumUtil::LessThan::compare(const bdld::Datum& left,
+                                 const bdld::Datum& right) const {
+    // The general rule is that 'left' and 'right' are compared first by their
+    // types, and if they have the same type then by their values. The
+    // exception is numbers, which are compared exactly by value regardless of
+    // their types (see 'NumberUtil::compare'), and which are ordered as one
+    // type relative to everything else.
+    //
+    // Note that since 'bdld::Datum::e_NIL' is the smallest
+    // 'bdld::Datum::DataType', empty lists and empty maps (null) are less
+    // than their non-empty counterparts, as expected.
+    const int leftRank  = typeRank(left);
+    const int rightRank = typeRank(right);
+    if (leftRank != rightRank) {
+        return compareValues(leftRank, rightRank);
+    }
+    if (leftRank == bdld::Datum::e_INTEGER) {
+        return NumberUtil::compare(left, right);
+    }
+
+    // 'left' and 'right' have the same type. Compare by value.
+    switch (left.type()) {
+        case bdld::Datum::e_NIL:
+            return 0;
+        case bdld::Datum::e_STRING: {
+            const bsl::string_view leftString  = left.theString();
+            const bsl::string_view rightString = right.theString();
+            if (leftString.data() == rightString.data() &&
+                leftString.size() == rightString.size()) {
+                return 0;
+            }
+            return leftString.compare(rightString);
+        }
+        case bdld::Datum::e_BOOLEAN:
+            return compareValues(int(left.theBoolean()),
+                                 int(right.theBoolean()));
+        case bdld::Datum::e_ERROR: {
+            const bdld::DatumError leftError  = left.theError();
+            const bdld::DatumError rightError = right.theError();
+            if (leftError.code() != rightError.code()) {
+                return compareValues(leftError.code(), rightError.code());
+            }
+            return leftError.message().compare(rightError.message());
+        }
+        case bdld::Datum::e_DATE:
+            return compareValues(left.theDate(), right.theDate());
+        case bdld::Datum::e_TIME:
+            return compareValues(left.theTime(), right.theTime());
+        case bdld::Datum::e_DATETIME:
+            return compareValues(left.theDatetime(), right.theDatetime());
+        case bdld::Datum::e_DATETIME_INTERVAL:
+            return compareValues(left.theDatetimeInterval(),
+                                 right.theDatetimeInterval());
+        case bdld::Datum::e_USERDEFINED:
+            return compareUdts(left, right, *this);
+        case bdld::Datum::e_ARRAY: {
+            const bdld::DatumArrayRef leftArray  = left.theArray();
+            const bdld::DatumArrayRef rightArray = right.theArray();
+            if (leftArray.data() == rightArray.data() &&
+                leftArray.length() == rightArray.length()) {
+                return 0;
+            }
+
+            return compareRanges(leftArray.data(),
+                                 leftArray.data() + leftArray.length(),
+                                 rightArray.data(),
+                                 rightArray.data() + rightArray.length(),
+                                 CompareElements(*this));
+        }
+        case bdld::Datum::e_MAP: {
+            const bdld::DatumMapRef leftMap  = left.theMap();
+            const bdld::DatumMapRef rightMap = right.theMap();
+            if (leftMap.data() == rightMap.data() &&
+                leftMap.size() == rightMap.size()) {
+                return 0;
+            }
+
+            return compareRanges(leftMap.data(),
+                                 leftMap.data() + leftMap.size(),
+                                 rightMap.data(),
+                                 rightMap.data() + rightMap.size(),
+                                 CompareEntries(*this));
+        }
+        case bdld::Datum::e_BINARY: {
+            const bdld::DatumBinaryRef leftBinary  = left.theBinary();
+            const bdld::DatumBinaryRef rightBinary = right.theBinary();
+            const bsl::size_t          shorter =
+                bsl::min(leftBinary.size(), rightBinary.size());
+            if (const int comparison = bsl::memcmp(
+                    leftBinary.data(), rightBinary.data(), shorter)) {
+                return comparison;
+            }
+            return compareValues(leftBinary.size(), rightBinary.size());
+        }
+        default: {
+            BSLS_ASSERT_OPT(left.type() == bdld::Datum::e_INT_MAP);
+            const bdld::DatumIntMapRef leftMap  = left.theIntMap();
+            const bdld::DatumIntMapRef rightMap = right.theIntMap();
+
+            return compareRanges(leftMap.data(),
+                                 leftMap.data() + leftMap.size(),
+                                 rightMap.data(),
+                                 rightMap.data() + rightMap.size(),
+                                 CompareEntries(*this));
+        }
+    }
+}
+
 DatumUtil::Comparator DatumUtil::lessThanComparator(int typeOffset) {
     return LessThan(typeOffset);
 }
 
+bool DatumUtil::equal(const bdld::Datum& left,
+                      const bdld::Datum& right,
+                      int                typeOffset) {
+    return Equal(typeOffset)(left, right);
+}
+
+bsl::size_t DatumUtil::hash(const bdld::Datum& value, int typeOffset) {
+    return Hash(typeOffset)(value);
+}
+
 }  // namespace lspcore
@@ -1,6 +1,7 @@
 #ifndef INCLUDED_LSPCORE_DATUMUTIL
 #define INCLUDED_LSPCORE_DATUMUTIL
 
+#include <bsl_cstddef.h>
 #include <bsl_functional.h>
 
 namespace BloombergLP {
@@ -13,12 +14,70 @@ namespace lspcore {
 namespace bdld = BloombergLP::bdld;
 
 struct DatumUtil {
+    // 'LessThan' is a total order on 'bdld::Datum' values, where user-defined
+    // types are identified relative to a 'typeOffset'. Values are ordered
+    // first by type and then by value, except that all numbers are ordered
+    // together by value, as by 'NumberUtil::compare'. Lists, sets, arrays,
+    // and maps are ordered lexicographically by their elements. Hash maps
+    // and hash sets are ordered by size and then by their entries in trie
+    // order, so that values that are 'equal' are equivalent.
+    class LessThan {
+        int d_typeOffset;
+
+      public:
+        explicit LessThan(int typeOffset);
+
+        bool operator()(const bdld::Datum& left,
+                        const bdld::Datum& right) const;
+
+        // Return a negative number if the specified 'left' is before the
+        // specified 'right', a positive number if 'left' is after 'right',
+        // or zero if they are equivalent. This costs the same as one call to
+        // 'operator()'.
+        int compare(const bdld::Datum& left, const bdld::Datum& right) const;
+
+        int typeOffset() const;
+    };
+
     typedef bsl::function<bool(const bdld::Datum&, const bdld::Datum&)>
         Comparator;
 
+    // Return a type-erased 'LessThan'. Prefer 'LessThan' itself where the
+    // type of the comparator can be a template parameter.
     static Comparator lessThanComparator(int typeOffset);
+
+    // Return whether the specified 'left' and 'right' are structurally
+    // equal, where user-defined types are identified relative to the
+    // specified 'typeOffset'. Numbers are equal if they have the same value,
+    // regardless of their types. Lists, sets, arrays, and maps are equal if
+    // their elements are equal. Symbols are equal if they have the same name.
+    // Procedures and other user-defined types are equal only to themselves.
+    // Values that share a representation are equal without their contents
+    // being examined, e.g. two references to the same list, or two lists
+    // sharing a tail once the tail is reached.
+    static bool equal(const bdld::Datum& left,
+                      const bdld::Datum& right,
+                      int                typeOffset);
+
+    // Return a hash of the specified 'value', where user-defined types are
+    // identified relative to the specified 'typeOffset'. Values that are
+    // 'equal' have the same hash.
+    static bsl::size_t hash(const bdld::Datum& value, int typeOffset);
 };
 
+inline DatumUtil::LessThan::LessThan(int typeOffset)
+: d_typeOffset(typeOffset) {
+}
+
+inline bool DatumUtil::LessThan::operator()(const bdld::Datum& left,
+                                            const bdld::Datum& right) const {
+    return compare(left, right) < 0;
+}
+
+inline int DatumUtil::LessThan::typeOffset() const {
+    return d_typeOffset;
+}
+
 }  // namespace lspcore
 
 #endif
@@ -0,0 +1,754 @@
+#include <bsl_new.h>
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+#include <lspcore_deque.h>
+#include <lspcore_userdefinedtypes.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+struct Deque::Node {
+    bsl::size_t size;   // number of values, at depth zero
+    int         count;  // two or three
+    bdld::Datum elements[3];
+};
+
+Deque::Deque()
+: d_size(0)
+, d_middle(0)
+, d_prefixCount(0)
+, d_suffixCount(0) {
+}
+
+// Depths and Digits
+// =================
+// Every function below takes the 'depth' of the tree or elements it works
+// on, which determines whether an element is a value or a 'Node'. A
+// "digit" is a prefix or suffix, given as a pointer to its first element and
+// a count. The functions named after Hinze and Paterson's 'deepL' and 'deepR'
+// build a deep tree whose prefix or suffix, respectively, might be empty, by
+// borrowing a node from the middle tree or, if the middle is empty, by
+// rebuilding the tree from the other digit.
+//
+// Every function takes and returns null pointers for empty trees.
+class DequeImpl {
+  public:
+    typedef Deque::Node Node;
+
+    enum { k_MAX_DIGIT = Deque::k_MAX_DIGIT };
+
+    static bdld::Datum fromNode(const Node* node) {
+        return bdld::Datum::createUdt(
+            const_cast<void*>(static_cast<const void*>(node)), 0);
+    }
+
+    static const Node* toNode(const bdld::Datum& element) {
+        return static_cast<const Node*>(element.theUdt().data());
+    }
+
+    static bool isSingle(const Deque& tree) {
+        return tree.d_suffixCount == 0;
+    }
+
+    static bsl::size_t size(const bdld::Datum& element, int depth) {
+        return depth ? toNode(element)->size : 1;
+    }
+
+    static bsl::size_t size(const bdld::Datum* elements,
+                            int                count,
+                            int                depth) {
+        if (depth == 0) {
+            return count;
+        }
+
+        bsl::size_t sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += toNode(elements[i])->size;
+        }
+        return sum;
+    }
+
+    // Return the position of the element among the specified 'elements' that
+    // contains the specified 'index', and subtract from 'index' the number
+    // of values in the elements to its left.
+    static int find(const bdld::Datum* elements,
+                    int                count,
+                    int                depth,
+                    bsl::size_t*       index) {
+        int position = 0;
+        for (;;) {
+            const bsl::size_t elementSize = size(elements[position], depth);
+            if (*index < elementSize) {
+                return position;
+            }
+            *index -= elementSize;
+            ++position;
+            BSLS_ASSERT(position < count);
+        }
+    }
+
+    static bdld::Datum makeNode(const bdld::Datum* elements,
+                                int                count,
+                                int                depth,
+                                bslma::Allocator*  allocator) {
+        BSLS_ASSERT(count == 2 || count == 3);
+
+        Node* node  = new (*allocator) Node;
+        node->size  = size(elements, count, depth);
+        node->count = count;
+        for (int i = 0; i < count; ++i) {
+            node->elements[i] = elements[i];
+        }
+        return fromNode(node);
+    }
+
+    static const Deque* makeDeep(const bdld::Datum* prefix,
+                                 int                prefixCount,
+                                 const Deque*       middle,
+                                 const bdld::Datum* suffix,
+                                 int                suffixCount,
+                                 int                depth,
+                                 bslma::Allocator*  allocator) {
+        BSLS_ASSERT(0 < prefixCount && prefixCount <= k_MAX_DIGIT);
+        BSLS_ASSERT(0 <= suffixCount && suffixCount <= k_MAX_DIGIT);
+        BSLS_ASSERT(suffixCount || (prefixCount == 1 && !middle));
+
+        Deque* tree         = new (*allocator) Deque;
+        tree->d_size        = size(prefix, prefixCount, depth) +
+                       Deque::size(middle) +
+                       size(suffix, suffixCount, depth);
+        tree->d_middle      = middle;
+        tree->d_prefixCount = prefixCount;
+        tree->d_suffixCount = suffixCount;
+        for (int i = 0; i < prefixCount; ++i) {
+            tree->d_prefix[i] = prefix[i];
+        }
+        for (int i = 0; i < suffixCount; ++i) {
+            tree->d_suffix[i] = suffix[i];
+        }
+        return tree;
+    }
+
+    static const Deque* makeSingle(const bdld::Datum& element,
+                                   int                depth,
+                                   bslma::Allocator*  allocator) {
+        return makeDeep(&element, 1, 0, 0, 0, depth, allocator);
+    }
+
+    // Return a tree of the specified zero to four 'elements'.
+    static const Deque* fromDigit(const bdld::Datum* elements,
+                                  int                count,
+                                  int                depth,
+                                  bslma::Allocator*  allocator) {
+        BSLS_ASSERT(0 <= count && count <= k_MAX_DIGIT);
+
+        if (count == 0) {
+            return 0;
+        }
+        if (count == 1) {
+            return makeSingle(elements[0], depth, allocator);
+        }
+
+        const int prefixCount = (count + 1) / 2;
+        return makeDeep(elements,
+                        prefixCount,
+                        0,
+                        elements + prefixCount,
+                        count - prefixCount,
+                        depth,
+                        allocator);
+    }
+
+    static const Deque* pushFront(const Deque*       tree,
+                                  const bdld::Datum& element,
+                                  int                depth,
+                                  bslma::Allocator*  allocator) {
+        if (!tree) {
+            return makeSingle(element, depth, allocator);
+        }
+        if (isSingle(*tree)) {
+            return makeDeep(
+                &element, 1, 0, tree->d_prefix, 1, depth, allocator);
+        }
+
+        bdld::Datum prefix[k_MAX_DIGIT];
+        prefix[0] = element;
+        if (tree->d_prefixCount < k_MAX_DIGIT) {
+            for (int i = 0; i < tree->d_prefixCount; ++i) {
+                prefix[i + 1] = tree->d_prefix[i];
+            }
+            return makeDeep(prefix,
+                            tree->d_prefixCount + 1,
+                            tree->d_middle,
+                            tree->d_suffix,
+                            tree->d_suffixCount,
+                            depth,
+                            allocator);
+        }
+
+        // The prefix is full. Keep its first element, and push the other
+        // three onto the middle as a node.
+        prefix[1] = tree->d_prefix[0];
+        const bdld::Datum node =
+            makeNode(tree->d_prefix + 1, 3, depth, allocator);
+        return makeDeep(prefix,
+                        2,
+                        pushFront(tree->d_middle, node, depth + 1, allocator),
+                        tree->d_suffix,
+                        tree->d_suffixCount,
+                        depth,
+                        allocator);
+    }
+
+    static const Deque* pushBack(const Deque*       tree,
+                                 const bdld::Datum& element,
+                                 int                depth,
+                                 bslma::Allocator*  allocator) {
+        if (!tree) {
+            return makeSingle(element, depth, allocator);
+        }
+        if (isSingle(*tree)) {
+            return makeDeep(
+                tree->d_prefix, 1, 0, &element, 1, depth, allocator);
+        }
+
+        bdld::Datum suffix[k_MAX_DIGIT];
+        if (tree->d_suffixCount < k_MAX_DIGIT) {
+            for (int i = 0; i < tree->d_suffixCount; ++i) {
+                suffix[i] = tree->d_suffix[i];
+            }
+            suffix[tree->d_suffixCount] = element;
+            return makeDeep(tree->d_prefix,
+                            tree->d_prefixCount,
+                            tree->d_middle,
+                            suffix,
+                            tree->d_suffixCount + 1,
+                            depth,
+                            allocator);
+        }
+
+        // The suffix is full. Keep its last element, and push the other
+        // three onto the middle as a node.
+        suffix[0] = tree->d_suffix[3];
+        suffix[1] = element;
+        const bdld::Datum node = makeNode(tree->d_suffix, 3, depth, allocator);
+        return makeDeep(tree->d_prefix,
+                        tree->d_prefixCount,
+                        pushBack(tree->d_middle, node, depth + 1, allocator),
+                        suffix,
+                        2,
+                        depth,
+                        allocator);
+    }
+
+    static const Deque* deepL(const bdld::Datum* prefix,
+                              int                prefixCount,
+                              const Deque*       middle,
+                              const bdld::Datum* suffix,
+                              int                suffixCount,
+                              int                depth,
+                              bslma::Allocator*  allocator) {
+        BSLS_ASSERT(suffixCount > 0);
+
+        if (prefixCount) {
+            return makeDeep(prefix,
+                            prefixCount,
+                            middle,
+                            suffix,
+                            suffixCount,
+                            depth,
+                            allocator);
+        }
+        if (!middle) {
+            return fromDigit(suffix, suffixCount, depth, allocator);
+        }
+
+        bdld::Datum        first;
+        const Deque* const rest =
+            popFront(middle, depth + 1, &first, allocator);
+        const Node* const node = toNode(first);
+        return makeDeep(node->elements,
+                        node->count,
+                        rest,
+                        suffix,
+                        suffixCount,
+                        depth,
+                        allocator);
+    }
+
+    static const Deque* deepR(const bdld::Datum* prefix,
+                              int                prefixCount,
+                              const Deque*       middle,
+                              const bdld::Datum* suffix,
+                              int                suffixCount,
+                              int                depth,
+                              bslma::Allocator*  allocator) {
+        BSLS_ASSERT(prefixCount > 0);
+
+        if (suffixCount) {
+            return makeDeep(prefix,
+                            prefixCount,
+                            middle,
+                            suffix,
+                            suffixCount,
+                            depth,
+                            allocator);
+        }
+        if (!middle) {
+            return fromDigit(prefix, prefixCount, depth, allocator);
+        }
+
+        bdld::Datum        last;
+        const Deque* const rest = popBack(middle, depth + 1, &last, allocator);
+        const Node* const  node = toNode(last);
+        return makeDeep(prefix,
+                        prefixCount,
+                        rest,
+                        node->elements,
+                        node->count,
+                        depth,
+                        allocator);
+    }
+
+    // Load the first element of the specified nonempty 'tree' into the
+    // specified 'element', and return a tree of the rest.
+    static const Deque* popFront(const Deque*      tree,
+                                 int               depth,
+                                 bdld::Datum*      element,
+                                 bslma::Allocator* allocator) {
+        BSLS_ASSERT(tree);
+
+        *element = tree->d_prefix[0];
+        if (isSingle(*tree)) {
+            return 0;
+        }
+        return deepL(tree->d_prefix + 1,
+                     tree->d_prefixCount - 1,
+                     tree->d_middle,
+                     tree->d_suffix,
+                     tree->d_suffixCount,
+                     depth,
+                     allocator);
+    }
+
+    // Load the last element of the specified nonempty 'tree' into the
+    // specified 'element', and return a tree of the rest.
+    static const Deque* popBack(const Deque*      tree,
+                                int               depth,
+                                bdld::Datum*      element,
+                                bslma::Allocator* allocator) {
+        BSLS_ASSERT(tree);
+
+        if (isSingle(*tree)) {
+            *element = tree->d_prefix[0];
+            return 0;
+        }
+        *element = tree->d_suffix[tree->d_suffixCount - 1];
+        return deepR(tree->d_prefix,
+                     tree->d_prefixCount,
+                     tree->d_middle,
+                     tree->d_suffix,
+                     tree->d_suffixCount - 1,
+                     depth,
+                     allocator);
+    }
+
+    // Group the specified two to twelve 'elements' into nodes of two or
+    // three, load the nodes into the specified 'nodes', and return how many
+    // there are.
+    static int makeNodes(const bdld::Datum* elements,
+                         int                count,
+                         int                depth,
+                         bdld::Datum*       nodes,
+                         bslma::Allocator*  allocator) {
+        BSLS_ASSERT(2 <= count && count <= 3 * k_MAX_DIGIT);
+
+        int made = 0;
+        while (count > 4) {
+            nodes[made++] = makeNode(elements, 3, depth, allocator);
+            elements += 3;
+            count -= 3;
+        }
+        if (count == 4) {
+            nodes[made++] = makeNode(elements, 2, depth, allocator);
+            nodes[made++] = makeNode(elements + 2, 2, depth, allocator);
+        }
+        else {
+            nodes[made++] = makeNode(elements, count, depth, allocator);
+        }
+        return made;
+    }
+
+    // Return a tree of the elements of the specified 'left', followed by the
+    // specified zero to four 'elements', followed by the elements of the
+    // specified 'right'.
+    static const Deque* append(const Deque*       left,
+                               const bdld::Datum* elements,
+                               int                count,
+                               const Deque*       right,
+                               int                depth,
+                               bslma::Allocator*  allocator) {
+        if (!left) {
+            for (int i = count; i--;) {
+                right = pushFront(right, elements[i], depth, allocator);
+            }
+            return right;
+        }
+        if (!right) {
+            for (int i = 0; i < count; ++i) {
+                left = pushBack(left, elements[i], depth, allocator);
+            }
+            return left;
+        }
+        if (isSingle(*left)) {
+            right = append(0, elements, count, right, depth, allocator);
+            return pushFront(right, left->d_prefix[0], depth, allocator);
+        }
+        if (isSingle(*right)) {
+            left = append(left, elements, count, 0, depth, allocator);
+            return pushBack(left, right->d_prefix[0], depth, allocator);
+        }
+
+        bdld::Datum seam[3 * k_MAX_DIGIT];
+        int         seamCount = 0;
+        for (int i = 0; i < left->d_suffixCount; ++i) {
+            seam[seamCount++] = left->d_suffix[i];
+        }
+        for (int i = 0; i < count; ++i) {
+            seam[seamCount++] = elements[i];
+        }
+        for (int i = 0; i < right->d_prefixCount; ++i) {
+            seam[seamCount++] = right->d_prefix[i];
+        }
+
+        bdld::Datum nodes[k_MAX_DIGIT];
+        const int   nodeCount =
+            makeNodes(seam, seamCount, depth, nodes, allocator);
+        return makeDeep(left->d_prefix,
+                        left->d_prefixCount,
+                        append(left->d_middle,
+                               nodes,
+                               nodeCount,
+                               right->d_middle,
+                               depth + 1,
+                               allocator),
+                        right->d_suffix,
+                        right->d_suffixCount,
+                        depth,
+                        allocator);
+    }
+
+    // Load into the specified 'element' the element of the specified
+    // nonempty 'tree' that contains the value at the specified 'index', and
+    // load into the specified 'left' and 'right' trees of the elements
+    // before and after it. The behavior is undefined unless
+    // 'index < tree->d_size'.
+    static void split(const Deque*      tree,
+                      bsl::size_t       index,
+                      int               depth,
+                      const Deque**     left,
+                      bdld::Datum*      element,
+                      const Deque**     right,
+                      bslma::Allocator* allocator) {
+        BSLS_ASSERT(index < tree->d_size);
+
+        if (isSingle(*tree)) {
+            *left    = 0;
+            *element = tree->d_prefix[0];
+            *right   = 0;
+            return;
+        }
+
+        const bdld::Datum* const prefix      = tree->d_prefix;
+        const int                prefixCount = tree->d_prefixCount;
+        const bdld::Datum* const suffix      = tree->d_suffix;
+        const int                suffixCount = tree->d_suffixCount;
+
+        const bsl::size_t prefixSize = size(prefix, prefixCount, depth);
+        if (index < prefixSize) {
+            const int k = find(prefix, prefixCount, depth, &index);
+            *left       = fromDigit(prefix, k, depth, allocator);
+            *element    = prefix[k];
+            *right      = deepL(prefix + k + 1,
+                           prefixCount - k - 1,
+                           tree->d_middle,
+                           suffix,
+                           suffixCount,
+                           depth,
+                           allocator);
+            return;
+        }
+        index -= prefixSize;
+
+        const bsl::size_t middleSize = Deque::size(tree->d_middle);
+        if (index < middleSize) {
+            const Deque* middleLeft;
+            bdld::Datum  nodeElement;
+            const Deque* middleRight;
+            split(tree->d_middle,
+                  index,
+                  depth + 1,
+                  &middleLeft,
+                  &nodeElement,
+                  &middleRight,
+                  allocator);
+            index -= Deque::size(middleLeft);
+
+            const Node* const node = toNode(nodeElement);
+            const int k = find(node->elements, node->count, depth, &index);
+            *left       = deepR(prefix,
+                          prefixCount,
+                          middleLeft,
+                          node->elements,
+                          k,
+                          depth,
+                          allocator);
+            *element    = node->elements[k];
+            *right      = deepL(node->elements + k + 1,
+                           node->count - k - 1,
+                           middleRight,
+                           suffix,
+                           suffixCount,
+                           depth,
+                           allocator);
+            return;
+        }
+        index -= middleSize;
+
+        const int k = find(suffix, suffixCount, depth, &index);
+        *left       = deepR(prefix,
+                      prefixCount,
+                      tree->d_middle,
+                      suffix,
+                      k,
+                      depth,
+                      allocator);
+        *element    = suffix[k];
+        *right      = fromDigit(
+            suffix + k + 1, suffixCount - k - 1, depth, allocator);
+    }
+};
+
+void Deque::Cursor::enter(const bdld::Datum& element, int depth) {
+    const bdld::Datum* current = &element;
+    for (; depth; --depth) {
+        const Node* const node   = DequeImpl::toNode(*current);
+        d_nodes[d_nodeDepth]     = node;
+        d_indices[d_nodeDepth++] = 0;
+        current                  = node->elements;
+    }
+    d_value = current;
+}
+
+void Deque::Cursor::nextInTrees() {
+    // The position within a tree counts its prefix elements from zero, then
+    // its middle, and then its suffix elements. A tree is pushed at position
+    // -1, before its first element.
+    while (d_treeDepth) {
+        const int          depth    = d_treeDepth - 1;
+        const Deque* const tree     = d_trees[depth];
+        const int          position = ++d_positions[depth];
+        const int          prefix   = tree->d_prefixCount;
+
+        if (position < prefix) {
+            enter(tree->d_prefix[position], depth);
+            return;
+        }
+        if (position == prefix) {
+            if (tree->d_middle) {
+                BSLS_ASSERT(d_treeDepth < k_MAX_DEPTH);
+                d_trees[d_treeDepth]       = tree->d_middle;
+                d_positions[d_treeDepth++] = -1;
+            }
+            continue;
+        }
+        if (position <= prefix + tree->d_suffixCount) {
+            enter(tree->d_suffix[position - prefix - 1], depth);
+            return;
+        }
+        --d_treeDepth;
+    }
+
+    d_value = 0;
+}
+
+Deque::Cursor::Cursor(const Deque* deque)
+: d_treeDepth(0)
+, d_nodeDepth(0)
+, d_value(0) {
+    if (deque) {
+        d_trees[0]     = deque;
+        d_positions[0] = -1;
+        d_treeDepth    = 1;
+        nextInTrees();
+    }
+}
+
+void Deque::Cursor::advance() {
+    BSLS_ASSERT(!done());
+
+    while (d_nodeDepth) {
+        const Node* const node  = d_nodes[d_nodeDepth - 1];
+        const int         index = ++d_indices[d_nodeDepth - 1];
+        if (index < node->count) {
+            // The children of the innermost node are one level shallower
+            // than it is, and it is 'd_nodeDepth' levels below the tree.
+            enter(node->elements[index], d_treeDepth - 1 - d_nodeDepth);
+            return;
+        }
+        --d_nodeDepth;
+    }
+
+    nextInTrees();
+}
+
+bsl::size_t Deque::size(const Deque* deque) {
+    return deque ? deque->d_size : 0;
+}
+
+const bdld::Datum& Deque::front(const Deque* deque) {
+    BSLS_ASSERT(deque);
+    return deque->d_prefix[0];
+}
+
+const bdld::Datum& Deque::back(const Deque* deque) {
+    BSLS_ASSERT(deque);
+    return DequeImpl::isSingle(*deque)
+               ? deque->d_prefix[0]
+               : deque->d_suffix[deque->d_suffixCount - 1];
+}
+
+const bdld::Datum& Deque::nth(const Deque* deque, bsl::size_t index) {
+    BSLS_ASSERT(index < size(deque));
+
+    // Descend the spine of trees to the element that contains 'index', and
+    // then descend its nodes to the value.
+    const Deque*       tree  = deque;
+    int                depth = 0;
+    const bdld::Datum* element;
+    for (;;) {
+        if (DequeImpl::isSingle(*tree)) {
+            element = tree->d_prefix;
+            break;
+        }
+
+        const bsl::size_t prefixSize =
+            DequeImpl::size(tree->d_prefix, tree->d_prefixCount, depth);
+        if (index < prefixSize) {
+            element = tree->d_prefix + DequeImpl::find(tree->d_prefix,
+                                                       tree->d_prefixCount,
+                                                       depth,
+                                                       &index);
+            break;
+        }
+        index -= prefixSize;
+
+        const bsl::size_t middleSize = size(tree->d_middle);
+        if (index < middleSize) {
+            tree = tree->d_middle;
+            ++depth;
+            continue;
+        }
+        index -= middleSize;
+
+        element = tree->d_suffix + DequeImpl::find(tree->d_suffix,
+                                                   tree->d_suffixCount,
+                                                   depth,
+                                                   &index);
+        break;
+    }
+
+    for (; depth; --depth) {
+        const Node* const node = DequeImpl::toNode(*element);
+        const int position = DequeImpl::find(
+            node->elements, node->count, depth - 1, &index);
+        element = node->elements + position;
+    }
+
+    return *element;
+}
+
+const Deque* Deque::pushFront(const Deque*       deque,
+                              const bdld::Datum& value,
+                              bslma::Allocator*  allocator) {
+    return DequeImpl::pushFront(deque, value, 0, allocator);
+}
+
+const Deque* Deque::pushBack(const Deque*       deque,
+                             const bdld::Datum& value,
+                             bslma::Allocator*  allocator) {
+    return DequeImpl::pushBack(deque, value, 0, allocator);
+}
+
+const Deque* Deque::popFront(const Deque* deque, bslma::Allocator* allocator) {
+    bdld::Datum first;
+    return DequeImpl::popFront(deque, 0, &first, allocator);
+}
+
+const Deque* Deque::popBack(const Deque* deque, bslma::Allocator* allocator) {
+    bdld::Datum last;
+    return DequeImpl::popBack(deque, 0, &last, allocator);
+}
+
+const Deque* Deque::concatenate(const Deque*      left,
+                                const Deque*      right,
+                                bslma::Allocator* allocator) {
+    return DequeImpl::append(left, 0, 0, right, 0, allocator);
+}
+
+bsl::pair<const Deque*, const Deque*> Deque::split(
+    const Deque*      deque,
+    bsl::size_t       index,
+    bslma::Allocator* allocator) {
+    BSLS_ASSERT(index <= size(deque));
+
+    if (index == 0) {
+        return bsl::make_pair(static_cast<const Deque*>(0), deque);
+    }
+    if (index == size(deque)) {
+        return bsl::make_pair(deque, static_cast<const Deque*>(0));
+    }
+
+    const Deque* left;
+    bdld::Datum  value;
+    const Deque* right;
+    DequeImpl::split(deque, index, 0, &left, &value, &right, allocator);
+    return bsl::make_pair(left,
+                          DequeImpl::pushFront(right, value, 0, allocator));
+}
+
+const Deque* Deque::fromRange(const bdld::Datum* begin,
+                              const bdld::Datum* end,
+                              bslma::Allocator*  allocator) {
+    const Deque* result = 0;
+    for (; begin != end; ++begin) {
+        result = DequeImpl::pushBack(result, *begin, 0, allocator);
+    }
+    return result;
+}
+
+bool Deque::isDeque(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && isDeque(datum.theUdt(), typeOffset);
+}
+
+bool Deque::isDeque(const bdld::DatumUdt& udt, int typeOffset) {
+    return udt.type() == UserDefinedTypes::e_DEQUE + typeOffset;
+}
+
+const Deque* Deque::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+const Deque* Deque::access(const bdld::DatumUdt& udt) {
+    return static_cast<const Deque*>(udt.data());
+}
+
+bdld::Datum Deque::create(const Deque* deque, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(deque)),
+        UserDefinedTypes::e_DEQUE + typeOffset);
+}
+
+}  // namespace lspcore
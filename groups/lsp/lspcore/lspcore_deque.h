@@ -0,0 +1,154 @@
+#ifndef INCLUDED_LSPCORE_DEQUE
+#define INCLUDED_LSPCORE_DEQUE
+
+// A deque is an immutable sequence of values that can be extended or
+// shortened at either end. A list built from 'Pair' objects shares its tail,
+// so it can grow and shrink only at the front; a deque shares everything but
+// O(1) of its structure with the deque it was derived from, at both ends.
+//
+// Deques are "2-3 finger trees" annotated with sizes (Hinze and Paterson,
+// "Finger Trees: A Simple General-purpose Data Structure," 2006). A finger
+// tree is either empty, a "single" element, or "deep": a "prefix" of one to
+// four elements, a "suffix" of one to four elements, and, between them, a
+// "middle" finger tree whose elements are nodes of two or three elements of
+// the outer tree. Pushing onto a full prefix or suffix moves three of its
+// elements into a node that is pushed onto the middle tree, which happens at
+// most once every three pushes at each level, so 'pushFront', 'pushBack',
+// 'popFront', and 'popBack' take O(1) amortized time. Each tree and node
+// stores the number of values below it, so 'nth' and 'split' take O(log n)
+// time, as does 'concatenate', which regroups the digits along the seam into
+// nodes.
+//
+// A deque is represented as a pointer to its outermost 'Deque' tree. A null
+// pointer denotes an empty deque.
+
+#include <bdld_datum.h>
+#include <bsl_cstddef.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+class Deque {
+  public:
+    enum { k_MAX_DIGIT = 4 };
+
+  private:
+    // A tree is "single" if it has no suffix, in which case its one element
+    // is the first of its prefix and it has no middle. An element of a tree
+    // at depth zero is a value, while an element of a tree at depth 'd > 0'
+    // is a 'Node' whose elements are at depth 'd - 1'. Nodes are stored in
+    // 'bdld::Datum' objects so that every depth can share the same code.
+    struct Node;
+
+    bsl::size_t  d_size;         // number of values, at depth zero
+    const Deque* d_middle;       // null if empty
+    int          d_prefixCount;  // one to four
+    int          d_suffixCount;  // zero (single) or one to four
+    bdld::Datum  d_prefix[k_MAX_DIGIT];
+    bdld::Datum  d_suffix[k_MAX_DIGIT];
+
+    Deque();
+
+    friend class DequeImpl;
+
+  public:
+    // 'Cursor' visits the elements of a 'Deque' in order without allocating
+    // memory.
+    class Cursor {
+        // Each element of a tree at depth 'd' holds at least '2^d' values,
+        // so a deque of fewer than '2^64' values has fewer than 64 levels.
+        enum { k_MAX_DEPTH = 64 };
+
+        const Deque*       d_trees[k_MAX_DEPTH];
+        int                d_positions[k_MAX_DEPTH];  // see 'nextInTrees'
+        int                d_treeDepth;
+        const Node*        d_nodes[k_MAX_DEPTH];
+        int                d_indices[k_MAX_DEPTH];    // current child of each
+        int                d_nodeDepth;
+        const bdld::Datum* d_value;                   // null when done
+
+        void enter(const bdld::Datum& element, int depth);
+        void nextInTrees();
+
+      public:
+        explicit Cursor(const Deque* deque);
+
+        bool               done() const;
+        const bdld::Datum& value() const;
+        void               advance();
+    };
+
+    static bsl::size_t size(const Deque*);
+
+    // Return the first or last value of the specified 'deque'. The behavior
+    // is undefined if 'deque' is empty.
+    static const bdld::Datum& front(const Deque* deque);
+    static const bdld::Datum& back(const Deque* deque);
+
+    // Return the value of the specified 'deque' at the specified 'index'.
+    // The behavior is undefined unless 'index < size(deque)'.
+    static const bdld::Datum& nth(const Deque* deque, bsl::size_t index);
+
+    // Return a deque of the specified 'value' followed by the values of the
+    // specified 'deque'.
+    static const Deque* pushFront(const Deque*       deque,
+                                  const bdld::Datum& value,
+                                  bslma::Allocator*);
+
+    // Return a deque of the values of the specified 'deque' followed by the
+    // specified 'value'.
+    static const Deque* pushBack(const Deque*       deque,
+                                 const bdld::Datum& value,
+                                 bslma::Allocator*);
+
+    // Return a deque of all but the first or last value of the specified
+    // 'deque'. The behavior is undefined if 'deque' is empty.
+    static const Deque* popFront(const Deque* deque, bslma::Allocator*);
+    static const Deque* popBack(const Deque* deque, bslma::Allocator*);
+
+    // Return a deque of the values of the specified 'left' followed by the
+    // values of the specified 'right'.
+    static const Deque* concatenate(const Deque* left,
+                                    const Deque* right,
+                                    bslma::Allocator*);
+
+    // Return a pair of deques: the first 'index' values of the specified
+    // 'deque', and the rest. The behavior is undefined unless
+    // 'index <= size(deque)'.
+    static bsl::pair<const Deque*, const Deque*> split(const Deque* deque,
+                                                       bsl::size_t  index,
+                                                       bslma::Allocator*);
+
+    // Return a deque of the values in the specified range '[begin, end)'.
+    static const Deque* fromRange(const bdld::Datum* begin,
+                                  const bdld::Datum* end,
+                                  bslma::Allocator*);
+
+    static bool isDeque(const bdld::Datum&, int typeOffset);
+    static bool isDeque(const bdld::DatumUdt&, int typeOffset);
+
+    static const Deque* access(const bdld::Datum&);
+    static const Deque* access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(const Deque* deque, int typeOffset);
+};
+
+inline bool Deque::Cursor::done() const {
+    return d_value == 0;
+}
+
+inline const bdld::Datum& Deque::Cursor::value() const {
+    return *d_value;
+}
+
+}  // namespace lspcore
+
+#endif
@@ -0,0 +1,645 @@
+#include <bdlb_bitutil.h>
+#include <bsl_algorithm.h>
+#include <bsl_cstdint.h>
+#include <bsl_limits.h>
+#include <bsl_new.h>
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+#include <lspcore_datumutil.h>
+#include <lspcore_hashmap.h>
+#include <lspcore_userdefinedtypes.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+// Node Layout
+// ===========
+// A 'HashMapNode' is allocated together with its slots, which follow it in
+// memory: first the pointers to the child nodes, and then the entries, each
+// in the order of their slots' positions in the bitmaps. For example, the
+// node with entries in slots 3 and 17 and a child in slot 9 looks like this:
+//
+//     entryMap: 0b00000000000000100000000000001000
+//     nodeMap:  0b00000000000000000000001000000000
+//     nodes:    [child for slot 9]
+//     entries:  [entry for slot 3] [entry for slot 17]
+//
+// The index of a slot within its array is the number of bits set in the
+// bitmap below the slot's bit.
+//
+// A collision node is one that is deeper than the number of bits in a hash.
+// It has no children, and its 'd_entryMap' is not a bitmap but the number of
+// its entries.
+class HashMapNode {
+  public:
+    typedef bsl::uint32_t Bitmap;
+
+    Bitmap d_entryMap;
+    Bitmap d_nodeMap;
+
+    static bsl::size_t entriesOffset(int nodeCount);
+
+    const HashMapNode* const* nodes() const;
+    const HashMapNode**       nodes();
+
+    const HashMap::Entry* entries() const;
+    HashMap::Entry*       entries();
+};
+
+namespace {
+
+typedef HashMapNode::Bitmap Bitmap;
+typedef HashMap::Entry      Entry;
+
+const int k_BITS_PER_LEVEL = 5;
+const int k_HASH_BITS      = bsl::numeric_limits<bsl::size_t>::digits;
+
+int popCount(Bitmap bitmap) {
+    return bdlb::BitUtil::numBitsSet(bsl::uint32_t(bitmap));
+}
+
+bool isCollision(int shift) {
+    return shift >= k_HASH_BITS;
+}
+
+// Return the bit of the slot for the specified 'hash' in a node at the depth
+// corresponding to the specified 'shift'.
+Bitmap bitFor(bsl::size_t hash, int shift) {
+    BSLS_ASSERT(!isCollision(shift));
+    return Bitmap(1) << ((hash >> shift) & 31);
+}
+
+// Return the position of the specified 'bit' among the slots in the
+// specified 'bitmap'.
+int indexOf(Bitmap bitmap, Bitmap bit) {
+    return popCount(bitmap & (bit - 1));
+}
+
+int entryCount(const HashMapNode& node, int shift) {
+    if (isCollision(shift)) {
+        return node.d_entryMap;
+    }
+
+    return popCount(node.d_entryMap);
+}
+
+int nodeCount(const HashMapNode& node) {
+    return popCount(node.d_nodeMap);
+}
+
+// Return whether the specified 'node', at the depth corresponding to the
+// specified 'shift', contains exactly one entry and no children.
+bool isSingleEntry(const HashMapNode& node, int shift) {
+    return node.d_nodeMap == 0 && entryCount(node, shift) == 1;
+}
+
+HashMapNode* allocateNode(Bitmap            entryMap,
+                          Bitmap            nodeMap,
+                          int               entryCount,
+                          int               nodeCount,
+                          bslma::Allocator* allocator) {
+    const bsl::size_t size = HashMapNode::entriesOffset(nodeCount) +
+                             entryCount * sizeof(Entry);
+    HashMapNode* node = static_cast<HashMapNode*>(allocator->allocate(size));
+    node->d_entryMap  = entryMap;
+    node->d_nodeMap   = nodeMap;
+    return node;
+}
+
+// Return a copy of the specified 'node', at the depth corresponding to the
+// specified 'shift', where the entry at the specified 'index' is replaced by
+// the specified 'entry'.
+const HashMapNode* replaceEntry(const HashMapNode& node,
+                                int                shift,
+                                int                index,
+                                const Entry&       entry,
+                                bslma::Allocator*  allocator) {
+    const int    entries = entryCount(node, shift);
+    const int    nodes   = nodeCount(node);
+    HashMapNode* result  = allocateNode(
+        node.d_entryMap, node.d_nodeMap, entries, nodes, allocator);
+
+    bsl::copy(node.nodes(), node.nodes() + nodes, result->nodes());
+    bsl::copy(node.entries(), node.entries() + entries, result->entries());
+    result->entries()[index] = entry;
+    return result;
+}
+
+// Return a copy of the specified 'node' where the child at the specified
+// 'index' is replaced by the specified 'child'.
+const HashMapNode* replaceNode(const HashMapNode& node,
+                               int                shift,
+                               int                index,
+                               const HashMapNode* child,
+                               bslma::Allocator*  allocator) {
+    const int    entries = entryCount(node, shift);
+    const int    nodes   = nodeCount(node);
+    HashMapNode* result  = allocateNode(
+        node.d_entryMap, node.d_nodeMap, entries, nodes, allocator);
+
+    bsl::copy(node.nodes(), node.nodes() + nodes, result->nodes());
+    bsl::copy(node.entries(), node.entries() + entries, result->entries());
+    result->nodes()[index] = child;
+    return result;
+}
+
+// Return a copy of the specified non-collision 'node' with the specified
+// 'entry' added in the slot of the specified 'bit', which must be empty.
+const HashMapNode* addEntry(const HashMapNode& node,
+                            Bitmap             bit,
+                            const Entry&       entry,
+                            bslma::Allocator*  allocator) {
+    const int    entries = popCount(node.d_entryMap);
+    const int    nodes   = nodeCount(node);
+    const int    index   = indexOf(node.d_entryMap, bit);
+    HashMapNode* result  = allocateNode(
+        node.d_entryMap | bit, node.d_nodeMap, entries + 1, nodes, allocator);
+
+    bsl::copy(node.nodes(), node.nodes() + nodes, result->nodes());
+    Entry* output = bsl::copy(
+        node.entries(), node.entries() + index, result->entries());
+    *output++ = entry;
+    bsl::copy(node.entries() + index, node.entries() + entries, output);
+    return result;
+}
+
+// Return a copy of the specified non-collision 'node' without the entry in
+// the slot of the specified 'bit'.
+const HashMapNode* removeEntry(const HashMapNode& node,
+                               Bitmap             bit,
+                               bslma::Allocator*  allocator) {
+    const int    entries = popCount(node.d_entryMap);
+    const int    nodes   = nodeCount(node);
+    const int    index   = indexOf(node.d_entryMap, bit);
+    HashMapNode* result  = allocateNode(
+        node.d_entryMap & ~bit, node.d_nodeMap, entries - 1, nodes, allocator);
+
+    bsl::copy(node.nodes(), node.nodes() + nodes, result->nodes());
+    Entry* output = bsl::copy(
+        node.entries(), node.entries() + index, result->entries());
+    bsl::copy(node.entries() + index + 1, node.entries() + entries, output);
+    return result;
+}
+
+// Return a copy of the specified non-collision 'node' where the entry in the
+// slot of the specified 'bit' is replaced by the specified 'child'.
+const HashMapNode* entryToNode(const HashMapNode& node,
+                               Bitmap             bit,
+                               const HashMapNode* child,
+                               bslma::Allocator*  allocator) {
+    const int    entries    = popCount(node.d_entryMap);
+    const int    nodes      = nodeCount(node);
+    const int    entryIndex = indexOf(node.d_entryMap, bit);
+    const int    nodeIndex  = indexOf(node.d_nodeMap, bit);
+    HashMapNode* result     = allocateNode(node.d_entryMap & ~bit,
+                                       node.d_nodeMap | bit,
+                                       entries - 1,
+                                       nodes + 1,
+                                       allocator);
+
+    const HashMapNode** nodeOutput =
+        bsl::copy(node.nodes(), node.nodes() + nodeIndex, result->nodes());
+    *nodeOutput++ = child;
+    bsl::copy(node.nodes() + nodeIndex, node.nodes() + nodes, nodeOutput);
+
+    Entry* entryOutput = bsl::copy(
+        node.entries(), node.entries() + entryIndex, result->entries());
+    bsl::copy(node.entries() + entryIndex + 1,
+              node.entries() + entries,
+              entryOutput);
+    return result;
+}
+
+// Return a copy of the specified non-collision 'node' where the child in the
+// slot of the specified 'bit' is replaced by the specified 'entry'.
+const HashMapNode* nodeToEntry(const HashMapNode& node,
+                               Bitmap             bit,
+                               const Entry&       entry,
+                               bslma::Allocator*  allocator) {
+    const int    entries    = popCount(node.d_entryMap);
+    const int    nodes      = nodeCount(node);
+    const int    entryIndex = indexOf(node.d_entryMap, bit);
+    const int    nodeIndex  = indexOf(node.d_nodeMap, bit);
+    HashMapNode* result     = allocateNode(node.d_entryMap | bit,
+                                       node.d_nodeMap & ~bit,
+                                       entries + 1,
+                                       nodes - 1,
+                                       allocator);
+
+    const HashMapNode** nodeOutput =
+        bsl::copy(node.nodes(), node.nodes() + nodeIndex, result->nodes());
+    bsl::copy(node.nodes() + nodeIndex + 1, node.nodes() + nodes, nodeOutput);
+
+    Entry* entryOutput = bsl::copy(
+        node.entries(), node.entries() + entryIndex, result->entries());
+    *entryOutput++ = entry;
+    bsl::copy(
+        node.entries() + entryIndex, node.entries() + entries, entryOutput);
+    return result;
+}
+
+// Return a node, at the depth corresponding to the specified 'shift', that
+// contains the specified 'first' and 'second', whose keys are distinct.
+const HashMapNode* merge(const Entry&      first,
+                         const Entry&      second,
+                         int               shift,
+                         bslma::Allocator* allocator) {
+    if (isCollision(shift)) {
+        HashMapNode* result  = allocateNode(2, 0, 2, 0, allocator);
+        result->entries()[0] = first;
+        result->entries()[1] = second;
+        return result;
+    }
+
+    const Bitmap firstBit  = bitFor(first.hash, shift);
+    const Bitmap secondBit = bitFor(second.hash, shift);
+    if (firstBit == secondBit) {
+        HashMapNode* result = allocateNode(0, firstBit, 0, 1, allocator);
+        result->nodes()[0] =
+            merge(first, second, shift + k_BITS_PER_LEVEL, allocator);
+        return result;
+    }
+
+    HashMapNode* result =
+        allocateNode(firstBit | secondBit, 0, 2, 0, allocator);
+    const bool inOrder   = firstBit < secondBit;
+    result->entries()[0] = inOrder ? first : second;
+    result->entries()[1] = inOrder ? second : first;
+    return result;
+}
+
+// Return the specified 'node', at the depth corresponding to the specified
+// 'shift', with the specified 'entry' added, or with the value of the entry
+// having an equal key replaced. Load into the specified 'added' whether the
+// number of entries grew.
+const HashMapNode* insertEntry(const HashMapNode& node,
+                               const Entry&       entry,
+                               int                shift,
+                               int                typeOffset,
+                               bool*              added,
+                               bslma::Allocator*  allocator) {
+    if (isCollision(shift)) {
+        const int entries = node.d_entryMap;
+        for (int i = 0; i < entries; ++i) {
+            const Entry& existing = node.entries()[i];
+            if (DatumUtil::equal(existing.key, entry.key, typeOffset)) {
+                *added = false;
+                return replaceEntry(node, shift, i, entry, allocator);
+            }
+        }
+
+        *added = true;
+        HashMapNode* result =
+            allocateNode(entries + 1, 0, entries + 1, 0, allocator);
+        Entry* output = bsl::copy(
+            node.entries(), node.entries() + entries, result->entries());
+        *output = entry;
+        return result;
+    }
+
+    const Bitmap bit = bitFor(entry.hash, shift);
+    if (node.d_entryMap & bit) {
+        const int    index    = indexOf(node.d_entryMap, bit);
+        const Entry& existing = node.entries()[index];
+        if (existing.hash == entry.hash &&
+            DatumUtil::equal(existing.key, entry.key, typeOffset)) {
+            *added = false;
+            return replaceEntry(node, shift, index, entry, allocator);
+        }
+
+        *added = true;
+        return entryToNode(
+            node,
+            bit,
+            merge(existing, entry, shift + k_BITS_PER_LEVEL, allocator),
+            allocator);
+    }
+
+    if (node.d_nodeMap & bit) {
+        const int                index = indexOf(node.d_nodeMap, bit);
+        const HashMapNode* const child = node.nodes()[index];
+        return replaceNode(node,
+                           shift,
+                           index,
+                           insertEntry(*child,
+                                       entry,
+                                       shift + k_BITS_PER_LEVEL,
+                                       typeOffset,
+                                       added,
+                                       allocator),
+                           allocator);
+    }
+
+    *added = true;
+    return addEntry(node, bit, entry, allocator);
+}
+
+// Return the specified 'node', at the depth corresponding to the specified
+// 'shift', without the entry whose key is equal to the specified 'key',
+// which has the specified 'hash'. Return 'node' itself if there is no such
+// entry, or return a null pointer if that entry is the only one in 'node'.
+const HashMapNode* removeKey(const HashMapNode* node,
+                             const bdld::Datum& key,
+                             bsl::size_t        hash,
+                             int                shift,
+                             int                typeOffset,
+                             bslma::Allocator*  allocator) {
+    if (isCollision(shift)) {
+        const int entries = node->d_entryMap;
+        for (int i = 0; i < entries; ++i) {
+            if (DatumUtil::equal(node->entries()[i].key, key, typeOffset)) {
+                if (entries == 1) {
+                    return 0;
+                }
+
+                HashMapNode* result =
+                    allocateNode(entries - 1, 0, entries - 1, 0, allocator);
+                Entry* output = bsl::copy(
+                    node->entries(), node->entries() + i, result->entries());
+                bsl::copy(node->entries() + i + 1,
+                          node->entries() + entries,
+                          output);
+                return result;
+            }
+        }
+
+        return node;
+    }
+
+    const Bitmap bit = bitFor(hash, shift);
+    if (node->d_entryMap & bit) {
+        const Entry& existing =
+            node->entries()[indexOf(node->d_entryMap, bit)];
+        if (existing.hash != hash ||
+            !DatumUtil::equal(existing.key, key, typeOffset)) {
+            return node;
+        }
+        if (isSingleEntry(*node, shift)) {
+            return 0;
+        }
+
+        return removeEntry(*node, bit, allocator);
+    }
+
+    if (node->d_nodeMap & bit) {
+        const int                index = indexOf(node->d_nodeMap, bit);
+        const HashMapNode* const child = node->nodes()[index];
+        const HashMapNode* const newChild = removeKey(
+            child, key, hash, shift + k_BITS_PER_LEVEL, typeOffset, allocator);
+        if (newChild == child) {
+            return node;
+        }
+
+        // A child node always has at least two entries beneath it, so it is
+        // never emptied. If it's left with only one entry, then the entry
+        // moves up into this node, to keep the trie canonical.
+        BSLS_ASSERT(newChild);
+        if (isSingleEntry(*newChild, shift + k_BITS_PER_LEVEL)) {
+            return nodeToEntry(*node, bit, newChild->entries()[0], allocator);
+        }
+
+        return replaceNode(*node, shift, index, newChild, allocator);
+    }
+
+    return node;
+}
+
+}  // namespace
+
+bsl::size_t HashMapNode::entriesOffset(int nodeCount) {
+    const bsl::size_t alignment = alignof(HashMap::Entry);
+    const bsl::size_t offset =
+        sizeof(HashMapNode) + nodeCount * sizeof(const HashMapNode*);
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+const HashMapNode* const* HashMapNode::nodes() const {
+    return reinterpret_cast<const HashMapNode* const*>(this + 1);
+}
+
+const HashMapNode** HashMapNode::nodes() {
+    return reinterpret_cast<const HashMapNode**>(this + 1);
+}
+
+const HashMap::Entry* HashMapNode::entries() const {
+    return reinterpret_cast<const HashMap::Entry*>(
+        reinterpret_cast<const char*>(this) +
+        entriesOffset(popCount(d_nodeMap)));
+}
+
+HashMap::Entry* HashMapNode::entries() {
+    return reinterpret_cast<HashMap::Entry*>(
+        reinterpret_cast<char*>(this) + entriesOffset(popCount(d_nodeMap)));
+}
+
+HashMap::Cursor::Cursor(const HashMap* map)
+: d_depth(0) {
+    if (map) {
+        push(map->d_root);
+        settle();
+    }
+}
+
+void HashMap::Cursor::push(const HashMapNode* node) {
+    BSLS_ASSERT(d_depth < k_MAX_DEPTH);
+
+    Frame& frame     = d_stack[d_depth];
+    frame.node       = node;
+    frame.index      = 0;
+    frame.entryCount = entryCount(*node, d_depth * k_BITS_PER_LEVEL);
+    frame.nodeCount  = nodeCount(*node);
+    ++d_depth;
+}
+
+void HashMap::Cursor::settle() {
+    // Descend or ascend until the top frame refers to an entry, or until
+    // there are no frames left.
+    while (d_depth) {
+        Frame& top = d_stack[d_depth - 1];
+        if (top.index < top.entryCount) {
+            return;
+        }
+
+        const int child = top.index - top.entryCount;
+        if (child < top.nodeCount) {
+            ++top.index;
+            push(top.node->nodes()[child]);
+        }
+        else {
+            --d_depth;
+        }
+    }
+}
+
+const HashMap::Entry& HashMap::Cursor::entry() const {
+    BSLS_ASSERT(!done());
+
+    const Frame& top = d_stack[d_depth - 1];
+    return top.node->entries()[top.index];
+}
+
+void HashMap::Cursor::advance() {
+    BSLS_ASSERT(!done());
+
+    ++d_stack[d_depth - 1].index;
+    settle();
+}
+
+HashMap::HashMap(bsl::size_t size, const HashMapNode* root)
+: d_size(size)
+, d_root(root) {
+}
+
+const HashMap* HashMap::insert(const HashMap*     map,
+                               const bdld::Datum& key,
+                               const bdld::Datum& value,
+                               int                typeOffset,
+                               bslma::Allocator*  allocator) {
+    Entry entry;
+    entry.key   = key;
+    entry.value = value;
+    entry.hash  = DatumUtil::hash(key, typeOffset);
+
+    if (!map) {
+        HashMapNode* root =
+            allocateNode(bitFor(entry.hash, 0), 0, 1, 0, allocator);
+        root->entries()[0] = entry;
+        return new (*allocator) HashMap(1, root);
+    }
+
+    bool                     added;
+    const HashMapNode* const root =
+        insertEntry(*map->d_root, entry, 0, typeOffset, &added, allocator);
+    return new (*allocator) HashMap(map->d_size + added, root);
+}
+
+const bdld::Datum* HashMap::find(const HashMap*     map,
+                                 const bdld::Datum& key,
+                                 int                typeOffset) {
+    if (!map) {
+        return 0;
+    }
+
+    const bsl::size_t  hash = DatumUtil::hash(key, typeOffset);
+    const HashMapNode* node = map->d_root;
+    for (int shift = 0;; shift += k_BITS_PER_LEVEL) {
+        if (isCollision(shift)) {
+            const int entries = node->d_entryMap;
+            for (int i = 0; i < entries; ++i) {
+                const Entry& entry = node->entries()[i];
+                if (DatumUtil::equal(entry.key, key, typeOffset)) {
+                    return &entry.value;
+                }
+            }
+            return 0;
+        }
+
+        const Bitmap bit = bitFor(hash, shift);
+        if (node->d_entryMap & bit) {
+            const Entry& entry =
+                node->entries()[indexOf(node->d_entryMap, bit)];
+            if (entry.hash == hash &&
+                DatumUtil::equal(entry.key, key, typeOffset)) {
+                return &entry.value;
+            }
+            return 0;
+        }
+        if (!(node->d_nodeMap & bit)) {
+            return 0;
+        }
+
+        node = node->nodes()[indexOf(node->d_nodeMap, bit)];
+    }
+}
+
+const HashMap* HashMap::remove(const HashMap*     map,
+                               const bdld::Datum& key,
+                               int                typeOffset,
+                               bslma::Allocator*  allocator) {
+    if (!map) {
+        return map;
+    }
+
+    const HashMapNode* const root = removeKey(map->d_root,
+                                              key,
+                                              DatumUtil::hash(key, typeOffset),
+                                              0,
+                                              typeOffset,
+                                              allocator);
+    if (root == map->d_root) {
+        return map;
+    }
+    if (!root) {
+        return 0;
+    }
+
+    return new (*allocator) HashMap(map->d_size - 1, root);
+}
+
+bool HashMap::equal(const HashMap* left,
+                    const HashMap* right,
+                    int            typeOffset) {
+    if (left == right) {
+        return true;
+    }
+    if (size(left) != size(right)) {
+        return false;
+    }
+
+    for (Cursor cursor(left); !cursor.done(); cursor.advance()) {
+        const Entry&             entry = cursor.entry();
+        const bdld::Datum* const value = find(right, entry.key, typeOffset);
+        if (!value || !DatumUtil::equal(entry.value, *value, typeOffset)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bsl::size_t HashMap::hash(const HashMap* map, int typeOffset) {
+    // Summing is insensitive to order, which varies among equal maps only
+    // within collision nodes, but which is unspecified in any case.
+    bsl::size_t result = size(map);
+    for (Cursor cursor(map); !cursor.done(); cursor.advance()) {
+        const Entry& entry = cursor.entry();
+        result += entry.hash ^ (DatumUtil::hash(entry.value, typeOffset) *
+                                bsl::size_t(0x9e3779b97f4a7c15ULL));
+    }
+
+    return result;
+}
+
+bool HashMap::isHashMap(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && datum.theUdt().type() ==
+                                UserDefinedTypes::e_HASH_MAP + typeOffset;
+}
+
+bool HashMap::isHashSet(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && datum.theUdt().type() ==
+                                UserDefinedTypes::e_HASH_SET + typeOffset;
+}
+
+const HashMap* HashMap::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+const HashMap* HashMap::access(const bdld::DatumUdt& udt) {
+    return static_cast<const HashMap*>(udt.data());
+}
+
+bdld::Datum HashMap::createMap(const HashMap* map, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(map)),
+        UserDefinedTypes::e_HASH_MAP + typeOffset);
+}
+
+bdld::Datum HashMap::createSet(const HashMap* set, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(set)),
+        UserDefinedTypes::e_HASH_SET + typeOffset);
+}
+
+}  // namespace lspcore
@@ -0,0 +1,162 @@
+#ifndef INCLUDED_LSPCORE_HASHMAP
+#define INCLUDED_LSPCORE_HASHMAP
+
+// A hash map is an immutable hash array mapped trie
+// (https://en.wikipedia.org/wiki/Hash_array_mapped_trie) from keys to values.
+// Keys may be any 'bdld::Datum', and are hashed and compared using
+// 'DatumUtil::hash' and 'DatumUtil::equal', so that, for example, lists and
+// arrays can be keys. A hash map is represented as a pointer to a 'HashMap'
+// instance. A null pointer denotes an empty map.
+//
+// Each node of the trie consumes five bits of a key's hash, and so has up to
+// 32 slots. A slot holds either an entry or a pointer to a child node, and
+// the node stores a bitmap of which slots hold entries and another of which
+// slots hold children, followed by compact arrays of only the occupied
+// slots. Keys whose hashes agree in every bit share a "collision" node at the
+// bottom of the trie, which is searched linearly. Insertion and removal copy
+// only the path from the root to the affected node, so the old and new maps
+// share everything else.
+//
+// Removal keeps the trie in a canonical form: a child node is never left
+// holding a single entry; instead, the entry moves up into its parent. Thus
+// maps with the same keys have the same shape, modulo the order of entries in
+// collision nodes.
+//
+// The same structure is used for hash sets, whose elements are the keys of
+// a map whose values are all null. Maps and sets are distinct user-defined
+// types that share the 'HashMap' representation.
+
+#include <bdld_datum.h>
+#include <bsl_cstddef.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+class HashMapNode;
+
+class HashMap {
+  public:
+    struct Entry {
+        bdld::Datum key;
+        bdld::Datum value;
+        bsl::size_t hash;  // 'DatumUtil::hash' of 'key'
+    };
+
+    // 'Cursor' visits the entries of a 'HashMap' without allocating memory.
+    // The order depends only on the shape of the trie, so it is the same for
+    // maps with the same keys, except among entries in a collision node.
+    // Those entries, which have the same hash, are visited consecutively.
+    class Cursor {
+        enum { k_MAX_DEPTH = 16 };
+
+        struct Frame {
+            const HashMapNode* node;
+            int                index;
+            int                entryCount;
+            int                nodeCount;
+        };
+
+        Frame d_stack[k_MAX_DEPTH];
+        int   d_depth;
+
+        void push(const HashMapNode*);
+        void settle();
+
+      public:
+        explicit Cursor(const HashMap* map);
+
+        bool         done() const;
+        const Entry& entry() const;
+        void         advance();
+    };
+
+  private:
+    bsl::size_t        d_size;
+    const HashMapNode* d_root;
+
+    HashMap(bsl::size_t size, const HashMapNode* root);
+
+  public:
+    bsl::size_t        size() const;
+    static bsl::size_t size(const HashMap*);
+
+    // Return a map that contains the entries of the specified 'map' and
+    // associates the specified 'key' with the specified 'value', replacing
+    // any previous value of 'key'.
+    static const HashMap* insert(const HashMap*     map,
+                                 const bdld::Datum& key,
+                                 const bdld::Datum& value,
+                                 int                typeOffset,
+                                 bslma::Allocator*);
+
+    // Return a pointer to the value associated with the specified 'key' in
+    // the specified 'map', or return a null pointer if 'map' does not contain
+    // 'key'.
+    static const bdld::Datum* find(const HashMap*     map,
+                                   const bdld::Datum& key,
+                                   int                typeOffset);
+
+    static bool contains(const HashMap*     map,
+                         const bdld::Datum& key,
+                         int                typeOffset);
+
+    // Return a map that contains the entries of the specified 'map' except
+    // for the entry whose key is the specified 'key', if any. Return 'map'
+    // itself if it does not contain 'key'.
+    static const HashMap* remove(const HashMap*     map,
+                                 const bdld::Datum& key,
+                                 int                typeOffset,
+                                 bslma::Allocator*);
+
+    // Return whether the specified 'left' and 'right' contain equal keys
+    // associated with equal values.
+    static bool equal(const HashMap* left,
+                      const HashMap* right,
+                      int            typeOffset);
+
+    // Return a hash of the entries of the specified 'map' that does not
+    // depend on their order. Maps that are 'equal' have the same hash.
+    static bsl::size_t hash(const HashMap* map, int typeOffset);
+
+    static bool isHashMap(const bdld::Datum&, int typeOffset);
+    static bool isHashSet(const bdld::Datum&, int typeOffset);
+
+    static const HashMap* access(const bdld::Datum&);
+    static const HashMap* access(const bdld::DatumUdt&);
+
+    static bdld::Datum createMap(const HashMap* map, int typeOffset);
+    static bdld::Datum createSet(const HashMap* set, int typeOffset);
+};
+
+inline bsl::size_t HashMap::size() const {
+    return d_size;
+}
+
+inline bsl::size_t HashMap::size(const HashMap* map) {
+    if (map) {
+        return map->size();
+    }
+
+    return 0;
+}
+
+inline bool HashMap::contains(const HashMap*     map,
+                              const bdld::Datum& key,
+                              int                typeOffset) {
+    return find(map, key, typeOffset) != 0;
+}
+
+inline bool HashMap::Cursor::done() const {
+    return d_depth == 0;
+}
+
+}  // namespace lspcore
+
+#endif
@@ -0,0 +1,161 @@
+#include <bsl_algorithm.h>
+#include <bsl_new.h>
+#include <bsl_utility.h>
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+#include <lspcore_datumutil.h>
+#include <lspcore_hashtable.h>
+#include <lspcore_userdefinedtypes.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+void HashTable::Cursor::settle() {
+    while (d_slot != d_table_p->d_capacity &&
+           d_table_p->d_distances[d_slot] == 0) {
+        ++d_slot;
+    }
+}
+
+HashTable::Cursor::Cursor(const HashTable& table)
+: d_table_p(&table)
+, d_slot(0) {
+    settle();
+}
+
+void HashTable::Cursor::advance() {
+    BSLS_ASSERT(!done());
+    ++d_slot;
+    settle();
+}
+
+HashTable::HashTable(int typeOffset, bslma::Allocator* allocator)
+: d_distances(0)
+, d_entries(0)
+, d_capacity(0)
+, d_size(0)
+, d_typeOffset(typeOffset)
+, d_allocator_p(allocator) {
+}
+
+void HashTable::place(Entry entry) {
+    BSLS_ASSERT(d_size < d_capacity);
+
+    const bsl::size_t mask     = d_capacity - 1;
+    bsl::size_t       slot     = entry.hash & mask;
+    unsigned          distance = 1;
+    for (;; slot = (slot + 1) & mask, ++distance) {
+        if (d_distances[slot] == 0) {
+            new (d_entries + slot) Entry(entry);
+            d_distances[slot] = distance;
+            ++d_size;
+            return;
+        }
+
+        // Robin Hood: take the slot of an entry that is closer to its home
+        // than 'entry' is to its own, and carry on inserting that entry.
+        if (d_distances[slot] < distance) {
+            bsl::swap(entry, d_entries[slot]);
+            bsl::swap(distance, d_distances[slot]);
+        }
+    }
+}
+
+void HashTable::grow() {
+    unsigned* const   oldDistances = d_distances;
+    Entry* const      oldEntries   = d_entries;
+    const bsl::size_t oldCapacity  = d_capacity;
+
+    d_capacity  = oldCapacity ? oldCapacity * 2 : 16;
+    d_distances = static_cast<unsigned*>(
+        d_allocator_p->allocate(d_capacity * sizeof *d_distances));
+    d_entries   = static_cast<Entry*>(
+        d_allocator_p->allocate(d_capacity * sizeof *d_entries));
+    bsl::fill(d_distances, d_distances + d_capacity, 0u);
+    d_size = 0;
+
+    for (bsl::size_t slot = 0; slot < oldCapacity; ++slot) {
+        if (oldDistances[slot]) {
+            place(oldEntries[slot]);
+        }
+    }
+
+    if (oldCapacity) {
+        d_allocator_p->deallocate(oldDistances);
+        d_allocator_p->deallocate(oldEntries);
+    }
+}
+
+bsl::size_t HashTable::hash(const bdld::Datum& key) const {
+    return DatumUtil::hash(key, d_typeOffset);
+}
+
+const bdld::Datum* HashTable::find(const bdld::Datum& key,
+                                   bsl::size_t        hash) const {
+    const bsl::size_t slot = findSlot(key, hash);
+    return slot == d_capacity ? 0 : &d_entries[slot].value;
+}
+
+bsl::size_t HashTable::findSlot(const bdld::Datum& key,
+                                bsl::size_t        hash) const {
+    if (d_size == 0) {
+        return d_capacity;
+    }
+
+    const bsl::size_t mask = d_capacity - 1;
+    bsl::size_t       slot = hash & mask;
+    // An empty slot has distance zero, so it ends the search too.
+    for (unsigned distance = 1; d_distances[slot] >= distance;
+         slot = (slot + 1) & mask, ++distance) {
+        const Entry& entry = d_entries[slot];
+        if (entry.hash == hash &&
+            DatumUtil::equal(entry.key, key, d_typeOffset)) {
+            return slot;
+        }
+    }
+
+    return d_capacity;
+}
+
+void HashTable::insert(const bdld::Datum& key,
+                       bsl::size_t        hash,
+                       const bdld::Datum& value) {
+    const bsl::size_t slot = findSlot(key, hash);
+    if (slot != d_capacity) {
+        d_entries[slot].value = value;
+        return;
+    }
+
+    // Keep the table at most seven eighths full.
+    if ((d_size + 1) * 8 > d_capacity * 7) {
+        grow();
+    }
+
+    const Entry entry = { key, value, hash };
+    place(entry);
+}
+
+bool HashTable::isHashTable(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && isHashTable(datum.theUdt(), typeOffset);
+}
+
+bool HashTable::isHashTable(const bdld::DatumUdt& udt, int typeOffset) {
+    return udt.type() == UserDefinedTypes::e_HASH_TABLE + typeOffset;
+}
+
+HashTable* HashTable::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+HashTable* HashTable::access(const bdld::DatumUdt& udt) {
+    return static_cast<HashTable*>(udt.data());
+}
+
+bdld::Datum HashTable::create(HashTable* table, int typeOffset) {
+    return bdld::Datum::createUdt(table,
+                                  UserDefinedTypes::e_HASH_TABLE + typeOffset);
+}
+
+}  // namespace lspcore
@@ -0,0 +1,130 @@
+#ifndef INCLUDED_LSPCORE_HASHTABLE
+#define INCLUDED_LSPCORE_HASHTABLE
+
+// A hash table is a mutable map from keys to values. Unlike a 'HashMap',
+// which copies a path of its trie on every insertion, a hash table is
+// modified in place, so that, for example, counting occurrences of a key
+// that is already present allocates no memory. Keys may be any
+// 'bdld::Datum', and are hashed and compared using 'DatumUtil::hash' and
+// 'DatumUtil::equal', as in 'HashMap'.
+//
+// Entries are stored in one array using open addressing with linear probing
+// and "Robin Hood" insertion (Celis, "Robin Hood Hashing," 1986): an entry
+// being inserted displaces any entry it passes that is closer to its own
+// home slot, so that the distances of entries from their home slots stay
+// short and even. A lookup stops as soon as it reaches a slot whose entry is
+// closer to home than the key being sought would be, because the key would
+// have displaced that entry. The probe distance of each slot is kept in a
+// separate array from the entries, so that a probe reads mostly contiguous
+// integers, and each entry stores its key's hash, so that keys are compared
+// only when their hashes are equal.
+//
+// A hash table is not safe to use concurrently. Hash tables are equal only
+// to themselves.
+
+#include <bdld_datum.h>
+#include <bdld_datumudt.h>
+#include <bsl_cstddef.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+class HashTable {
+  public:
+    struct Entry {
+        bdld::Datum key;
+        bdld::Datum value;
+        bsl::size_t hash;  // 'DatumUtil::hash' of 'key'
+    };
+
+    // 'Cursor' visits the entries of a 'HashTable' in an unspecified order.
+    // The behavior is undefined if the table is modified during the visit.
+    class Cursor {
+        const HashTable* d_table_p;
+        bsl::size_t      d_slot;
+
+        void settle();
+
+      public:
+        explicit Cursor(const HashTable& table);
+
+        bool         done() const;
+        const Entry& entry() const;
+        void         advance();
+    };
+
+  private:
+    // 'd_distances[i]' is one more than the distance of 'd_entries[i]' from
+    // its key's home slot, or zero if slot 'i' is empty.
+    unsigned*         d_distances;
+    Entry*            d_entries;
+    bsl::size_t       d_capacity;  // zero or a power of two
+    bsl::size_t       d_size;
+    int               d_typeOffset;
+    bslma::Allocator* d_allocator_p;
+
+    HashTable(const HashTable&);             // = delete
+    HashTable& operator=(const HashTable&);  // = delete
+
+    // Return the slot of the entry having the specified 'key', whose hash is
+    // the specified 'hash', or return 'd_capacity' if there is none.
+    bsl::size_t findSlot(const bdld::Datum& key, bsl::size_t hash) const;
+
+    // Store the specified 'entry' without checking whether its key is
+    // already present. The behavior is undefined unless there is room.
+    void place(Entry entry);
+
+    void grow();
+
+  public:
+    HashTable(int typeOffset, bslma::Allocator*);
+
+    bsl::size_t size() const;
+
+    // Return 'DatumUtil::hash' of the specified 'key'. The hash of a key can
+    // be computed once and passed to both 'find' and 'insert'.
+    bsl::size_t hash(const bdld::Datum& key) const;
+
+    // Return a pointer to the value associated with the specified 'key',
+    // whose hash is the specified 'hash', or return a null pointer if there
+    // is none. The pointer is valid until the table is next modified.
+    const bdld::Datum* find(const bdld::Datum& key, bsl::size_t hash) const;
+
+    // Associate the specified 'value' with the specified 'key', whose hash is
+    // the specified 'hash', replacing any value already associated with
+    // 'key'.
+    void insert(const bdld::Datum& key,
+                bsl::size_t        hash,
+                const bdld::Datum& value);
+
+    static bool isHashTable(const bdld::Datum&, int typeOffset);
+    static bool isHashTable(const bdld::DatumUdt&, int typeOffset);
+
+    static HashTable* access(const bdld::Datum&);
+    static HashTable* access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(HashTable* table, int typeOffset);
+};
+
+inline bsl::size_t HashTable::size() const {
+    return d_size;
+}
+
+inline bool HashTable::Cursor::done() const {
+    return d_slot == d_table_p->d_capacity;
+}
+
+inline const HashTable::Entry& HashTable::Cursor::entry() const {
+    return d_table_p->d_entries[d_slot];
+}
+
+}  // namespace lspcore
+
+#endif
@@ -2,15 +2,21 @@
 #include <bdld_datumintmapbuilder.h>
 #include <bdld_datummapowningkeysbuilder.h>
 #include <bsl_cstddef.h>
+#include <bsl_limits.h>
+#include <bsl_memory.h>
 #include <bsl_sstream.h>
 #include <bsl_unordered_set.h>
 #include <bslma_managedptr.h>
 #include <lspcore_builtins.h>
 #include <lspcore_interpreter.h>
 #include <lspcore_listutil.h>
+#include <lspcore_mutablevector.h>
 #include <lspcore_pair.h>
 #include <lspcore_printutil.h>
 #include <lspcore_procedure.h>
+#include <lspcore_quasiquote.h>
+#include <lspcore_record.h>
+#include <lspcore_rrbvector.h>
 #include <lspcore_symbolutil.h>
 #include <lspcore_userdefinedtypes.h>
 
@@ -30,6 +36,10 @@ void defineDefaultGlobalEnvironment(Environment& environment, int typeOffset) {
     defineBuiltin(environment, Builtins::e_SET, typeOffset);
     defineBuiltin(environment, Builtins::e_IF, typeOffset);
     defineBuiltin(environment, Builtins::e_QUOTE, typeOffset);
+    defineBuiltin(environment, Builtins::e_DEFINE_RECORD, typeOffset);
+    defineBuiltin(environment, Builtins::e_QUASIQUOTE, typeOffset);
+    defineBuiltin(environment, Builtins::e_UNQUOTE, typeOffset);
+    defineBuiltin(environment, Builtins::e_UNQUOTE_SPLICING, typeOffset);
 
     // alternative spellings
     environment.define("lambda",
@@ -40,7 +50,8 @@ void defineDefaultGlobalEnvironment(Environment& environment, int typeOffset) {
 
 Interpreter::Interpreter(int typeOffset, bslma::Allocator* allocator)
 : d_globals(allocator)
-, d_typeOffset(typeOffset) {
+, d_typeOffset(typeOffset)
+, d_threadPool_p(0) {
     defineDefaultGlobalEnvironment(d_globals, d_typeOffset);
 }
 
@@ -94,6 +105,59 @@ bdld::Datum Interpreter::evaluateExpression(const bdld::Datum& expression,
     }
 }
 
+bdld::Datum Interpreter::invoke(const bdld::Datum& procedure,
+                                const bdld::Datum* arguments,
+                                bsl::size_t        count,
+                                Environment&       environment) {
+    if (NativeProcedureUtil::isNativeProcedure(procedure, d_typeOffset)) {
+        bsl::vector<bdld::Datum> argumentsAndResult(arguments,
+                                                    arguments + count);
+        const NativeProcedureUtil::Arguments args = {
+            &argumentsAndResult, &environment, d_typeOffset, this, allocator()
+        };
+        NativeProcedureUtil::invoke(procedure, args);
+        BSLS_ASSERT_OPT(argumentsAndResult.size() == 1);
+        return argumentsAndResult[0];
+    }
+
+    if (RecordAccessor::isRecordAccessor(procedure, d_typeOffset)) {
+        if (count != 1) {
+            bsl::ostringstream error;
+            error << "record accessor takes 1 argument, but was invoked with "
+                  << count;
+            throw bdld::Datum::createError(-1, error.str(), allocator());
+        }
+        return loadSlot(RecordAccessor::access(procedure), arguments[0]);
+    }
+
+    if (!Procedure::isProcedure(procedure, d_typeOffset)) {
+        bsl::ostringstream error;
+        error << "cannot be invoked as a procedure: ";
+        PrintUtil::print(error, procedure, d_typeOffset);
+        throw bdld::Datum::createError(-1, error.str(), allocator());
+    }
+
+    // 'invokeProcedure' evaluates the argument forms, so quote each argument
+    // to make it evaluate to itself, e.g. a symbol argument must not be
+    // looked up in 'environment'.
+    const bdld::Datum quote =
+        Builtins::toDatum(Builtins::e_QUOTE, d_typeOffset);
+    bdld::Datum tail = bdld::Datum::createNull();
+    for (bsl::size_t i = count; i > 0; --i) {
+        const bdld::Datum quoted = Pair::create(
+            quote,
+            Pair::create(arguments[i - 1],
+                         bdld::Datum::createNull(),
+                         d_typeOffset,
+                         allocator()),
+            d_typeOffset,
+            allocator());
+        tail = Pair::create(quoted, tail, d_typeOffset, allocator());
+    }
+
+    return invokeProcedure(procedure.theUdt(), tail, environment);
+}
+
 int Interpreter::defineNativeProcedure(bsl::string_view name,
                                        NativeFunc*      function) {
     return !d_globals
@@ -116,6 +180,26 @@ void Interpreter::collectGarbage() {
     // TODO
 }
 
+namespace {
+
+// Return the map built by the specified 'builder', whose entries are in the
+// same order as those of a map that is sorted if the specified 'sorted' is
+// 'true'. Maps are always committed sorted, so that invoking a map as a
+// function of its keys is a binary search rather than a linear scan. Note
+// that this works for both 'bdld::DatumMapOwningKeysBuilder' and
+// 'bdld::DatumIntMapBuilder'.
+template <typename Builder>
+bdld::Datum commitMap(Builder* builder, bool sorted) {
+    if (sorted) {
+        builder->setSorted(true);
+        return builder->commit();
+    }
+
+    return builder->sortAndCommit();
+}
+
+}  // namespace
+
 bdld::Datum Interpreter::evaluateArray(const bdld::DatumArrayRef& array,
                                        Environment& environment) {
     BSLS_ASSERT(array.length() != 0);
@@ -136,7 +220,7 @@ bdld::Datum Interpreter::evaluateStringMap(const bdld::DatumMapRef& map,
                          evaluateExpression(map[i].value(), environment));
     }
 
-    return builder.commit();
+    return commitMap(&builder, map.isSorted());
 }
 
 bdld::Datum Interpreter::evaluateIntMap(const bdld::DatumIntMapRef& map,
@@ -147,7 +231,7 @@ bdld::Datum Interpreter::evaluateIntMap(const bdld::DatumIntMapRef& map,
                          evaluateExpression(map[i].value(), environment));
     }
 
-    return builder.commit();
+    return commitMap(&builder, map.isSorted());
 }
 
 namespace {
@@ -199,15 +283,16 @@ bdld::Datum Interpreter::evaluatePair(const Pair&  pair,
             return invokeArray(head.theArray(), pair, environment);
         case bdld::Datum::e_MAP:
         case bdld::Datum::e_INT_MAP:
-            // TODO: These are functions of their keys.
-            throw bdld::Datum::createError(
-                -1, "invoking dicts/vectors not yet implemented", allocator());
+            return invokeMap(head, pair, environment);
         case bdld::Datum::e_USERDEFINED: {
             const bdld::DatumUdt udt = head.theUdt();
             // Valid cases:
             // - procedure
             // - native procedure
             // - builtin
+            // - RRB vector
+            // - mutable vector
+            // - record accessor
             //
             // Otherwise, fall through to the next section, which produces an
             // error.
@@ -219,6 +304,15 @@ bdld::Datum Interpreter::evaluatePair(const Pair&  pair,
                 // TODO: Could have it return a continuation in the future.
                 return invokeNative(udt, pair.second, environment);
             }
+            if (RrbVector::isRrbVector(udt, d_typeOffset)) {
+                return invokeRrbVector(udt, pair, environment);
+            }
+            if (MutableVector::isMutableVector(udt, d_typeOffset)) {
+                return invokeMutableVector(udt, pair, environment);
+            }
+            if (RecordAccessor::isRecordAccessor(udt, d_typeOffset)) {
+                return invokeRecordAccessor(udt, pair, environment);
+            }
             if (Builtins::isBuiltin(udt, d_typeOffset)) {
                 switch (Builtins::fromUdtData(udt.data())) {
                     case Builtins::e_LAMBDA:
@@ -235,6 +329,20 @@ bdld::Datum Interpreter::evaluatePair(const Pair&  pair,
                         return evaluateExpression(
                             partiallyEvaluateIf(pair.second, environment),
                             environment);
+                    case Builtins::e_DEFINE_RECORD:
+                        return evaluateDefineRecord(pair.second, environment);
+                    case Builtins::e_QUASIQUOTE:
+                        return evaluateQuasiquote(pair.second, environment);
+                    case Builtins::e_UNQUOTE:
+                    case Builtins::e_UNQUOTE_SPLICING: {
+                        bsl::ostringstream error;
+                        error << '"'
+                              << Builtins::name(
+                                     Builtins::fromUdtData(udt.data()))
+                              << "\" form must be within a quasiquote form";
+                        throw bdld::Datum::createError(
+                            -1, error.str(), allocator());
+                    }
                     case Builtins::e_UNDEFINED:
                         break;
                 }
@@ -468,7 +576,7 @@ bdld::Datum Interpreter::partiallyResolve(
                                                   restParameter,
                                                   environment));
             }
-            return builder.commit();
+            return commitMap(&builder, map.isSorted());
         }
         case bdld::Datum::e_INT_MAP: {
             const bdld::DatumIntMapRef map = form.theIntMap();
@@ -480,7 +588,7 @@ bdld::Datum Interpreter::partiallyResolve(
                                                   restParameter,
                                                   environment));
             }
-            return builder.commit();
+            return commitMap(&builder, map.isSorted());
         }
         default:
             BSLS_ASSERT(form.type() == bdld::Datum::e_USERDEFINED);
@@ -548,6 +656,9 @@ bdld::Datum Interpreter::partiallyResolvePair(
     // If 'head' is a symbol that resolved to a builtin, or if 'head' is itself
     // a builtin, then we might have special handling for this form. Use
     // 'e_UNDEFINED' to mean "no special handling" ('e_IF' would work as well).
+    // A symbol that resolved to anything else, such as a record accessor, is
+    // left as a symbol, because its name might be redefined before the form
+    // is evaluated.
     Builtins::Builtin headBuiltin = Builtins::e_UNDEFINED;
     if (Builtins::isBuiltin(head, d_typeOffset)) {
         headBuiltin = Builtins::access(head);
@@ -568,6 +679,7 @@ bdld::Datum Interpreter::partiallyResolvePair(
     switch (headBuiltin) {
         case Builtins::e_LAMBDA:
         case Builtins::e_QUOTE:
+        case Builtins::e_DEFINE_RECORD:
             // skip these forms
             return pairDatum;
         case Builtins::e_DEFINE:
@@ -576,7 +688,15 @@ bdld::Datum Interpreter::partiallyResolvePair(
             // resolve only the 'value'
             skipFirstArgument = true;
             break;
+        case Builtins::e_QUASIQUOTE:
+            return partiallyResolveQuasiquote(pairDatum,
+                                              head,
+                                              positionalParameters,
+                                              restParameter,
+                                              environment);
         case Builtins::e_IF:
+        case Builtins::e_UNQUOTE:
+        case Builtins::e_UNQUOTE_SPLICING:
         case Builtins::e_UNDEFINED:
             break;
     }
@@ -615,6 +735,270 @@ bdld::Datum Interpreter::partiallyResolvePair(
     return ListUtil::createList(items, d_typeOffset, allocator());
 }
 
+namespace {
+
+// If the specified 'form' is a list of two elements whose first element is
+// the symbol having the specified 'name', e.g. '(unquote x)' when 'name' is
+// "unquote", then load the second element into the specified '*argument' and
+// return 'true'. Otherwise, return 'false'.
+bool matchQuoteLike(bdld::Datum*       argument,
+                    const bdld::Datum& form,
+                    bsl::string_view   name,
+                    int                typeOffset) {
+    if (!Pair::isPair(form, typeOffset)) {
+        return false;
+    }
+
+    const Pair& pair = Pair::access(form);
+    if (!SymbolUtil::isSymbol(pair.first, typeOffset) ||
+        !Pair::isPair(pair.second, typeOffset) ||
+        !Pair::access(pair.second).second.isNull()) {
+        return false;
+    }
+
+    const bdld::Datum      nameDatum = SymbolUtil::name(pair.first);
+    const bsl::string_view symbol    = nameDatum.theString();
+    if (symbol != name) {
+        return false;
+    }
+
+    *argument = Pair::access(pair.second).first;
+    return true;
+}
+
+Quasiquote::Node makeNode(Quasiquote::Node::Kind kind,
+                          const bdld::Datum&     datum) {
+    const Quasiquote::Node node = { kind, datum, 0, 0 };
+    return node;
+}
+
+// Return a copy of the specified 'nodes' in memory supplied by the specified
+// 'allocator'.
+const Quasiquote::Node* copyNodes(const bsl::vector<Quasiquote::Node>& nodes,
+                                  bslma::Allocator* allocator) {
+    Quasiquote::Node* const result = static_cast<Quasiquote::Node*>(
+        allocator->allocate(nodes.size() * sizeof(Quasiquote::Node)));
+    bsl::uninitialized_copy(nodes.begin(), nodes.end(), result);
+    return result;
+}
+
+}  // namespace
+
+bdld::Datum Interpreter::partiallyResolveQuasiquote(
+    const bdld::Datum&              form,
+    const bdld::Datum&              head,
+    const bsl::vector<bsl::string>& positionalParameters,
+    const bsl::string&              restParameter,
+    const Environment&              environment) {
+    // Analyze the template of the quasiquote 'form' once, here, and replace
+    // the template by its analysis, so that each evaluation of the resulting
+    // form need only fill in the holes. 'head' is the resolved 'form.first'.
+    const bdld::Datum& tail = Pair::access(form).second;
+    if (!Pair::isPair(tail, d_typeOffset) ||
+        !Pair::access(tail).second.isNull()) {
+        // 'evaluateQuasiquote' will report the error.
+        return form;
+    }
+
+    const bdld::Datum& templateDatum = Pair::access(tail).first;
+    if (Quasiquote::isQuasiquote(templateDatum, d_typeOffset)) {
+        return form;
+    }
+
+    const Quasiquote* const quasiquote = new (*allocator())
+        Quasiquote(templateDatum,
+                   analyzeQuasiquote(templateDatum,
+                                     0,
+                                     positionalParameters,
+                                     restParameter,
+                                     environment));
+
+    return Pair::create(
+        head,
+        Pair::create(Quasiquote::create(quasiquote, d_typeOffset),
+                     bdld::Datum::createNull(),
+                     d_typeOffset,
+                     allocator()),
+        d_typeOffset,
+        allocator());
+}
+
+Quasiquote::Node Interpreter::analyzeQuasiquote(
+    const bdld::Datum&              form,
+    int                             depth,
+    const bsl::vector<bsl::string>& positionalParameters,
+    const bsl::string&              restParameter,
+    const Environment&              environment) {
+    bdld::Datum argument;
+    if (depth == 0) {
+        if (matchQuoteLike(&argument, form, "unquote", d_typeOffset)) {
+            return makeNode(Quasiquote::Node::e_UNQUOTE,
+                            partiallyResolve(argument,
+                                             positionalParameters,
+                                             restParameter,
+                                             environment));
+        }
+        if (matchQuoteLike(
+                &argument, form, "unquote-splicing", d_typeOffset)) {
+            throw bdld::Datum::createError(
+                -1,
+                "\"unquote-splicing\" form must be an element of a list or "
+                "an array in a quasiquote template",
+                allocator());
+        }
+    }
+
+    if (Pair::isPair(form, d_typeOffset)) {
+        return analyzeQuasiquoteList(
+            form, depth, positionalParameters, restParameter, environment);
+    }
+    if (form.isArray()) {
+        return analyzeQuasiquoteArray(form.theArray(),
+                                      form,
+                                      depth,
+                                      positionalParameters,
+                                      restParameter,
+                                      environment);
+    }
+
+    // Anything else, including a map, is a constant.
+    return makeNode(Quasiquote::Node::e_CONSTANT, form);
+}
+
+Quasiquote::Node Interpreter::analyzeQuasiquoteList(
+    const bdld::Datum&              list,
+    int                             depth,
+    const bsl::vector<bsl::string>& positionalParameters,
+    const bsl::string&              restParameter,
+    const Environment&              environment) {
+    // The holes within a nested quasiquote form belong to that form, so the
+    // argument of a nested 'quasiquote' is one level deeper, and the argument
+    // of an 'unquote' or 'unquote-splicing' within it is one level shallower.
+    bdld::Datum argument;
+    int         argumentDepth = depth;
+    if (matchQuoteLike(&argument, list, "quasiquote", d_typeOffset)) {
+        argumentDepth = depth + 1;
+    }
+    else if (matchQuoteLike(&argument, list, "unquote", d_typeOffset) ||
+             matchQuoteLike(
+                 &argument, list, "unquote-splicing", d_typeOffset)) {
+        BSLS_ASSERT(depth > 0);
+        argumentDepth = depth - 1;
+    }
+
+    // 'suffixes[i]' is the part of 'list' that begins with element 'i'.
+    bsl::vector<Quasiquote::Node> children;
+    bsl::vector<bdld::Datum>      suffixes;
+    Quasiquote::Node              tail =
+        makeNode(Quasiquote::Node::e_CONSTANT, bdld::Datum::createNull());
+    bdld::Datum rest         = list;
+    int         elementDepth = depth;
+    for (;;) {
+        if (!Pair::isPair(rest, d_typeOffset)) {
+            tail.datum = rest;
+            break;
+        }
+        if (depth == 0 && !suffixes.empty() &&
+            matchQuoteLike(&argument, rest, "unquote", d_typeOffset)) {
+            // '(a . ,b)' is read as '(a unquote b)', whose tail is a hole.
+            tail = makeNode(Quasiquote::Node::e_UNQUOTE,
+                            partiallyResolve(argument,
+                                             positionalParameters,
+                                             restParameter,
+                                             environment));
+            break;
+        }
+
+        const Pair& pair = Pair::access(rest);
+        suffixes.push_back(rest);
+        if (elementDepth == 0 &&
+            matchQuoteLike(
+                &argument, pair.first, "unquote-splicing", d_typeOffset)) {
+            children.push_back(
+                makeNode(Quasiquote::Node::e_UNQUOTE_SPLICING,
+                         partiallyResolve(argument,
+                                          positionalParameters,
+                                          restParameter,
+                                          environment)));
+        }
+        else {
+            children.push_back(analyzeQuasiquote(pair.first,
+                                                 elementDepth,
+                                                 positionalParameters,
+                                                 restParameter,
+                                                 environment));
+        }
+        elementDepth = argumentDepth;
+        rest         = pair.second;
+    }
+
+    // Share the longest suffix of the list that contains no holes.
+    bsl::size_t count = children.size();
+    if (tail.kind == Quasiquote::Node::e_CONSTANT) {
+        while (count &&
+               children[count - 1].kind == Quasiquote::Node::e_CONSTANT) {
+            --count;
+        }
+        if (count == 0) {
+            return makeNode(Quasiquote::Node::e_CONSTANT, list);
+        }
+        if (count < suffixes.size()) {
+            tail.datum = suffixes[count];
+        }
+        children.resize(count);
+    }
+    children.push_back(tail);
+
+    const Quasiquote::Node node = { Quasiquote::Node::e_LIST,
+                                    bdld::Datum::createNull(),
+                                    copyNodes(children, allocator()),
+                                    count };
+    return node;
+}
+
+Quasiquote::Node Interpreter::analyzeQuasiquoteArray(
+    const bdld::DatumArrayRef&      array,
+    const bdld::Datum&              form,
+    int                             depth,
+    const bsl::vector<bsl::string>& positionalParameters,
+    const bsl::string&              restParameter,
+    const Environment&              environment) {
+    bsl::vector<Quasiquote::Node> children;
+    bool                          isConstant = true;
+    for (bsl::size_t i = 0; i < array.length(); ++i) {
+        bdld::Datum argument;
+        if (depth == 0 &&
+            matchQuoteLike(
+                &argument, array[i], "unquote-splicing", d_typeOffset)) {
+            children.push_back(
+                makeNode(Quasiquote::Node::e_UNQUOTE_SPLICING,
+                         partiallyResolve(argument,
+                                          positionalParameters,
+                                          restParameter,
+                                          environment)));
+        }
+        else {
+            children.push_back(analyzeQuasiquote(array[i],
+                                                 depth,
+                                                 positionalParameters,
+                                                 restParameter,
+                                                 environment));
+        }
+        isConstant = isConstant &&
+                     children.back().kind == Quasiquote::Node::e_CONSTANT;
+    }
+
+    if (isConstant) {
+        return makeNode(Quasiquote::Node::e_CONSTANT, form);
+    }
+
+    const Quasiquote::Node node = { Quasiquote::Node::e_ARRAY,
+                                    bdld::Datum::createNull(),
+                                    copyNodes(children, allocator()),
+                                    children.size() };
+    return node;
+}
+
 bdld::Datum Interpreter::partiallyEvaluateIf(const bdld::Datum& tail,
                                              Environment&       environment) {
     // An 'if' form has three arguments:
@@ -729,6 +1113,128 @@ bdld::Datum Interpreter::evaluateDefine(const bdld::Datum& tail,
     return value;
 }
 
+namespace {
+
+// 'RecordConstructor' is the native procedure that 'define-record' binds to,
+// e.g., 'make-point'. It returns a record whose slots are its arguments.
+class RecordConstructor {
+    const RecordType* d_type_p;
+
+  public:
+    explicit RecordConstructor(const RecordType* type)
+    : d_type_p(type) {
+    }
+
+    void operator()(const NativeProcedureUtil::Arguments& args) const {
+        const bsl::vector<bdld::Datum>& slots = *args.argsAndOutput;
+        if (slots.size() != d_type_p->fields.size()) {
+            bsl::ostringstream error;
+            error << "procedure \"make-" << d_type_p->name << "\" takes "
+                  << d_type_p->fields.size()
+                  << " arguments, but was invoked with " << slots.size();
+            throw bdld::Datum::createError(-1, error.str(), args.allocator);
+        }
+
+        const bdld::Datum result = Record::create(
+            d_type_p, slots.data(), args.typeOffset, args.allocator);
+        args.argsAndOutput->resize(1);
+        args.argsAndOutput->front() = result;
+    }
+};
+
+// 'RecordPredicate' is the native procedure that 'define-record' binds to,
+// e.g., 'point?'. It returns whether its argument is a record of its type.
+class RecordPredicate {
+    const RecordType* d_type_p;
+
+  public:
+    explicit RecordPredicate(const RecordType* type)
+    : d_type_p(type) {
+    }
+
+    void operator()(const NativeProcedureUtil::Arguments& args) const {
+        if (args.argsAndOutput->size() != 1) {
+            bsl::ostringstream error;
+            error << "procedure \"" << d_type_p->name
+                  << "?\" takes 1 arguments, but was invoked with "
+                  << args.argsAndOutput->size();
+            throw bdld::Datum::createError(-1, error.str(), args.allocator);
+        }
+
+        const bdld::Datum& value = args.argsAndOutput->front();
+        args.argsAndOutput->front() = bdld::Datum::createBoolean(
+            Record::isRecord(value, args.typeOffset) &&
+            &Record::access(value).type() == d_type_p);
+    }
+};
+
+}  // namespace
+
+bdld::Datum Interpreter::evaluateDefineRecord(const bdld::Datum& tail,
+                                              Environment&       environment) {
+    // 'tail' is the part of the form following the "define-record" symbol.
+    //
+    //     (name field ...)
+    //
+    // where 'name' and each 'field' are symbols. See 'lspcore_record.h' for
+    // what is defined.
+    if (!Pair::isPair(tail, d_typeOffset) ||
+        !SymbolUtil::isSymbol(Pair::access(tail).first, d_typeOffset)) {
+        throw bdld::Datum::createError(
+            -1,
+            "\"define-record\" form's first argument must be a symbol naming "
+            "the record type",
+            allocator());
+    }
+
+    RecordType* const type = new (*allocator()) RecordType(allocator());
+    const Pair&       form = Pair::access(tail);
+    type->name = SymbolUtil::name(form.first).theString();
+
+    bsl::unordered_set<bsl::string> fieldNames;
+    bdld::Datum                     rest = form.second;
+    while (Pair::isPair(rest, d_typeOffset)) {
+        const Pair&        pair  = Pair::access(rest);
+        const bdld::Datum& field = pair.first;
+        if (!SymbolUtil::isSymbol(field, d_typeOffset)) {
+            throw bdld::Datum::createError(
+                -1, "\"define-record\" fields must be symbols", allocator());
+        }
+        const bdld::Datum name = SymbolUtil::name(field);
+        if (!fieldNames.insert(name.theString()).second) {
+            bsl::ostringstream error;
+            error << "duplicate record field name: " << name.theString();
+            throw bdld::Datum::createError(-1, error.str(), allocator());
+        }
+        type->fields.push_back(name.theString());
+
+        rest = pair.second;
+    }
+
+    if (!rest.isNull()) {
+        throw bdld::Datum::createError(
+            -1, "\"define-record\" form must be a proper list", allocator());
+    }
+
+    const bdld::Datum result = RecordType::create(type, d_typeOffset);
+    environment.defineOrRedefine(type->name, result);
+    environment.defineOrRedefine(
+        "make-" + type->name,
+        NativeProcedureUtil::create(
+            RecordConstructor(type), d_typeOffset, allocator()));
+    environment.defineOrRedefine(
+        type->name + "?",
+        NativeProcedureUtil::create(
+            RecordPredicate(type), d_typeOffset, allocator()));
+    for (bsl::size_t i = 0; i < type->fields.size(); ++i) {
+        environment.defineOrRedefine(
+            type->name + "-" + type->fields[i],
+            RecordAccessor::create(type, i, d_typeOffset, allocator()));
+    }
+
+    return result;
+}
+
 bdld::Datum Interpreter::evaluateQuote(const bdld::Datum& tail) {
     if (Pair::isPair(tail, d_typeOffset)) {
         const Pair& pair = Pair::access(tail);
@@ -744,6 +1250,137 @@ bdld::Datum Interpreter::evaluateQuote(const bdld::Datum& tail) {
         allocator());
 }
 
+bdld::Datum Interpreter::evaluateQuasiquote(const bdld::Datum& tail,
+                                            Environment&       environment) {
+    if (!Pair::isPair(tail, d_typeOffset) ||
+        !Pair::access(tail).second.isNull()) {
+        throw bdld::Datum::createError(
+            -1,
+            "\"quasiquote\" form must be a proper list having two elements: "
+            "\"quasiquote\" and one argument",
+            allocator());
+    }
+
+    const bdld::Datum& templateDatum = Pair::access(tail).first;
+    if (Quasiquote::isQuasiquote(templateDatum, d_typeOffset)) {
+        return instantiate(Quasiquote::access(templateDatum).root(),
+                           environment);
+    }
+
+    // The form is not part of a procedure body, so its template was not
+    // analyzed in advance. Analyze it now, with no parameters to resolve.
+    return instantiate(analyzeQuasiquote(templateDatum,
+                                         0,
+                                         bsl::vector<bsl::string>(),
+                                         bsl::string(),
+                                         environment),
+                       environment);
+}
+
+bdld::Datum Interpreter::instantiate(const Quasiquote::Node& node,
+                                     Environment&            environment) {
+    typedef Quasiquote::Node Node;
+
+    switch (node.kind) {
+        case Node::e_CONSTANT:
+            return node.datum;
+        case Node::e_UNQUOTE:
+            return evaluateExpression(node.datum, environment);
+        case Node::e_LIST: {
+            BSLS_ASSERT(node.count > 0);
+
+            // If the list ends with an 'unquote-splicing' form, then the
+            // spliced list becomes the tail of the result as it is.
+            const Node& tailNode = node.children[node.count];
+            bsl::size_t count    = node.count;
+            const bool  shareLast =
+                tailNode.kind == Node::e_CONSTANT &&
+                tailNode.datum.isNull() &&
+                node.children[count - 1].kind == Node::e_UNQUOTE_SPLICING;
+            if (shareLast) {
+                --count;
+            }
+
+            bsl::vector<bdld::Datum> elements;
+            for (bsl::size_t i = 0; i < count; ++i) {
+                instantiateElement(&elements, node.children[i], environment);
+            }
+
+            bdld::Datum tail;
+            if (shareLast) {
+                tail = evaluateExpression(node.children[count].datum,
+                                          environment);
+                if (!tail.isNull() && !Pair::isPair(tail, d_typeOffset)) {
+                    splice(&elements, tail);
+                    tail = bdld::Datum::createNull();
+                }
+            }
+            else {
+                tail = instantiate(tailNode, environment);
+            }
+
+            for (bsl::size_t i = elements.size(); i > 0; --i) {
+                tail = Pair::create(
+                    elements[i - 1], tail, d_typeOffset, allocator());
+            }
+            return tail;
+        }
+        case Node::e_ARRAY: {
+            bsl::vector<bdld::Datum> elements;
+            for (bsl::size_t i = 0; i < node.count; ++i) {
+                instantiateElement(&elements, node.children[i], environment);
+            }
+
+            bdld::DatumArrayBuilder builder(allocator());
+            for (bsl::size_t i = 0; i < elements.size(); ++i) {
+                builder.pushBack(elements[i]);
+            }
+            return builder.commit();
+        }
+        case Node::e_UNQUOTE_SPLICING:
+            break;
+    }
+
+    BSLS_ASSERT_OPT(!"'unquote-splicing' is instantiated only as an element");
+    return bdld::Datum::createNull();
+}
+
+void Interpreter::instantiateElement(bsl::vector<bdld::Datum>* output,
+                                     const Quasiquote::Node&   node,
+                                     Environment&              environment) {
+    if (node.kind == Quasiquote::Node::e_UNQUOTE_SPLICING) {
+        splice(output, evaluateExpression(node.datum, environment));
+    }
+    else {
+        output->push_back(instantiate(node, environment));
+    }
+}
+
+void Interpreter::splice(bsl::vector<bdld::Datum>* output,
+                         const bdld::Datum&        sequence) {
+    if (sequence.isArray()) {
+        const bdld::DatumArrayRef array = sequence.theArray();
+        output->insert(
+            output->end(), array.data(), array.data() + array.length());
+        return;
+    }
+
+    bdld::Datum rest = sequence;
+    while (Pair::isPair(rest, d_typeOffset)) {
+        const Pair& pair = Pair::access(rest);
+        output->push_back(pair.first);
+        rest = pair.second;
+    }
+
+    if (!rest.isNull()) {
+        bsl::ostringstream error;
+        error << "value of \"unquote-splicing\" form must be a proper list or "
+                 "an array, not: ";
+        PrintUtil::print(error, sequence, d_typeOffset);
+        throw bdld::Datum::createError(-1, error.str(), allocator());
+    }
+}
+
 bdld::Datum Interpreter::invokeProcedure(const bdld::DatumUdt& procedure,
                                          const bdld::Datum&    tail,
                                          Environment&          environment) {
@@ -970,30 +1607,93 @@ bdld::Datum Interpreter::invokeArray(const bdld::DatumArrayRef& array,
                                      Environment&               environment) {
     // Arrays are functions of their indices, e.g. '([9 8 7 6] 2)' is '7',
     // because the element at offset '2' in the array is '7'.
-    //
-    // There must be exactly one argument, and it must be either an integer or
-    // an integer64.
+    return array[evaluateIndex("array", array.length(), form, environment)];
+}
 
-    if (!Pair::isPair(form.second, d_typeOffset)) {
+bdld::Datum Interpreter::invokeRrbVector(const bdld::DatumUdt& vector,
+                                         const Pair&           form,
+                                         Environment&          environment) {
+    // RRB vectors are functions of their indices, as arrays are.
+    const RrbVector* const elements = RrbVector::access(vector);
+    return RrbVector::nth(
+        elements,
+        evaluateIndex(
+            "vector", RrbVector::size(elements), form, environment));
+}
+
+bdld::Datum Interpreter::invokeMutableVector(const bdld::DatumUdt& vector,
+                                             const Pair&           form,
+                                             Environment& environment) {
+    // Mutable vectors are functions of their indices, as arrays are.
+    const MutableVector& elements = *MutableVector::access(vector);
+    return elements[evaluateIndex(
+        "vector", elements.size(), form, environment)];
+}
+
+bdld::Datum Interpreter::invokeRecordAccessor(const bdld::DatumUdt& accessor,
+                                              const Pair&           form,
+                                              Environment& environment) {
+    // Record accessors are functions of records, e.g. '(point-x p)' is the
+    // value of the "x" field of 'p'. The argument is evaluated here and the
+    // slot loaded directly, rather than by a native procedure, which would
+    // need a vector of arguments.
+    if (!Pair::isPair(form.second, d_typeOffset) ||
+        !Pair::access(form.second).second.isNull()) {
         throw bdld::Datum::createError(
             -1,
-            "array invocation form must be a proper list of two elements",
+            "record accessor invocation form must be a proper list of two "
+            "elements",
             allocator());
     }
 
+    return loadSlot(
+        RecordAccessor::access(accessor),
+        evaluateExpression(Pair::access(form.second).first, environment));
+}
+
+bdld::Datum Interpreter::loadSlot(const RecordAccessor& accessor,
+                                  const bdld::Datum&    record) {
+    if (!Record::isRecord(record, d_typeOffset) ||
+        &Record::access(record).type() != accessor.type) {
+        bsl::ostringstream error;
+        error << "argument to \"" << accessor.type->name << '-'
+              << accessor.type->fields[accessor.slot] << "\" must be a "
+              << accessor.type->name << " record, not: ";
+        PrintUtil::print(error, record, d_typeOffset);
+        throw bdld::Datum::createError(-1, error.str(), allocator());
+    }
+
+    return Record::access(record).slots()[accessor.slot];
+}
+
+bsl::size_t Interpreter::evaluateIndex(bsl::string_view kind,
+                                       bsl::size_t      length,
+                                       const Pair&      form,
+                                       Environment&     environment) {
+    // There must be exactly one argument, and it must be either an integer or
+    // an integer64 that is a valid index into a sequence of the specified
+    // 'length'.
+
+    if (!Pair::isPair(form.second, d_typeOffset)) {
+        bsl::ostringstream error;
+        error << kind
+              << " invocation form must be a proper list of two elements";
+        throw bdld::Datum::createError(-1, error.str(), allocator());
+    }
+
     const Pair& tail = Pair::access(form.second);
     if (!tail.second.isNull()) {
-        throw bdld::Datum::createError(
-            -1,
-            "array invocation form must be a proper list of two elements",
-            allocator());
+        bsl::ostringstream error;
+        error << kind
+              << " invocation form must be a proper list of two elements";
+        throw bdld::Datum::createError(-1, error.str(), allocator());
     }
 
     const bdld::Datum indexDatum = evaluateExpression(tail.first, environment);
     if (!indexDatum.isInteger() && !indexDatum.isInteger64()) {
         bsl::ostringstream error;
-        error << "argument to array invocation must be some kind of integer, "
-                 "not: "
+        error << "argument to " << kind
+              << " invocation must be some kind of integer, not: "
               << indexDatum << "  Error occurred in form: ";
         PrintUtil::print(error, form, d_typeOffset);
         throw bdld::Datum::createError(-1, error.str(), allocator());
@@ -1002,13 +1702,87 @@ bdld::Datum Interpreter::invokeArray(const bdld::DatumArrayRef& array,
     const bsls::Types::Int64 index = indexDatum.isInteger()
                                          ? indexDatum.theInteger()
                                          : indexDatum.theInteger64();
-    if (index < 0 || index >= bsls::Types::Int64(array.length())) {
+    if (index < 0 || index >= bsls::Types::Int64(length)) {
+        bsl::ostringstream error;
+        error << kind << " index out of range (" << index << ")";
+        throw bdld::Datum::createError(-1, error.str(), allocator());
+    }
+
+    return bsl::size_t(index);
+}
+
+bdld::Datum Interpreter::invokeMap(const bdld::Datum& map,
+                                   const Pair&        form,
+                                   Environment&       environment) {
+    // Maps are functions of their keys, e.g. '({"foo" 1 "bar" 2} "bar")' is
+    // '2', because the value associated with "bar" in the map is '2'.
+    //
+    // There must be exactly one argument, and it must be a string if 'map' is
+    // a string map, or either an integer or an integer64 if 'map' is an
+    // integer map. Maps are sorted when they are created (see 'commitMap'),
+    // so the lookup is a binary search.
+
+    if (!Pair::isPair(form.second, d_typeOffset)) {
+        throw bdld::Datum::createError(
+            -1,
+            "map invocation form must be a proper list of two elements",
+            allocator());
+    }
+
+    const Pair& tail = Pair::access(form.second);
+    if (!tail.second.isNull()) {
+        throw bdld::Datum::createError(
+            -1,
+            "map invocation form must be a proper list of two elements",
+            allocator());
+    }
+
+    const bdld::Datum  key   = evaluateExpression(tail.first, environment);
+    const bdld::Datum* value = 0;
+    if (map.isMap()) {
+        if (!key.isString()) {
+            bsl::ostringstream error;
+            error << "argument to string map invocation must be a string, "
+                     "not: "
+                  << key << "  Error occurred in form: ";
+            PrintUtil::print(error, form, d_typeOffset);
+            throw bdld::Datum::createError(-1, error.str(), allocator());
+        }
+        value = map.theMap().find(key.theString());
+    }
+    else {
+        BSLS_ASSERT(map.isIntMap());
+        if (!key.isInteger() && !key.isInteger64()) {
+            bsl::ostringstream error;
+            error << "argument to integer map invocation must be some kind of "
+                     "integer, not: "
+                  << key << "  Error occurred in form: ";
+            PrintUtil::print(error, form, d_typeOffset);
+            throw bdld::Datum::createError(-1, error.str(), allocator());
+        }
+        const bsls::Types::Int64 intKey =
+            key.isInteger() ? key.theInteger() : key.theInteger64();
+        if (intKey >= bsl::numeric_limits<int>::min() &&
+            intKey <= bsl::numeric_limits<int>::max()) {
+            value = map.theIntMap().find(int(intKey));
+        }
+    }
+
+    if (!value) {
         bsl::ostringstream error;
-        error << "array index out of range (" << index << ")";
+        error << "key not found in map: " << key;
         throw bdld::Datum::createError(-1, error.str(), allocator());
     }
 
-    return array[index];
+    return *value;
+}
+
+bdlmt::ThreadPool* Interpreter::threadPool() const {
+    return d_threadPool_p;
+}
+
+void Interpreter::setThreadPool(bdlmt::ThreadPool* threadPool) {
+    d_threadPool_p = threadPool;
 }
 
 bslma::Allocator* Interpreter::allocator() const {
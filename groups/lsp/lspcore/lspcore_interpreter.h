@@ -2,11 +2,16 @@
 #define INCLUDED_LSPCORE_INTERPRETER
 
 #include <bdld_datum.h>
+#include <bsl_cstddef.h>
 #include <bsl_string_view.h>
 #include <lspcore_environment.h>
 #include <lspcore_nativeprocedureutil.h>
+#include <lspcore_quasiquote.h>
 
 namespace BloombergLP {
+namespace bdlmt {
+class ThreadPool;
+}  // namespace bdlmt
 namespace bslma {
 class Allocator;
 }  // namespace bslma
@@ -15,12 +20,15 @@ class Allocator;
 namespace lspcore {
 namespace bslma = BloombergLP::bslma;
 namespace bdld  = BloombergLP::bdld;
+namespace bdlmt = BloombergLP::bdlmt;
 
 class Pair;
+struct RecordAccessor;
 
 class Interpreter {
-    Environment d_globals;
-    int         d_typeOffset;
+    Environment        d_globals;
+    int                d_typeOffset;
+    bdlmt::ThreadPool* d_threadPool_p;
 
   public:
     explicit Interpreter(int typeOffset, bslma::Allocator*);
@@ -35,6 +43,17 @@ class Interpreter {
     bdld::Datum evaluateExpression(const bdld::Datum& expression,
                                    Environment&       environment);
 
+    // Return the result of invoking the specified 'procedure', which is a
+    // procedure or a native procedure, with the specified 'count' arguments
+    // beginning at the specified 'arguments', in the specified
+    // 'environment'. Unlike the evaluation of an invocation form, the
+    // arguments are not evaluated. Throw an exception of 'bdld::Datum' error
+    // type if an error occurs.
+    bdld::Datum invoke(const bdld::Datum& procedure,
+                       const bdld::Datum* arguments,
+                       bsl::size_t        count,
+                       Environment&       environment);
+
     typedef NativeProcedureUtil::Signature NativeFunc;
 
     // Associate the specified 'name' in the global environment with the
@@ -46,6 +65,16 @@ class Interpreter {
 
     void collectGarbage();
 
+    // Return the thread pool that native procedures may use to divide up
+    // large computations, or return a null pointer if there is none. There is
+    // none by default.
+    bdlmt::ThreadPool* threadPool() const;
+
+    // Make the specified 'threadPool' available to native procedures, or
+    // make none available if 'threadPool' is null. The behavior is undefined
+    // unless the allocator supplied at construction is thread-safe.
+    void setThreadPool(bdlmt::ThreadPool* threadPool);
+
   private:
     bdld::Datum evaluateArray(const bdld::DatumArrayRef&, Environment&);
     bdld::Datum evaluateStringMap(const bdld::DatumMapRef&, Environment&);
@@ -54,7 +83,9 @@ class Interpreter {
     bdld::Datum evaluateSymbol(const bdld::Datum&, Environment&);
     bdld::Datum evaluateLambda(const bdld::Datum&, Environment&);
     bdld::Datum evaluateDefine(const bdld::Datum&, Environment&);
+    bdld::Datum evaluateDefineRecord(const bdld::Datum&, Environment&);
     bdld::Datum evaluateQuote(const bdld::Datum& tail);
+    bdld::Datum evaluateQuasiquote(const bdld::Datum& tail, Environment&);
 
     bdld::Datum invokeProcedure(const bdld::DatumUdt& procedure,
                                 const bdld::Datum&    tail,
@@ -65,6 +96,31 @@ class Interpreter {
     bdld::Datum invokeArray(const bdld::DatumArrayRef& array,
                             const Pair&                form,
                             Environment&);
+    bdld::Datum invokeRrbVector(const bdld::DatumUdt& vector,
+                                const Pair&           form,
+                                Environment&);
+    bdld::Datum invokeMutableVector(const bdld::DatumUdt& vector,
+                                    const Pair&           form,
+                                    Environment&);
+    bdld::Datum invokeRecordAccessor(const bdld::DatumUdt& accessor,
+                                     const Pair&           form,
+                                     Environment&);
+
+    // Return the value of the slot of the specified 'record' that is loaded
+    // by the specified 'accessor'. Throw an error if 'record' is not a record
+    // of the accessor's type.
+    bdld::Datum loadSlot(const RecordAccessor& accessor,
+                         const bdld::Datum&    record);
+
+    // Return the index that is the argument of the specified 'form', which
+    // invokes a sequence of the specified 'kind' and 'length'.
+    bsl::size_t evaluateIndex(bsl::string_view kind,
+                              bsl::size_t      length,
+                              const Pair&      form,
+                              Environment&);
+    bdld::Datum invokeMap(const bdld::Datum& map,
+                          const Pair&        form,
+                          Environment&);
 
     bdld::Datum partiallyResolve(
         const bdld::Datum&              form,
@@ -81,9 +137,54 @@ class Interpreter {
         const bsl::vector<bsl::string>& positionalParameters,
         const bsl::string&              restParameter,
         const Environment&);
+    bdld::Datum partiallyResolveQuasiquote(
+        const bdld::Datum&              form,
+        const bdld::Datum&              head,
+        const bsl::vector<bsl::string>& positionalParameters,
+        const bsl::string&              restParameter,
+        const Environment&);
 
     bdld::Datum partiallyEvaluateIf(const bdld::Datum& tail, Environment&);
 
+    // Return the analysis of the specified 'form', which is part of a
+    // quasiquote template nested within the specified 'depth' quasiquote
+    // forms beyond the outermost. The expressions in holes are resolved as by
+    // 'partiallyResolve'. Throw an error if the template is malformed.
+    Quasiquote::Node analyzeQuasiquote(
+        const bdld::Datum&              form,
+        int                             depth,
+        const bsl::vector<bsl::string>& positionalParameters,
+        const bsl::string&              restParameter,
+        const Environment&);
+    Quasiquote::Node analyzeQuasiquoteList(
+        const bdld::Datum&              list,
+        int                             depth,
+        const bsl::vector<bsl::string>& positionalParameters,
+        const bsl::string&              restParameter,
+        const Environment&);
+    Quasiquote::Node analyzeQuasiquoteArray(
+        const bdld::DatumArrayRef&      array,
+        const bdld::Datum&              form,
+        int                             depth,
+        const bsl::vector<bsl::string>& positionalParameters,
+        const bsl::string&              restParameter,
+        const Environment&);
+
+    // Return the value of the template part analyzed as the specified 'node'.
+    bdld::Datum instantiate(const Quasiquote::Node& node, Environment&);
+
+    // Append to the specified 'output' the value of the sequence element
+    // analyzed as the specified 'node', or the values spliced by it.
+    void instantiateElement(bsl::vector<bdld::Datum>* output,
+                            const Quasiquote::Node&   node,
+                            Environment&);
+
+    // Append to the specified 'output' the elements of the specified
+    // 'sequence', which is the value of an 'unquote-splicing' form. Throw an
+    // error if 'sequence' is neither a proper list nor an array.
+    void splice(bsl::vector<bdld::Datum>* output,
+                const bdld::Datum&        sequence);
+
     bslma::Allocator* allocator() const;
 };
 
@@ -0,0 +1,761 @@
+#include <bdlb_bitutil.h>
+#include <bsl_limits.h>
+#include <bsl_new.h>
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+#include <lspcore_datumutil.h>
+#include <lspcore_inttrie.h>
+#include <lspcore_userdefinedtypes.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+// Key Bits
+// ========
+// Keys are handled internally with their sign bit flipped (see 'flip'), so
+// that unsigned order is numeric order. The 'd_key' of a branch holds the
+// bits above its branching bit that are shared by all keys below it, with
+// the rest of the bits zero. The 'd_key' of a tip holds its keys with the
+// lowest six bits zero; the lowest six bits of a key select its bit in the
+// bitmap. Thus a tip is a branch whose lowest six levels are packed into a
+// single word.
+//
+// Every function below takes and returns null pointers for empty tries, and
+// returns one of its arguments, rather than a copy, wherever the result is
+// unchanged.
+class IntTrieImpl {
+  public:
+    typedef IntTrie::Int64  Int64;
+    typedef IntTrie::Uint64 Uint64;
+
+    static Uint64 flip(Int64 key) {
+        return Uint64(key) ^ (Uint64(1) << 63);
+    }
+
+    static Uint64 tipPrefix(Uint64 key) {
+        return key & ~Uint64(63);
+    }
+
+    static Uint64 tipBit(Uint64 key) {
+        return Uint64(1) << (key & 63);
+    }
+
+    // Return the specified 'key' with the specified 'bit' and all lower bits
+    // cleared.
+    static Uint64 highBits(Uint64 key, int bit) {
+        return bit == 63 ? 0 : key & (~Uint64(0) << (bit + 1));
+    }
+
+    static bool isZero(Uint64 key, int bit) {
+        return ((key >> bit) & 1) == 0;
+    }
+
+    // Return whether the specified 'key' belongs under the specified
+    // 'branch', i.e. whether it agrees with the branch's prefix.
+    static bool matches(Uint64 key, const IntTrie& branch) {
+        return highBits(key, branch.d_bit) == branch.d_key;
+    }
+
+    // Return the highest bit in which the specified 'left' and 'right'
+    // differ. The behavior is undefined if they are equal.
+    static int branchingBit(Uint64 left, Uint64 right) {
+        return 63 - bdlb::BitUtil::numLeadingUnsetBits(left ^ right);
+    }
+
+    // Return the smallest and largest (flipped) keys that could appear
+    // below the specified 'node'.
+    static Uint64 first(const IntTrie& node) {
+        return node.d_key;
+    }
+
+    static Uint64 last(const IntTrie& node) {
+        switch (node.d_kind) {
+            case IntTrie::e_BRANCH:
+                return node.d_key | ((Uint64(2) << node.d_bit) - 1);
+            case IntTrie::e_TIP:
+                return node.d_key | 63;
+            default:
+                BSLS_ASSERT(node.d_kind == IntTrie::e_LEAF);
+                return node.d_key;
+        }
+    }
+
+    static IntTrie* allocateNode(Uint64            key,
+                                 IntTrie::Kind     kind,
+                                 int               bit,
+                                 bsl::size_t       payloadSize,
+                                 bslma::Allocator* allocator) {
+        void* memory = allocator->allocate(sizeof(IntTrie) + payloadSize);
+        return new (memory) IntTrie(key, kind, bit);
+    }
+
+    static const IntTrie* makeBranch(Uint64            prefix,
+                                     int               bit,
+                                     const IntTrie*    left,
+                                     const IntTrie*    right,
+                                     bslma::Allocator* allocator) {
+        IntTrie* node = allocateNode(
+            prefix, IntTrie::e_BRANCH, bit, 2 * sizeof(IntTrie*), allocator);
+        const IntTrie** children =
+            const_cast<const IntTrie**>(node->payload<const IntTrie*>());
+        children[0] = left;
+        children[1] = right;
+        return node;
+    }
+
+    static const IntTrie* makeTip(Uint64            prefix,
+                                  Uint64            bitmap,
+                                  bslma::Allocator* allocator) {
+        BSLS_ASSERT(bitmap);
+
+        IntTrie* node = allocateNode(
+            prefix, IntTrie::e_TIP, 0, sizeof(Uint64), allocator);
+        *const_cast<Uint64*>(node->payload<Uint64>()) = bitmap;
+        return node;
+    }
+
+    static const IntTrie* makeLeaf(Uint64             key,
+                                   const bdld::Datum& value,
+                                   bslma::Allocator*  allocator) {
+        IntTrie* node = allocateNode(
+            key, IntTrie::e_LEAF, 0, sizeof(bdld::Datum), allocator);
+        new (const_cast<bdld::Datum*>(node->payload<bdld::Datum>()))
+            bdld::Datum(value);
+        return node;
+    }
+
+    // Return a copy of the specified 'tip' having the specified 'bitmap', or
+    // 'tip' itself if the bitmaps are the same, or null if 'bitmap' is zero.
+    static const IntTrie* retip(const IntTrie&    tip,
+                                Uint64            bitmap,
+                                bslma::Allocator* allocator) {
+        if (bitmap == tip.bitmap()) {
+            return &tip;
+        }
+        if (bitmap == 0) {
+            return 0;
+        }
+        return makeTip(tip.d_key, bitmap, allocator);
+    }
+
+    // Return a branch like the specified 'branch' but having the specified
+    // 'left' and 'right' children. Return 'branch' itself if its children
+    // are unchanged, and return the other child if either is null, so that
+    // no branch has fewer than two children.
+    static const IntTrie* rebranch(const IntTrie&    branch,
+                                   const IntTrie*    left,
+                                   const IntTrie*    right,
+                                   bslma::Allocator* allocator) {
+        if (!left) {
+            return right;
+        }
+        if (!right) {
+            return left;
+        }
+        if (left == branch.left() && right == branch.right()) {
+            return &branch;
+        }
+        return makeBranch(branch.d_key, branch.d_bit, left, right, allocator);
+    }
+
+    // Return a branch having the specified disjoint 'left' and 'right'
+    // tries as children, where the specified 'leftKey' and 'rightKey' are
+    // the 'd_key' of each.
+    static const IntTrie* link(Uint64            leftKey,
+                               const IntTrie*    left,
+                               Uint64            rightKey,
+                               const IntTrie*    right,
+                               bslma::Allocator* allocator) {
+        const int    bit    = branchingBit(leftKey, rightKey);
+        const Uint64 prefix = highBits(leftKey, bit);
+        if (isZero(leftKey, bit)) {
+            return makeBranch(prefix, bit, left, right, allocator);
+        }
+        return makeBranch(prefix, bit, right, left, allocator);
+    }
+
+    // Return the tip or leaf in the specified 'trie' whose 'd_key' is the
+    // specified 'key', or return null if there is none.
+    static const IntTrie* findTerminal(const IntTrie* trie, Uint64 key) {
+        while (trie && trie->d_kind == IntTrie::e_BRANCH) {
+            if (!matches(key, *trie)) {
+                return 0;
+            }
+            trie = isZero(key, trie->d_bit) ? trie->left() : trie->right();
+        }
+
+        if (trie && trie->d_key == key) {
+            return trie;
+        }
+        return 0;
+    }
+
+    // Return the union of the specified 'trie' and the specified 'terminal'
+    // tip or leaf. If 'trie' has a leaf with the same key as 'terminal', then
+    // the result has 'terminal' if the specified 'terminalWins' is 'true',
+    // and has the existing leaf otherwise.
+    static const IntTrie* insertTerminal(const IntTrie*    trie,
+                                         const IntTrie&    terminal,
+                                         bool              terminalWins,
+                                         bslma::Allocator* allocator) {
+        if (!trie) {
+            return &terminal;
+        }
+
+        const Uint64 key = terminal.d_key;
+        if (trie->d_kind == IntTrie::e_BRANCH) {
+            if (!matches(key, *trie)) {
+                return link(key, &terminal, trie->d_key, trie, allocator);
+            }
+            if (isZero(key, trie->d_bit)) {
+                return rebranch(
+                    *trie,
+                    insertTerminal(
+                        trie->left(), terminal, terminalWins, allocator),
+                    trie->right(),
+                    allocator);
+            }
+            return rebranch(
+                *trie,
+                trie->left(),
+                insertTerminal(
+                    trie->right(), terminal, terminalWins, allocator),
+                allocator);
+        }
+
+        if (trie->d_key != key) {
+            return link(key, &terminal, trie->d_key, trie, allocator);
+        }
+
+        if (trie->d_kind == IntTrie::e_LEAF) {
+            return terminalWins ? &terminal : trie;
+        }
+
+        const Uint64 bitmap = trie->bitmap() | terminal.bitmap();
+        if (bitmap == terminal.bitmap()) {
+            return &terminal;
+        }
+        return retip(*trie, bitmap, allocator);
+    }
+
+    // Return the specified 'trie' without the keys of the specified
+    // 'terminal' tip or leaf.
+    static const IntTrie* removeTerminal(const IntTrie*    trie,
+                                         const IntTrie&    terminal,
+                                         bslma::Allocator* allocator) {
+        return removeBits(trie,
+                          terminal.d_key,
+                          terminal.d_kind == IntTrie::e_TIP
+                              ? terminal.bitmap()
+                              : 0,
+                          allocator);
+    }
+
+    // Return the specified 'trie' without the keys of the tip or leaf whose
+    // 'd_key' is the specified 'key'. For a tip, remove only the keys in the
+    // specified 'bits'.
+    static const IntTrie* removeBits(const IntTrie*    trie,
+                                     Uint64            key,
+                                     Uint64            bits,
+                                     bslma::Allocator* allocator) {
+        if (!trie) {
+            return 0;
+        }
+
+        if (trie->d_kind == IntTrie::e_BRANCH) {
+            if (!matches(key, *trie)) {
+                return trie;
+            }
+            if (isZero(key, trie->d_bit)) {
+                return rebranch(
+                    *trie,
+                    removeBits(trie->left(), key, bits, allocator),
+                    trie->right(),
+                    allocator);
+            }
+            return rebranch(*trie,
+                            trie->left(),
+                            removeBits(trie->right(), key, bits, allocator),
+                            allocator);
+        }
+
+        if (trie->d_key != key) {
+            return trie;
+        }
+        if (trie->d_kind == IntTrie::e_LEAF) {
+            return 0;
+        }
+        return retip(*trie, trie->bitmap() & ~bits, allocator);
+    }
+
+    static const IntTrie* unite(const IntTrie*    left,
+                                const IntTrie*    right,
+                                bslma::Allocator* allocator) {
+        if (!left) {
+            return right;
+        }
+        if (!right || left == right) {
+            return left;
+        }
+        if (left->d_kind != IntTrie::e_BRANCH) {
+            return insertTerminal(right, *left, true, allocator);
+        }
+        if (right->d_kind != IntTrie::e_BRANCH) {
+            return insertTerminal(left, *right, false, allocator);
+        }
+
+        // Both are branches. The one with the higher branching bit covers the
+        // wider range of keys, and so either contains the other or is
+        // disjoint from it.
+        if (left->d_bit > right->d_bit) {
+            if (!matches(right->d_key, *left)) {
+                return link(
+                    left->d_key, left, right->d_key, right, allocator);
+            }
+            if (isZero(right->d_key, left->d_bit)) {
+                return rebranch(*left,
+                                unite(left->left(), right, allocator),
+                                left->right(),
+                                allocator);
+            }
+            return rebranch(*left,
+                            left->left(),
+                            unite(left->right(), right, allocator),
+                            allocator);
+        }
+
+        if (left->d_bit < right->d_bit) {
+            if (!matches(left->d_key, *right)) {
+                return link(
+                    left->d_key, left, right->d_key, right, allocator);
+            }
+            if (isZero(left->d_key, right->d_bit)) {
+                return rebranch(*right,
+                                unite(left, right->left(), allocator),
+                                right->right(),
+                                allocator);
+            }
+            return rebranch(*right,
+                            right->left(),
+                            unite(left, right->right(), allocator),
+                            allocator);
+        }
+
+        if (left->d_key != right->d_key) {
+            return link(left->d_key, left, right->d_key, right, allocator);
+        }
+        return rebranch(*left,
+                        unite(left->left(), right->left(), allocator),
+                        unite(left->right(), right->right(), allocator),
+                        allocator);
+    }
+
+    static const IntTrie* intersect(const IntTrie*    left,
+                                    const IntTrie*    right,
+                                    bslma::Allocator* allocator) {
+        if (!left || !right) {
+            return 0;
+        }
+        if (left == right) {
+            return left;
+        }
+
+        if (left->d_kind != IntTrie::e_BRANCH) {
+            const IntTrie* match = findTerminal(right, left->d_key);
+            if (!match) {
+                return 0;
+            }
+            if (left->d_kind == IntTrie::e_LEAF) {
+                return left;
+            }
+            return retip(*left, left->bitmap() & match->bitmap(), allocator);
+        }
+
+        if (right->d_kind != IntTrie::e_BRANCH) {
+            const IntTrie* match = findTerminal(left, right->d_key);
+            if (!match) {
+                return 0;
+            }
+            if (match->d_kind == IntTrie::e_LEAF) {
+                return match;
+            }
+            return retip(
+                *match, match->bitmap() & right->bitmap(), allocator);
+        }
+
+        if (left->d_bit > right->d_bit) {
+            if (!matches(right->d_key, *left)) {
+                return 0;
+            }
+            return intersect(isZero(right->d_key, left->d_bit)
+                                 ? left->left()
+                                 : left->right(),
+                             right,
+                             allocator);
+        }
+
+        if (left->d_bit < right->d_bit) {
+            if (!matches(left->d_key, *right)) {
+                return 0;
+            }
+            return intersect(left,
+                             isZero(left->d_key, right->d_bit)
+                                 ? right->left()
+                                 : right->right(),
+                             allocator);
+        }
+
+        if (left->d_key != right->d_key) {
+            return 0;
+        }
+        return rebranch(*left,
+                        intersect(left->left(), right->left(), allocator),
+                        intersect(left->right(), right->right(), allocator),
+                        allocator);
+    }
+
+    static const IntTrie* subtract(const IntTrie*    left,
+                                   const IntTrie*    right,
+                                   bslma::Allocator* allocator) {
+        if (!left || left == right) {
+            return 0;
+        }
+        if (!right) {
+            return left;
+        }
+
+        if (left->d_kind != IntTrie::e_BRANCH) {
+            const IntTrie* match = findTerminal(right, left->d_key);
+            if (!match) {
+                return left;
+            }
+            if (left->d_kind == IntTrie::e_LEAF) {
+                return 0;
+            }
+            return retip(
+                *left, left->bitmap() & ~match->bitmap(), allocator);
+        }
+
+        if (right->d_kind != IntTrie::e_BRANCH) {
+            return removeTerminal(left, *right, allocator);
+        }
+
+        if (left->d_bit > right->d_bit) {
+            if (!matches(right->d_key, *left)) {
+                return left;
+            }
+            if (isZero(right->d_key, left->d_bit)) {
+                return rebranch(*left,
+                                subtract(left->left(), right, allocator),
+                                left->right(),
+                                allocator);
+            }
+            return rebranch(*left,
+                            left->left(),
+                            subtract(left->right(), right, allocator),
+                            allocator);
+        }
+
+        if (left->d_bit < right->d_bit) {
+            if (!matches(left->d_key, *right)) {
+                return left;
+            }
+            return subtract(left,
+                            isZero(left->d_key, right->d_bit)
+                                ? right->left()
+                                : right->right(),
+                            allocator);
+        }
+
+        if (left->d_key != right->d_key) {
+            return left;
+        }
+        return rebranch(*left,
+                        subtract(left->left(), right->left(), allocator),
+                        subtract(left->right(), right->right(), allocator),
+                        allocator);
+    }
+
+    // Return the keys of the specified 'trie' that are at least the
+    // specified 'low' and at most the specified 'high'.
+    static const IntTrie* range(const IntTrie*    trie,
+                                Uint64            low,
+                                Uint64            high,
+                                bslma::Allocator* allocator) {
+        if (!trie) {
+            return 0;
+        }
+
+        const Uint64 lowest  = first(*trie);
+        const Uint64 highest = last(*trie);
+        if (highest < low || lowest > high) {
+            return 0;
+        }
+        if (low <= lowest && highest <= high) {
+            return trie;
+        }
+
+        if (trie->d_kind == IntTrie::e_BRANCH) {
+            return rebranch(*trie,
+                            range(trie->left(), low, high, allocator),
+                            range(trie->right(), low, high, allocator),
+                            allocator);
+        }
+
+        // A leaf is either entirely in or entirely out of the range, so this
+        // is a tip that straddles 'low' or 'high' (or both).
+        BSLS_ASSERT(trie->d_kind == IntTrie::e_TIP);
+
+        const int    lowIndex  = low > lowest ? int(low - lowest) : 0;
+        const int    highIndex = high < highest ? int(high - lowest) : 63;
+        const Uint64 mask      = ((Uint64(2) << highIndex) - 1) &
+                            ~((Uint64(1) << lowIndex) - 1);
+        return retip(*trie, trie->bitmap() & mask, allocator);
+    }
+
+    static bool equal(const IntTrie* left,
+                      const IntTrie* right,
+                      int            typeOffset) {
+        // Tries having the same keys have the same shape, so this need only
+        // compare corresponding nodes.
+        if (left == right) {
+            return true;
+        }
+        if (!left || !right || left->d_kind != right->d_kind ||
+            left->d_key != right->d_key) {
+            return false;
+        }
+
+        switch (left->d_kind) {
+            case IntTrie::e_BRANCH:
+                return left->d_bit == right->d_bit &&
+                       equal(left->left(), right->left(), typeOffset) &&
+                       equal(left->right(), right->right(), typeOffset);
+            case IntTrie::e_TIP:
+                return left->bitmap() == right->bitmap();
+            default:
+                BSLS_ASSERT(left->d_kind == IntTrie::e_LEAF);
+                return DatumUtil::equal(
+                    left->value(), right->value(), typeOffset);
+        }
+    }
+};
+
+IntTrie::IntTrie(Uint64 key, Kind kind, int bit)
+: d_key(key)
+, d_kind(kind)
+, d_bit(bit) {
+}
+
+IntTrie::Cursor::Cursor(const IntTrie* trie)
+: d_depth(0)
+, d_bitmap(0) {
+    if (trie) {
+        d_stack[d_depth++] = trie;
+        settle();
+    }
+}
+
+void IntTrie::Cursor::settle() {
+    // Replace the branch on top of the stack with its children until a tip
+    // or leaf is on top.
+    const IntTrie* top = d_stack[d_depth - 1];
+    while (top->kind() == e_BRANCH) {
+        BSLS_ASSERT(d_depth < k_MAX_DEPTH);
+
+        d_stack[d_depth - 1] = top->right();
+        d_stack[d_depth++]   = top->left();
+        top                  = top->left();
+    }
+
+    if (top->kind() == e_TIP) {
+        d_bitmap = top->bitmap();
+    }
+}
+
+IntTrie::Int64 IntTrie::Cursor::key() const {
+    BSLS_ASSERT(!done());
+
+    const IntTrie* top = d_stack[d_depth - 1];
+    if (top->kind() == e_LEAF) {
+        return top->key();
+    }
+
+    const Uint64 key =
+        top->d_key | bdlb::BitUtil::numTrailingUnsetBits(d_bitmap);
+    return Int64(key ^ (Uint64(1) << 63));
+}
+
+const bdld::Datum& IntTrie::Cursor::value() const {
+    BSLS_ASSERT(!done());
+    BSLS_ASSERT(d_stack[d_depth - 1]->kind() == e_LEAF);
+
+    return d_stack[d_depth - 1]->value();
+}
+
+void IntTrie::Cursor::advance() {
+    BSLS_ASSERT(!done());
+
+    if (d_stack[d_depth - 1]->kind() == e_TIP) {
+        d_bitmap &= d_bitmap - 1;  // clear the lowest set bit
+        if (d_bitmap) {
+            return;
+        }
+    }
+
+    if (--d_depth) {
+        settle();
+    }
+}
+
+int IntTrie::toKey(Int64* result, const bdld::Datum& datum) {
+    BSLS_ASSERT(result);
+
+    if (datum.isInteger()) {
+        *result = datum.theInteger();
+        return 0;
+    }
+    if (datum.isInteger64()) {
+        *result = datum.theInteger64();
+        return 0;
+    }
+    return 1;
+}
+
+bdld::Datum IntTrie::fromKey(Int64 key, bslma::Allocator* allocator) {
+    if (key >= bsl::numeric_limits<int>::min() &&
+        key <= bsl::numeric_limits<int>::max()) {
+        return bdld::Datum::createInteger(int(key));
+    }
+    return bdld::Datum::createInteger64(key, allocator);
+}
+
+const IntTrie* IntTrie::insert(const IntTrie*    set,
+                               Int64             key,
+                               bslma::Allocator* allocator) {
+    const Uint64   flipped = IntTrieImpl::flip(key);
+    const Uint64   prefix  = IntTrieImpl::tipPrefix(flipped);
+    const Uint64   bit     = IntTrieImpl::tipBit(flipped);
+    const IntTrie* tip     = IntTrieImpl::findTerminal(set, prefix);
+    if (tip && (tip->bitmap() & bit)) {
+        return set;
+    }
+
+    // The new tip has all of the keys of the old one, if any, and so
+    // replaces it.
+    const Uint64   bitmap = tip ? tip->bitmap() | bit : bit;
+    const IntTrie* newTip = IntTrieImpl::makeTip(prefix, bitmap, allocator);
+    return IntTrieImpl::insertTerminal(set, *newTip, true, allocator);
+}
+
+bool IntTrie::contains(const IntTrie* set, Int64 key) {
+    const Uint64   flipped = IntTrieImpl::flip(key);
+    const IntTrie* tip =
+        IntTrieImpl::findTerminal(set, IntTrieImpl::tipPrefix(flipped));
+    return tip && (tip->bitmap() & IntTrieImpl::tipBit(flipped));
+}
+
+const IntTrie* IntTrie::remove(const IntTrie*    set,
+                               Int64             key,
+                               bslma::Allocator* allocator) {
+    const Uint64 flipped = IntTrieImpl::flip(key);
+    return IntTrieImpl::removeBits(set,
+                                   IntTrieImpl::tipPrefix(flipped),
+                                   IntTrieImpl::tipBit(flipped),
+                                   allocator);
+}
+
+const IntTrie* IntTrie::insert(const IntTrie*     map,
+                               Int64              key,
+                               const bdld::Datum& value,
+                               bslma::Allocator*  allocator) {
+    const IntTrie* leaf =
+        IntTrieImpl::makeLeaf(IntTrieImpl::flip(key), value, allocator);
+    return IntTrieImpl::insertTerminal(map, *leaf, true, allocator);
+}
+
+const bdld::Datum* IntTrie::find(const IntTrie* map, Int64 key) {
+    const IntTrie* leaf =
+        IntTrieImpl::findTerminal(map, IntTrieImpl::flip(key));
+    return leaf ? &leaf->value() : 0;
+}
+
+const IntTrie* IntTrie::removeKey(const IntTrie*    map,
+                                  Int64             key,
+                                  bslma::Allocator* allocator) {
+    return IntTrieImpl::removeBits(map, IntTrieImpl::flip(key), 0, allocator);
+}
+
+const IntTrie* IntTrie::unite(const IntTrie*    left,
+                              const IntTrie*    right,
+                              bslma::Allocator* allocator) {
+    return IntTrieImpl::unite(left, right, allocator);
+}
+
+const IntTrie* IntTrie::intersect(const IntTrie*    left,
+                                  const IntTrie*    right,
+                                  bslma::Allocator* allocator) {
+    return IntTrieImpl::intersect(left, right, allocator);
+}
+
+const IntTrie* IntTrie::subtract(const IntTrie*    left,
+                                 const IntTrie*    right,
+                                 bslma::Allocator* allocator) {
+    return IntTrieImpl::subtract(left, right, allocator);
+}
+
+const IntTrie* IntTrie::range(const IntTrie*    trie,
+                              Int64             low,
+                              Int64             high,
+                              bslma::Allocator* allocator) {
+    if (low >= high) {
+        return 0;
+    }
+
+    // 'IntTrieImpl::range' takes an inclusive upper bound, so that the
+    // largest key can be included.
+    return IntTrieImpl::range(trie,
+                              IntTrieImpl::flip(low),
+                              IntTrieImpl::flip(high - 1),
+                              allocator);
+}
+
+bool IntTrie::equal(const IntTrie* left,
+                    const IntTrie* right,
+                    int            typeOffset) {
+    return IntTrieImpl::equal(left, right, typeOffset);
+}
+
+bool IntTrie::isIntSet(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() &&
+           datum.theUdt().type() == UserDefinedTypes::e_INT_SET + typeOffset;
+}
+
+bool IntTrie::isIntMap(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() &&
+           datum.theUdt().type() == UserDefinedTypes::e_INT_MAP + typeOffset;
+}
+
+const IntTrie* IntTrie::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+const IntTrie* IntTrie::access(const bdld::DatumUdt& udt) {
+    return static_cast<const IntTrie*>(udt.data());
+}
+
+bdld::Datum IntTrie::createSet(const IntTrie* set, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(set)),
+        UserDefinedTypes::e_INT_SET + typeOffset);
+}
+
+bdld::Datum IntTrie::createMap(const IntTrie* map, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(map)),
+        UserDefinedTypes::e_INT_MAP + typeOffset);
+}
+
+}  // namespace lspcore
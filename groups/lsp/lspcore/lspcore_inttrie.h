@@ -0,0 +1,234 @@
+#ifndef INCLUDED_LSPCORE_INTTRIE
+#define INCLUDED_LSPCORE_INTTRIE
+
+// An int trie is an immutable big-endian Patricia trie (Okasaki and Gill,
+// "Fast Mergeable Integer Maps," 1998) whose keys are 64-bit integers. Keys
+// may be given as either 'int' or 'bsls::Types::Int64' values, and are
+// compared as plain integers, rather than through 'DatumUtil::LessThan'.
+//
+// Each 'IntTrie' node is one of three kinds:
+//
+// - A "branch" has two children. All keys below a branch agree in the bits
+//   above its "branching bit," and are divided between the children by the
+//   branching bit itself: zero on the left and one on the right.
+// - A "tip" holds a bitmap of up to 64 keys that agree in all but their
+//   lowest six bits. Int sets are made of branches and tips, so a dense set
+//   costs little more than a bit per element.
+// - A "leaf" holds one key and its associated value. Int maps are made of
+//   branches and leaves.
+//
+// A trie contains no empty nodes and no branches with only one child, so the
+// shape of a trie depends only on its keys. Lookups follow the bits of the
+// key from the most significant down, and never compare keys until they
+// reach a tip or leaf. Insertion and removal copy only the path from the root
+// to the affected node. Union, intersection, and difference descend both
+// operands together, take time proportional to the sizes of the operands at
+// worst, and share any subtree that one operand has and the other lacks.
+//
+// Keys are stored with their sign bit flipped, so that in-order traversal of
+// the trie visits keys in increasing numeric order.
+//
+// An int trie is represented as a pointer to its root 'IntTrie' node. A null
+// pointer denotes an empty set or map. Int sets and int maps are distinct
+// user-defined types that share the 'IntTrie' representation.
+
+#include <bdld_datum.h>
+#include <bsl_cstddef.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+namespace bsls  = BloombergLP::bsls;
+
+class IntTrie {
+  public:
+    enum Kind { e_BRANCH, e_TIP, e_LEAF };
+
+    typedef bsls::Types::Int64  Int64;
+    typedef bsls::Types::Uint64 Uint64;
+
+  private:
+    // A node is allocated together with its "payload," which follows it in
+    // memory: two child pointers for a branch, a bitmap for a tip, or a
+    // value for a leaf. See 'IntTrie::payload'.
+    Uint64 d_key;   // leaf: key; tip or branch: bits shared by all keys below
+    int    d_kind;  // 'Kind'
+    int    d_bit;   // branch: index of the branching bit
+
+    IntTrie(Uint64 key, Kind kind, int bit);
+
+    template <typename Payload>
+    const Payload* payload() const;
+
+    friend class IntTrieImpl;
+
+  public:
+    // 'Cursor' visits the keys of an 'IntTrie' in increasing order, and, for
+    // a map, their values, without allocating memory.
+    class Cursor {
+        // Each branch on the path from the root has a lower branching bit
+        // than the last, so there are at most 64 pending right children,
+        // plus the current tip or leaf.
+        enum { k_MAX_DEPTH = 65 };
+
+        const IntTrie* d_stack[k_MAX_DEPTH];
+        int            d_depth;
+        Uint64         d_bitmap;  // unvisited keys of the current tip
+
+        void settle();
+
+      public:
+        explicit Cursor(const IntTrie* trie);
+
+        bool               done() const;
+        Int64              key() const;
+        const bdld::Datum& value() const;  // leaves only
+        void               advance();
+    };
+
+    Kind kind() const;
+
+    // The behavior of the following is undefined unless 'kind()' is
+    // 'e_BRANCH'.
+    int            bit() const;
+    const IntTrie* left() const;
+    const IntTrie* right() const;
+
+    // The behavior of the following is undefined unless 'kind()' is
+    // 'e_TIP'.
+    Uint64 bitmap() const;
+
+    // The behavior of the following is undefined unless 'kind()' is
+    // 'e_LEAF'.
+    Int64              key() const;
+    const bdld::Datum& value() const;
+
+    // Load into the specified 'result' the integer value of the specified
+    // 'datum' and return zero if 'datum' is an 'int' or an 'Int64'.
+    // Otherwise, return a nonzero value.
+    static int toKey(Int64* result, const bdld::Datum& datum);
+
+    // Return an integer 'bdld::Datum' having the value of the specified
+    // 'key', which is an 'int' if it is in range, or otherwise an 'Int64'.
+    static bdld::Datum fromKey(Int64 key, bslma::Allocator*);
+
+    // Set operations. A set contains only branches and tips.
+
+    static const IntTrie* insert(const IntTrie*, Int64 key, bslma::Allocator*);
+
+    static bool contains(const IntTrie*, Int64 key);
+
+    static const IntTrie* remove(const IntTrie*, Int64 key, bslma::Allocator*);
+
+    // Map operations. A map contains only branches and leaves.
+
+    // Return a map that contains the entries of the specified 'map' and
+    // associates the specified 'key' with the specified 'value', replacing
+    // any previous value of 'key'.
+    static const IntTrie* insert(const IntTrie*     map,
+                                 Int64              key,
+                                 const bdld::Datum& value,
+                                 bslma::Allocator*);
+
+    // Return a pointer to the value associated with the specified 'key' in
+    // the specified 'map', or return a null pointer if 'map' does not contain
+    // 'key'.
+    static const bdld::Datum* find(const IntTrie* map, Int64 key);
+
+    static const IntTrie* removeKey(const IntTrie*    map,
+                                    Int64             key,
+                                    bslma::Allocator*);
+
+    // Operations on either sets or maps. Both operands must be of the same
+    // kind.
+
+    // Return the union of the specified 'left' and 'right'. Where both maps
+    // contain a key, the result has the value from 'left'.
+    static const IntTrie* unite(const IntTrie* left,
+                                const IntTrie* right,
+                                bslma::Allocator*);
+
+    // Return the elements (or entries) of the specified 'left' whose keys are
+    // in the specified 'right'.
+    static const IntTrie* intersect(const IntTrie* left,
+                                    const IntTrie* right,
+                                    bslma::Allocator*);
+
+    // Return the elements (or entries) of the specified 'left' whose keys are
+    // not in the specified 'right'.
+    static const IntTrie* subtract(const IntTrie* left,
+                                   const IntTrie* right,
+                                   bslma::Allocator*);
+
+    // Return the elements (or entries) of the specified 'trie' whose keys
+    // are at least the specified 'low' and less than the specified 'high'.
+    // Subtrees entirely within the range are shared with 'trie'.
+    static const IntTrie* range(const IntTrie* trie,
+                                Int64          low,
+                                Int64          high,
+                                bslma::Allocator*);
+
+    // Return whether the specified 'left' and 'right' have the same keys and,
+    // if they are maps, equal values according to 'DatumUtil::equal'.
+    static bool equal(const IntTrie* left,
+                      const IntTrie* right,
+                      int            typeOffset);
+
+    static bool isIntSet(const bdld::Datum&, int typeOffset);
+    static bool isIntMap(const bdld::Datum&, int typeOffset);
+
+    static const IntTrie* access(const bdld::Datum&);
+    static const IntTrie* access(const bdld::DatumUdt&);
+
+    static bdld::Datum createSet(const IntTrie* set, int typeOffset);
+    static bdld::Datum createMap(const IntTrie* map, int typeOffset);
+};
+
+template <typename Payload>
+inline const Payload* IntTrie::payload() const {
+    return reinterpret_cast<const Payload*>(this + 1);
+}
+
+inline IntTrie::Kind IntTrie::kind() const {
+    return Kind(d_kind);
+}
+
+inline int IntTrie::bit() const {
+    return d_bit;
+}
+
+inline const IntTrie* IntTrie::left() const {
+    return payload<const IntTrie*>()[0];
+}
+
+inline const IntTrie* IntTrie::right() const {
+    return payload<const IntTrie*>()[1];
+}
+
+inline IntTrie::Uint64 IntTrie::bitmap() const {
+    return *payload<Uint64>();
+}
+
+inline IntTrie::Int64 IntTrie::key() const {
+    // Undo the flipping of the sign bit. See the component documentation.
+    return Int64(d_key ^ (Uint64(1) << 63));
+}
+
+inline const bdld::Datum& IntTrie::value() const {
+    return *payload<bdld::Datum>();
+}
+
+inline bool IntTrie::Cursor::done() const {
+    return d_depth == 0;
+}
+
+}  // namespace lspcore
+
+#endif
@@ -0,0 +1,97 @@
+#include <bsl_algorithm.h>
+#include <bslma_allocator.h>
+#include <lspcore_mutablevector.h>
+#include <lspcore_userdefinedtypes.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+MutableVector::MutableVector(bslma::Allocator* allocator)
+: d_capacity(0)
+, d_frozen(false)
+, d_allocator_p(allocator) {
+}
+
+void MutableVector::reallocate(bsl::size_t capacity) {
+    const bsl::size_t size = this->size();
+    BSLS_ASSERT(capacity >= size);
+    BSLS_ASSERT(capacity > 0);
+
+    bdld::DatumMutableArrayRef storage;
+    bdld::Datum::createUninitializedArray(&storage, capacity, d_allocator_p);
+    bsl::copy(d_storage.data(), d_storage.data() + size, storage.data());
+    *storage.length() = size;
+
+    // Storage that was frozen belongs to an array, which outlives it here.
+    if (d_capacity && !d_frozen) {
+        bdld::Datum::disposeUninitializedArray(d_storage, d_allocator_p);
+    }
+
+    d_storage  = storage;
+    d_capacity = capacity;
+    d_frozen   = false;
+}
+
+void MutableVector::reserve(bsl::size_t capacity) {
+    if (capacity > d_capacity) {
+        reallocate(capacity);
+    }
+}
+
+void MutableVector::push(const bdld::Datum& value) {
+    const bsl::size_t size = this->size();
+    if (size == d_capacity) {
+        reallocate(d_capacity ? d_capacity * 2 : 8);
+    }
+    else if (d_frozen) {
+        reallocate(d_capacity);
+    }
+
+    d_storage.data()[size] = value;
+    *d_storage.length()    = size + 1;
+}
+
+void MutableVector::set(bsl::size_t index, const bdld::Datum& value) {
+    BSLS_ASSERT(index < size());
+
+    if (d_frozen) {
+        reallocate(d_capacity);
+    }
+
+    d_storage.data()[index] = value;
+}
+
+bdld::Datum MutableVector::freeze() {
+    if (size() == 0) {
+        return bdld::Datum::createArrayReference(0, 0, d_allocator_p);
+    }
+
+    d_frozen = true;
+    return bdld::Datum::adoptArray(d_storage);
+}
+
+bool MutableVector::isMutableVector(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && isMutableVector(datum.theUdt(), typeOffset);
+}
+
+bool MutableVector::isMutableVector(const bdld::DatumUdt& udt,
+                                    int                   typeOffset) {
+    return udt.type() == UserDefinedTypes::e_MUTABLE_VECTOR + typeOffset;
+}
+
+MutableVector* MutableVector::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+MutableVector* MutableVector::access(const bdld::DatumUdt& udt) {
+    return static_cast<MutableVector*>(udt.data());
+}
+
+bdld::Datum MutableVector::create(MutableVector* vector, int typeOffset) {
+    return bdld::Datum::createUdt(
+        vector, UserDefinedTypes::e_MUTABLE_VECTOR + typeOffset);
+}
+
+}  // namespace lspcore
@@ -0,0 +1,86 @@
+#ifndef INCLUDED_LSPCORE_MUTABLEVECTOR
+#define INCLUDED_LSPCORE_MUTABLEVECTOR
+
+// A mutable vector is a sequence of values indexed from zero that is
+// modified in place: 'push' appends an element in amortized O(1) time, and
+// 'set' replaces an element in O(1) time. Whereas a 'bdld' array can be
+// extended only by building a new one, and an 'RrbVector' copies a path of
+// its tree on every update, a mutable vector is meant for algorithms, such as
+// dynamic programming, that fill in a table one element at a time.
+//
+// The elements are stored in the same kind of block of memory as an array
+// created by 'bdld::Datum::createUninitializedArray', whose capacity doubles
+// when it is full. 'freeze' adopts that block as a 'bdld' array, so that the
+// array shares the vector's elements instead of copying them. The block then
+// belongs to the array, so the next modification of the vector first copies
+// its elements into a new block.
+//
+// A mutable vector is not safe to use concurrently. Mutable vectors are equal
+// only to themselves.
+
+#include <bdld_datum.h>
+#include <bdld_datumudt.h>
+#include <bsl_cstddef.h>
+#include <bsls_assert.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+class MutableVector {
+    bdld::DatumMutableArrayRef d_storage;   // unallocated if 'd_capacity' is 0
+    bsl::size_t                d_capacity;
+    bool                       d_frozen;    // whether an array owns storage
+    bslma::Allocator*          d_allocator_p;
+
+    MutableVector(const MutableVector&);             // = delete
+    MutableVector& operator=(const MutableVector&);  // = delete
+
+    // Move the elements into new storage having at least the specified
+    // 'capacity', which must be at least the size of this vector.
+    void reallocate(bsl::size_t capacity);
+
+  public:
+    explicit MutableVector(bslma::Allocator*);
+
+    bsl::size_t        size() const;
+    const bdld::Datum& operator[](bsl::size_t index) const;
+
+    // Make room for at least the specified 'capacity' elements, so that
+    // pushing up to that many does not reallocate.
+    void reserve(bsl::size_t capacity);
+
+    void push(const bdld::Datum& value);
+    void set(bsl::size_t index, const bdld::Datum& value);
+
+    // Return a 'bdld' array of the elements of this vector. The array shares
+    // this vector's storage, unless this vector is empty.
+    bdld::Datum freeze();
+
+    static bool isMutableVector(const bdld::Datum&, int typeOffset);
+    static bool isMutableVector(const bdld::DatumUdt&, int typeOffset);
+
+    static MutableVector* access(const bdld::Datum&);
+    static MutableVector* access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(MutableVector* vector, int typeOffset);
+};
+
+inline bsl::size_t MutableVector::size() const {
+    return d_capacity ? *d_storage.length() : 0;
+}
+
+inline const bdld::Datum& MutableVector::operator[](bsl::size_t index) const {
+    BSLS_ASSERT(index < size());
+    return d_storage.data()[index];
+}
+
+}  // namespace lspcore
+
+#endif
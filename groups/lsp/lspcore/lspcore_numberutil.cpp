@@ -0,0 +1,457 @@
+#include <bdlb_bitutil.h>
+#include <bdld_datum.h>
+#include <bdldfp_decimalconvertutil.h>
+#include <bdldfp_decimalutil.h>
+#include <bsl_algorithm.h>
+#include <bsl_cmath.h>
+#include <bsl_cstdint.h>
+#include <bsl_limits.h>
+#include <bsls_assert.h>
+#include <lspcore_numberutil.h>
+#include <math.h>  // FP_NAN, etc.
+
+using namespace BloombergLP;
+
+namespace lspcore {
+namespace {
+
+typedef bsls::Types::Uint64 Uint64;
+
+// Return a negative number, zero, or a positive number if the specified
+// 'left' is less than, equal to, or greater than the specified 'right',
+// respectively, according to 'operator<'.
+template <typename Value>
+int compareValues(const Value& left, const Value& right) {
+    if (left < right) {
+        return -1;
+    }
+    if (right < left) {
+        return 1;
+    }
+    return 0;
+}
+
+// 'BigInteger' is a nonnegative integer having enough bits to hold either
+// side of an exact comparison between a 'double' and a 'bdldfp::Decimal64'
+// whose magnitudes are within a few orders of magnitude of each other. The
+// largest such value is a 'double' significand times 5^398 (the reciprocal
+// of the smallest decimal exponent's factor of five), shifted by a few bits,
+// which is fewer than 1100 bits.
+class BigInteger {
+    enum { k_CAPACITY = 40 };  // 32-bit digits, i.e. 1280 bits
+
+    bsl::uint32_t d_digits[k_CAPACITY];  // least significant first
+    int           d_size;                // no leading zero digits
+
+  public:
+    explicit BigInteger(Uint64 value);
+
+    // Multiply this number by the specified 'factor'.
+    void multiply(bsl::uint32_t factor);
+
+    // Multiply this number by five to the specified 'exponent'.
+    void multiplyByPowerOfFive(int exponent);
+
+    // Multiply this number by two to the specified 'exponent'.
+    void shiftLeft(int exponent);
+
+    friend int compare(const BigInteger& left, const BigInteger& right);
+};
+
+BigInteger::BigInteger(Uint64 value)
+: d_size(0) {
+    for (; value; value >>= 32) {
+        d_digits[d_size++] = bsl::uint32_t(value);
+    }
+}
+
+void BigInteger::multiply(bsl::uint32_t factor) {
+    Uint64 carry = 0;
+    for (int i = 0; i < d_size; ++i) {
+        const Uint64 product = Uint64(d_digits[i]) * factor + carry;
+        d_digits[i]          = bsl::uint32_t(product);
+        carry                = product >> 32;
+    }
+    if (carry) {
+        BSLS_ASSERT(d_size < k_CAPACITY);
+        d_digits[d_size++] = bsl::uint32_t(carry);
+    }
+}
+
+void BigInteger::multiplyByPowerOfFive(int exponent) {
+    BSLS_ASSERT(exponent >= 0);
+
+    // 5^13 is the largest power of five that fits in 32 bits.
+    const bsl::uint32_t k_FIVE_TO_THE_13 = 1220703125;
+    for (; exponent >= 13; exponent -= 13) {
+        multiply(k_FIVE_TO_THE_13);
+    }
+    bsl::uint32_t factor = 1;
+    for (; exponent > 0; --exponent) {
+        factor *= 5;
+    }
+    multiply(factor);
+}
+
+void BigInteger::shiftLeft(int exponent) {
+    BSLS_ASSERT(exponent >= 0);
+    if (d_size == 0) {
+        return;
+    }
+
+    const int wholeDigits = exponent / 32;
+    const int bits        = exponent % 32;
+    BSLS_ASSERT(d_size + wholeDigits < k_CAPACITY);
+
+    d_digits[d_size] = 0;
+    for (int i = d_size; i >= 0; --i) {
+        const bsl::uint32_t high = d_digits[i] << bits;
+        const bsl::uint32_t low =
+            bits && i > 0 ? d_digits[i - 1] >> (32 - bits) : 0;
+        d_digits[i + wholeDigits] = high | low;
+    }
+    bsl::fill(d_digits, d_digits + wholeDigits, bsl::uint32_t(0));
+
+    d_size += wholeDigits + 1;
+    if (d_digits[d_size - 1] == 0) {
+        --d_size;
+    }
+}
+
+int compare(const BigInteger& left, const BigInteger& right) {
+    if (left.d_size != right.d_size) {
+        return compareValues(left.d_size, right.d_size);
+    }
+    for (int i = left.d_size - 1; i >= 0; --i) {
+        if (left.d_digits[i] != right.d_digits[i]) {
+            return compareValues(left.d_digits[i], right.d_digits[i]);
+        }
+    }
+    return 0;
+}
+
+// Return the number of decimal digits in the specified 'value'.
+int countDigits(Uint64 value) {
+    int count = 1;
+    for (; value >= 10; value /= 10) {
+        ++count;
+    }
+    return count;
+}
+
+// Return the three-way comparison of 'binarySignificand * 2^binaryExponent'
+// with 'decimalSignificand * 10^decimalExponent', for the specified
+// 'binarySignificand', 'binaryExponent', 'decimalSignificand', and
+// 'decimalExponent'. The behavior is undefined unless both significands are
+// positive.
+int compareMagnitudes(Uint64 binarySignificand,
+                      int    binaryExponent,
+                      Uint64 decimalSignificand,
+                      int    decimalExponent) {
+    BSLS_ASSERT(binarySignificand != 0);
+    BSLS_ASSERT(decimalSignificand != 0);
+
+    // The binary value is in '[2^(binaryTop - 1), 2^binaryTop)' and the
+    // decimal value is in '[10^(decimalTop - 1), 10^decimalTop)'. If those
+    // ranges don't overlap, we're done. The margin accounts for rounding in
+    // the estimate of 'log10(2^binaryTop)'.
+    const int binaryTop =
+        binaryExponent + 64 -
+        bdlb::BitUtil::numLeadingUnsetBits(bsl::uint64_t(binarySignificand));
+    const int decimalTop = decimalExponent + countDigits(decimalSignificand);
+    const double k_LOG10_2 = 0.30102999566398119521;
+    const double k_MARGIN  = 1e-6;
+    if (binaryTop * k_LOG10_2 + k_MARGIN < decimalTop - 1) {
+        return -1;
+    }
+    if ((binaryTop - 1) * k_LOG10_2 - k_MARGIN > decimalTop) {
+        return 1;
+    }
+
+    // The magnitudes are close. Write the decimal value as
+    // 'decimalSignificand * 5^decimalExponent * 2^decimalExponent', and then
+    // multiply both sides by whatever powers of two and five make them
+    // integers.
+    BigInteger binary(binarySignificand);
+    BigInteger decimal(decimalSignificand);
+    if (decimalExponent >= 0) {
+        decimal.multiplyByPowerOfFive(decimalExponent);
+    }
+    else {
+        binary.multiplyByPowerOfFive(-decimalExponent);
+    }
+
+    const int twos = binaryExponent - decimalExponent;
+    if (twos >= 0) {
+        binary.shiftLeft(twos);
+    }
+    else {
+        decimal.shiftLeft(-twos);
+    }
+
+    return compare(binary, decimal);
+}
+
+// Return the three-way comparison of the specified 'left' and 'right', where
+// NaN is equal to itself and greater than every other value.
+int compareDoubles(double left, double right) {
+    if (left != left) {
+        return right != right ? 0 : 1;
+    }
+    if (right != right) {
+        return -1;
+    }
+    return compareValues(left, right);
+}
+
+int compareDecimals(bdldfp::Decimal64 left, bdldfp::Decimal64 right) {
+    if (bdldfp::DecimalUtil::isNan(left)) {
+        return bdldfp::DecimalUtil::isNan(right) ? 0 : 1;
+    }
+    if (bdldfp::DecimalUtil::isNan(right)) {
+        return -1;
+    }
+    return compareValues(left, right);
+}
+
+}  // namespace
+
+bool NumberUtil::isNumeric(const bdld::Datum& value) {
+    switch (value.type()) {
+        case bdld::Datum::e_INTEGER:
+        case bdld::Datum::e_DOUBLE:
+        case bdld::Datum::e_INTEGER64:
+        case bdld::Datum::e_DECIMAL64:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool NumberUtil::equal(const bdld::Datum& left, const bdld::Datum& right) {
+    BSLS_ASSERT(isNumeric(left));
+    BSLS_ASSERT(isNumeric(right));
+
+    if (left.type() == right.type()) {
+        return left == right;
+    }
+
+    // Every 'int' is also an 'Int64', which leaves three cases.
+    if (left.isInteger() || left.isInteger64()) {
+        const bsls::Types::Int64 integer = left.isInteger()
+                                               ? left.theInteger()
+                                               : left.theInteger64();
+        switch (right.type()) {
+            case bdld::Datum::e_INTEGER:
+                return integer == right.theInteger();
+            case bdld::Datum::e_INTEGER64:
+                return integer == right.theInteger64();
+            case bdld::Datum::e_DOUBLE:
+                return equal(integer, right.theDouble());
+            default:
+                BSLS_ASSERT(right.isDecimal64());
+                return equal(integer, right.theDecimal64());
+        }
+    }
+
+    if (right.isInteger() || right.isInteger64()) {
+        return equal(right, left);
+    }
+
+    if (left.isDouble()) {
+        BSLS_ASSERT(right.isDecimal64());
+        return equal(left.theDouble(), right.theDecimal64());
+    }
+
+    BSLS_ASSERT(left.isDecimal64());
+    BSLS_ASSERT(right.isDouble());
+    return equal(right.theDouble(), left.theDecimal64());
+}
+
+bool NumberUtil::equal(bsls::Types::Int64 integer, double binary) {
+    // Every 'double' of magnitude 2^63 or more is out of range, as is NaN.
+    // Within range, truncating 'binary' is exact if and only if 'binary' is
+    // an integer.
+    const double k_TWO_TO_THE_63 = 9223372036854775808.0;
+    if (!(binary >= -k_TWO_TO_THE_63 && binary < k_TWO_TO_THE_63)) {
+        return false;
+    }
+
+    const bsls::Types::Int64 truncated = bsls::Types::Int64(binary);
+    return truncated == integer && double(truncated) == binary;
+}
+
+bool NumberUtil::equal(bsls::Types::Int64 integer, bdldfp::Decimal64 decimal) {
+    return !bdldfp::DecimalUtil::isNan(decimal) &&
+           compare(integer, decimal) == 0;
+}
+
+bool NumberUtil::equal(double binary, bdldfp::Decimal64 decimal) {
+    return binary == binary && !bdldfp::DecimalUtil::isNan(decimal) &&
+           compare(binary, decimal) == 0;
+}
+
+bool NumberUtil::isNan(const bdld::Datum& value) {
+    switch (value.type()) {
+        case bdld::Datum::e_DOUBLE: {
+            const double binary = value.theDouble();
+            return binary != binary;
+        }
+        case bdld::Datum::e_DECIMAL64:
+            return bdldfp::DecimalUtil::isNan(value.theDecimal64());
+        default:
+            BSLS_ASSERT(isNumeric(value));
+            return false;
+    }
+}
+
+int NumberUtil::compare(const bdld::Datum& left, const bdld::Datum& right) {
+    BSLS_ASSERT(isNumeric(left));
+    BSLS_ASSERT(isNumeric(right));
+
+    // Every 'int' is also an 'Int64', which leaves three cases involving
+    // integers, and then three cases without.
+    if (left.isInteger() || left.isInteger64()) {
+        const bsls::Types::Int64 integer = left.isInteger()
+                                               ? left.theInteger()
+                                               : left.theInteger64();
+        switch (right.type()) {
+            case bdld::Datum::e_INTEGER:
+                return compareValues(integer,
+                                     bsls::Types::Int64(right.theInteger()));
+            case bdld::Datum::e_INTEGER64:
+                return compareValues(integer, right.theInteger64());
+            case bdld::Datum::e_DOUBLE:
+                return compare(integer, right.theDouble());
+            default:
+                BSLS_ASSERT(right.isDecimal64());
+                return compare(integer, right.theDecimal64());
+        }
+    }
+
+    if (right.isInteger() || right.isInteger64()) {
+        return -compare(right, left);
+    }
+
+    if (left.isDouble()) {
+        if (right.isDouble()) {
+            return compareDoubles(left.theDouble(), right.theDouble());
+        }
+        BSLS_ASSERT(right.isDecimal64());
+        return compare(left.theDouble(), right.theDecimal64());
+    }
+
+    BSLS_ASSERT(left.isDecimal64());
+    if (right.isDecimal64()) {
+        return compareDecimals(left.theDecimal64(), right.theDecimal64());
+    }
+    BSLS_ASSERT(right.isDouble());
+    return -compare(right.theDouble(), left.theDecimal64());
+}
+
+int NumberUtil::compare(bsls::Types::Int64 integer, double binary) {
+    // Every 'double' of magnitude 2^63 or more is out of range. Within
+    // range, truncation toward zero is exact, and whatever is left over
+    // breaks a tie between the integer parts.
+    const double k_TWO_TO_THE_63 = 9223372036854775808.0;
+    if (binary != binary || binary >= k_TWO_TO_THE_63) {
+        return -1;
+    }
+    if (binary < -k_TWO_TO_THE_63) {
+        return 1;
+    }
+
+    const bsls::Types::Int64 truncated = bsls::Types::Int64(binary);
+    if (integer != truncated) {
+        return compareValues(integer, truncated);
+    }
+    return compareValues(0.0, binary - double(truncated));
+}
+
+int NumberUtil::compare(bsls::Types::Int64 integer,
+                        bdldfp::Decimal64  decimal) {
+    int                 sign;  // -1 or +1
+    bsls::Types::Uint64 significand;
+    int                 exponent;
+    switch (bdldfp::DecimalUtil::decompose(
+        &sign, &significand, &exponent, decimal)) {
+        case FP_NAN:
+            return -1;
+        case FP_INFINITE:
+            return -sign;
+        case FP_ZERO:
+            return compareValues(integer, bsls::Types::Int64(0));
+        default:
+            break;
+    }
+
+    if (integer == 0 || (integer < 0) != (sign < 0)) {
+        return -sign;
+    }
+
+    const Uint64 magnitude =
+        integer < 0 ? 0 - Uint64(integer) : Uint64(integer);
+    return sign * compareMagnitudes(magnitude, 0, significand, exponent);
+}
+
+int NumberUtil::compare(double binary, bdldfp::Decimal64 decimal) {
+    int                 sign;  // -1 or +1
+    bsls::Types::Uint64 significand;
+    int                 exponent;
+    const int           kind = bdldfp::DecimalUtil::decompose(
+        &sign, &significand, &exponent, decimal);
+
+    if (binary != binary) {
+        return kind == FP_NAN ? 0 : 1;
+    }
+
+    switch (kind) {
+        case FP_NAN:
+            return -1;
+        case FP_INFINITE:
+            return binary == bsl::numeric_limits<double>::infinity() * sign
+                       ? 0
+                       : -sign;
+        case FP_ZERO:
+            return compareValues(binary, 0.0);
+        default:
+            break;
+    }
+
+    if (binary == 0 || (binary < 0) != (sign < 0)) {
+        return -sign;
+    }
+    if (binary == bsl::numeric_limits<double>::infinity() * sign) {
+        return sign;
+    }
+
+    // 'frexp' gives a significand in '[0.5, 1)', which becomes an integer
+    // without loss of precision when multiplied by 2^53.
+    const int    precision = 53;
+    int          binaryExponent;
+    const double fraction  = bsl::frexp(bsl::fabs(binary), &binaryExponent);
+    const Uint64 binarySignificand =
+        Uint64(fraction * double(Uint64(1) << precision));
+
+    return sign * compareMagnitudes(binarySignificand,
+                                    binaryExponent - precision,
+                                    significand,
+                                    exponent);
+}
+
+double NumberUtil::toDouble(const bdld::Datum& value) {
+    switch (value.type()) {
+        case bdld::Datum::e_INTEGER:
+            return value.theInteger();
+        case bdld::Datum::e_INTEGER64:
+            return double(value.theInteger64());
+        case bdld::Datum::e_DOUBLE:
+            return value.theDouble();
+        default:
+            BSLS_ASSERT(value.isDecimal64());
+            return bdldfp::DecimalConvertUtil::decimalToDouble(
+                value.theDecimal64());
+    }
+}
+
+}  // namespace lspcore
@@ -0,0 +1,83 @@
+#ifndef INCLUDED_LSPCORE_NUMBERUTIL
+#define INCLUDED_LSPCORE_NUMBERUTIL
+
+#include <bdldfp_decimal.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace bdld {
+class Datum;
+}  // namespace bdld
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld   = BloombergLP::bdld;
+namespace bdldfp = BloombergLP::bdldfp;
+namespace bsls   = BloombergLP::bsls;
+
+// 'NumberUtil' provides exact comparisons among the numeric types of
+// 'bdld::Datum': 'int', 'bsls::Types::Int64', 'double', and
+// 'bdldfp::Decimal64'. Values of different types are compared by their
+// mathematical values, without conversion to a common type, so that, for
+// example, the 'double' nearest to 0.1 is not equal to the decimal 0.1, and
+// 2^53 + 1 is not equal to the 'double' 2^53. Not-a-number is equal to
+// nothing, including itself, but 'compare' orders it after every other
+// number so that it can be used as a total order.
+//
+// Comparing a 'double' with a 'bdldfp::Decimal64' first estimates the decimal
+// exponent of each. Only values within a couple of orders of magnitude of
+// each other are compared exactly, using integer arithmetic.
+struct NumberUtil {
+    // Return whether the specified 'value' is of a numeric type.
+    static bool isNumeric(const bdld::Datum& value);
+
+    // Return whether the specified 'left' and 'right' have the same value.
+    // The behavior is undefined unless 'isNumeric(left)' and
+    // 'isNumeric(right)'.
+    static bool equal(const bdld::Datum& left, const bdld::Datum& right);
+
+    // Return whether the specified 'integer' and 'binary' have the same
+    // value.
+    static bool equal(bsls::Types::Int64 integer, double binary);
+
+    // Return whether the specified 'integer' and 'decimal' have the same
+    // value.
+    static bool equal(bsls::Types::Int64 integer, bdldfp::Decimal64 decimal);
+
+    // Return whether the specified 'binary' and 'decimal' have the same
+    // value.
+    static bool equal(double binary, bdldfp::Decimal64 decimal);
+
+    // Return whether the specified 'value' is not-a-number. The behavior is
+    // undefined unless 'isNumeric(value)'.
+    static bool isNan(const bdld::Datum& value);
+
+    // Return a negative number, zero, or a positive number if the specified
+    // 'left' is less than, equal to, or greater than the specified 'right',
+    // respectively. Not-a-number is equal to itself and greater than every
+    // other number, including infinity. The behavior is undefined unless
+    // 'isNumeric(left)' and 'isNumeric(right)'.
+    static int compare(const bdld::Datum& left, const bdld::Datum& right);
+
+    // Return the three-way comparison of the specified 'integer' and
+    // 'binary', as described by the other overload of 'compare'.
+    static int compare(bsls::Types::Int64 integer, double binary);
+
+    // Return the three-way comparison of the specified 'integer' and
+    // 'decimal', as described by the other overload of 'compare'.
+    static int compare(bsls::Types::Int64 integer, bdldfp::Decimal64 decimal);
+
+    // Return the three-way comparison of the specified 'binary' and
+    // 'decimal', as described by the other overload of 'compare'.
+    static int compare(double binary, bdldfp::Decimal64 decimal);
+
+    // Return the 'double' nearest to the value of the specified 'value'. The
+    // behavior is undefined unless 'isNumeric(value)'. Note that numbers
+    // that are equal have the same nearest 'double', which makes the result
+    // suitable for hashing.
+    static double toDouble(const bdld::Datum& value);
+};
+
+}  // namespace lspcore
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef INCLUDED_LSPCORE_NUMERICPARSEUTIL
+#define INCLUDED_LSPCORE_NUMERICPARSEUTIL
+
+#include <bdldfp_decimal.h>
+#include <bsl_string_view.h>
+#include <bsls_types.h>
+
+namespace lspcore {
+namespace bdldfp = BloombergLP::bdldfp;
+namespace bsls   = BloombergLP::bsls;
+
+// 'NumericParseUtil' converts the text of numeric tokens into values. It
+// replaces the general purpose 'baljsn::ParserUtil::getValue' for the common
+// cases, relying on the fact that the lexer has already restricted the text
+// to one of the following forms:
+//
+//     integer:  -?(?:0|[1-9]\d*)
+//     decimal:  -?(?:0|[1-9]\d*)[,.]\d+(?:[eE][+-]?\d+)?
+//
+// Note that either "." or "," may separate the whole and fractional parts of
+// a decimal. Text that is not of the expected form is rejected. Cases that
+// are too rare to deserve a dedicated implementation (e.g. subnormal doubles
+// or decimals that must be rounded) are forwarded to 'baljsn::ParserUtil', so
+// the results are always the same as those produced by that component.
+struct NumericParseUtil {
+    // Load into the specified 'result' the integer value of the specified
+    // 'text'. Return zero on success, or a nonzero value if 'text' is not an
+    // integer or is outside of the range of the target type.
+    static int parseInt32(int* result, bsl::string_view text);
+    static int parseInt64(bsls::Types::Int64* result, bsl::string_view text);
+
+    // Load into the specified 'result' the value of the specified 'text',
+    // correctly rounded to the nearest 'double'. Return zero on success, or a
+    // nonzero value if 'text' is not a decimal or cannot be represented.
+    static int parseDouble(double* result, bsl::string_view text);
+
+    // Load into the specified 'result' the value of the specified 'text',
+    // preserving the number of digits in 'text' as the quantum of 'result',
+    // e.g. "1.50" is 150e-2, not 15e-1. Return zero on success, or a nonzero
+    // value if 'text' is not a decimal or cannot be represented.
+    static int parseDecimal64(bdldfp::Decimal64* result,
+                              bsl::string_view   text);
+};
+
+}  // namespace lspcore
+
+#endif
@@ -0,0 +1,1238 @@
+#include <bdld_datumarraybuilder.h>
+#include <bsl_algorithm.h>
+#include <bsl_new.h>
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+#include <bsls_types.h>
+#include <lspcore_cpuutil.h>
+#include <lspcore_packedvector.h>
+#include <lspcore_userdefinedtypes.h>
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+#include <immintrin.h>
+#endif
+
+using namespace BloombergLP;
+
+namespace lspcore {
+namespace {
+
+typedef bsls::Types::Int64  Int64;
+typedef bsls::Types::Uint64 Uint64;
+
+// 'Lanes<NUMBER>::k_COUNT' is the number of 'NUMBER' values in a 256-bit
+// register. The portable reductions below use the same number of lanes as
+// the AVX2 reductions, so that they add (or compare) in the same order.
+template <typename NUMBER>
+struct Lanes {
+    enum { k_COUNT = 32 / sizeof(NUMBER) };
+};
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+// 'Int32x8', 'Int64x4', and 'Doublex4' are 256-bit registers of elements of
+// each type. They are distinct types, unlike '__m256i', so that operations
+// can be overloaded on them. 'Avx2<NUMBER>::Vector' is the register type for
+// 'NUMBER'.
+struct Int32x8 {
+    __m256i value;
+};
+
+struct Int64x4 {
+    __m256i value;
+};
+
+struct Doublex4 {
+    __m256d value;
+};
+
+template <typename NUMBER>
+struct Avx2;
+
+template <>
+struct Avx2<int> {
+    typedef Int32x8 Vector;
+};
+
+template <>
+struct Avx2<Int64> {
+    typedef Int64x4 Vector;
+};
+
+template <>
+struct Avx2<double> {
+    typedef Doublex4 Vector;
+};
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int32x8 int32x8(__m256i value) {
+    const Int32x8 result = { value };
+    return result;
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int64x4 int64x4(__m256i value) {
+    const Int64x4 result = { value };
+    return result;
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Doublex4 doublex4(__m256d value) {
+    const Doublex4 result = { value };
+    return result;
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int32x8 load(const int* input) {
+    return int32x8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input)));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int64x4 load(const Int64* input) {
+    return int64x4(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input)));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Doublex4 load(const double* input) {
+    return doublex4(_mm256_loadu_pd(input));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int32x8 splat(int value) {
+    return int32x8(_mm256_set1_epi32(value));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int64x4 splat(Int64 value) {
+    return int64x4(_mm256_set1_epi64x(value));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Doublex4 splat(double value) {
+    return doublex4(_mm256_set1_pd(value));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+void store(int* output, Int32x8 vector) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), vector.value);
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+void store(Int64* output, Int64x4 vector) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), vector.value);
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+void store(double* output, Doublex4 vector) {
+    _mm256_storeu_pd(output, vector.value);
+}
+
+// Store at the specified 'output' one 'int' for each lane of the specified
+// 'mask', which is one if the lane is all ones and zero if it is all zeros.
+LSPCORE_CPUUTIL_TARGET("avx2")
+void storeFlags(int* output, Int32x8 mask) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output),
+                        _mm256_srli_epi32(mask.value, 31));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+void storeFlags(int* output, Int64x4 mask) {
+    // Gather the low half of each 64-bit lane into the low 128 bits.
+    const __m256i halves = _mm256_permutevar8x32_epi32(
+        mask.value, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                     _mm_srli_epi32(_mm256_castsi256_si128(halves), 31));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+void storeFlags(int* output, Doublex4 mask) {
+    storeFlags(output, int64x4(_mm256_castpd_si256(mask.value)));
+}
+
+// Return the inclusive prefix sums of the lanes of the specified 'vector'.
+// Each step adds the vector shifted by one lane, then two, and so on, within
+// each 128-bit half, and then the last sum of the low half is added to every
+// lane of the high half.
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int32x8 scan(Int32x8 vector) {
+    __m256i sums = vector.value;
+    sums = _mm256_add_epi32(sums, _mm256_slli_si256(sums, 4));
+    sums = _mm256_add_epi32(sums, _mm256_slli_si256(sums, 8));
+    const __m256i lows = _mm256_shuffle_epi32(sums, 0xFF);
+    return int32x8(
+        _mm256_add_epi32(sums, _mm256_permute2x128_si256(lows, lows, 0x08)));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int64x4 scan(Int64x4 vector) {
+    __m256i sums = vector.value;
+    sums = _mm256_add_epi64(sums, _mm256_slli_si256(sums, 8));
+    const __m256i lows = _mm256_permute4x64_epi64(sums, 0x55);
+    return int64x4(
+        _mm256_add_epi64(sums, _mm256_permute2x128_si256(lows, lows, 0x08)));
+}
+
+// Return a vector having the last lane of the specified 'vector' in every
+// lane.
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int32x8 last(Int32x8 vector) {
+    return int32x8(
+        _mm256_permutevar8x32_epi32(vector.value, _mm256_set1_epi32(7)));
+}
+
+LSPCORE_CPUUTIL_TARGET("avx2")
+Int64x4 last(Int64x4 vector) {
+    return int64x4(_mm256_permute4x64_epi64(vector.value, 0xFF));
+}
+#endif
+
+// Operations
+// ==========
+// Each operation has an 'apply' overload for each element type and, where
+// AVX2 is available, for each register type. Integer arithmetic is done in
+// the corresponding unsigned type, so that it wraps around on overflow just
+// as the vector instructions do. Comparisons return 'bool', or a mask of all
+// ones or all zeros in each lane. There are no integer division
+// instructions, so 'Divide' is only for doubles; see 'divide'.
+
+struct Add {
+    static int apply(int left, int right) {
+        return int(unsigned(left) + unsigned(right));
+    }
+
+    static Int64 apply(Int64 left, Int64 right) {
+        return Int64(Uint64(left) + Uint64(right));
+    }
+
+    static double apply(double left, double right) {
+        return left + right;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int32x8 apply(Int32x8 left, Int32x8 right) {
+        return int32x8(_mm256_add_epi32(left.value, right.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int64x4 apply(Int64x4 left, Int64x4 right) {
+        return int64x4(_mm256_add_epi64(left.value, right.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Doublex4 apply(Doublex4 left, Doublex4 right) {
+        return doublex4(_mm256_add_pd(left.value, right.value));
+    }
+#endif
+};
+
+struct Subtract {
+    static int apply(int left, int right) {
+        return int(unsigned(left) - unsigned(right));
+    }
+
+    static Int64 apply(Int64 left, Int64 right) {
+        return Int64(Uint64(left) - Uint64(right));
+    }
+
+    static double apply(double left, double right) {
+        return left - right;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int32x8 apply(Int32x8 left, Int32x8 right) {
+        return int32x8(_mm256_sub_epi32(left.value, right.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int64x4 apply(Int64x4 left, Int64x4 right) {
+        return int64x4(_mm256_sub_epi64(left.value, right.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Doublex4 apply(Doublex4 left, Doublex4 right) {
+        return doublex4(_mm256_sub_pd(left.value, right.value));
+    }
+#endif
+};
+
+struct Multiply {
+    static int apply(int left, int right) {
+        return int(unsigned(left) * unsigned(right));
+    }
+
+    static Int64 apply(Int64 left, Int64 right) {
+        return Int64(Uint64(left) * Uint64(right));
+    }
+
+    static double apply(double left, double right) {
+        return left * right;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int32x8 apply(Int32x8 left, Int32x8 right) {
+        return int32x8(_mm256_mullo_epi32(left.value, right.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int64x4 apply(Int64x4 left, Int64x4 right) {
+        // AVX2 multiplies only 32-bit halves. The low 64 bits of the product
+        // are 'lo*lo + ((lo*hi + hi*lo) << 32)'.
+        const __m256i leftHigh  = _mm256_srli_epi64(left.value, 32);
+        const __m256i rightHigh = _mm256_srli_epi64(right.value, 32);
+        const __m256i cross     = _mm256_add_epi64(
+            _mm256_mul_epu32(left.value, rightHigh),
+            _mm256_mul_epu32(leftHigh, right.value));
+        return int64x4(
+            _mm256_add_epi64(_mm256_mul_epu32(left.value, right.value),
+                             _mm256_slli_epi64(cross, 32)));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Doublex4 apply(Doublex4 left, Doublex4 right) {
+        return doublex4(_mm256_mul_pd(left.value, right.value));
+    }
+#endif
+};
+
+struct Divide {
+    static double apply(double left, double right) {
+        return left / right;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Doublex4 apply(Doublex4 left, Doublex4 right) {
+        return doublex4(_mm256_div_pd(left.value, right.value));
+    }
+#endif
+};
+
+// 'Minimum' and 'Maximum' have the semantics of the 'minpd' and 'maxpd'
+// instructions: if the comparison is false, e.g. because of NaN, the result
+// is the right operand.
+struct Minimum {
+    template <typename NUMBER>
+    static NUMBER apply(NUMBER left, NUMBER right) {
+        return left < right ? left : right;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int32x8 apply(Int32x8 left, Int32x8 right) {
+        return int32x8(_mm256_min_epi32(left.value, right.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int64x4 apply(Int64x4 left, Int64x4 right) {
+        return int64x4(_mm256_blendv_epi8(
+            right.value,
+            left.value,
+            _mm256_cmpgt_epi64(right.value, left.value)));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Doublex4 apply(Doublex4 left, Doublex4 right) {
+        return doublex4(_mm256_min_pd(left.value, right.value));
+    }
+#endif
+};
+
+struct Maximum {
+    template <typename NUMBER>
+    static NUMBER apply(NUMBER left, NUMBER right) {
+        return left > right ? left : right;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int32x8 apply(Int32x8 left, Int32x8 right) {
+        return int32x8(_mm256_max_epi32(left.value, right.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int64x4 apply(Int64x4 left, Int64x4 right) {
+        return int64x4(_mm256_blendv_epi8(
+            right.value,
+            left.value,
+            _mm256_cmpgt_epi64(left.value, right.value)));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Doublex4 apply(Doublex4 left, Doublex4 right) {
+        return doublex4(_mm256_max_pd(left.value, right.value));
+    }
+#endif
+};
+
+struct Less {
+    template <typename NUMBER>
+    static bool apply(NUMBER left, NUMBER right) {
+        return left < right;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int32x8 apply(Int32x8 left, Int32x8 right) {
+        return int32x8(_mm256_cmpgt_epi32(right.value, left.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int64x4 apply(Int64x4 left, Int64x4 right) {
+        return int64x4(_mm256_cmpgt_epi64(right.value, left.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Doublex4 apply(Doublex4 left, Doublex4 right) {
+        return doublex4(_mm256_cmp_pd(left.value, right.value, _CMP_LT_OQ));
+    }
+#endif
+};
+
+struct LessOrEqual {
+    template <typename NUMBER>
+    static bool apply(NUMBER left, NUMBER right) {
+        return left <= right;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int32x8 apply(Int32x8 left, Int32x8 right) {
+        return int32x8(
+            _mm256_xor_si256(_mm256_cmpgt_epi32(left.value, right.value),
+                             _mm256_set1_epi32(-1)));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int64x4 apply(Int64x4 left, Int64x4 right) {
+        return int64x4(
+            _mm256_xor_si256(_mm256_cmpgt_epi64(left.value, right.value),
+                             _mm256_set1_epi32(-1)));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Doublex4 apply(Doublex4 left, Doublex4 right) {
+        return doublex4(_mm256_cmp_pd(left.value, right.value, _CMP_LE_OQ));
+    }
+#endif
+};
+
+struct Equal {
+    template <typename NUMBER>
+    static bool apply(NUMBER left, NUMBER right) {
+        return left == right;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int32x8 apply(Int32x8 left, Int32x8 right) {
+        return int32x8(_mm256_cmpeq_epi32(left.value, right.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Int64x4 apply(Int64x4 left, Int64x4 right) {
+        return int64x4(_mm256_cmpeq_epi64(left.value, right.value));
+    }
+
+    LSPCORE_CPUUTIL_TARGET("avx2")
+    static Doublex4 apply(Doublex4 left, Doublex4 right) {
+        return doublex4(_mm256_cmp_pd(left.value, right.value, _CMP_EQ_OQ));
+    }
+#endif
+};
+
+// Kernels
+// =======
+// Each "Avx2" kernel processes whole registers of elements for as long as
+// there are enough left, and returns how many it processed. The caller then
+// finishes the job with portable code. An operand having a "step" of zero is
+// a single element paired with every element of the other operand.
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+template <typename OPERATION, typename NUMBER>
+LSPCORE_CPUUTIL_TARGET("avx2")
+bsl::size_t applyAvx2(NUMBER*       output,
+                      const NUMBER* left,
+                      bsl::size_t   leftStep,
+                      const NUMBER* right,
+                      bsl::size_t   rightStep,
+                      bsl::size_t   length) {
+    typedef typename Avx2<NUMBER>::Vector Vector;
+    const bsl::size_t count = Lanes<NUMBER>::k_COUNT;
+
+    const Vector leftSplat  = splat(leftStep ? NUMBER() : *left);
+    const Vector rightSplat = splat(rightStep ? NUMBER() : *right);
+    bsl::size_t  i          = 0;
+    for (; length - i >= count; i += count) {
+        const Vector leftLanes  = leftStep ? load(left + i) : leftSplat;
+        const Vector rightLanes = rightStep ? load(right + i) : rightSplat;
+        store(output + i, OPERATION::apply(leftLanes, rightLanes));
+    }
+    return i;
+}
+
+// This is 'applyAvx2' for comparisons, whose results are stored as flags.
+template <typename COMPARISON, typename NUMBER>
+LSPCORE_CPUUTIL_TARGET("avx2")
+bsl::size_t testAvx2(int*          output,
+                     const NUMBER* left,
+                     bsl::size_t   leftStep,
+                     const NUMBER* right,
+                     bsl::size_t   rightStep,
+                     bsl::size_t   length) {
+    typedef typename Avx2<NUMBER>::Vector Vector;
+    const bsl::size_t count = Lanes<NUMBER>::k_COUNT;
+
+    const Vector leftSplat  = splat(leftStep ? NUMBER() : *left);
+    const Vector rightSplat = splat(rightStep ? NUMBER() : *right);
+    bsl::size_t  i          = 0;
+    for (; length - i >= count; i += count) {
+        const Vector leftLanes  = leftStep ? load(left + i) : leftSplat;
+        const Vector rightLanes = rightStep ? load(right + i) : rightSplat;
+        storeFlags(output + i, COMPARISON::apply(leftLanes, rightLanes));
+    }
+    return i;
+}
+
+template <typename OPERATION, typename NUMBER>
+LSPCORE_CPUUTIL_TARGET("avx2")
+bsl::size_t reduceAvx2(NUMBER*       lanes,
+                       const NUMBER* input,
+                       bsl::size_t   length) {
+    const bsl::size_t count = Lanes<NUMBER>::k_COUNT;
+
+    typename Avx2<NUMBER>::Vector accumulator = load(lanes);
+    bsl::size_t                   i           = 0;
+    for (; length - i >= count; i += count) {
+        accumulator = OPERATION::apply(accumulator, load(input + i));
+    }
+    store(lanes, accumulator);
+    return i;
+}
+
+template <typename NUMBER>
+LSPCORE_CPUUTIL_TARGET("avx2")
+bsl::size_t dotAvx2(NUMBER*       lanes,
+                    const NUMBER* left,
+                    const NUMBER* right,
+                    bsl::size_t   length) {
+    const bsl::size_t count = Lanes<NUMBER>::k_COUNT;
+
+    typename Avx2<NUMBER>::Vector accumulator = load(lanes);
+    bsl::size_t                   i           = 0;
+    for (; length - i >= count; i += count) {
+        accumulator = Add::apply(
+            accumulator, Multiply::apply(load(left + i), load(right + i)));
+    }
+    store(lanes, accumulator);
+    return i;
+}
+
+template <typename NUMBER>
+LSPCORE_CPUUTIL_TARGET("avx2")
+bsl::size_t prefixSumAvx2(NUMBER*       output,
+                          const NUMBER* input,
+                          bsl::size_t   length) {
+    typedef typename Avx2<NUMBER>::Vector Vector;
+    const bsl::size_t count = Lanes<NUMBER>::k_COUNT;
+
+    Vector      carry = splat(NUMBER(0));
+    bsl::size_t i     = 0;
+    for (; length - i >= count; i += count) {
+        const Vector sums = Add::apply(scan(load(input + i)), carry);
+        store(output + i, sums);
+        carry = last(sums);
+    }
+    return i;
+}
+#endif
+
+template <typename OPERATION, typename NUMBER>
+void applyEach(NUMBER*       output,
+               const NUMBER* left,
+               bsl::size_t   leftStep,
+               const NUMBER* right,
+               bsl::size_t   rightStep,
+               bsl::size_t   length) {
+    bsl::size_t i = 0;
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    if (CpuUtil::hasAvx2()) {
+        i = applyAvx2<OPERATION>(
+            output, left, leftStep, right, rightStep, length);
+    }
+#endif
+    for (; i < length; ++i) {
+        output[i] =
+            OPERATION::apply(left[i * leftStep], right[i * rightStep]);
+    }
+}
+
+template <typename COMPARISON, typename NUMBER>
+void testEach(int*          output,
+              const NUMBER* left,
+              bsl::size_t   leftStep,
+              const NUMBER* right,
+              bsl::size_t   rightStep,
+              bsl::size_t   length) {
+    bsl::size_t i = 0;
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    if (CpuUtil::hasAvx2()) {
+        i = testAvx2<COMPARISON>(
+            output, left, leftStep, right, rightStep, length);
+    }
+#endif
+    for (; i < length; ++i) {
+        output[i] =
+            COMPARISON::apply(left[i * leftStep], right[i * rightStep]);
+    }
+}
+
+// Divide each element of the specified 'left' by the corresponding element
+// of the specified 'right', truncating toward zero, as with 'applyEach'.
+// Return zero on success, or a nonzero value if a divisor is zero. Dividing
+// the least integer by -1 wraps around, as with the other operations, rather
+// than trapping.
+template <typename NUMBER>
+int divide(NUMBER*       output,
+           const NUMBER* left,
+           bsl::size_t   leftStep,
+           const NUMBER* right,
+           bsl::size_t   rightStep,
+           bsl::size_t   length) {
+    for (bsl::size_t i = 0; i < length; ++i) {
+        const NUMBER dividend = left[i * leftStep];
+        const NUMBER divisor  = right[i * rightStep];
+        if (divisor == 0) {
+            return 1;
+        }
+        output[i] = divisor == -1 ? Subtract::apply(NUMBER(0), dividend)
+                                  : dividend / divisor;
+    }
+    return 0;
+}
+
+int divide(double*       output,
+           const double* left,
+           bsl::size_t   leftStep,
+           const double* right,
+           bsl::size_t   rightStep,
+           bsl::size_t   length) {
+    applyEach<Divide>(output, left, leftStep, right, rightStep, length);
+    return 0;
+}
+
+template <typename OPERATION, typename NUMBER>
+NUMBER reduce(const NUMBER* input, bsl::size_t length, NUMBER initial) {
+    const bsl::size_t count = Lanes<NUMBER>::k_COUNT;
+
+    NUMBER lanes[Lanes<NUMBER>::k_COUNT];
+    bsl::fill(lanes, lanes + count, initial);
+
+    bsl::size_t i = 0;
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    if (CpuUtil::hasAvx2()) {
+        i = reduceAvx2<OPERATION>(lanes, input, length);
+    }
+#endif
+    for (; length - i >= count; i += count) {
+        for (bsl::size_t j = 0; j < count; ++j) {
+            lanes[j] = OPERATION::apply(lanes[j], input[i + j]);
+        }
+    }
+
+    NUMBER result = lanes[0];
+    for (bsl::size_t j = 1; j < count; ++j) {
+        result = OPERATION::apply(result, lanes[j]);
+    }
+    for (; i < length; ++i) {
+        result = OPERATION::apply(result, input[i]);
+    }
+    return result;
+}
+
+template <typename NUMBER>
+NUMBER dotProduct(const NUMBER* left,
+                  const NUMBER* right,
+                  bsl::size_t   length) {
+    const bsl::size_t count = Lanes<NUMBER>::k_COUNT;
+
+    NUMBER lanes[Lanes<NUMBER>::k_COUNT];
+    bsl::fill(lanes, lanes + count, NUMBER(0));
+
+    bsl::size_t i = 0;
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    if (CpuUtil::hasAvx2()) {
+        i = dotAvx2(lanes, left, right, length);
+    }
+#endif
+    for (; length - i >= count; i += count) {
+        for (bsl::size_t j = 0; j < count; ++j) {
+            lanes[j] = Add::apply(lanes[j],
+                                  Multiply::apply(left[i + j], right[i + j]));
+        }
+    }
+
+    NUMBER result = lanes[0];
+    for (bsl::size_t j = 1; j < count; ++j) {
+        result = Add::apply(result, lanes[j]);
+    }
+    for (; i < length; ++i) {
+        result = Add::apply(result, Multiply::apply(left[i], right[i]));
+    }
+    return result;
+}
+
+template <typename NUMBER>
+void prefixSums(NUMBER* output, const NUMBER* input, bsl::size_t length) {
+    bsl::size_t i = 0;
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    if (CpuUtil::hasAvx2()) {
+        i = prefixSumAvx2(output, input, length);
+    }
+#endif
+    NUMBER sum = i ? output[i - 1] : NUMBER(0);
+    for (; i < length; ++i) {
+        sum       = Add::apply(sum, input[i]);
+        output[i] = sum;
+    }
+}
+
+void prefixSums(double* output, const double* input, bsl::size_t length) {
+    double sum = 0;
+    for (bsl::size_t i = 0; i < length; ++i) {
+        sum += input[i];
+        output[i] = sum;
+    }
+}
+
+// Return a 'bdld::Datum' having the specified 'value'.
+bdld::Datum makeDatum(int value, bslma::Allocator*) {
+    return bdld::Datum::createInteger(value);
+}
+
+bdld::Datum makeDatum(Int64 value, bslma::Allocator* allocator) {
+    return bdld::Datum::createInteger64(value, allocator);
+}
+
+bdld::Datum makeDatum(double value, bslma::Allocator*) {
+    return bdld::Datum::createDouble(value);
+}
+
+// Load into the specified 'output' the value of the specified 'datum'.
+// Return zero on success, or a nonzero value if 'datum' is not a number that
+// the type of 'output' represents exactly.
+int convert(int* output, const bdld::Datum& datum) {
+    if (!datum.isInteger()) {
+        return 1;
+    }
+    *output = datum.theInteger();
+    return 0;
+}
+
+int convert(Int64* output, const bdld::Datum& datum) {
+    if (datum.isInteger()) {
+        *output = datum.theInteger();
+    }
+    else if (datum.isInteger64()) {
+        *output = datum.theInteger64();
+    }
+    else {
+        return 1;
+    }
+    return 0;
+}
+
+int convert(double* output, const bdld::Datum& datum) {
+    if (datum.isInteger()) {
+        *output = datum.theInteger();
+    }
+    else if (datum.isDouble()) {
+        *output = datum.theDouble();
+    }
+    else {
+        return 1;
+    }
+    return 0;
+}
+
+template <typename NUMBER>
+int convertRange(NUMBER*            output,
+                 const bdld::Datum* begin,
+                 const bdld::Datum* end) {
+    for (; begin != end; ++begin, ++output) {
+        if (convert(output, *begin)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+bsl::size_t elementSize(PackedVector::ElementType type) {
+    switch (type) {
+        case PackedVector::e_INT32:
+            return sizeof(int);
+        case PackedVector::e_INT64:
+            return sizeof(Int64);
+        default:
+            BSLS_ASSERT(type == PackedVector::e_DOUBLE);
+            return sizeof(double);
+    }
+}
+
+// Apply the specified 'operation' to the specified 'left' and 'right',
+// writing the result to the specified 'output', as described by
+// 'PackedVector::apply'.
+template <typename NUMBER>
+int applyOperation(NUMBER*                 output,
+                   PackedVector::Operation operation,
+                   const PackedVector&     left,
+                   const PackedVector&     right,
+                   bsl::size_t             length) {
+    const NUMBER* const leftElements  = left.elements<NUMBER>();
+    const NUMBER* const rightElements = right.elements<NUMBER>();
+    const bsl::size_t   leftStep      = left.length() == 1 ? 0 : 1;
+    const bsl::size_t   rightStep     = right.length() == 1 ? 0 : 1;
+
+    switch (operation) {
+        case PackedVector::e_ADD:
+            applyEach<Add>(output,
+                           leftElements,
+                           leftStep,
+                           rightElements,
+                           rightStep,
+                           length);
+            return 0;
+        case PackedVector::e_SUBTRACT:
+            applyEach<Subtract>(output,
+                                leftElements,
+                                leftStep,
+                                rightElements,
+                                rightStep,
+                                length);
+            return 0;
+        case PackedVector::e_MULTIPLY:
+            applyEach<Multiply>(output,
+                                leftElements,
+                                leftStep,
+                                rightElements,
+                                rightStep,
+                                length);
+            return 0;
+        default:
+            BSLS_ASSERT(operation == PackedVector::e_DIVIDE);
+            return divide(output,
+                          leftElements,
+                          leftStep,
+                          rightElements,
+                          rightStep,
+                          length);
+    }
+}
+
+// Write to the specified 'output' the result of the specified 'comparison'
+// of the specified 'left' and 'right', as described by
+// 'PackedVector::compareEach'.
+template <typename NUMBER>
+void testElements(int*                     output,
+                  PackedVector::Comparison comparison,
+                  const PackedVector&      left,
+                  const PackedVector&      right,
+                  bsl::size_t              length) {
+    const NUMBER* leftElements  = left.elements<NUMBER>();
+    const NUMBER* rightElements = right.elements<NUMBER>();
+    bsl::size_t   leftStep      = left.length() == 1 ? 0 : 1;
+    bsl::size_t   rightStep     = right.length() == 1 ? 0 : 1;
+
+    // "Greater" is "less" with the operands swapped.
+    if (comparison == PackedVector::e_GREATER ||
+        comparison == PackedVector::e_GREATER_OR_EQUAL) {
+        bsl::swap(leftElements, rightElements);
+        bsl::swap(leftStep, rightStep);
+    }
+
+    switch (comparison) {
+        case PackedVector::e_LESS:
+        case PackedVector::e_GREATER:
+            testEach<Less>(output,
+                           leftElements,
+                           leftStep,
+                           rightElements,
+                           rightStep,
+                           length);
+            return;
+        case PackedVector::e_LESS_OR_EQUAL:
+        case PackedVector::e_GREATER_OR_EQUAL:
+            testEach<LessOrEqual>(output,
+                                  leftElements,
+                                  leftStep,
+                                  rightElements,
+                                  rightStep,
+                                  length);
+            return;
+        default:
+            BSLS_ASSERT(comparison == PackedVector::e_EQUAL);
+            testEach<Equal>(output,
+                            leftElements,
+                            leftStep,
+                            rightElements,
+                            rightStep,
+                            length);
+    }
+}
+
+template <typename NUMBER>
+bool equalElements(const PackedVector& left, const PackedVector& right) {
+    return bsl::equal(left.elements<NUMBER>(),
+                      left.elements<NUMBER>() + left.length(),
+                      right.elements<NUMBER>());
+}
+
+template <typename NUMBER>
+int compareElements(const PackedVector& left, const PackedVector& right) {
+    const NUMBER* const leftElements  = left.elements<NUMBER>();
+    const NUMBER* const rightElements = right.elements<NUMBER>();
+    const bsl::size_t   length = bsl::min(left.length(), right.length());
+    for (bsl::size_t i = 0; i < length; ++i) {
+        if (leftElements[i] < rightElements[i]) {
+            return -1;
+        }
+        if (rightElements[i] < leftElements[i]) {
+            return 1;
+        }
+    }
+
+    return int(left.length() > length) - int(right.length() > length);
+}
+
+}  // namespace
+
+#define DISPATCH(VECTOR, FUNCTION, ARGS)                                  \
+    switch ((VECTOR).type()) {                                            \
+        case e_INT32:                                                     \
+            return FUNCTION<int> ARGS;                                    \
+        case e_INT64:                                                     \
+            return FUNCTION<Int64> ARGS;                                  \
+        default:                                                          \
+            BSLS_ASSERT((VECTOR).type() == e_DOUBLE);                     \
+            return FUNCTION<double> ARGS;                                 \
+    }
+
+PackedVector::PackedVector(ElementType type, bsl::size_t length)
+: d_type(type)
+, d_length(length) {
+}
+
+PackedVector* PackedVector::allocate(ElementType       type,
+                                     bsl::size_t       length,
+                                     bslma::Allocator* allocator) {
+    void* memory = allocator->allocate(sizeof(PackedVector) +
+                                       length * elementSize(type));
+    return new (memory) PackedVector(type, length);
+}
+
+int PackedVector::inferType(ElementType*       type,
+                            const bdld::Datum* begin,
+                            const bdld::Datum* end) {
+    bool hasInt64  = false;
+    bool hasDouble = false;
+    for (const bdld::Datum* iter = begin; iter != end; ++iter) {
+        switch (iter->type()) {
+            case bdld::Datum::e_INTEGER:
+                break;
+            case bdld::Datum::e_INTEGER64:
+                hasInt64 = true;
+                break;
+            case bdld::Datum::e_DOUBLE:
+                hasDouble = true;
+                break;
+            default:
+                return 1;
+        }
+    }
+
+    if (hasInt64 && hasDouble) {
+        return 1;
+    }
+
+    if (hasDouble || begin == end) {
+        *type = e_DOUBLE;
+    }
+    else if (hasInt64) {
+        *type = e_INT64;
+    }
+    else {
+        *type = e_INT32;
+    }
+    return 0;
+}
+
+int PackedVector::fromRange(const PackedVector** result,
+                            ElementType          type,
+                            const bdld::Datum*   begin,
+                            const bdld::Datum*   end,
+                            bslma::Allocator*    allocator) {
+    PackedVector* const vector = allocate(type, end - begin, allocator);
+    *result                    = vector;
+    switch (type) {
+        case e_INT32:
+            return convertRange(vector->elements<int>(), begin, end);
+        case e_INT64:
+            return convertRange(vector->elements<Int64>(), begin, end);
+        default:
+            BSLS_ASSERT(type == e_DOUBLE);
+            return convertRange(vector->elements<double>(), begin, end);
+    }
+}
+
+bdld::Datum PackedVector::element(const PackedVector& vector,
+                                  bsl::size_t         index,
+                                  bslma::Allocator*   allocator) {
+    BSLS_ASSERT(index < vector.length());
+
+    switch (vector.type()) {
+        case e_INT32:
+            return makeDatum(vector.elements<int>()[index], allocator);
+        case e_INT64:
+            return makeDatum(vector.elements<Int64>()[index], allocator);
+        default:
+            BSLS_ASSERT(vector.type() == e_DOUBLE);
+            return makeDatum(vector.elements<double>()[index], allocator);
+    }
+}
+
+bdld::Datum PackedVector::toArray(const PackedVector& vector,
+                                  bslma::Allocator*   allocator) {
+    bdld::DatumArrayBuilder builder(vector.length(), allocator);
+    for (bsl::size_t i = 0; i < vector.length(); ++i) {
+        builder.pushBack(element(vector, i, allocator));
+    }
+
+    return builder.commit();
+}
+
+int PackedVector::apply(const PackedVector** result,
+                        Operation            operation,
+                        const PackedVector&  left,
+                        const PackedVector&  right,
+                        bslma::Allocator*    allocator) {
+    BSLS_ASSERT(left.type() == right.type());
+    BSLS_ASSERT(left.length() == right.length() || left.length() == 1 ||
+                right.length() == 1);
+
+    const bsl::size_t length =
+        left.length() == 1 ? right.length() : left.length();
+    PackedVector* const output = allocate(left.type(), length, allocator);
+    *result                    = output;
+    switch (left.type()) {
+        case e_INT32:
+            return applyOperation(
+                output->elements<int>(), operation, left, right, length);
+        case e_INT64:
+            return applyOperation(
+                output->elements<Int64>(), operation, left, right, length);
+        default:
+            BSLS_ASSERT(left.type() == e_DOUBLE);
+            return applyOperation(
+                output->elements<double>(), operation, left, right, length);
+    }
+}
+
+const PackedVector* PackedVector::compareEach(Comparison          comparison,
+                                              const PackedVector& left,
+                                              const PackedVector& right,
+                                              bslma::Allocator*   allocator) {
+    BSLS_ASSERT(left.type() == right.type());
+    BSLS_ASSERT(left.length() == right.length() || left.length() == 1 ||
+                right.length() == 1);
+
+    const bsl::size_t length =
+        left.length() == 1 ? right.length() : left.length();
+    PackedVector* const output = allocate(e_INT32, length, allocator);
+    int* const          flags  = output->elements<int>();
+    switch (left.type()) {
+        case e_INT32:
+            testElements<int>(flags, comparison, left, right, length);
+            break;
+        case e_INT64:
+            testElements<Int64>(flags, comparison, left, right, length);
+            break;
+        default:
+            BSLS_ASSERT(left.type() == e_DOUBLE);
+            testElements<double>(flags, comparison, left, right, length);
+    }
+    return output;
+}
+
+bdld::Datum PackedVector::sum(const PackedVector& vector,
+                              bslma::Allocator*   allocator) {
+    switch (vector.type()) {
+        case e_INT32:
+            return makeDatum(
+                reduce<Add>(vector.elements<int>(), vector.length(), 0),
+                allocator);
+        case e_INT64:
+            return makeDatum(reduce<Add>(vector.elements<Int64>(),
+                                         vector.length(),
+                                         Int64(0)),
+                             allocator);
+        default:
+            BSLS_ASSERT(vector.type() == e_DOUBLE);
+            return makeDatum(reduce<Add>(vector.elements<double>(),
+                                         vector.length(),
+                                         0.0),
+                             allocator);
+    }
+}
+
+bdld::Datum PackedVector::minimum(const PackedVector& vector,
+                                  bslma::Allocator*   allocator) {
+    BSLS_ASSERT(vector.length() > 0);
+
+    // Every lane begins with the first element, which is harmless to
+    // include more than once.
+    switch (vector.type()) {
+        case e_INT32: {
+            const int* const elements = vector.elements<int>();
+            return makeDatum(
+                reduce<Minimum>(elements, vector.length(), elements[0]),
+                allocator);
+        }
+        case e_INT64: {
+            const Int64* const elements = vector.elements<Int64>();
+            return makeDatum(
+                reduce<Minimum>(elements, vector.length(), elements[0]),
+                allocator);
+        }
+        default: {
+            BSLS_ASSERT(vector.type() == e_DOUBLE);
+            const double* const elements = vector.elements<double>();
+            return makeDatum(
+                reduce<Minimum>(elements, vector.length(), elements[0]),
+                allocator);
+        }
+    }
+}
+
+bdld::Datum PackedVector::maximum(const PackedVector& vector,
+                                  bslma::Allocator*   allocator) {
+    BSLS_ASSERT(vector.length() > 0);
+
+    switch (vector.type()) {
+        case e_INT32: {
+            const int* const elements = vector.elements<int>();
+            return makeDatum(
+                reduce<Maximum>(elements, vector.length(), elements[0]),
+                allocator);
+        }
+        case e_INT64: {
+            const Int64* const elements = vector.elements<Int64>();
+            return makeDatum(
+                reduce<Maximum>(elements, vector.length(), elements[0]),
+                allocator);
+        }
+        default: {
+            BSLS_ASSERT(vector.type() == e_DOUBLE);
+            const double* const elements = vector.elements<double>();
+            return makeDatum(
+                reduce<Maximum>(elements, vector.length(), elements[0]),
+                allocator);
+        }
+    }
+}
+
+bdld::Datum PackedVector::dot(const PackedVector& left,
+                              const PackedVector& right,
+                              bslma::Allocator*   allocator) {
+    BSLS_ASSERT(left.type() == right.type());
+    BSLS_ASSERT(left.length() == right.length());
+
+    switch (left.type()) {
+        case e_INT32:
+            return makeDatum(dotProduct(left.elements<int>(),
+                                        right.elements<int>(),
+                                        left.length()),
+                             allocator);
+        case e_INT64:
+            return makeDatum(dotProduct(left.elements<Int64>(),
+                                        right.elements<Int64>(),
+                                        left.length()),
+                             allocator);
+        default:
+            BSLS_ASSERT(left.type() == e_DOUBLE);
+            return makeDatum(dotProduct(left.elements<double>(),
+                                        right.elements<double>(),
+                                        left.length()),
+                             allocator);
+    }
+}
+
+const PackedVector* PackedVector::prefixSum(const PackedVector& vector,
+                                            bslma::Allocator*   allocator) {
+    PackedVector* const output =
+        allocate(vector.type(), vector.length(), allocator);
+    switch (vector.type()) {
+        case e_INT32:
+            prefixSums(output->elements<int>(),
+                       vector.elements<int>(),
+                       vector.length());
+            break;
+        case e_INT64:
+            prefixSums(output->elements<Int64>(),
+                       vector.elements<Int64>(),
+                       vector.length());
+            break;
+        default:
+            BSLS_ASSERT(vector.type() == e_DOUBLE);
+            prefixSums(output->elements<double>(),
+                       vector.elements<double>(),
+                       vector.length());
+    }
+    return output;
+}
+
+bool PackedVector::equal(const PackedVector& left, const PackedVector& right) {
+    if (left.type() != right.type() || left.length() != right.length()) {
+        return false;
+    }
+
+    DISPATCH(left, equalElements, (left, right))
+}
+
+int PackedVector::compare(const PackedVector& left,
+                          const PackedVector& right) {
+    if (left.type() != right.type()) {
+        return left.type() < right.type() ? -1 : 1;
+    }
+
+    DISPATCH(left, compareElements, (left, right))
+}
+
+#undef DISPATCH
+
+bool PackedVector::isPackedVector(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && isPackedVector(datum.theUdt(), typeOffset);
+}
+
+bool PackedVector::isPackedVector(const bdld::DatumUdt& udt, int typeOffset) {
+    return udt.type() == UserDefinedTypes::e_PACKED_VECTOR + typeOffset;
+}
+
+const PackedVector& PackedVector::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+const PackedVector& PackedVector::access(const bdld::DatumUdt& udt) {
+    return *static_cast<const PackedVector*>(udt.data());
+}
+
+bdld::Datum PackedVector::create(const PackedVector& vector, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(&vector)),
+        UserDefinedTypes::e_PACKED_VECTOR + typeOffset);
+}
+
+}  // namespace lspcore
@@ -0,0 +1,191 @@
+#ifndef INCLUDED_LSPCORE_PACKEDVECTOR
+#define INCLUDED_LSPCORE_PACKEDVECTOR
+
+// A packed vector is an immutable sequence of numbers that all have the same
+// type: 32-bit integers, 64-bit integers, or doubles. Whereas a 'bdld' array
+// of numbers stores a tagged 'bdld::Datum' for each element, and arithmetic
+// on it examines the type of every element, a packed vector stores the bare
+// numbers contiguously, and its operations examine the type once.
+//
+// Elementwise arithmetic, elementwise comparison, 'sum', 'minimum',
+// 'maximum', 'dot', and 'prefixSum' each have an implementation that uses
+// AVX2 instructions and a portable implementation that does not. The AVX2
+// implementation is used when 'CpuUtil' says that the processor supports it.
+// The two produce identical results: each reduction accumulates into one
+// "lane" per element of a 256-bit register, combining the lanes in order at
+// the end, and the portable implementation does the same. Integer arithmetic
+// wraps around on overflow in both. The prefix sum of doubles is always
+// computed sequentially, since a vectorized scan would round differently.
+//
+// A packed vector is represented as a pointer to a 'PackedVector', which is
+// allocated together with its elements. Unlike most of the other sequence
+// types, an empty packed vector is not a null pointer, since it still has an
+// element type.
+
+#include <bdld_datum.h>
+#include <bsl_cstddef.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+class PackedVector {
+  public:
+    enum ElementType { e_INT32, e_INT64, e_DOUBLE };
+
+    enum Operation { e_ADD, e_SUBTRACT, e_MULTIPLY, e_DIVIDE };
+
+    enum Comparison {
+        e_LESS,
+        e_LESS_OR_EQUAL,
+        e_EQUAL,
+        e_GREATER_OR_EQUAL,
+        e_GREATER
+    };
+
+  private:
+    // The elements follow the 'PackedVector' in memory. See 'elements'.
+    ElementType d_type;
+    bsl::size_t d_length;
+
+    PackedVector(ElementType type, bsl::size_t length);
+
+  public:
+    // Return a new vector of the specified 'length' elements of the specified
+    // 'type', whose values are unspecified until assigned via 'elements'.
+    static PackedVector* allocate(ElementType       type,
+                                  bsl::size_t       length,
+                                  bslma::Allocator* allocator);
+
+    ElementType type() const;
+    bsl::size_t length() const;
+
+    // Return the elements of this vector. The behavior is undefined unless
+    // 'NUMBER' is 'int', 'bsls::Types::Int64', or 'double' according to
+    // 'type()'.
+    template <typename NUMBER>
+    const NUMBER* elements() const;
+    template <typename NUMBER>
+    NUMBER* elements();
+
+    // Load into the specified 'type' the element type that can represent
+    // every number in the specified range '[begin, end)': 'e_INT32' if they
+    // are all 'int', 'e_INT64' if they are 'int' and 64-bit integers, or
+    // 'e_DOUBLE' if they are 'int' and doubles or if the range is empty.
+    // Return zero on success, or a nonzero value if any element is not a
+    // number or if no element type can represent all of them.
+    static int inferType(ElementType*       type,
+                         const bdld::Datum* begin,
+                         const bdld::Datum* end);
+
+    // Load into the specified 'result' a vector of the specified 'type'
+    // whose elements are the numbers in the specified range '[begin, end)'.
+    // Return zero on success, or a nonzero value if any element cannot be
+    // represented exactly as 'type'.
+    static int fromRange(const PackedVector** result,
+                         ElementType          type,
+                         const bdld::Datum*   begin,
+                         const bdld::Datum*   end,
+                         bslma::Allocator*);
+
+    // Return the element of the specified 'vector' at the specified 'index'.
+    // The behavior is undefined unless 'index < vector.length()'.
+    static bdld::Datum element(const PackedVector& vector,
+                               bsl::size_t         index,
+                               bslma::Allocator*);
+
+    // Return a 'bdld' array of the elements of the specified 'vector'.
+    static bdld::Datum toArray(const PackedVector& vector, bslma::Allocator*);
+
+    // Load into the specified 'result' the vector of the specified
+    // 'operation' applied to each pair of corresponding elements of the
+    // specified 'left' and 'right'. Return zero on success, or a nonzero
+    // value if integer division by zero is attempted. If one operand has
+    // length one and the other does not, its element is paired with every
+    // element of the other. The behavior is undefined unless 'left' and
+    // 'right' have the same element type, and either have the same length
+    // or one of them has length one.
+    static int apply(const PackedVector** result,
+                     Operation            operation,
+                     const PackedVector&  left,
+                     const PackedVector&  right,
+                     bslma::Allocator*);
+
+    // Return a vector of 32-bit integers having one where the specified
+    // 'comparison' is true of the corresponding elements of the specified
+    // 'left' and 'right', and zero elsewhere. Comparisons involving NaN are
+    // false. The behavior is undefined unless 'left' and 'right' meet the
+    // requirements of 'apply'.
+    static const PackedVector* compareEach(Comparison          comparison,
+                                           const PackedVector& left,
+                                           const PackedVector& right,
+                                           bslma::Allocator*);
+
+    // Return the sum of the elements of the specified 'vector', or zero if it
+    // is empty.
+    static bdld::Datum sum(const PackedVector& vector, bslma::Allocator*);
+
+    // Return the least or greatest element of the specified 'vector'. The
+    // result is unspecified if 'vector' contains NaN. The behavior is
+    // undefined if 'vector' is empty.
+    static bdld::Datum minimum(const PackedVector& vector, bslma::Allocator*);
+    static bdld::Datum maximum(const PackedVector& vector, bslma::Allocator*);
+
+    // Return the sum of the products of corresponding elements of the
+    // specified 'left' and 'right'. The behavior is undefined unless 'left'
+    // and 'right' have the same element type and the same length.
+    static bdld::Datum dot(const PackedVector& left,
+                           const PackedVector& right,
+                           bslma::Allocator*);
+
+    // Return a vector whose element at each index is the sum of the elements
+    // of the specified 'vector' up to and including that index.
+    static const PackedVector* prefixSum(const PackedVector& vector,
+                                         bslma::Allocator*);
+
+    // Return whether the specified 'left' and 'right' have the same element
+    // type and equal elements.
+    static bool equal(const PackedVector& left, const PackedVector& right);
+
+    // Return a negative number, zero, or a positive number if the specified
+    // 'left' is ordered before, equivalent to, or after the specified
+    // 'right', comparing first the element types and then the elements in
+    // lexicographical order.
+    static int compare(const PackedVector& left, const PackedVector& right);
+
+    static bool isPackedVector(const bdld::Datum&, int typeOffset);
+    static bool isPackedVector(const bdld::DatumUdt&, int typeOffset);
+
+    static const PackedVector& access(const bdld::Datum&);
+    static const PackedVector& access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(const PackedVector& vector, int typeOffset);
+};
+
+inline PackedVector::ElementType PackedVector::type() const {
+    return d_type;
+}
+
+inline bsl::size_t PackedVector::length() const {
+    return d_length;
+}
+
+template <typename NUMBER>
+inline const NUMBER* PackedVector::elements() const {
+    return reinterpret_cast<const NUMBER*>(this + 1);
+}
+
+template <typename NUMBER>
+inline NUMBER* PackedVector::elements() {
+    return reinterpret_cast<NUMBER*>(this + 1);
+}
+
+}  // namespace lspcore
+
+#endif
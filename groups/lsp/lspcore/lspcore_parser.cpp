@@ -13,8 +13,10 @@
 #include <bsl_numeric.h>
 #include <bsl_sstream.h>
 #include <bsls_timeinterval.h>
+#include <lspcore_base64util.h>
 #include <lspcore_datumutil.h>
 #include <lspcore_listutil.h>
+#include <lspcore_numericparseutil.h>
 #include <lspcore_parser.h>
 #include <lspcore_set.h>
 #include <lspcore_symbolutil.h>
@@ -108,6 +110,9 @@ DEFINE_PARSER_ERROR(DuplicateMapKey,
                     "key values. Keys must be unique.");
 DEFINE_PARSER_ERROR(IncompleteSet,
                     "input ended before the set that starts here was closed");
+DEFINE_PARSER_ERROR(TooDeep,
+                    "datum beginning here is nested more deeply than the "
+                    "parser's configured maximum depth");
 
 #undef DEFINE_PARSER_ERROR
 
@@ -248,11 +253,26 @@ ParserError::ParserError(bsl::string_view what, const LexerToken& where)
 Parser::Parser(Lexer& lexer, int typeOffset, bslma::Allocator* datumAllocator)
 : d_lexer(lexer)
 , d_typeOffset(typeOffset)
-, d_datumAllocator_p(datumAllocator) {
+, d_datumAllocator_p(datumAllocator)
+, d_maxDepth(k_DEFAULT_MAX_DEPTH) {
+}
+
+void Parser::setMaxDepth(bsl::size_t maxDepth) {
+    d_maxDepth = maxDepth;
+}
+
+bsl::size_t Parser::maxDepth() const {
+    return d_maxDepth;
 }
 
 bdlb::Variant2<bdld::Datum, ParserError> Parser::parse() {
     typedef bdlb::Variant2<bdld::Datum, ParserError> Variant;
+
+    // If the previous call failed, it might have left partially parsed
+    // datums behind.
+    d_frames.clear();
+    d_values.clear();
+
     try {
         return Variant(parseDatum());
     }
@@ -262,72 +282,274 @@ bdlb::Variant2<bdld::Datum, ParserError> Parser::parse() {
 }
 
 bdld::Datum Parser::parseDatum() {
-    const LexerToken token = next();
+    // The parser is iterative rather than recursive, so that deeply nested
+    // input consumes heap memory (in 'd_frames' and 'd_values') instead of
+    // the native stack. Each token read either
+    //
+    // - begins a compound datum (e.g. "(" or "'"), which pushes a frame onto
+    //   the parse stack,
+    // - is a complete datum by itself (e.g. a number), or
+    // - ends a compound datum (e.g. ")"), which pops one or more frames.
+    //
+    // A completed datum is given to the frame on top of the stack, which
+    // might thereby complete its own datum, and so on. When the stack is
+    // empty, the completed datum is the result.
+    for (;;) {
+        const LexerToken token = next();
+        bdld::Datum      value;
+
+        switch (token.kind) {
+            case LexerToken::e_OPEN_PARENTHESIS:
+            case LexerToken::e_OPEN_SQUARE_BRACKET:
+            case LexerToken::e_OPEN_CURLY_BRACE:
+            case LexerToken::e_OPEN_SET_BRACE:
+            case LexerToken::e_QUOTE:
+            case LexerToken::e_QUASIQUOTE:
+            case LexerToken::e_UNQUOTE:
+            case LexerToken::e_UNQUOTE_SPLICING:
+            case LexerToken::e_SYNTAX:
+            case LexerToken::e_QUASISYNTAX:
+            case LexerToken::e_UNSYNTAX:
+            case LexerToken::e_UNSYNTAX_SPLICING:
+            case LexerToken::e_COMMENT_DATUM:
+            case LexerToken::e_ERROR_TAG:
+            case LexerToken::e_USER_DEFINED_TYPE_TAG:
+                pushFrame(token);
+                continue;
+            case LexerToken::e_EOF:
+            case LexerToken::e_CLOSE_PARENTHESIS:
+            case LexerToken::e_CLOSE_SQUARE_BRACKET:
+            case LexerToken::e_CLOSE_CURLY_BRACE:
+            case LexerToken::e_PAIR_SEPARATOR:
+                if (!close(&value, token)) {
+                    continue;
+                }
+                break;
+            case LexerToken::e_TRUE:
+            case LexerToken::e_FALSE:
+                value = parseBoolean(token);
+                break;
+            case LexerToken::e_STRING:
+                value = parseString(token);
+                break;
+            case LexerToken::e_BYTES:
+                value = parseBytes(token);
+                break;
+            case LexerToken::e_DOUBLE:
+                value = parseDouble(token);
+                break;
+            case LexerToken::e_DECIMAL64:
+                value = parseDecimal64(token);
+                break;
+            case LexerToken::e_INT32:
+                value = parseInt32(token);
+                break;
+            case LexerToken::e_INT64:
+                value = parseInt64(token);
+                break;
+            case LexerToken::e_SYMBOL:
+                value = parseSymbol(token);
+                break;
+            case LexerToken::e_DATE:
+                value = parseDate(token);
+                break;
+            case LexerToken::e_TIME:
+                value = parseTime(token);
+                break;
+            case LexerToken::e_DATETIME:
+                value = parseDatetime(token);
+                break;
+            default:
+                BSLS_ASSERT_OPT(token.kind ==
+                                LexerToken::e_DATETIME_INTERVAL);
+                value = parseDatetimeInterval(token);
+
+                // Impossible cases:
+                // - LexerToken::e_COMMENT_LINE (skipped by 'this->next')
+                // - LexerToken::e_COMMENT_SHEBANG (skipped by 'this->next')
+                // - LexerToken::e_INVALID (never produced by 'Lexer')
+                // - LexerToken::e_WHITESPACE (skipped by 'this->next')
+        }
 
-    switch (token.kind) {
-        case LexerToken::e_EOF:
-            throw EofError(token);
-        case LexerToken::e_TRUE:
-        case LexerToken::e_FALSE:
-            return parseBoolean(token);
-        case LexerToken::e_STRING:
-            return parseString(token);
-        case LexerToken::e_BYTES:
-            return parseBytes(token);
-        case LexerToken::e_DOUBLE:
-            return parseDouble(token);
-        case LexerToken::e_DECIMAL64:
-            return parseDecimal64(token);
-        case LexerToken::e_INT32:
-            return parseInt32(token);
-        case LexerToken::e_INT64:
-            return parseInt64(token);
-        case LexerToken::e_SYMBOL:
-            return parseSymbol(token);
-        case LexerToken::e_OPEN_PARENTHESIS:
-            return parseList(token);
-        case LexerToken::e_OPEN_SQUARE_BRACKET:
-            return parseArray(token);
-        case LexerToken::e_OPEN_CURLY_BRACE:
-            return parseMap(token);
-        case LexerToken::e_OPEN_SET_BRACE:
-            return parseSet(token);
-        case LexerToken::e_CLOSE_PARENTHESIS:
-        case LexerToken::e_CLOSE_SQUARE_BRACKET:
-        case LexerToken::e_CLOSE_CURLY_BRACE:
-        case LexerToken::e_PAIR_SEPARATOR:
-            throw NotAValue(token);
-        case LexerToken::e_QUOTE:
-        case LexerToken::e_QUASIQUOTE:
-        case LexerToken::e_UNQUOTE:
-        case LexerToken::e_UNQUOTE_SPLICING:
-        case LexerToken::e_SYNTAX:
-        case LexerToken::e_QUASISYNTAX:
-        case LexerToken::e_UNSYNTAX:
-        case LexerToken::e_UNSYNTAX_SPLICING:
-            return parseQuoteLike(token);
-        case LexerToken::e_COMMENT_DATUM:
-            return parseComment(token);
-        case LexerToken::e_DATE:
-            return parseDate(token);
-        case LexerToken::e_TIME:
-            return parseTime(token);
-        case LexerToken::e_DATETIME:
-            return parseDatetime(token);
-        case LexerToken::e_DATETIME_INTERVAL:
-            return parseDatetimeInterval(token);
-        case LexerToken::e_ERROR_TAG:
-            return parseError(token);
-        default:
-            BSLS_ASSERT_OPT(token.kind == LexerToken::e_USER_DEFINED_TYPE_TAG);
-            return parseUdt(token);
+        if (deliver(&value)) {
+            return value;
+        }
+    }
+}
 
-            // Impossible cases:
-            // - LexerToken::e_COMMENT_LINE (skipped by 'this->next')
-            // - LexerToken::e_COMMENT_SHEBANG (skipped by 'this->next')
-            // - LexerToken::e_INVALID (never produced by 'Lexer')
-            // - LexerToken::e_WHITESPACE (skipped by 'this->next')
+void Parser::pushFrame(const LexerToken& token) {
+    if (d_frames.size() >= d_maxDepth) {
+        throw TooDeep(token);
+    }
+
+    const Frame frame = { token, d_values.size() };
+    d_frames.push_back(frame);
+}
+
+void Parser::popFrame() {
+    BSLS_ASSERT(!d_frames.empty());
+
+    d_values.resize(d_frames.back().begin);
+    d_frames.pop_back();
+}
+
+bool Parser::deliver(bdld::Datum* value) {
+    BSLS_ASSERT(value);
+
+    while (!d_frames.empty()) {
+        const Frame frame = d_frames.back();
+        switch (frame.token.kind) {
+            case LexerToken::e_OPEN_PARENTHESIS:
+            case LexerToken::e_OPEN_SQUARE_BRACKET:
+            case LexerToken::e_OPEN_CURLY_BRACE:
+            case LexerToken::e_OPEN_SET_BRACE:
+                // another element
+                d_values.push_back(*value);
+                return false;
+            case LexerToken::e_COMMENT_DATUM:
+                // Here are what datum comments look like:
+                //
+                //     #;some-datum-goes-here
+                //     #;(could be "like this")
+                //     #;{"or" 'any "single" 'value}
+                //
+                // e.g. in context:
+                //
+                //     (this is a #;list with some #;["parts commented" out])
+                //
+                // The "#;" is followed by one datum, which we discard. Then
+                // the datum after that takes the place of the comment in the
+                // enclosing frame, which is as if the "#;" and the first
+                // datum were never there.
+                popFrame();
+                return false;
+            case LexerToken::e_PAIR_SEPARATOR:
+                *value = finishPair(frame, *value);
+                break;
+            case LexerToken::e_ERROR_TAG:
+                *value = finishError(frame.token, *value);
+                break;
+            case LexerToken::e_USER_DEFINED_TYPE_TAG:
+                *value = finishUdt(frame.token, *value);
+                break;
+            default:
+                *value = finishQuoteLike(frame.token, *value);
+        }
+        popFrame();
     }
+
+    return true;
+}
+
+bool Parser::close(bdld::Datum* value, const LexerToken& token) {
+    BSLS_ASSERT(value);
+
+    // Each frame either accepts the specified 'token', which might complete
+    // the frame's datum, or rejects it. A rejected token is passed to the
+    // next frame down, so, for example, the "}" in
+    //
+    //     [1 2 (3 4}
+    //
+    // is rejected by the list and then by the array, and so is reported as
+    // the unexpected token. The end of input is never passed on: it is an
+    // error specific to the innermost frame.
+    const bool isEof = token.kind == LexerToken::e_EOF;
+
+    for (; !d_frames.empty(); popFrame()) {
+        const Frame&      frame  = d_frames.back();
+        const bdld::Datum* begin = d_values.data() + frame.begin;
+        const bdld::Datum* end   = d_values.data() + d_values.size();
+
+        switch (frame.token.kind) {
+            case LexerToken::e_OPEN_PARENTHESIS:
+                if (isEof) {
+                    throw IncompleteList(frame.token);
+                }
+                if (token.kind == LexerToken::e_CLOSE_PARENTHESIS) {
+                    *value = ListUtil::createList(
+                        begin, end, d_typeOffset, d_datumAllocator_p);
+                    popFrame();
+                    return true;
+                }
+                if (token.kind == LexerToken::e_PAIR_SEPARATOR &&
+                    begin != end) {
+                    // (a b c . d): The list becomes a pair whose second
+                    // element is the single datum following the ".". Note
+                    // that in ( . foo) there needs to be something before
+                    // the ".".
+                    d_frames.back().token = token;
+                    return false;
+                }
+                break;
+            case LexerToken::e_PAIR_SEPARATOR:
+                if (isEof || token.kind == LexerToken::e_CLOSE_PARENTHESIS) {
+                    throw IncompletePair(frame.token);
+                }
+                break;
+            case LexerToken::e_OPEN_SQUARE_BRACKET:
+                if (isEof) {
+                    throw IncompleteArray(frame.token);
+                }
+                if (token.kind == LexerToken::e_CLOSE_SQUARE_BRACKET) {
+                    bdld::DatumArrayBuilder builder(d_datumAllocator_p);
+                    for (; begin != end; ++begin) {
+                        builder.pushBack(*begin);
+                    }
+                    *value = builder.commit();
+                    popFrame();
+                    return true;
+                }
+                break;
+            case LexerToken::e_OPEN_CURLY_BRACE:
+                if (isEof) {
+                    throw UnterminatedMap(frame.token);
+                }
+                if (token.kind == LexerToken::e_CLOSE_CURLY_BRACE) {
+                    if ((end - begin) % 2) {
+                        // a key without a value
+                        throw OddMap(frame.token);
+                    }
+                    *value = finishMap(frame);
+                    popFrame();
+                    return true;
+                }
+                break;
+            case LexerToken::e_OPEN_SET_BRACE:
+                if (isEof) {
+                    throw IncompleteSet(frame.token);
+                }
+                if (token.kind == LexerToken::e_CLOSE_CURLY_BRACE) {
+                    *value = finishSet(frame);
+                    popFrame();
+                    return true;
+                }
+                break;
+            case LexerToken::e_COMMENT_DATUM:
+                if (isEof) {
+                    throw IncompleteComment(frame.token);
+                }
+                break;
+            case LexerToken::e_ERROR_TAG:
+                if (isEof) {
+                    throw ErrorIncomplete(frame.token);
+                }
+                break;
+            case LexerToken::e_USER_DEFINED_TYPE_TAG:
+                if (isEof) {
+                    throw UdtIncomplete(frame.token);
+                }
+                break;
+            default:
+                // A quote-like token must be followed by a datum, and this
+                // isn't one.
+                throw UnterminatedQuoteLike(frame.token);
+        }
+    }
+
+    if (isEof) {
+        throw EofError(token);
+    }
+    throw NotAValue(token);
 }
 
 bdld::Datum Parser::parseBoolean(const LexerToken& token) {
@@ -362,17 +584,35 @@ bdld::Datum Parser::parseBytes(const LexerToken& token) {
     //
     //     #base64"9kDfid899==="
     //
-    // If we skip past the leading "#base64", then the JSON decoder can treat
-    // it as a base-64 encoded string.
+    // Almost always, the string contains nothing but canonical base-64, and
+    // so we can decode it directly. The decoded bytes go into 'd_bytes',
+    // which is reused from one literal to the next, because 'bdld::Datum'
+    // does not provide a way to allocate an uninitialized binary value.
     bsl::string_view base64 = token.text;
     base64.remove_prefix(sizeof "#base64" - 1);
-    bsl::vector<char> buffer;
-    if (baljsn::ParserUtil::getValue(&buffer, base64)) {
+
+    bsl::string_view encoded = base64;
+    encoded.remove_prefix(1);  // opening quote
+    encoded.remove_suffix(1);  // closing quote
+    if (encoded.find('\\') == bsl::string_view::npos) {
+        d_bytes.resize(Base64Util::maxDecodedLength(encoded.size()));
+        bsl::size_t size;
+        if (!Base64Util::decode(
+                d_bytes.data(), &size, encoded.data(), encoded.size())) {
+            return bdld::Datum::copyBinary(
+                d_bytes.data(), size, d_datumAllocator_p);
+        }
+    }
+
+    // Otherwise, the JSON decoder can treat it as a base-64 encoded string,
+    // escape sequences, unusual padding and all.
+    d_bytes.clear();
+    if (baljsn::ParserUtil::getValue(&d_bytes, base64)) {
         throw InvalidBase64(token);
     }
 
     return bdld::Datum::copyBinary(
-        buffer.data(), buffer.size(), d_datumAllocator_p);
+        d_bytes.data(), d_bytes.size(), d_datumAllocator_p);
 }
 
 bdld::Datum Parser::parseDouble(const LexerToken& token) {
@@ -380,7 +620,7 @@ bdld::Datum Parser::parseDouble(const LexerToken& token) {
     bsl::string_view text = token.text;
     text.remove_suffix(1);
     double parsed;
-    if (baljsn::ParserUtil::getValue(&parsed, text)) {
+    if (NumericParseUtil::parseDouble(&parsed, text)) {
         throw InvalidNumber(token);
     }
 
@@ -391,7 +631,7 @@ bdld::Datum Parser::parseDecimal64(const LexerToken& token) {
     // Decimal64 are the naked decimals, e.g. 34.54 (no special prefix or
     // suffix).
     bdldfp::Decimal64 parsed;
-    if (baljsn::ParserUtil::getValue(&parsed, token.text)) {
+    if (NumericParseUtil::parseDecimal64(&parsed, token.text)) {
         throw InvalidNumber(token);
     }
 
@@ -401,7 +641,7 @@ bdld::Datum Parser::parseDecimal64(const LexerToken& token) {
 bdld::Datum Parser::parseInt32(const LexerToken& token) {
     // int32 are the naked integers, e.g. 1234 (no special suffix).
     int parsed;
-    if (baljsn::ParserUtil::getValue(&parsed, token.text)) {
+    if (NumericParseUtil::parseInt32(&parsed, token.text)) {
         throw InvalidNumber(token);
     }
 
@@ -414,7 +654,7 @@ bdld::Datum Parser::parseInt64(const LexerToken& token) {
     bsl::string_view text = token.text;
     text.remove_suffix(1);
     bsls::Types::Int64 parsed;
-    if (baljsn::ParserUtil::getValue(&parsed, text)) {
+    if (NumericParseUtil::parseInt64(&parsed, text)) {
         throw InvalidNumber(token);
     }
 
@@ -426,127 +666,69 @@ bdld::Datum Parser::parseSymbol(const LexerToken& token) {
     return SymbolUtil::create(token.text, d_typeOffset, d_datumAllocator_p);
 }
 
-bdld::Datum Parser::parseList(const LexerToken& token) {
-    bsl::vector<bdld::Datum> elements;
-
-    // Consume zero or more elements, and if we hit a "." make sure that
-    // there's exactly one element remaining afterward. We're done when we
-    // find a ")".
-    for (;;) {
-        try {
-            elements.push_back(parseDatum());
-        }
-        catch (const NotAValue& error) {
-            switch (error.where.kind) {
-                case LexerToken::e_CLOSE_PARENTHESIS:  // all done
-                    return ListUtil::createList(
-                        elements, d_typeOffset, d_datumAllocator_p);
-                case LexerToken::e_PAIR_SEPARATOR:  // one more
-                    if (elements.empty()) {
-                        // ( . foo): there needs to be something before the "."
-                        throw;
-                    }
-                    elements.push_back(parsePairSecond(error.where));
-                    return ListUtil::createImproperList(
-                        elements, d_typeOffset, d_datumAllocator_p);
-                default:  // unexpected punctuation (e.g. "}")
-                    throw;
-            }
-        }
-        catch (const EofError&) {
-            throw IncompleteList(token);
-        }
+bdld::Datum Parser::parseDate(const LexerToken& token) {
+    bdlt::Date parsed;
+    if (bdlt::Iso8601Util::parse(
+            &parsed, token.text.data(), token.text.size())) {
+        throw InvalidTemporal(token);
     }
-}
 
-bdld::Datum Parser::parsePairSecond(const LexerToken& token) {
-    // Parse the foo in (anything before the dot . foo)
-    // The specified 'token' is the "."
-    // There must be exactly one datum following the ".", and then the closing
-    // parenthesis.
-    bdld::Datum last;
-    try {
-        last = parseDatum();
-    }
-    catch (const NotAValue& error) {
-        if (error.where.kind == LexerToken::e_CLOSE_PARENTHESIS) {
-            throw IncompletePair(token);
-        }
-        throw;  // some other unexpected punctutation
-    }
-    catch (const EofError&) {
-        throw IncompletePair(token);
-    }
+    return bdld::Datum::createDate(parsed);
+}
 
-    const LexerToken extra = next();
-    if (extra.kind != LexerToken::e_CLOSE_PARENTHESIS) {
-        throw PairSuffix(extra);
+bdld::Datum Parser::parseTime(const LexerToken& token) {
+    bdlt::Time parsed;
+    if (bdlt::Iso8601Util::parse(
+            &parsed, token.text.data(), token.text.size())) {
+        throw InvalidTemporal(token);
     }
 
-    return last;
+    return bdld::Datum::createTime(parsed);
 }
 
-bdld::Datum Parser::parseArray(const LexerToken& token) {
-    bdld::DatumArrayBuilder builder(d_datumAllocator_p);
-
-    // Consume array elements (datums) until either we hit "]" (done), we hit
-    // EOF (error), or some other exception is thrown (implicit error).
-    for (;;) {
-        try {
-            builder.pushBack(parseDatum());
-        }
-        catch (const NotAValue& error) {
-            if (error.where.kind == LexerToken::e_CLOSE_SQUARE_BRACKET) {
-                // finished
-                return builder.commit();
-            }
-            // some other unexpected punctutation: propagate the error
-            throw;
-        }
-        catch (const EofError&) {
-            throw IncompleteArray(token);
-        }
+bdld::Datum Parser::parseDatetime(const LexerToken& token) {
+    bdlt::Datetime parsed;
+    if (bdlt::Iso8601Util::parse(
+            &parsed, token.text.data(), token.text.size())) {
+        throw InvalidTemporal(token);
     }
-}
 
-bool Parser::appendMapItem(
-    bsl::vector<bsl::pair<bdld::Datum, bdld::Datum> >* items,
-    LexerToken                                         openCurly) {
-    BSLS_ASSERT(items);
+    return bdld::Datum::createDatetime(parsed, d_datumAllocator_p);
+}
 
-    bdld::Datum key;
-    try {
-        key = parseDatum();
-    }
-    catch (const EofError&) {
-        throw UnterminatedMap(openCurly);
-    }
-    catch (const NotAValue& error) {
-        if (error.where.kind == LexerToken::e_CLOSE_CURLY_BRACE) {
-            return false;  // end of map
-        }
-        throw;  // some other unexpected punctuation
+bdld::Datum Parser::parseDatetimeInterval(const LexerToken& token) {
+    // A time period, e.g. #P10W (ten weeks) starts with a "#" character in
+    // this lisp. The rest conforms to ISO-8601, so omit the first character
+    // before parsing.
+    bsl::string_view text = token.text;
+    text.remove_prefix(1);
+    bsls::TimeInterval parsed;
+    if (bdlt::Iso8601Util::parse(&parsed, text.data(), text.size())) {
+        throw InvalidTemporal(token);
     }
 
-    bdld::Datum value;
-    try {
-        value = parseDatum();
-    }
-    catch (const EofError&) {
-        throw UnterminatedMap(openCurly);
-    }
-    catch (const NotAValue& error) {
-        if (error.where.kind == LexerToken::e_CLOSE_CURLY_BRACE) {
-            throw OddMap(openCurly);
-        }
-        throw;  // some other unexpected punctuation
+    return bdld::Datum::createDatetimeInterval(
+        bdlt::IntervalConversionUtil::convertToDatetimeInterval(parsed),
+        d_datumAllocator_p);
+}
+
+bdld::Datum Parser::finishPair(const Frame& frame, const bdld::Datum& last) {
+    // The specified 'last' is the foo in (anything before the dot . foo).
+    // There must be exactly one datum following the ".", and then the
+    // closing parenthesis.
+    const LexerToken extra = next();
+    if (extra.kind != LexerToken::e_CLOSE_PARENTHESIS) {
+        throw PairSuffix(extra);
     }
 
-    items->push_back(bsl::make_pair(key, value));
-    return true;  // continue, might not be at end of map yet
+    d_values.push_back(last);
+    return ListUtil::createImproperList(d_values.data() + frame.begin,
+                                        d_values.data() + d_values.size(),
+                                        d_typeOffset,
+                                        d_datumAllocator_p);
 }
 
-bdld::Datum Parser::parseMap(const LexerToken& token) {
+bdld::Datum Parser::finishMap(const Frame& frame) {
     // A map can have either all 32-bit integer keys or all string keys, but no
     // combination of the two. Since the datum parsed is either a (string) Map
     // or an IntMap, we must know upfront what the types of the keys are. This
@@ -566,15 +748,18 @@ bdld::Datum Parser::parseMap(const LexerToken& token) {
     // - the parser will sort the entries before constructing the map
 
     // Here's the plan:
-    // - parse the elements of the map into a sequence of 'bsl::pair' of
+    // - pair up the elements of the map into a sequence of 'bsl::pair' of
     //   'Datum'
     // - make sure that the '.first' of each pair all have the same type
     // - make sure that '.first' is either a string or an int32
     // - dispatch to a more specific parser depending on the key type
+    const LexerToken& token = frame.token;
 
     bsl::vector<bsl::pair<bdld::Datum, bdld::Datum> > items;
-    while (appendMapItem(&items, token))
-        ;
+    items.reserve((d_values.size() - frame.begin) / 2);
+    for (bsl::size_t i = frame.begin; i < d_values.size(); i += 2) {
+        items.push_back(bsl::make_pair(d_values[i], d_values[i + 1]));
+    }
 
     if (items.empty()) {
         return bdld::Datum::createNull();  // {} == ()
@@ -595,34 +780,21 @@ bdld::Datum Parser::parseMap(const LexerToken& token) {
     }
 }
 
-bdld::Datum Parser::parseSet(const LexerToken& token) {
-    // The set starts out containing its unevaluated elements. Later, the
-    // interpreter will produce a new set that contains the evaluated elements.
-    const Set*            set = 0;
-    DatumUtil::Comparator lessThan =
-        DatumUtil::lessThanComparator(d_typeOffset);
+bdld::Datum Parser::finishSet(const Frame& frame) {
+    // The set contains its unevaluated elements. Later, the interpreter will
+    // produce a new set that contains the evaluated elements.
+    const DatumUtil::LessThan lessThan(d_typeOffset);
 
-    // Consume array elements (datums) until either we hit "}" (done), we hit
-    // EOF (error), or some other exception is thrown (implicit error).
-    for (;;) {
-        try {
-            set = Set::insert(set, parseDatum(), lessThan, d_datumAllocator_p);
-        }
-        catch (const NotAValue& error) {
-            if (error.where.kind == LexerToken::e_CLOSE_CURLY_BRACE) {
-                // finished
-                return Set::create(set, d_typeOffset);
-            }
-            // some other unexpected punctutation: propagate the error
-            throw;
-        }
-        catch (const EofError&) {
-            throw IncompleteSet(token);
-        }
-    }
+    const bdld::Datum* const begin = d_values.data() + frame.begin;
+    const bdld::Datum* const end   = d_values.data() + d_values.size();
+    const Set* const         set =
+        Set::fromRange(begin, end, lessThan, d_datumAllocator_p);
+
+    return Set::create(set, d_typeOffset);
 }
 
-bdld::Datum Parser::parseQuoteLike(const LexerToken& token) {
+bdld::Datum Parser::finishQuoteLike(const LexerToken&  token,
+                                    const bdld::Datum& argument) {
     // A quote-like form is one preceded by special punctuation, like a single
     // quote (hence the name "quote-like"). Here are some examples where the
     // list "(foo bar)" is made quote-like by adding a preceding token:
@@ -649,102 +821,17 @@ bdld::Datum Parser::parseQuoteLike(const LexerToken& token) {
     // The parser thus aways produces a two-element list whose first element is
     // a hard-coded symbol and whose second element is the datum following the
     // quote-like token.
-
-    bdld::Datum  data[2];
-    bdld::Datum& symbol   = data[0];
-    bdld::Datum& argument = data[1];
-
-    try {
-        argument = parseDatum();
-    }
-    catch (const EofError&) {
-        throw UnterminatedQuoteLike(token);
-    }
-    catch (const NotAValue&) {
-        throw UnterminatedQuoteLike(token);
-    }
-
-    symbol = SymbolUtil::create(
+    bdld::Datum data[2];
+    data[0] = SymbolUtil::create(
         quoteLikeName(token.kind), d_typeOffset, d_datumAllocator_p);
+    data[1] = argument;
 
     return ListUtil::createList(
         data, bdlb::ArrayUtil::end(data), d_typeOffset, d_datumAllocator_p);
 }
 
-bdld::Datum Parser::parseComment(const LexerToken& token) {
-    // Here are what datum comments look like:
-    //
-    //     #;some-datum-goes-here
-    //     #;(could be "like this")
-    //     #;{"or" 'any "single" 'value}
-    //
-    // e.g. in context:
-    //
-    //     (this is a #;list with some #;["parts commented" out])
-    //
-    // The token passed to us is the "#;". We need to parse one additional
-    // datum. If we can't, then that's an error.
-    //
-    // If we can parse one additional datum, then we discard what we parsed,
-    // and return the result of attempting to parse yet another datum,
-    // effectively skipping the datum that immediately followed the "#;" token.
-    try {
-        (void)parseDatum();
-    }
-    catch (const EofError&) {
-        throw IncompleteComment(token);
-    }
-
-    return parseDatum();
-}
-
-bdld::Datum Parser::parseDate(const LexerToken& token) {
-    bdlt::Date parsed;
-    if (bdlt::Iso8601Util::parse(
-            &parsed, token.text.data(), token.text.size())) {
-        throw InvalidTemporal(token);
-    }
-
-    return bdld::Datum::createDate(parsed);
-}
-
-bdld::Datum Parser::parseTime(const LexerToken& token) {
-    bdlt::Time parsed;
-    if (bdlt::Iso8601Util::parse(
-            &parsed, token.text.data(), token.text.size())) {
-        throw InvalidTemporal(token);
-    }
-
-    return bdld::Datum::createTime(parsed);
-}
-
-bdld::Datum Parser::parseDatetime(const LexerToken& token) {
-    bdlt::Datetime parsed;
-    if (bdlt::Iso8601Util::parse(
-            &parsed, token.text.data(), token.text.size())) {
-        throw InvalidTemporal(token);
-    }
-
-    return bdld::Datum::createDatetime(parsed, d_datumAllocator_p);
-}
-
-bdld::Datum Parser::parseDatetimeInterval(const LexerToken& token) {
-    // A time period, e.g. #P10W (ten weeks) starts with a "#" character in
-    // this lisp. The rest conforms to ISO-8601, so omit the first character
-    // before parsing.
-    bsl::string_view text = token.text;
-    text.remove_prefix(1);
-    bsls::TimeInterval parsed;
-    if (bdlt::Iso8601Util::parse(&parsed, text.data(), text.size())) {
-        throw InvalidTemporal(token);
-    }
-
-    return bdld::Datum::createDatetimeInterval(
-        bdlt::IntervalConversionUtil::convertToDatetimeInterval(parsed),
-        d_datumAllocator_p);
-}
-
-bdld::Datum Parser::parseError(const LexerToken& token) {
+bdld::Datum Parser::finishError(const LexerToken&  token,
+                                const bdld::Datum& datum) {
     // An error is represented as an error tag ("#error") followed by an
     // array containing either one or two elements. The first element is
     // always the integer code of the error. The optional second element
@@ -754,14 +841,6 @@ bdld::Datum Parser::parseError(const LexerToken& token) {
     //     #error[10]
     //     #error[10 "this is serious, guys!"]
 
-    bdld::Datum datum;
-    try {
-        datum = parseDatum();
-    }
-    catch (const EofError&) {
-        throw ErrorIncomplete(token);
-    }
-
     if (!datum.isArray()) {
         throw ErrorNotArray(token);
     }
@@ -790,7 +869,8 @@ bdld::Datum Parser::parseError(const LexerToken& token) {
         code.theInteger(), message.theString(), d_datumAllocator_p);
 }
 
-bdld::Datum Parser::parseUdt(const LexerToken& token) {
+bdld::Datum Parser::finishUdt(const LexerToken&  token,
+                              const bdld::Datum& datum) {
     // A user-defined type literal is represented as a udt tag ("#udt")
     // followed by an array containing two elements. The first element is the
     // integer "type" of the user-defined type (that which distinguishes it
@@ -821,14 +901,6 @@ bdld::Datum Parser::parseUdt(const LexerToken& token) {
     // user-defined types with codes conflicting with those used by this
     // library will result in an error.
 
-    bdld::Datum datum;
-    try {
-        datum = parseDatum();
-    }
-    catch (const EofError&) {
-        throw UdtIncomplete(token);
-    }
-
     if (!datum.isArray()) {
         throw UdtNotArray(token);
     }
@@ -4,6 +4,7 @@
 #include <bdlb_nullablevalue.h>
 #include <bdlb_variant.h>
 #include <bdld_datum.h>
+#include <bsl_cstddef.h>
 #include <bsl_string.h>
 #include <bsl_utility.h>
 #include <bsl_vector.h>
@@ -42,14 +43,43 @@ struct ParserError {
 };
 
 class Parser {
-    Lexer&            d_lexer;
-    int               d_typeOffset;
-    LexerToken        d_previousToken;
-    bslma::Allocator* d_datumAllocator_p;
+    // 'Frame' is an entry in the parse stack: a compound datum whose
+    // beginning has been parsed but whose end has not. The 'token' that began
+    // the datum determines its kind, e.g. "(" begins a list and "#;" begins a
+    // datum comment. The elements parsed so far are in 'd_values', starting at
+    // index 'begin'.
+    struct Frame {
+        LexerToken  token;
+        bsl::size_t begin;
+    };
+
+    Lexer&                   d_lexer;
+    int                      d_typeOffset;
+    LexerToken               d_previousToken;
+    bslma::Allocator*        d_datumAllocator_p;
+    bsl::vector<char>        d_bytes;   // scratch space for decoding base-64
+    bsl::vector<Frame>       d_frames;  // the parse stack
+    bsl::vector<bdld::Datum> d_values;  // elements of the datums in 'd_frames'
+    bsl::size_t              d_maxDepth;
 
   public:
+    // The default maximum depth of nesting is high enough for any reasonable
+    // input, but low enough that the (recursive) printer and interpreter can
+    // cope with the result.
+    enum { k_DEFAULT_MAX_DEPTH = 10000 };
+
     Parser(Lexer& lexer, int typeOffset, bslma::Allocator* datumAllocator);
 
+    // Set the maximum depth of nesting of compound datums to the specified
+    // 'maxDepth'. Input nested more deeply than 'maxDepth' will result in a
+    // 'ParserError'. Note that each of lists, arrays, maps, sets, quote-like
+    // forms, datum comments, and "#error" and "#udt" literals is a level of
+    // nesting.
+    void setMaxDepth(bsl::size_t maxDepth);
+
+    // Return the maximum depth of nesting of compound datums.
+    bsl::size_t maxDepth() const;
+
     // TODO: document
     bdlb::Variant2<bdld::Datum, ParserError> parse();
 
@@ -63,25 +93,42 @@ class Parser {
     bdld::Datum parseInt32(const LexerToken&);
     bdld::Datum parseInt64(const LexerToken&);
     bdld::Datum parseSymbol(const LexerToken&);
-    bdld::Datum parseList(const LexerToken&);
-    bdld::Datum parseArray(const LexerToken&);
-    bdld::Datum parseMap(const LexerToken&);
-    bdld::Datum parseSet(const LexerToken&);
-    bdld::Datum parseQuoteLike(const LexerToken&);
-    bdld::Datum parseComment(const LexerToken&);
     bdld::Datum parseDate(const LexerToken&);
     bdld::Datum parseTime(const LexerToken&);
     bdld::Datum parseDatetime(const LexerToken&);
     bdld::Datum parseDatetimeInterval(const LexerToken&);
-    bdld::Datum parseError(const LexerToken&);
-    bdld::Datum parseUdt(const LexerToken&);
-    bdld::Datum parsePairSecond(const LexerToken&);
 
-    LexerToken next();
+    // Push onto the parse stack a frame for the compound datum beginning
+    // with the specified 'token', or throw a 'ParserError' if the stack is
+    // already at its maximum depth.
+    void pushFrame(const LexerToken& token);
 
-    bool appendMapItem(
-        bsl::vector<bsl::pair<bdld::Datum, bdld::Datum> >* items,
-        LexerToken                                         openCurly);
+    // Pop the top frame from the parse stack, discarding its elements.
+    void popFrame();
+
+    // Give the specified '*value' to the frame on top of the parse stack. If
+    // that completes the frame's datum, then pop the frame and give its datum
+    // to the next frame, and so on, loading the last completed datum into
+    // '*value'. Return 'true' if '*value' is then a complete top-level datum,
+    // or return 'false' if more input is needed.
+    bool deliver(bdld::Datum* value);
+
+    // Apply the specified 'token', which is closing punctuation, a pair
+    // separator, or the end of input, to the parse stack, popping frames
+    // that do not accept it. If the frame that accepts 'token' is thereby
+    // complete, then pop it, load its datum into the specified '*value', and
+    // return 'true'. Otherwise, return 'false'. Throw a 'ParserError' if no
+    // frame accepts 'token' or if 'token' is an error for the frame.
+    bool close(bdld::Datum* value, const LexerToken& token);
+
+    bdld::Datum finishPair(const Frame&, const bdld::Datum& last);
+    bdld::Datum finishMap(const Frame&);
+    bdld::Datum finishSet(const Frame&);
+    bdld::Datum finishQuoteLike(const LexerToken&, const bdld::Datum&);
+    bdld::Datum finishError(const LexerToken&, const bdld::Datum&);
+    bdld::Datum finishUdt(const LexerToken&, const bdld::Datum&);
+
+    LexerToken next();
 };
 
 }  // namespace lspcore
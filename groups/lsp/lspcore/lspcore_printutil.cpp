@@ -1,10 +1,8 @@
 #include <baljsn_printutil.h>
-#include <balxml_typesprintutil.h>
 #include <bdld_datum.h>
 #include <bdld_datumbinaryref.h>
 #include <bdld_datumerror.h>
 #include <bdld_datumudt.h>
-#include <bdlde_base64encoder.h>
 #include <bdldfp_decimal.h>
 #include <bdlt_date.h>
 #include <bdlt_datetime.h>
@@ -12,15 +10,31 @@
 #include <bdlt_intervalconversionutil.h>
 #include <bdlt_iso8601util.h>
 #include <bdlt_time.h>
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+#include <bsl_limits.h>
 #include <bsl_ostream.h>
 #include <bsl_string_view.h>
 #include <bsl_vector.h>
 #include <bsls_assert.h>
+#include <lspcore_base64util.h>
+#include <lspcore_btreeset.h>
 #include <lspcore_builtins.h>
+#include <lspcore_deque.h>
+#include <lspcore_hashmap.h>
+#include <lspcore_hashtable.h>
+#include <lspcore_inttrie.h>
+#include <lspcore_mutablevector.h>
+#include <lspcore_packedvector.h>
 #include <lspcore_pair.h>
 #include <lspcore_printutil.h>
 #include <lspcore_procedure.h>
+#include <lspcore_quasiquote.h>
+#include <lspcore_record.h>
+#include <lspcore_rope.h>
+#include <lspcore_rrbvector.h>
 #include <lspcore_set.h>
+#include <lspcore_setsequence.h>
 #include <lspcore_symbolutil.h>
 #include <lspcore_userdefinedtypes.h>
 
@@ -66,6 +80,19 @@ struct PrintVisitor {
     void printPointer(const void*);
     void printProcedure(const Procedure&);
     void printSet(const Set*);
+    void printBTreeSet(const BTreeSet*);
+    void printHashMap(const HashMap*, bool isSet);
+    void printHashTable(const HashTable&);
+    void printIntTrie(const IntTrie*, bool isMap);
+    void printSetSequence(const SetSequence*);
+    void printTransient(const Set::Transient&);
+    void printRrbVector(const RrbVector*);
+    void printDeque(const Deque*);
+    void printPackedVector(const PackedVector&);
+    void printRope(const Rope*);
+    void printRecordType(const RecordType&);
+    void printRecord(const Record&);
+    void printMutableVector(const MutableVector&);
 };
 
 void PrintVisitor::operator()(bslmf::Nil) {
@@ -146,6 +173,62 @@ void PrintVisitor::operator()(const bdld::DatumUdt& value) {
         case UserDefinedTypes::e_SET:
             printSet(Set::access(value));
             return;
+        case UserDefinedTypes::e_HASH_MAP:
+            printHashMap(HashMap::access(value), false);
+            return;
+        case UserDefinedTypes::e_HASH_SET:
+            printHashMap(HashMap::access(value), true);
+            return;
+        case UserDefinedTypes::e_HASH_TABLE:
+            printHashTable(*HashTable::access(value));
+            return;
+        case UserDefinedTypes::e_BTREE_SET:
+            printBTreeSet(BTreeSet::access(value));
+            return;
+        case UserDefinedTypes::e_INT_SET:
+            printIntTrie(IntTrie::access(value), false);
+            return;
+        case UserDefinedTypes::e_INT_MAP:
+            printIntTrie(IntTrie::access(value), true);
+            return;
+        case UserDefinedTypes::e_SET_SEQUENCE:
+            printSetSequence(SetSequence::access(value));
+            return;
+        case UserDefinedTypes::e_SET_TRANSIENT:
+            printTransient(*Set::Transient::access(value));
+            return;
+        case UserDefinedTypes::e_RRB_VECTOR:
+            printRrbVector(RrbVector::access(value));
+            return;
+        case UserDefinedTypes::e_DEQUE:
+            printDeque(Deque::access(value));
+            return;
+        case UserDefinedTypes::e_PACKED_VECTOR:
+            printPackedVector(PackedVector::access(value));
+            return;
+        case UserDefinedTypes::e_ROPE:
+            printRope(Rope::access(value));
+            return;
+        case UserDefinedTypes::e_RECORD_TYPE:
+            printRecordType(RecordType::access(value));
+            return;
+        case UserDefinedTypes::e_RECORD:
+            printRecord(Record::access(value));
+            return;
+        case UserDefinedTypes::e_RECORD_ACCESSOR: {
+            // e.g. #record-accessor[point x]
+            const RecordAccessor& accessor = RecordAccessor::access(value);
+            stream << "#record-accessor[" << accessor.type->name << " "
+                   << accessor.type->fields[accessor.slot] << "]";
+            return;
+        }
+        case UserDefinedTypes::e_MUTABLE_VECTOR:
+            printMutableVector(*MutableVector::access(value));
+            return;
+        case UserDefinedTypes::e_QUASIQUOTE:
+            // An analyzed template prints as it was written.
+            Quasiquote::access(value).templateDatum().apply(*this);
+            return;
     }
 
     // Otherwise, it's some user-defined type we're not aware of. Print its
@@ -199,10 +282,23 @@ void PrintVisitor::operator()(const bdld::DatumMapRef& map) {
 
 void PrintVisitor::operator()(const bdld::DatumBinaryRef& value) {
     stream << "#base64\"";
-    balxml::TypesPrintUtil::printBase64(
-        stream,
-        bsl::string_view(static_cast<const char*>(value.data()),
-                         value.size()));
+
+    // Encode a chunk at a time into a buffer on the stack. Every chunk but
+    // the last is a multiple of three bytes, so that there is padding only at
+    // the end.
+    const bsl::size_t k_CHUNK_SIZE = 3 * 1024;
+    char              buffer[k_CHUNK_SIZE / 3 * 4];
+
+    const char*       bytes = static_cast<const char*>(value.data());
+    const char* const end   = bytes + value.size();
+    while (bytes != end) {
+        const bsl::size_t size =
+            bsl::min<bsl::size_t>(end - bytes, k_CHUNK_SIZE);
+        Base64Util::encode(buffer, bytes, size);
+        stream.write(buffer, Base64Util::encodedLength(size));
+        bytes += size;
+    }
+
     stream << "\"";
 }
 
@@ -299,47 +395,259 @@ void PrintVisitor::printProcedure(const Procedure& value) {
 }
 
 void PrintVisitor::printSet(const Set* set) {
+    // e.g. #{1 2 3}
     stream << "#{";
 
-    // in-order depth-first traversal
-    class SetVisitor {
-        PrintVisitor& print;
-        bool          first;
+    const char* separator = "";
+    for (Set::Cursor cursor(set); !cursor.done(); cursor.advance()) {
+        stream << separator;
+        cursor.value().apply(*this);
+        separator = " ";
+    }
 
-      public:
-        explicit SetVisitor(PrintVisitor& print)
-        : print(print)
-        , first(true) {
+    stream << "}";
+}
+
+void PrintVisitor::printBTreeSet(const BTreeSet* set) {
+    // e.g. #btree-set{1 2 3}
+    stream << "#btree-set{";
+
+    const char* separator = "";
+    for (BTreeSet::Cursor cursor(set); !cursor.done(); cursor.advance()) {
+        stream << separator;
+        cursor.value().apply(*this);
+        separator = " ";
+    }
+
+    stream << "}";
+}
+
+void PrintVisitor::printHashMap(const HashMap* map, bool isSet) {
+    // e.g. #hash-map{"one" 1 "two" 2} or #hash-set{1 2 3}
+    stream << (isSet ? "#hash-set{" : "#hash-map{");
+
+    const char* separator = "";
+    for (HashMap::Cursor cursor(map); !cursor.done(); cursor.advance()) {
+        const HashMap::Entry& entry = cursor.entry();
+        stream << separator;
+        entry.key.apply(*this);
+        if (!isSet) {
+            stream << " ";
+            entry.value.apply(*this);
         }
+        separator = " ";
+    }
 
-        void operator()(const Set* set) {
-            if (!set) {
-                return;
-            }
+    stream << "}";
+}
+
+void PrintVisitor::printHashTable(const HashTable& table) {
+    // e.g. #hash-table{"one" 1 "two" 2}
+    stream << "#hash-table{";
+
+    const char* separator = "";
+    for (HashTable::Cursor cursor(table); !cursor.done(); cursor.advance()) {
+        const HashTable::Entry& entry = cursor.entry();
+        stream << separator;
+        entry.key.apply(*this);
+        stream << " ";
+        entry.value.apply(*this);
+        separator = " ";
+    }
+
+    stream << "}";
+}
+
+void PrintVisitor::printIntTrie(const IntTrie* trie, bool isMap) {
+    // Int sets print like sets, e.g. #{1 2 3}, and int maps print like int
+    // maps, e.g. {1 "one" 2 "two"}. Keys that don't fit in an 'int' print
+    // with the suffix of an 'Int64', e.g. 4294967296L.
+    stream << (isMap ? "{" : "#{");
+
+    const char* separator = "";
+    for (IntTrie::Cursor cursor(trie); !cursor.done(); cursor.advance()) {
+        const bsls::Types::Int64 key = cursor.key();
+        stream << separator;
+        if (key >= bsl::numeric_limits<int>::min() &&
+            key <= bsl::numeric_limits<int>::max()) {
+            (*this)(int(key));
+        }
+        else {
+            (*this)(key);
+        }
+        if (isMap) {
+            stream << " ";
+            cursor.value().apply(*this);
+        }
+        separator = " ";
+    }
+
+    stream << "}";
+}
+
+void PrintVisitor::printSetSequence(const SetSequence* sequence) {
+    // e.g. #set-seq(1 2 3)
+    stream << "#set-seq(";
+
+    const char* separator = "";
+    for (SetSequence::Cursor cursor(sequence); !cursor.done();
+         cursor.advance()) {
+        stream << separator;
+        cursor.value().apply(*this);
+        separator = " ";
+    }
+
+    stream << ")";
+}
 
-            // predecessors
-            (*this)(set->left());
+void PrintVisitor::printTransient(const Set::Transient& transient) {
+    // e.g. #transient{1 2 3}, or #persisted{1 2 3} once it's been persisted
+    stream << (transient.isPersisted() ? "#persisted" : "#transient");
+    printSet(transient.set());
+}
+
+void PrintVisitor::printRrbVector(const RrbVector* vector) {
+    // e.g. #rrb[1 2 3]
+    stream << "#rrb[";
+
+    const char* separator = "";
+    for (RrbVector::Cursor cursor(vector); !cursor.done(); cursor.advance()) {
+        stream << separator;
+        cursor.value().apply(*this);
+        separator = " ";
+    }
+
+    stream << "]";
+}
+
+void PrintVisitor::printDeque(const Deque* deque) {
+    // e.g. #deque[1 2 3]
+    stream << "#deque[";
+
+    const char* separator = "";
+    for (Deque::Cursor cursor(deque); !cursor.done(); cursor.advance()) {
+        stream << separator;
+        cursor.value().apply(*this);
+        separator = " ";
+    }
 
-            // separating space, unless we're first
-            if (first) {
-                first = false;
+    stream << "]";
+}
+
+void PrintVisitor::printPackedVector(const PackedVector& vector) {
+    // e.g. #int32[1 2 3], #int64[1L 2L 3L], or #double[1.5B 2.5B]
+    const char* separator = "";
+    switch (vector.type()) {
+        case PackedVector::e_INT32:
+            stream << "#int32[";
+            for (bsl::size_t i = 0; i < vector.length(); ++i) {
+                stream << separator;
+                (*this)(vector.elements<int>()[i]);
+                separator = " ";
+            }
+            break;
+        case PackedVector::e_INT64:
+            stream << "#int64[";
+            for (bsl::size_t i = 0; i < vector.length(); ++i) {
+                stream << separator;
+                (*this)(vector.elements<bsls::Types::Int64>()[i]);
+                separator = " ";
             }
-            else {
-                print.stream << " ";
+            break;
+        default:
+            BSLS_ASSERT(vector.type() == PackedVector::e_DOUBLE);
+            stream << "#double[";
+            for (bsl::size_t i = 0; i < vector.length(); ++i) {
+                stream << separator;
+                (*this)(vector.elements<double>()[i]);
+                separator = " ";
             }
+    }
 
-            // our value
-            set->value().apply(print);
+    stream << "]";
+}
 
-            // successors
-            (*this)(set->right());
+void PrintVisitor::printRope(const Rope* rope) {
+    // e.g. #rope"hello, world"
+    // The rope is printed a chunk at a time, rather than converted to a
+    // string first. The escaping is the same as for strings, except that
+    // bytes that are not ASCII are printed as they are.
+    stream << "#rope\"";
+
+    for (Rope::Cursor cursor(rope); !cursor.done(); cursor.advance()) {
+        const bsl::string_view& chunk = cursor.chunk();
+        for (bsl::size_t i = 0; i < chunk.size(); ++i) {
+            const unsigned char byte = chunk[i];
+            switch (byte) {
+                case '"':
+                    stream << "\\\"";
+                    break;
+                case '\\':
+                    stream << "\\\\";
+                    break;
+                case '\b':
+                    stream << "\\b";
+                    break;
+                case '\f':
+                    stream << "\\f";
+                    break;
+                case '\n':
+                    stream << "\\n";
+                    break;
+                case '\r':
+                    stream << "\\r";
+                    break;
+                case '\t':
+                    stream << "\\t";
+                    break;
+                default:
+                    if (byte < 0x20) {
+                        const char digits[] = "0123456789abcdef";
+                        stream << "\\u00" << digits[byte >> 4]
+                               << digits[byte & 0xf];
+                    }
+                    else {
+                        stream << char(byte);
+                    }
+            }
         }
-    };
+    }
 
-    SetVisitor visit(*this);
-    visit(set);
+    stream << '"';
+}
 
-    stream << "}";
+void PrintVisitor::printRecordType(const RecordType& type) {
+    // e.g. #record-type[point x y]
+    stream << "#record-type[" << type.name;
+    for (bsl::size_t i = 0; i < type.fields.size(); ++i) {
+        stream << " " << type.fields[i];
+    }
+    stream << "]";
+}
+
+void PrintVisitor::printRecord(const Record& record) {
+    // e.g. #record[point x 1 y 2]
+    const RecordType& type = record.type();
+    stream << "#record[" << type.name;
+    for (bsl::size_t i = 0; i < record.size(); ++i) {
+        stream << " " << type.fields[i] << " ";
+        record.slots()[i].apply(*this);
+    }
+    stream << "]";
+}
+
+void PrintVisitor::printMutableVector(const MutableVector& vector) {
+    // e.g. #vector[1 2 3]
+    stream << "#vector[";
+
+    const char* separator = "";
+    for (bsl::size_t i = 0; i < vector.size(); ++i) {
+        stream << separator;
+        vector[i].apply(*this);
+        separator = " ";
+    }
+
+    stream << "]";
 }
 
 }  // namespace
@@ -0,0 +1,18 @@
+#include <lspcore_quasiquote.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+Quasiquote::Quasiquote(const bdld::Datum& templateDatum, const Node& root)
+: d_template(templateDatum)
+, d_root(root) {
+}
+
+bdld::Datum Quasiquote::create(const Quasiquote* quasiquote, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(quasiquote)),
+        UserDefinedTypes::e_QUASIQUOTE + typeOffset);
+}
+
+}  // namespace lspcore
@@ -0,0 +1,106 @@
+#ifndef INCLUDED_LSPCORE_QUASIQUOTE
+#define INCLUDED_LSPCORE_QUASIQUOTE
+
+// A quasiquote form is a template of a datum some of whose parts are
+// computed, e.g.
+//
+//     `(reply (id ,id) (items ,@items) (version 2))
+//
+// is a list like '(reply (id 0) (items) (version 2))', but with the value of
+// 'id' in place of ",id" and the elements of 'items' spliced in place of
+// ",@items". The 'unquote' (",") and 'unquote-splicing' (",@") forms are the
+// "holes" of the template.
+//
+// A 'Quasiquote' is a template that has been analyzed once, so that each
+// evaluation of it does work in proportion to its holes rather than to its
+// size. The analysis produces a tree of 'Quasiquote::Node' objects. A part of
+// the template that contains no holes becomes a constant node that refers to
+// that part of the template itself, so that every evaluation shares it. A
+// list that does contain holes becomes a list node whose elements are the
+// nodes of its elements up to the last one containing a hole, and whose tail
+// is a constant node referring to the rest of the list, so that evaluation
+// allocates pairs only along the spine that leads to holes. When a list ends
+// with an 'unquote-splicing' form, the spliced list becomes the tail of the
+// result without being copied.
+//
+// The interpreter analyzes the template of a quasiquote form when it resolves
+// the body of a λ expression, and replaces the template by the 'Quasiquote'.
+// A quasiquote form evaluated outside of a procedure body is analyzed when it
+// is evaluated.
+
+#include <bdld_datum.h>
+#include <bdld_datumudt.h>
+#include <bsl_cstddef.h>
+#include <bsls_assert.h>
+#include <lspcore_userdefinedtypes.h>
+
+namespace lspcore {
+namespace bdld = BloombergLP::bdld;
+
+class Quasiquote {
+  public:
+    struct Node {
+        enum Kind {
+            e_CONSTANT,          // 'datum' is the value
+            e_UNQUOTE,           // 'datum' is an expression to evaluate
+            e_UNQUOTE_SPLICING,  // as 'e_UNQUOTE', but spliced into a sequence
+            e_LIST,              // 'count' elements and then the tail
+            e_ARRAY              // 'count' elements
+        };
+
+        Kind        kind;
+        bdld::Datum datum;     // null for lists and arrays
+        const Node* children;  // null for constants and holes
+        bsl::size_t count;
+    };
+
+  private:
+    bdld::Datum d_template;
+    Node        d_root;
+
+  public:
+    Quasiquote(const bdld::Datum& templateDatum, const Node& root);
+
+    // Return the template as it was written, e.g. for printing.
+    const bdld::Datum& templateDatum() const;
+    const Node&        root() const;
+
+    static bool isQuasiquote(const bdld::Datum&, int typeOffset);
+    static bool isQuasiquote(const bdld::DatumUdt&, int typeOffset);
+
+    static const Quasiquote& access(const bdld::Datum&);
+    static const Quasiquote& access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(const Quasiquote* quasiquote, int typeOffset);
+};
+
+inline const bdld::Datum& Quasiquote::templateDatum() const {
+    return d_template;
+}
+
+inline const Quasiquote::Node& Quasiquote::root() const {
+    return d_root;
+}
+
+inline bool Quasiquote::isQuasiquote(const bdld::Datum& datum,
+                                     int                typeOffset) {
+    return datum.isUdt() && isQuasiquote(datum.theUdt(), typeOffset);
+}
+
+inline bool Quasiquote::isQuasiquote(const bdld::DatumUdt& udt,
+                                     int                   typeOffset) {
+    return udt.type() - typeOffset == UserDefinedTypes::e_QUASIQUOTE;
+}
+
+inline const Quasiquote& Quasiquote::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+inline const Quasiquote& Quasiquote::access(const bdld::DatumUdt& udt) {
+    return *static_cast<const Quasiquote*>(udt.data());
+}
+
+}  // namespace lspcore
+
+#endif
@@ -0,0 +1,55 @@
+#include <bsl_new.h>
+#include <bslma_allocator.h>
+#include <lspcore_record.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+RecordType::RecordType(bslma::Allocator* allocator)
+: name(allocator)
+, fields(allocator) {
+}
+
+bdld::Datum RecordType::create(const RecordType* type, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(type)),
+        UserDefinedTypes::e_RECORD_TYPE + typeOffset);
+}
+
+Record::Record(const RecordType* type)
+: d_type_p(type) {
+}
+
+bdld::Datum Record::create(const RecordType* type,
+                           const bdld::Datum* slots,
+                           int                typeOffset,
+                           bslma::Allocator*  allocator) {
+    const bsl::size_t size   = type->fields.size();
+    void* const       memory = allocator->allocate(
+        sizeof(Record) + size * sizeof(bdld::Datum));
+    Record* const record = new (memory) Record(type);
+
+    bdld::Datum* const output = reinterpret_cast<bdld::Datum*>(record + 1);
+    for (bsl::size_t i = 0; i < size; ++i) {
+        new (output + i) bdld::Datum(slots[i]);
+    }
+
+    return bdld::Datum::createUdt(record,
+                                  UserDefinedTypes::e_RECORD + typeOffset);
+}
+
+bdld::Datum RecordAccessor::create(const RecordType* type,
+                                   bsl::size_t       slot,
+                                   int               typeOffset,
+                                   bslma::Allocator* allocator) {
+    BSLS_ASSERT(slot < type->fields.size());
+
+    RecordAccessor* const accessor = new (*allocator) RecordAccessor;
+    accessor->type                 = type;
+    accessor->slot                 = slot;
+    return bdld::Datum::createUdt(
+        accessor, UserDefinedTypes::e_RECORD_ACCESSOR + typeOffset);
+}
+
+}  // namespace lspcore
@@ -0,0 +1,172 @@
+#ifndef INCLUDED_LSPCORE_RECORD
+#define INCLUDED_LSPCORE_RECORD
+
+// A record is an immutable value having a fixed set of named fields, like a
+// 'struct'. The form
+//
+//     (define-record point x y)
+//
+// creates a 'RecordType' named "point" having the fields "x" and "y", and
+// binds 'point' to it. It also binds 'make-point' to a procedure that
+// returns a new 'Record' of that type given the value of each field,
+// 'point?' to a procedure that returns whether its argument is such a
+// record, and 'point-x' and 'point-y' to 'RecordAccessor' objects that
+// return the value of one field of such a record.
+//
+// A record stores its values in an array of "slots," one per field in the
+// order in which the fields were declared, so an accessor loads a slot at a
+// fixed index instead of searching for a field by name. The interpreter
+// invokes accessors directly, rather than as native procedures, so a call to
+// an accessor does not build a vector of arguments.
+
+#include <bdld_datum.h>
+#include <bdld_datumudt.h>
+#include <bsl_cstddef.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslmf_nestedtraitdeclaration.h>
+#include <bsls_assert.h>
+#include <lspcore_userdefinedtypes.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+struct RecordType {
+    bsl::string              name;
+    bsl::vector<bsl::string> fields;  // in slot order
+
+    BSLMF_NESTED_TRAIT_DECLARATION(RecordType, bslma::UsesBslmaAllocator);
+
+    explicit RecordType(bslma::Allocator* = 0);
+
+    static bool isRecordType(const bdld::Datum&, int typeOffset);
+    static bool isRecordType(const bdld::DatumUdt&, int typeOffset);
+
+    static const RecordType& access(const bdld::Datum&);
+    static const RecordType& access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(const RecordType* type, int typeOffset);
+};
+
+class Record {
+    const RecordType* d_type_p;
+    // The slots follow the 'Record' in memory.
+
+    explicit Record(const RecordType* type);
+
+  public:
+    // Return a record of the specified 'type' whose slots are copies of the
+    // 'type->fields.size()' values beginning at the specified 'slots'.
+    static bdld::Datum create(const RecordType* type,
+                              const bdld::Datum* slots,
+                              int                typeOffset,
+                              bslma::Allocator*);
+
+    const RecordType&  type() const;
+    bsl::size_t        size() const;
+    const bdld::Datum* slots() const;
+
+    static bool isRecord(const bdld::Datum&, int typeOffset);
+    static bool isRecord(const bdld::DatumUdt&, int typeOffset);
+
+    static const Record& access(const bdld::Datum&);
+    static const Record& access(const bdld::DatumUdt&);
+};
+
+struct RecordAccessor {
+    const RecordType* type;
+    bsl::size_t       slot;
+
+    static bool isRecordAccessor(const bdld::Datum&, int typeOffset);
+    static bool isRecordAccessor(const bdld::DatumUdt&, int typeOffset);
+
+    static const RecordAccessor& access(const bdld::Datum&);
+    static const RecordAccessor& access(const bdld::DatumUdt&);
+
+    // Return an accessor for the slot at the specified 'slot' index of
+    // records of the specified 'type'.
+    static bdld::Datum create(const RecordType* type,
+                              bsl::size_t       slot,
+                              int               typeOffset,
+                              bslma::Allocator*);
+};
+
+inline bool RecordType::isRecordType(const bdld::Datum& datum,
+                                     int                typeOffset) {
+    return datum.isUdt() && isRecordType(datum.theUdt(), typeOffset);
+}
+
+inline bool RecordType::isRecordType(const bdld::DatumUdt& udt,
+                                     int                   typeOffset) {
+    return udt.type() - typeOffset == UserDefinedTypes::e_RECORD_TYPE;
+}
+
+inline const RecordType& RecordType::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+inline const RecordType& RecordType::access(const bdld::DatumUdt& udt) {
+    return *static_cast<const RecordType*>(udt.data());
+}
+
+inline const RecordType& Record::type() const {
+    return *d_type_p;
+}
+
+inline bsl::size_t Record::size() const {
+    return d_type_p->fields.size();
+}
+
+inline const bdld::Datum* Record::slots() const {
+    return reinterpret_cast<const bdld::Datum*>(this + 1);
+}
+
+inline bool Record::isRecord(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && isRecord(datum.theUdt(), typeOffset);
+}
+
+inline bool Record::isRecord(const bdld::DatumUdt& udt, int typeOffset) {
+    return udt.type() - typeOffset == UserDefinedTypes::e_RECORD;
+}
+
+inline const Record& Record::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+inline const Record& Record::access(const bdld::DatumUdt& udt) {
+    return *static_cast<const Record*>(udt.data());
+}
+
+inline bool RecordAccessor::isRecordAccessor(const bdld::Datum& datum,
+                                             int                typeOffset) {
+    return datum.isUdt() && isRecordAccessor(datum.theUdt(), typeOffset);
+}
+
+inline bool RecordAccessor::isRecordAccessor(const bdld::DatumUdt& udt,
+                                             int typeOffset) {
+    return udt.type() - typeOffset == UserDefinedTypes::e_RECORD_ACCESSOR;
+}
+
+inline const RecordAccessor& RecordAccessor::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+inline const RecordAccessor& RecordAccessor::access(
+    const bdld::DatumUdt& udt) {
+    return *static_cast<const RecordAccessor*>(udt.data());
+}
+
+}  // namespace lspcore
+
+#endif
@@ -0,0 +1,494 @@
+#include <bsl_algorithm.h>
+#include <bsl_cstring.h>
+#include <bsl_new.h>
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <lspcore_rope.h>
+#include <lspcore_userdefinedtypes.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+struct Rope::Node {
+    bsl::size_t length;  // number of characters
+    int         height;  // zero for a leaf
+    const char* data;    // leaf only
+    const Node* left;    // branch only
+    const Node* right;   // branch only
+};
+
+struct Rope::Buffer {
+    bsls::AtomicUint used;  // number of characters written so far
+    unsigned         capacity;
+
+    // The characters follow the 'Buffer' in memory.
+    char* data() {
+        return reinterpret_cast<char*>(this + 1);
+    }
+};
+
+Rope::Rope(const Node* tree, Buffer* tail, bsl::size_t tailLength)
+: d_tree(tree)
+, d_tail(tail)
+, d_tailLength(tailLength) {
+}
+
+// Trees
+// =====
+// The functions below take and return null pointers for empty trees. A
+// nonempty tree has no empty leaves. Every branch's children differ in
+// height by at most one.
+class RopeImpl {
+  public:
+    typedef Rope::Node   Node;
+    typedef Rope::Buffer Buffer;
+
+    // A new buffer has room for twice as many characters as the last, within
+    // these limits. Text at least as long as the largest buffer becomes a
+    // leaf of its own.
+    enum { k_MIN_BUFFER = 32, k_MAX_BUFFER = 4096 };
+
+    static bsl::size_t length(const Node* tree) {
+        return tree ? tree->length : 0;
+    }
+
+    static const Node* leaf(const char*       data,
+                            bsl::size_t       length,
+                            bslma::Allocator* allocator) {
+        if (length == 0) {
+            return 0;
+        }
+
+        Node* node   = new (*allocator) Node;
+        node->length = length;
+        node->height = 0;
+        node->data   = data;
+        node->left   = 0;
+        node->right  = 0;
+        return node;
+    }
+
+    static const Node* branch(const Node*       left,
+                              const Node*       right,
+                              bslma::Allocator* allocator) {
+        BSLS_ASSERT(left);
+        BSLS_ASSERT(right);
+
+        Node* node   = new (*allocator) Node;
+        node->length = left->length + right->length;
+        node->height = bsl::max(left->height, right->height) + 1;
+        node->data   = 0;
+        node->left   = left;
+        node->right  = right;
+        return node;
+    }
+
+    // Return a tree of the specified 'left' followed by the specified
+    // 'right', rotating if their heights differ by two. The behavior is
+    // undefined unless their heights differ by at most two.
+    static const Node* balance(const Node*       left,
+                               const Node*       right,
+                               bslma::Allocator* allocator) {
+        if (left->height > right->height + 1) {
+            if (left->left->height >= left->right->height) {
+                return branch(
+                    left->left, branch(left->right, right, allocator),
+                    allocator);
+            }
+            return branch(
+                branch(left->left, left->right->left, allocator),
+                branch(left->right->right, right, allocator),
+                allocator);
+        }
+
+        if (right->height > left->height + 1) {
+            if (right->right->height >= right->left->height) {
+                return branch(
+                    branch(left, right->left, allocator), right->right,
+                    allocator);
+            }
+            return branch(branch(left, right->left->left, allocator),
+                          branch(right->left->right, right->right, allocator),
+                          allocator);
+        }
+
+        return branch(left, right, allocator);
+    }
+
+    // Return a tree of the specified 'left' followed by the specified
+    // 'right'. This takes time proportional to the difference in their
+    // heights.
+    static const Node* join(const Node*       left,
+                            const Node*       right,
+                            bslma::Allocator* allocator) {
+        if (!left) {
+            return right;
+        }
+        if (!right) {
+            return left;
+        }
+
+        if (left->height > right->height + 1) {
+            return balance(
+                left->left, join(left->right, right, allocator), allocator);
+        }
+        if (right->height > left->height + 1) {
+            return balance(
+                join(left, right->left, allocator), right->right, allocator);
+        }
+        return branch(left, right, allocator);
+    }
+
+    // Load into the specified 'before' and 'after' trees of the first
+    // 'index' characters of the specified 'tree' and of the rest,
+    // respectively. The behavior is undefined unless
+    // 'index <= length(tree)'.
+    static void split(const Node**      before,
+                      const Node**      after,
+                      const Node*       tree,
+                      bsl::size_t       index,
+                      bslma::Allocator* allocator) {
+        BSLS_ASSERT(index <= length(tree));
+
+        if (index == 0) {
+            *before = 0;
+            *after  = tree;
+            return;
+        }
+        if (index == tree->length) {
+            *before = tree;
+            *after  = 0;
+            return;
+        }
+
+        if (tree->height == 0) {
+            *before = leaf(tree->data, index, allocator);
+            *after  = leaf(
+                tree->data + index, tree->length - index, allocator);
+            return;
+        }
+
+        const bsl::size_t leftLength = tree->left->length;
+        if (index <= leftLength) {
+            const Node* rest;
+            split(before, &rest, tree->left, index, allocator);
+            *after = join(rest, tree->right, allocator);
+        }
+        else {
+            const Node* first;
+            split(&first, after, tree->right, index - leftLength, allocator);
+            *before = join(tree->left, first, allocator);
+        }
+    }
+
+    // Return a buffer having room for the specified 'capacity' characters
+    // whose first 'text.size()' characters are the specified 'text'.
+    static Buffer* buffer(const bsl::string_view& text,
+                          unsigned                capacity,
+                          bslma::Allocator*       allocator) {
+        BSLS_ASSERT(text.size() <= capacity);
+
+        void* const   memory = allocator->allocate(sizeof(Buffer) + capacity);
+        Buffer* const result = new (memory) Buffer;
+        result->used.storeRelaxed(unsigned(text.size()));
+        result->capacity = capacity;
+        bsl::memcpy(result->data(), text.data(), text.size());
+        return result;
+    }
+
+    // Claim the room in the specified 'buffer' for the specified 'count'
+    // characters after the first 'used'. Return whether no other rope had
+    // claimed any characters after the first 'used' and there was room.
+    static bool reserve(Buffer* buffer, bsl::size_t used, bsl::size_t count) {
+        if (used + count > buffer->capacity) {
+            return false;
+        }
+        return buffer->used.testAndSwap(unsigned(used),
+                                        unsigned(used + count)) == used;
+    }
+
+    static const Rope* make(const Node*       tree,
+                            Buffer*           tail,
+                            bsl::size_t       tailLength,
+                            bslma::Allocator* allocator) {
+        if (!tree && tailLength == 0) {
+            return 0;
+        }
+        return new (*allocator) Rope(tree, tailLength ? tail : 0, tailLength);
+    }
+
+    // Return a tree of all the characters of the specified 'rope', including
+    // its tail.
+    static const Node* wholeTree(const Rope*       rope,
+                                 bslma::Allocator* allocator) {
+        if (!rope) {
+            return 0;
+        }
+        return join(rope->d_tree,
+                    tailLeaf(rope, 0, rope->d_tailLength, allocator),
+                    allocator);
+    }
+
+    // Return a leaf of the characters of the tail of the specified 'rope'
+    // from the specified 'begin' up to but not including the specified
+    // 'end', or a null pointer if they are the same.
+    static const Node* tailLeaf(const Rope*       rope,
+                                bsl::size_t       begin,
+                                bsl::size_t       end,
+                                bslma::Allocator* allocator) {
+        BSLS_ASSERT(begin <= end);
+        if (begin == end) {
+            return 0;
+        }
+
+        BSLS_ASSERT(end <= rope->d_tailLength);
+        return leaf(rope->d_tail->data() + begin, end - begin, allocator);
+    }
+};
+
+void Rope::Cursor::descend(const Node* node) {
+    while (node->height) {
+        BSLS_ASSERT(d_depth < k_MAX_DEPTH);
+        d_stack[d_depth++] = node->right;
+        node               = node->left;
+    }
+    d_chunk = bsl::string_view(node->data, node->length);
+}
+
+Rope::Cursor::Cursor(const Rope* rope)
+: d_depth(0)
+, d_rope_p(rope) {
+    if (rope && rope->d_tree) {
+        descend(rope->d_tree);
+    }
+    else {
+        advance();
+    }
+}
+
+void Rope::Cursor::advance() {
+    if (d_depth) {
+        descend(d_stack[--d_depth]);
+    }
+    else if (d_rope_p && d_rope_p->d_tailLength) {
+        d_chunk  = bsl::string_view(d_rope_p->d_tail->data(),
+                                   d_rope_p->d_tailLength);
+        d_rope_p = 0;
+    }
+    else {
+        d_chunk  = bsl::string_view();
+        d_rope_p = 0;
+    }
+}
+
+bsl::size_t Rope::length(const Rope* rope) {
+    return rope ? RopeImpl::length(rope->d_tree) + rope->d_tailLength : 0;
+}
+
+char Rope::at(const Rope* rope, bsl::size_t index) {
+    BSLS_ASSERT(index < length(rope));
+
+    const Node* node = rope->d_tree;
+    if (index >= RopeImpl::length(node)) {
+        return rope->d_tail->data()[index - RopeImpl::length(node)];
+    }
+
+    while (node->height) {
+        if (index < node->left->length) {
+            node = node->left;
+        }
+        else {
+            index -= node->left->length;
+            node = node->right;
+        }
+    }
+    return node->data[index];
+}
+
+const Rope* Rope::append(const Rope*             rope,
+                         const bsl::string_view& text,
+                         bslma::Allocator*       allocator) {
+    if (text.empty()) {
+        return rope;
+    }
+
+    const Node* tree       = rope ? rope->d_tree : 0;
+    Buffer*     tail       = rope ? rope->d_tail : 0;
+    bsl::size_t tailLength = rope ? rope->d_tailLength : 0;
+    if (tail && RopeImpl::reserve(tail, tailLength, text.size())) {
+        bsl::memcpy(tail->data() + tailLength, text.data(), text.size());
+        return RopeImpl::make(
+            tree, tail, tailLength + text.size(), allocator);
+    }
+
+    // The tail is full, or another rope has already appended to it. Either
+    // way, it becomes part of the tree.
+    tree = RopeImpl::join(
+        tree, RopeImpl::tailLeaf(rope, 0, tailLength, allocator), allocator);
+
+    if (text.size() >= RopeImpl::k_MAX_BUFFER) {
+        char* const copy =
+            static_cast<char*>(allocator->allocate(text.size()));
+        bsl::memcpy(copy, text.data(), text.size());
+        return RopeImpl::make(
+            RopeImpl::join(
+                tree, RopeImpl::leaf(copy, text.size(), allocator), allocator),
+            0,
+            0,
+            allocator);
+    }
+
+    const unsigned previous = tail ? tail->capacity : 0;
+    const unsigned capacity = bsl::max(
+        unsigned(text.size()),
+        bsl::min(unsigned(RopeImpl::k_MAX_BUFFER),
+                 bsl::max(unsigned(RopeImpl::k_MIN_BUFFER), 2 * previous)));
+    return RopeImpl::make(tree,
+                          RopeImpl::buffer(text, capacity, allocator),
+                          text.size(),
+                          allocator);
+}
+
+const Rope* Rope::concatenate(const Rope*       left,
+                              const Rope*       right,
+                              bslma::Allocator* allocator) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+
+    // The result keeps the tail of 'right', so that it can be appended to in
+    // place.
+    return RopeImpl::make(
+        RopeImpl::join(
+            RopeImpl::wholeTree(left, allocator), right->d_tree, allocator),
+        right->d_tail,
+        right->d_tailLength,
+        allocator);
+}
+
+const Rope* Rope::slice(const Rope*       rope,
+                        bsl::size_t       begin,
+                        bsl::size_t       end,
+                        bslma::Allocator* allocator) {
+    BSLS_ASSERT(begin <= end);
+    BSLS_ASSERT(end <= length(rope));
+
+    if (begin == 0 && end == length(rope)) {
+        return rope;
+    }
+    if (begin == end) {
+        return 0;
+    }
+
+    // Take what's wanted from the tree, and then from the tail. If the slice
+    // includes the whole tail, then it keeps the tail, so that it can be
+    // appended to in place.
+    const bsl::size_t treeLength = RopeImpl::length(rope->d_tree);
+    const Node*       tree       = 0;
+    if (begin < treeLength) {
+        const Node* unused;
+        const Node* rest;
+        RopeImpl::split(&unused, &rest, rope->d_tree, begin, allocator);
+        RopeImpl::split(&tree,
+                        &unused,
+                        rest,
+                        bsl::min(end, treeLength) - begin,
+                        allocator);
+    }
+
+    if (end <= treeLength) {
+        return RopeImpl::make(tree, 0, 0, allocator);
+    }
+
+    const bsl::size_t tailBegin = begin > treeLength ? begin - treeLength : 0;
+    const bsl::size_t tailEnd   = end - treeLength;
+    if (tailBegin == 0 && tailEnd == rope->d_tailLength) {
+        return RopeImpl::make(
+            tree, rope->d_tail, rope->d_tailLength, allocator);
+    }
+
+    return RopeImpl::make(
+        RopeImpl::join(
+            tree,
+            RopeImpl::tailLeaf(rope, tailBegin, tailEnd, allocator),
+            allocator),
+        0,
+        0,
+        allocator);
+}
+
+bdld::Datum Rope::toString(const Rope* rope, bslma::Allocator* allocator) {
+    bdld::Datum result;
+    char*       output = bdld::Datum::createUninitializedString(
+        &result, length(rope), allocator);
+    for (Cursor cursor(rope); !cursor.done(); cursor.advance()) {
+        const bsl::string_view& chunk = cursor.chunk();
+        bsl::memcpy(output, chunk.data(), chunk.size());
+        output += chunk.size();
+    }
+
+    return result;
+}
+
+int Rope::compare(const Rope* left, const Rope* right) {
+    if (left == right) {
+        return 0;
+    }
+
+    // Compare the overlap of the current chunks, and then move past it.
+    Cursor           leftCursor(left);
+    Cursor           rightCursor(right);
+    bsl::string_view leftChunk  = leftCursor.chunk();
+    bsl::string_view rightChunk = rightCursor.chunk();
+    while (!leftChunk.empty() && !rightChunk.empty()) {
+        const bsl::size_t overlap =
+            bsl::min(leftChunk.size(), rightChunk.size());
+        if (const int comparison =
+                bsl::memcmp(leftChunk.data(), rightChunk.data(), overlap)) {
+            return comparison;
+        }
+
+        leftChunk.remove_prefix(overlap);
+        if (leftChunk.empty()) {
+            leftCursor.advance();
+            leftChunk = leftCursor.chunk();
+        }
+        rightChunk.remove_prefix(overlap);
+        if (rightChunk.empty()) {
+            rightCursor.advance();
+            rightChunk = rightCursor.chunk();
+        }
+    }
+
+    return int(!leftChunk.empty()) - int(!rightChunk.empty());
+}
+
+bool Rope::isRope(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && isRope(datum.theUdt(), typeOffset);
+}
+
+bool Rope::isRope(const bdld::DatumUdt& udt, int typeOffset) {
+    return udt.type() == UserDefinedTypes::e_ROPE + typeOffset;
+}
+
+const Rope* Rope::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+const Rope* Rope::access(const bdld::DatumUdt& udt) {
+    return static_cast<const Rope*>(udt.data());
+}
+
+bdld::Datum Rope::create(const Rope* rope, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(rope)),
+        UserDefinedTypes::e_ROPE + typeOffset);
+}
+
+}  // namespace lspcore
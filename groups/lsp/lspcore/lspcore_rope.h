@@ -0,0 +1,135 @@
+#ifndef INCLUDED_LSPCORE_ROPE
+#define INCLUDED_LSPCORE_ROPE
+
+// A rope is an immutable string that can be extended without copying the
+// characters it already has. Appending to a 'bdld' string copies the whole
+// string, so building a string piece by piece takes time quadratic in its
+// length; appending to a rope takes time proportional to the appended text.
+//
+// A rope consists of a "tree" followed by a "tail." The tree is a binary tree
+// whose leaves are runs of characters and whose branches denote the
+// concatenation of their children. Its height is balanced as in an AVL tree,
+// so 'at' takes O(log n) time, as do 'concatenate' and 'slice', which split
+// and join trees. Leaves refer to characters stored elsewhere, so splitting a
+// leaf copies no characters.
+//
+// The tail is a prefix of a "buffer" that has room for more characters.
+// Appending to a rope writes into the spare room of its tail's buffer, if the
+// tail ends where the buffer's contents do, and otherwise moves the tail into
+// the tree as a leaf and starts a new buffer. Characters in a buffer never
+// change once written, so every rope that shares a buffer sees the same
+// prefix of it, and only one of them (whichever appends first) can extend it
+// in place. The buffer's length is updated atomically, so ropes can be
+// appended to from any thread.
+//
+// Nothing is flattened into a contiguous string unless 'toString' is called.
+// 'Cursor' visits the characters of a rope as a sequence of contiguous
+// "chunks," which is how ropes are printed, compared, and hashed.
+//
+// A rope is represented as a pointer to a 'Rope'. A null pointer denotes an
+// empty rope.
+
+#include <bdld_datum.h>
+#include <bsl_cstddef.h>
+#include <bsl_string_view.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+class Rope {
+    struct Node;
+    struct Buffer;
+
+    const Node* d_tree;        // null if empty
+    Buffer*     d_tail;        // null if 'd_tailLength' is zero
+    bsl::size_t d_tailLength;  // characters of 'd_tail' belonging to this
+
+    Rope(const Node* tree, Buffer* tail, bsl::size_t tailLength);
+
+    friend class RopeImpl;
+
+  public:
+    // 'Cursor' visits the characters of a 'Rope' in order, a contiguous
+    // chunk at a time, without allocating memory.
+    class Cursor {
+        // A tree with 'n' leaves has height less than '1.45 * log2(n + 2)',
+        // so a rope of fewer than '2^64' characters has height less than 94.
+        enum { k_MAX_DEPTH = 96 };
+
+        const Node*      d_stack[k_MAX_DEPTH];  // right subtrees to visit
+        int              d_depth;
+        const Rope*      d_rope_p;  // null once the tail has been visited
+        bsl::string_view d_chunk;   // empty when done
+
+        void descend(const Node* node);
+
+      public:
+        explicit Cursor(const Rope* rope);
+
+        bool                    done() const;
+        const bsl::string_view& chunk() const;
+        void                    advance();
+    };
+
+    static bsl::size_t length(const Rope*);
+
+    // Return the character of the specified 'rope' at the specified
+    // 'index'. The behavior is undefined unless 'index < length(rope)'.
+    static char at(const Rope* rope, bsl::size_t index);
+
+    // Return a rope of the characters of the specified 'rope' followed by
+    // the specified 'text'.
+    static const Rope* append(const Rope*             rope,
+                              const bsl::string_view& text,
+                              bslma::Allocator*);
+
+    // Return a rope of the characters of the specified 'left' followed by
+    // the characters of the specified 'right'.
+    static const Rope* concatenate(const Rope* left,
+                                   const Rope* right,
+                                   bslma::Allocator*);
+
+    // Return a rope of the characters of the specified 'rope' from the
+    // specified 'begin' index up to but not including the specified 'end'
+    // index. The behavior is undefined unless
+    // 'begin <= end && end <= length(rope)'.
+    static const Rope* slice(const Rope* rope,
+                             bsl::size_t begin,
+                             bsl::size_t end,
+                             bslma::Allocator*);
+
+    // Return a 'bdld' string of the characters of the specified 'rope'.
+    static bdld::Datum toString(const Rope* rope, bslma::Allocator*);
+
+    // Return a negative number, zero, or a positive number if the characters
+    // of the specified 'left' are lexicographically before, the same as, or
+    // after those of the specified 'right', respectively.
+    static int compare(const Rope* left, const Rope* right);
+
+    static bool isRope(const bdld::Datum&, int typeOffset);
+    static bool isRope(const bdld::DatumUdt&, int typeOffset);
+
+    static const Rope* access(const bdld::Datum&);
+    static const Rope* access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(const Rope* rope, int typeOffset);
+};
+
+inline bool Rope::Cursor::done() const {
+    return d_chunk.empty();
+}
+
+inline const bsl::string_view& Rope::Cursor::chunk() const {
+    return d_chunk;
+}
+
+}  // namespace lspcore
+
+#endif
@@ -0,0 +1,579 @@
+#include <bdld_datumarraybuilder.h>
+#include <bsl_algorithm.h>
+#include <bsl_new.h>
+#include <bsl_vector.h>
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+#include <lspcore_rrbvector.h>
+#include <lspcore_userdefinedtypes.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+// Sizes and Seams
+// ===============
+// A branch of height 'h' has children of height 'h - 1', each of which holds
+// at most '32^h' elements. So, the child that contains index 'i' is at
+// position 'i >> (5 * h)' or to its right, and it is exactly there if every
+// child to its left is full. The cumulative sizes of the children say how
+// far to the right to look.
+//
+// 'merge' is the heart of concatenation. It takes two nodes and returns one
+// or two nodes, of the height of the taller argument, that hold the elements
+// of the first followed by those of the second. Below the top, the nodes
+// along the right spine of the first argument and the left spine of the
+// second are merged pairwise, from the bottom up, and their siblings join
+// them as "slots" of the level above. If the slots at a level are more than
+// 'k_EXTRA' more than the fewest that could hold their contents, then the
+// slots from the first one that is not full onward are repacked into full
+// nodes.
+//
+// Every function below takes and returns null pointers for empty vectors,
+// and returns one of its arguments, rather than a copy, wherever the result
+// is unchanged.
+class RrbVectorImpl {
+  public:
+    enum {
+        k_BITS  = RrbVector::k_BITS,
+        k_WIDTH = RrbVector::k_WIDTH,
+        k_EXTRA = 2
+    };
+
+    // 'Nodes' is the result of 'merge': one or two nodes of the same height.
+    struct Nodes {
+        const RrbVector* nodes[2];
+        int              count;
+    };
+
+    static const bdld::Datum* elements(const RrbVector& leaf) {
+        BSLS_ASSERT(leaf.d_height == 0);
+        return leaf.payload<bdld::Datum>();
+    }
+
+    static const RrbVector* const* children(const RrbVector& branch) {
+        BSLS_ASSERT(branch.d_height > 0);
+        return branch.payload<const RrbVector*>();
+    }
+
+    // Return the cumulative sizes of the children of the specified 'branch',
+    // i.e. the number of elements in each child plus those to its left.
+    static const bsl::size_t* sizes(const RrbVector& branch) {
+        return reinterpret_cast<const bsl::size_t*>(children(branch) +
+                                                    branch.d_count);
+    }
+
+    static bsl::size_t size(const RrbVector& node) {
+        return node.d_height ? sizes(node)[node.d_count - 1] : node.d_count;
+    }
+
+    // Return the position of the child of the specified 'branch' that
+    // contains the specified 'index', and load into the specified 'before'
+    // the number of elements in the children to its left.
+    static int childIndex(const RrbVector& branch,
+                          bsl::size_t      index,
+                          bsl::size_t*     before) {
+        const int          shift = k_BITS * branch.d_height;
+        const bsl::size_t* sums  = sizes(branch);
+        int position = shift < int(sizeof(bsl::size_t) * 8)
+                           ? int(bsl::min(index >> shift,
+                                          bsl::size_t(branch.d_count - 1)))
+                           : 0;
+        while (sums[position] <= index) {
+            ++position;
+            BSLS_ASSERT(position < branch.d_count);
+        }
+
+        *before = position ? sums[position - 1] : 0;
+        return position;
+    }
+
+    static const RrbVector* makeLeaf(const bdld::Datum* values,
+                                     int                count,
+                                     bslma::Allocator*  allocator) {
+        BSLS_ASSERT(0 < count && count <= k_WIDTH);
+
+        void* memory =
+            allocator->allocate(sizeof(RrbVector) + count * sizeof(*values));
+        RrbVector*   leaf   = new (memory) RrbVector(0, count);
+        bdld::Datum* output = const_cast<bdld::Datum*>(elements(*leaf));
+        for (int i = 0; i < count; ++i) {
+            new (output + i) bdld::Datum(values[i]);
+        }
+        return leaf;
+    }
+
+    static const RrbVector* makeBranch(int                     height,
+                                       const RrbVector* const* nodes,
+                                       int                     count,
+                                       bslma::Allocator*       allocator) {
+        BSLS_ASSERT(height > 0);
+        BSLS_ASSERT(0 < count && count <= k_WIDTH);
+
+        void* memory = allocator->allocate(
+            sizeof(RrbVector) +
+            count * (sizeof(const RrbVector*) + sizeof(bsl::size_t)));
+        RrbVector*        branch = new (memory) RrbVector(height, count);
+        const RrbVector** output =
+            const_cast<const RrbVector**>(children(*branch));
+        bsl::size_t* sums = const_cast<bsl::size_t*>(sizes(*branch));
+        bsl::size_t  sum  = 0;
+        for (int i = 0; i < count; ++i) {
+            BSLS_ASSERT(nodes[i]->d_height == height - 1);
+            output[i] = nodes[i];
+            sum += size(*nodes[i]);
+            sums[i] = sum;
+        }
+        return branch;
+    }
+
+    // Return a copy of the specified 'branch' having the specified 'child' at
+    // the specified 'position'. If 'position' is the count of 'branch', then
+    // 'child' is appended.
+    static const RrbVector* replaceChild(const RrbVector&  branch,
+                                         int               position,
+                                         const RrbVector*  child,
+                                         bslma::Allocator* allocator) {
+        const RrbVector* nodes[k_WIDTH];
+        bsl::copy(children(branch), children(branch) + branch.d_count, nodes);
+        nodes[position] = child;
+        return makeBranch(branch.d_height,
+                          nodes,
+                          bsl::max(branch.d_count, position + 1),
+                          allocator);
+    }
+
+    // Return a vector of the specified 'height' containing only the
+    // specified 'value'.
+    static const RrbVector* makePath(int                height,
+                                     const bdld::Datum& value,
+                                     bslma::Allocator*  allocator) {
+        const RrbVector* node = makeLeaf(&value, 1, allocator);
+        for (int level = 1; level <= height; ++level) {
+            node = makeBranch(level, &node, 1, allocator);
+        }
+        return node;
+    }
+
+    // Return the specified 'vector' without the branches at its root that
+    // have only one child.
+    static const RrbVector* collapse(const RrbVector* vector) {
+        while (vector && vector->d_height && vector->d_count == 1) {
+            vector = children(*vector)[0];
+        }
+        return vector;
+    }
+
+    static const RrbVector* assoc(const RrbVector&   node,
+                                  bsl::size_t        index,
+                                  const bdld::Datum& value,
+                                  bslma::Allocator*  allocator) {
+        if (!node.d_height) {
+            bdld::Datum values[k_WIDTH];
+            bsl::copy(elements(node), elements(node) + node.d_count, values);
+            values[index] = value;
+            return makeLeaf(values, node.d_count, allocator);
+        }
+
+        bsl::size_t before;
+        const int   position = childIndex(node, index, &before);
+        return replaceChild(
+            node,
+            position,
+            assoc(*children(node)[position], index - before, value, allocator),
+            allocator);
+    }
+
+    // Return the specified 'node' with the specified 'value' appended, or
+    // return a null pointer if 'node' has no room for it.
+    static const RrbVector* pushRight(const RrbVector&   node,
+                                      const bdld::Datum& value,
+                                      bslma::Allocator*  allocator) {
+        if (!node.d_height) {
+            if (node.d_count == k_WIDTH) {
+                return 0;
+            }
+            bdld::Datum values[k_WIDTH];
+            bsl::copy(elements(node), elements(node) + node.d_count, values);
+            values[node.d_count] = value;
+            return makeLeaf(values, node.d_count + 1, allocator);
+        }
+
+        const int last = node.d_count - 1;
+        if (const RrbVector* child =
+                pushRight(*children(node)[last], value, allocator)) {
+            return replaceChild(node, last, child, allocator);
+        }
+        if (node.d_count == k_WIDTH) {
+            return 0;
+        }
+
+        return replaceChild(node,
+                            node.d_count,
+                            makePath(node.d_height - 1, value, allocator),
+                            allocator);
+    }
+
+    // Return the first 'count' elements of the specified 'node', as a node
+    // of the same height. The behavior is undefined unless
+    // '0 < count <= size(node)'.
+    static const RrbVector* take(const RrbVector&  node,
+                                 bsl::size_t       count,
+                                 bslma::Allocator* allocator) {
+        if (count == size(node)) {
+            return &node;
+        }
+        if (!node.d_height) {
+            return makeLeaf(elements(node), int(count), allocator);
+        }
+
+        bsl::size_t before;
+        const int   position = childIndex(node, count - 1, &before);
+        const RrbVector* nodes[k_WIDTH];
+        bsl::copy(children(node), children(node) + position, nodes);
+        nodes[position] =
+            take(*children(node)[position], count - before, allocator);
+        return makeBranch(node.d_height, nodes, position + 1, allocator);
+    }
+
+    // Return the elements of the specified 'node' after the first 'count',
+    // as a node of the same height. The behavior is undefined unless
+    // '0 <= count < size(node)'.
+    static const RrbVector* drop(const RrbVector&  node,
+                                 bsl::size_t       count,
+                                 bslma::Allocator* allocator) {
+        if (count == 0) {
+            return &node;
+        }
+        if (!node.d_height) {
+            return makeLeaf(elements(node) + count,
+                            node.d_count - int(count),
+                            allocator);
+        }
+
+        bsl::size_t before;
+        const int   position = childIndex(node, count, &before);
+        const RrbVector* nodes[k_WIDTH];
+        nodes[0] = drop(*children(node)[position], count - before, allocator);
+        bsl::copy(children(node) + position + 1,
+                  children(node) + node.d_count,
+                  nodes + 1);
+        return makeBranch(
+            node.d_height, nodes, node.d_count - position, allocator);
+    }
+
+    // Repack the specified 'slots', which are 'count' nodes of the specified
+    // 'height', if there are more than 'k_EXTRA' more of them than
+    // necessary. Return the new number of slots.
+    static int rebalance(const RrbVector** slots,
+                         int               count,
+                         int               height,
+                         bslma::Allocator* allocator) {
+        bsl::size_t total = 0;
+        for (int i = 0; i < count; ++i) {
+            total += slots[i]->d_count;
+        }
+        const bsl::size_t fewest = (total + k_WIDTH - 1) / k_WIDTH;
+        if (bsl::size_t(count) <= fewest + k_EXTRA) {
+            return count;
+        }
+
+        // Full slots at the beginning stay as they are.
+        int first = 0;
+        while (slots[first]->d_count == k_WIDTH) {
+            ++first;
+        }
+
+        int result = first;
+        if (height == 0) {
+            bsl::vector<bdld::Datum> values;
+            for (int i = first; i < count; ++i) {
+                values.insert(values.end(),
+                              elements(*slots[i]),
+                              elements(*slots[i]) + slots[i]->d_count);
+            }
+            for (bsl::size_t i = 0; i < values.size(); i += k_WIDTH) {
+                slots[result++] = makeLeaf(
+                    values.data() + i,
+                    int(bsl::min(values.size() - i, bsl::size_t(k_WIDTH))),
+                    allocator);
+            }
+        }
+        else {
+            bsl::vector<const RrbVector*> nodes;
+            for (int i = first; i < count; ++i) {
+                nodes.insert(nodes.end(),
+                             children(*slots[i]),
+                             children(*slots[i]) + slots[i]->d_count);
+            }
+            for (bsl::size_t i = 0; i < nodes.size(); i += k_WIDTH) {
+                slots[result++] = makeBranch(
+                    height,
+                    nodes.data() + i,
+                    int(bsl::min(nodes.size() - i, bsl::size_t(k_WIDTH))),
+                    allocator);
+            }
+        }
+
+        BSLS_ASSERT(bsl::size_t(result) == fewest);
+        return result;
+    }
+
+    static Nodes merge(const RrbVector&  left,
+                       const RrbVector&  right,
+                       bslma::Allocator* allocator) {
+        if (!left.d_height && !right.d_height) {
+            const int count = left.d_count + right.d_count;
+            if (count > k_WIDTH) {
+                const Nodes result = { { &left, &right }, 2 };
+                return result;
+            }
+
+            bdld::Datum values[k_WIDTH];
+            bsl::copy(elements(left), elements(left) + left.d_count, values);
+            bsl::copy(elements(right),
+                      elements(right) + right.d_count,
+                      values + left.d_count);
+            const Nodes result = {
+                { makeLeaf(values, count, allocator), 0 }, 1
+            };
+            return result;
+        }
+
+        // The slots are the children of the taller argument(s), except that
+        // the children along the seam are replaced by their merger.
+        const int        height = bsl::max(left.d_height, right.d_height);
+        const RrbVector* slots[2 * k_WIDTH];
+        int              count = 0;
+
+        const RrbVector* leftSeam = &left;
+        if (left.d_height == height) {
+            count    = left.d_count - 1;
+            leftSeam = children(left)[count];
+            bsl::copy(children(left), children(left) + count, slots);
+        }
+
+        const RrbVector* rightSeam = &right;
+        if (right.d_height == height) {
+            rightSeam = children(right)[0];
+        }
+
+        const Nodes middle = merge(*leftSeam, *rightSeam, allocator);
+        for (int i = 0; i < middle.count; ++i) {
+            slots[count++] = middle.nodes[i];
+        }
+
+        if (right.d_height == height) {
+            count = int(bsl::copy(children(right) + 1,
+                                  children(right) + right.d_count,
+                                  slots + count) -
+                        slots);
+        }
+
+        count = rebalance(slots, count, height - 1, allocator);
+        if (count <= k_WIDTH) {
+            const Nodes result = {
+                { makeBranch(height, slots, count, allocator), 0 }, 1
+            };
+            return result;
+        }
+
+        const RrbVector* const first =
+            makeBranch(height, slots, k_WIDTH, allocator);
+        const RrbVector* const second =
+            makeBranch(height, slots + k_WIDTH, count - k_WIDTH, allocator);
+        const Nodes result = { { first, second }, 2 };
+        return result;
+    }
+};
+
+RrbVector::RrbVector(int height, int count)
+: d_height(height)
+, d_count(count) {
+}
+
+RrbVector::Cursor::Cursor(const RrbVector* vector)
+: d_depth(0)
+, d_leaf(0)
+, d_index(0) {
+    if (vector) {
+        pushLeftSpine(vector);
+    }
+}
+
+void RrbVector::Cursor::pushLeftSpine(const RrbVector* node) {
+    for (; node->height(); node = RrbVectorImpl::children(*node)[0]) {
+        BSLS_ASSERT(d_depth < k_MAX_HEIGHT);
+        d_branches[d_depth] = node;
+        d_indices[d_depth]  = 0;
+        ++d_depth;
+    }
+
+    d_leaf  = node;
+    d_index = 0;
+}
+
+void RrbVector::Cursor::advance() {
+    BSLS_ASSERT(!done());
+
+    if (++d_index < d_leaf->count()) {
+        return;
+    }
+
+    // Go up to the nearest branch that has another child, and then down to
+    // the first leaf of that child.
+    for (; d_depth; --d_depth) {
+        const RrbVector* branch   = d_branches[d_depth - 1];
+        const int        position = ++d_indices[d_depth - 1];
+        if (position < branch->count()) {
+            pushLeftSpine(RrbVectorImpl::children(*branch)[position]);
+            return;
+        }
+    }
+
+    d_leaf = 0;
+}
+
+bsl::size_t RrbVector::size(const RrbVector* vector) {
+    return vector ? RrbVectorImpl::size(*vector) : 0;
+}
+
+const bdld::Datum& RrbVector::nth(const RrbVector* vector, bsl::size_t index) {
+    BSLS_ASSERT(index < size(vector));
+
+    while (vector->height()) {
+        bsl::size_t before;
+        const int   position =
+            RrbVectorImpl::childIndex(*vector, index, &before);
+        vector = RrbVectorImpl::children(*vector)[position];
+        index -= before;
+    }
+
+    return RrbVectorImpl::elements(*vector)[index];
+}
+
+const RrbVector* RrbVector::assoc(const RrbVector*   vector,
+                                  bsl::size_t        index,
+                                  const bdld::Datum& value,
+                                  bslma::Allocator*  allocator) {
+    BSLS_ASSERT(index < size(vector));
+
+    return RrbVectorImpl::assoc(*vector, index, value, allocator);
+}
+
+const RrbVector* RrbVector::push(const RrbVector*   vector,
+                                 const bdld::Datum& value,
+                                 bslma::Allocator*  allocator) {
+    if (!vector) {
+        return RrbVectorImpl::makeLeaf(&value, 1, allocator);
+    }
+
+    if (const RrbVector* result =
+            RrbVectorImpl::pushRight(*vector, value, allocator)) {
+        return result;
+    }
+
+    // The root is full, so the vector grows a level.
+    const RrbVector* nodes[] = {
+        vector, RrbVectorImpl::makePath(vector->height(), value, allocator)
+    };
+    return RrbVectorImpl::makeBranch(
+        vector->height() + 1, nodes, 2, allocator);
+}
+
+const RrbVector* RrbVector::concatenate(const RrbVector*  left,
+                                        const RrbVector*  right,
+                                        bslma::Allocator* allocator) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+
+    const RrbVectorImpl::Nodes merged =
+        RrbVectorImpl::merge(*left, *right, allocator);
+    if (merged.count == 1) {
+        return RrbVectorImpl::collapse(merged.nodes[0]);
+    }
+
+    return RrbVectorImpl::makeBranch(
+        merged.nodes[0]->height() + 1, merged.nodes, 2, allocator);
+}
+
+const RrbVector* RrbVector::slice(const RrbVector*  vector,
+                                  bsl::size_t       begin,
+                                  bsl::size_t       end,
+                                  bslma::Allocator* allocator) {
+    BSLS_ASSERT(begin <= end);
+    BSLS_ASSERT(end <= size(vector));
+
+    if (begin == end) {
+        return 0;
+    }
+
+    const RrbVector* taken = RrbVectorImpl::take(*vector, end, allocator);
+    return RrbVectorImpl::collapse(
+        RrbVectorImpl::drop(*taken, begin, allocator));
+}
+
+const RrbVector* RrbVector::fromRange(const bdld::Datum* begin,
+                                      const bdld::Datum* end,
+                                      bslma::Allocator*  allocator) {
+    // Build the leaves, and then each level of branches above them, until
+    // there is only one node.
+    const bsl::size_t             length = end - begin;
+    bsl::vector<const RrbVector*> level;
+    for (bsl::size_t i = 0; i < length; i += k_WIDTH) {
+        const int count = int(bsl::min(length - i, bsl::size_t(k_WIDTH)));
+        level.push_back(RrbVectorImpl::makeLeaf(begin + i, count, allocator));
+    }
+
+    for (int height = 1; level.size() > 1; ++height) {
+        bsl::size_t next = 0;
+        for (bsl::size_t i = 0; i < level.size(); i += k_WIDTH) {
+            const int count =
+                int(bsl::min(level.size() - i, bsl::size_t(k_WIDTH)));
+            level[next++] = RrbVectorImpl::makeBranch(
+                height, level.data() + i, count, allocator);
+        }
+        level.resize(next);
+    }
+
+    return level.empty() ? 0 : level.front();
+}
+
+bdld::Datum RrbVector::toArray(const RrbVector*  vector,
+                               bslma::Allocator* allocator) {
+    bdld::DatumArrayBuilder builder(size(vector), allocator);
+    for (Cursor cursor(vector); !cursor.done(); cursor.advance()) {
+        builder.pushBack(cursor.value());
+    }
+
+    return builder.commit();
+}
+
+bool RrbVector::isRrbVector(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && isRrbVector(datum.theUdt(), typeOffset);
+}
+
+bool RrbVector::isRrbVector(const bdld::DatumUdt& udt, int typeOffset) {
+    return udt.type() == UserDefinedTypes::e_RRB_VECTOR + typeOffset;
+}
+
+const RrbVector* RrbVector::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+const RrbVector* RrbVector::access(const bdld::DatumUdt& udt) {
+    return static_cast<const RrbVector*>(udt.data());
+}
+
+bdld::Datum RrbVector::create(const RrbVector* vector, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(vector)),
+        UserDefinedTypes::e_RRB_VECTOR + typeOffset);
+}
+
+}  // namespace lspcore
@@ -0,0 +1,163 @@
+#ifndef INCLUDED_LSPCORE_RRBVECTOR
+#define INCLUDED_LSPCORE_RRBVECTOR
+
+// An RRB vector is an immutable sequence of values indexed from zero, stored
+// as a "relaxed radix balanced" tree (Bagwell and Rompf, "RRB-Trees:
+// Efficient Immutable Vectors," 2011). Whereas replacing or appending an
+// element of a 'bdld' array copies the whole array, an RRB vector copies
+// only the path from the root to the affected element, so 'nth', 'assoc',
+// and 'push' take O(log32 n) time, as do 'concatenate' and 'slice'.
+//
+// Each 'RrbVector' node is either a "leaf," which holds up to 32 elements, or
+// a "branch," which holds up to 32 children. Every leaf is at the same depth.
+// A vector built by 'fromRange' or by 'push' is packed to the left, so that
+// the child containing a given index could be found by dividing the index by
+// a power of 32. Concatenation and slicing leave some nodes less than full,
+// though, so each branch also stores the cumulative sizes of its children.
+// Lookup guesses the child by division, which is never past the right child,
+// and then steps right until the sizes say it has arrived. Concatenation
+// merges the nodes along the seam between its operands, and repacks them only
+// when there would otherwise be more than two nodes more than necessary at a
+// level, which bounds the number of steps.
+//
+// An RRB vector is represented as a pointer to its root 'RrbVector' node. A
+// null pointer denotes an empty vector. No node is empty, and the root is
+// never a branch with only one child.
+
+#include <bdld_datum.h>
+#include <bsl_cstddef.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+class RrbVector {
+  public:
+    enum { k_BITS = 5, k_WIDTH = 1 << k_BITS };
+
+  private:
+    // A node is allocated together with its "payload," which follows it in
+    // memory: 'count' elements for a leaf, or 'count' child pointers followed
+    // by 'count' cumulative sizes for a branch. See 'RrbVector::payload'.
+    int d_height;  // zero for a leaf, or one more than that of the children
+    int d_count;   // number of elements or children
+
+    RrbVector(int height, int count);
+
+    template <typename Payload>
+    const Payload* payload() const;
+
+    friend class RrbVectorImpl;
+
+  public:
+    // 'Cursor' visits the elements of an 'RrbVector' in order without
+    // allocating memory.
+    class Cursor {
+        // The height of a vector of 'n' elements built by 'fromRange' or
+        // 'push' is at most log32(n), which is less than 13. Relaxed nodes add
+        // little to that.
+        enum { k_MAX_HEIGHT = 16 };
+
+        const RrbVector* d_branches[k_MAX_HEIGHT];
+        int              d_indices[k_MAX_HEIGHT];  // current child of each
+        int              d_depth;
+        const RrbVector* d_leaf;                   // null when done
+        int              d_index;                  // current element of leaf
+
+        void pushLeftSpine(const RrbVector*);
+
+      public:
+        explicit Cursor(const RrbVector* vector);
+
+        bool               done() const;
+        const bdld::Datum& value() const;
+        void               advance();
+    };
+
+    int height() const;
+    int count() const;
+
+    static bsl::size_t size(const RrbVector*);
+
+    // Return the element of the specified 'vector' at the specified
+    // 'index'. The behavior is undefined unless 'index < size(vector)'.
+    static const bdld::Datum& nth(const RrbVector* vector, bsl::size_t index);
+
+    // Return a vector like the specified 'vector', but having the specified
+    // 'value' at the specified 'index'. The behavior is undefined unless
+    // 'index < size(vector)'.
+    static const RrbVector* assoc(const RrbVector*   vector,
+                                  bsl::size_t        index,
+                                  const bdld::Datum& value,
+                                  bslma::Allocator*);
+
+    // Return a vector of the elements of the specified 'vector' followed by
+    // the specified 'value'.
+    static const RrbVector* push(const RrbVector*   vector,
+                                 const bdld::Datum& value,
+                                 bslma::Allocator*);
+
+    // Return a vector of the elements of the specified 'left' followed by the
+    // elements of the specified 'right'. All but O(log n) of the nodes of the
+    // result are shared with the operands.
+    static const RrbVector* concatenate(const RrbVector* left,
+                                        const RrbVector* right,
+                                        bslma::Allocator*);
+
+    // Return a vector of the elements of the specified 'vector' at indices
+    // from the specified 'begin' up to but not including the specified
+    // 'end'. The behavior is undefined unless
+    // 'begin <= end && end <= size(vector)'.
+    static const RrbVector* slice(const RrbVector* vector,
+                                  bsl::size_t      begin,
+                                  bsl::size_t      end,
+                                  bslma::Allocator*);
+
+    // Return a vector of the values in the specified range '[begin, end)'.
+    // Every node of the result is full, except for those at the right edge.
+    static const RrbVector* fromRange(const bdld::Datum* begin,
+                                      const bdld::Datum* end,
+                                      bslma::Allocator*);
+
+    // Return a 'bdld' array of the elements of the specified 'vector'.
+    static bdld::Datum toArray(const RrbVector* vector, bslma::Allocator*);
+
+    static bool isRrbVector(const bdld::Datum&, int typeOffset);
+    static bool isRrbVector(const bdld::DatumUdt&, int typeOffset);
+
+    static const RrbVector* access(const bdld::Datum&);
+    static const RrbVector* access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(const RrbVector* vector, int typeOffset);
+};
+
+template <typename Payload>
+inline const Payload* RrbVector::payload() const {
+    return reinterpret_cast<const Payload*>(this + 1);
+}
+
+inline int RrbVector::height() const {
+    return d_height;
+}
+
+inline int RrbVector::count() const {
+    return d_count;
+}
+
+inline bool RrbVector::Cursor::done() const {
+    return d_leaf == 0;
+}
+
+inline const bdld::Datum& RrbVector::Cursor::value() const {
+    return d_leaf->payload<bdld::Datum>()[d_index];
+}
+
+}  // namespace lspcore
+
+#endif
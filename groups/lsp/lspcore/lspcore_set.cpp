@@ -1,8 +1,13 @@
 #include <bdlb_arrayutil.h>
+#include <bdlmt_threadpool.h>
 #include <bsl_algorithm.h>
-#include <bsl_vector.h>
+#include <bsl_exception.h>
+#include <bsl_functional.h>
+#include <bsl_limits.h>
 #include <bslma_allocator.h>
+#include <bslmt_latch.h>
 #include <bsls_assert.h>
+#include <bsls_atomic.h>
 #include <lspcore_listutil.h>
 #include <lspcore_set.h>
 #include <lspcore_userdefinedtypes.h>
@@ -175,31 +180,188 @@ const Set* balance(const Set* set, bslma::Allocator* allocator) {
     }
 }
 
-const Set* insertNew(const Set*             set,
-                     const bdld::Datum&     value,
-                     const Set::Comparator& before,
-                     bslma::Allocator*      allocator) {
-    if (!set) {
-        return new (*allocator) Set(value, 0, 0);
+// Split and Join
+// ==============
+// 'join(left, value, right)' returns a set of the elements of 'left', then
+// 'value', then the elements of 'right', where every element of 'left' is
+// before 'value' and every element of 'right' is after it. If the heights of
+// 'left' and 'right' differ by at most one, then 'value' becomes the root.
+// Otherwise, we walk down the inner spine of the taller tree until we find a
+// subtree no more than one taller than the shorter tree, put 'value' there,
+// and rebalance on the way back up. Each rebalancing involves at most a
+// height difference of two, which is what 'balance' expects.
+//
+// 'split(set, value)' returns the elements of 'set' before 'value', the
+// elements after 'value', and the node equivalent to 'value', if any. It
+// follows the search path for 'value', and joins the subtrees that hang off
+// of the path onto one side or the other.
+
+const Set* joinRight(const Set*         left,
+                     const bdld::Datum& value,
+                     const Set*         right,
+                     bslma::Allocator*  allocator) {
+    // 'left' is the taller tree.
+    if (Set::height(left) <= Set::height(right) + 1) {
+        return new (*allocator) Set(value, left, right);
     }
 
-    if (before(value, set->value())) {
-        return balance(new (*allocator) Set(
-                           set->value(),
-                           insertNew(set->left(), value, before, allocator),
-                           set->right()),
-                       allocator);
+    return balance(
+        new (*allocator)
+            Set(left->value(),
+                left->left(),
+                joinRight(left->right(), value, right, allocator)),
+        allocator);
+}
+
+const Set* joinLeft(const Set*         left,
+                    const bdld::Datum& value,
+                    const Set*         right,
+                    bslma::Allocator*  allocator) {
+    // 'right' is the taller tree.
+    if (Set::height(right) <= Set::height(left) + 1) {
+        return new (*allocator) Set(value, left, right);
     }
 
-    if (before(set->value(), value)) {
-        return balance(new (*allocator) Set(
-                           set->value(),
-                           set->left(),
-                           insertNew(set->right(), value, before, allocator)),
-                       allocator);
+    return balance(new (*allocator)
+                       Set(right->value(),
+                           joinLeft(left, value, right->left(), allocator),
+                           right->right()),
+                   allocator);
+}
+
+// Set Algebra
+// ===========
+// Each operation splits the right operand by the root of the left operand,
+// and then applies itself to the two pairs of halves. A node of the left
+// operand is reused in the result if its value and both of its subtrees are
+// unchanged. The pairs are independent, so when a thread pool is available
+// and the operands are large, the pair of left halves is handed to the pool
+// while the current thread works on the pair of right halves.
+//
+// Only the thread that called the operation forks. Jobs run on the pool
+// without a pool of their own, so no thread ever waits for a job that is
+// queued behind it, and the operation cannot deadlock however few threads
+// the pool has. The calling thread forks at each level of its descent, so the
+// work is divided into pieces of one half, one quarter, one eighth, etc.
+
+// The token to give the next 'Set::Transient'. See 'Set::Transient::newOwner'.
+bsls::AtomicUint s_nextOwner(1);
+
+// Operands whose smaller height is below this are not worth forking for. An
+// AVL tree of height 14 has at least 986 elements.
+enum { k_PARALLEL_MIN_HEIGHT = 14 };
+
+// 'ForkedJob' runs a job on a thread pool, and signals a latch when it is
+// done.
+class ForkedJob {
+    const bsl::function<void()>* d_job_p;
+    bsl::exception_ptr           d_exception;
+    bslmt::Latch                 d_latch;
+
+  public:
+    explicit ForkedJob(const bsl::function<void()>& job)
+    : d_job_p(&job)
+    , d_latch(1) {
     }
 
-    return set;
+    void operator()() {
+        try {
+            (*d_job_p)();
+        }
+        catch (...) {
+            d_exception = bsl::current_exception();
+        }
+        d_latch.arrive();
+    }
+
+    // Wait for the job to finish, and then rethrow its exception, if any.
+    void join() {
+        d_latch.wait();
+        if (d_exception) {
+            bsl::rethrow_exception(d_exception);
+        }
+    }
+
+    // Wait for the job to finish, ignoring its outcome.
+    void abandon() {
+        d_latch.wait();
+    }
+};
+
+}  // namespace
+
+Set::Set(const bdld::Datum& value, const Set* left, const Set* right)
+: d_value(value)
+, d_owner(0) {
+    reset(left, right);
+}
+
+Set::Set(const bdld::Datum& value,
+         const Set*         left,
+         const Set*         right,
+         unsigned           owner)
+: d_value(value)
+, d_owner(owner) {
+    reset(left, right);
+}
+
+void Set::reset(const Set* left, const Set* right) {
+    const bsl::size_t count = size(left) + 1 + size(right);
+    // Make sure that 'count' fits in 'd_size'.
+    BSLS_ASSERT_OPT(unsigned(count) == count);
+
+    d_left  = left;
+    d_right = right;
+    d_size  = unsigned(count);
+    setHeight(bsl::max(height(left), height(right)) + 1);
+}
+
+Set::Cursor::Cursor(const Set* set)
+: d_depth(0) {
+    pushLeftSpine(set);
+}
+
+void Set::Cursor::pushLeftSpine(const Set* node) {
+    for (; node; node = node->left()) {
+        BSLS_ASSERT(d_depth < k_MAX_HEIGHT);
+        d_stack[d_depth++] = node;
+    }
+}
+
+const bdld::Datum& Set::Cursor::value() const {
+    BSLS_ASSERT(!done());
+    return d_stack[d_depth - 1]->value();
+}
+
+void Set::Cursor::advance() {
+    BSLS_ASSERT(!done());
+    pushLeftSpine(d_stack[--d_depth]->right());
+}
+
+void Set::setHeight(int height) {
+#ifdef BSLS_PLATFORM_CPU_32_BIT
+    d_height = height;
+#else
+    // Make sure that 'height' fits in six bits.
+    BSLS_ASSERT_OPT((0x3F & height) == height);
+
+    // Bottom three bits go to the low end of 'd_right'. Next three bits go to
+    // the low end of 'd_left', i.e.
+    //
+    //     d_left bits:     _ _ _ _ _ ... a b c
+    //     d_right bits:    _ _ _ _ _ ... d e f
+    //     height bits:     ... _ _ a b c d e f
+    //
+    d_right = asPtr(asInt(d_right) | (height & 7));
+    d_left  = asPtr(asInt(d_left) | ((height >> 3) & 7));
+#endif
+}
+
+const Set* Set::balanced(const bdld::Datum& value,
+                         const Set*         left,
+                         const Set*         right,
+                         bslma::Allocator*  allocator) {
+    return balance(new (*allocator) Set(value, left, right), allocator);
 }
 
 // 'removalSubtree' is the part of 'remove' where we've already found the node
@@ -210,8 +372,9 @@ const Set* insertNew(const Set*             set,
 // root of the subtree, where it instead is the left child), and where
 // 'replacement' is the node whose value will replace the value being removed,
 // i.e. the in-order predecessor of the removed value.
-bsl::pair<const Set*, const Set*> removalSubtree(const Set*        set,
-                                                 bslma::Allocator* allocator) {
+bsl::pair<const Set*, const Set*> Set::removalSubtree(
+    const Set*        set,
+    bslma::Allocator* allocator) {
     BSLS_ASSERT_OPT(set);
 
     if (!set->right()) {
@@ -234,126 +397,367 @@ bsl::pair<const Set*, const Set*> removalSubtree(const Set*        set,
         replacement);
 }
 
-const Set* removeExisting(const Set*             set,
-                          const bdld::Datum&     value,
-                          const Set::Comparator& before,
-                          bslma::Allocator*      allocator) {
-    if (!set) {
-        return set;
+// Return the specified 'set' itself if it is owned by the specified 'owner',
+// so that it can be modified in place. Otherwise, return a copy of 'set' that
+// is owned by 'owner'. A zero 'owner' owns nothing.
+Set* Set::edit(const Set* set, unsigned owner, bslma::Allocator* allocator) {
+    BSLS_ASSERT(set);
+
+    if (owner && set->d_owner == owner) {
+        // Nodes are never created 'const', and nothing outside of the owning
+        // transient refers to this one, so this is safe.
+        return const_cast<Set*>(set);
     }
 
-    if (before(value, set->value())) {
-        return balance(
-            new (*allocator)
-                Set(set->value(),
-                    removeExisting(set->left(), value, before, allocator),
-                    set->right()),
-            allocator);
+    return new (*allocator)
+        Set(set->value(), set->left(), set->right(), owner);
+}
+
+// 'rotateRightOwned', 'rotateLeftOwned', 'balanceOwned', and
+// 'removalSubtreeOwned' are like 'rotateRight', 'rotateLeft', 'balance', and
+// 'removalSubtree', respectively, except that they modify the nodes owned by
+// 'owner' instead of allocating new ones. Since a node might be modified, its
+// children are read before it is.
+
+Set* Set::rotateRightOwned(const Set*        set,
+                           unsigned          owner,
+                           bslma::Allocator* allocator) {
+    const Set* A = set;
+    BSLS_ASSERT_OPT(A);
+    const Set* B    = A->left();
+    const Set* high = A->right();
+    BSLS_ASSERT_OPT(B);
+    const Set* low    = B->left();
+    const Set* middle = B->right();
+
+    Set* const Aout = edit(A, owner, allocator);
+    Set* const Bout = edit(B, owner, allocator);
+    Aout->reset(middle, high);
+    Bout->reset(low, Aout);
+    return Bout;
+}
+
+Set* Set::rotateLeftOwned(const Set*        set,
+                          unsigned          owner,
+                          bslma::Allocator* allocator) {
+    const Set* B = set;
+    BSLS_ASSERT_OPT(B);
+    const Set* low = B->left();
+    const Set* A   = B->right();
+    BSLS_ASSERT_OPT(A);
+    const Set* middle = A->left();
+    const Set* high   = A->right();
+
+    Set* const Bout = edit(B, owner, allocator);
+    Set* const Aout = edit(A, owner, allocator);
+    Bout->reset(low, middle);
+    Aout->reset(Bout, high);
+    return Aout;
+}
+
+const Set* Set::balanceOwned(Set*              set,
+                             unsigned          owner,
+                             bslma::Allocator* allocator) {
+    BSLS_ASSERT(set);
+
+    switch (const int diff = heightDiff(set)) {
+        case 2:
+            if (heightDiff(set->right()) == -1) {
+                // right-leaning special case
+                set->reset(set->left(),
+                           rotateRightOwned(set->right(), owner, allocator));
+            }
+            return rotateLeftOwned(set, owner, allocator);
+        case -2:
+            if (heightDiff(set->left()) == 1) {
+                // left-leaning special case
+                set->reset(rotateLeftOwned(set->left(), owner, allocator),
+                           set->right());
+            }
+            return rotateRightOwned(set, owner, allocator);
+        default:
+            (void)diff;
+            BSLS_ASSERT(diff == 0 || diff == 1 || diff == -1);
+            return set;
     }
+}
+
+bsl::pair<const Set*, const Set*> Set::removalSubtreeOwned(
+    const Set*        set,
+    unsigned          owner,
+    bslma::Allocator* allocator) {
+    BSLS_ASSERT_OPT(set);
 
-    if (before(set->value(), value)) {
-        return balance(
-            new (*allocator)
-                Set(set->value(),
-                    set->left(),
-                    removeExisting(set->right(), value, before, allocator)),
-            allocator);
+    if (!set->right()) {
+        return bsl::make_pair(set->left(), set);
     }
 
-    // We found the node to remove. There are three cases:
-    // - No children? Return null.
-    // - One child? Return it.
-    // - Two children? Put your pants on.
-    if (!set->left() && !set->right()) {
+    const bsl::pair<const Set*, const Set*> results =
+        removalSubtreeOwned(set->right(), owner, allocator);
+    Set* const node = edit(set, owner, allocator);
+    node->reset(set->left(), results.first);
+    return bsl::make_pair(balanceOwned(node, owner, allocator),
+                          results.second);
+}
+
+// Return a perfectly balanced set of the values in the specified range
+// '[begin, end)', which must be strictly increasing.
+const Set* Set::buildBalanced(const bdld::Datum* begin,
+                              const bdld::Datum* end,
+                              bslma::Allocator*  allocator) {
+    if (begin == end) {
         return 0;
     }
-    if (!set->left()) {
-        return set->right();
+
+    const bdld::Datum* const middle = begin + (end - begin) / 2;
+    return new (*allocator) Set(*middle,
+                                buildBalanced(begin, middle, allocator),
+                                buildBalanced(middle + 1, end, allocator));
+}
+
+const Set* Set::join(const Set*         left,
+                     const bdld::Datum& value,
+                     const Set*         right,
+                     bslma::Allocator*  allocator) {
+    if (height(left) > height(right) + 1) {
+        return joinRight(left, value, right, allocator);
     }
-    if (!set->right()) {
-        return set->left();
+
+    if (height(right) > height(left) + 1) {
+        return joinLeft(left, value, right, allocator);
+    }
+
+    return new (*allocator) Set(value, left, right);
+}
+
+// Return the result of joining the specified 'left' and 'right' about the
+// value of the specified 'node', or return 'node' itself if 'left' and 'right'
+// are its children.
+const Set* Set::rejoin(const Set*        node,
+                       const Set*        left,
+                       const Set*        right,
+                       bslma::Allocator* allocator) {
+    if (left == node->left() && right == node->right()) {
+        return node;
+    }
+
+    return join(left, node->value(), right, allocator);
+}
+
+// Return a set of the elements of the specified 'left' followed by the
+// elements of the specified 'right', where every element of 'left' is before
+// every element of 'right'.
+const Set* Set::concatenate(const Set*        left,
+                            const Set*        right,
+                            bslma::Allocator* allocator) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
     }
 
-    // We can pick either the in-order predecessor or the in-order successor.
-    // There's probably a clever choice that minimizes tree rotations, but
-    // let's just pick the in-order predecessor. That node will replace this
-    // one, and we reparent stuff so the tree remains correct, while
-    // rebalancing as needed.
+    // Remove the greatest element of 'left' and use it to join the two.
     const bsl::pair<const Set*, const Set*> results =
-        removalSubtree(set->left(), allocator);
-    const Set* const leftChild   = results.first;
-    const Set* const predecessor = results.second;
-    return balance(new (*allocator)
-                       Set(predecessor->value(), leftChild, set->right()),
-                   allocator);
+        removalSubtree(left, allocator);
+    const Set* const rest     = results.first;
+    const Set* const greatest = results.second;
+    return join(rest, greatest->value(), right, allocator);
 }
 
-}  // namespace
+// Return whether an operation on the specified 'first' and 'second' should
+// be run as a job on the specified 'threadPool'.
+bool Set::shouldFork(bdlmt::ThreadPool* threadPool,
+                     const Set*         first,
+                     const Set*         second) {
+    return threadPool &&
+           bsl::min(height(first), height(second)) >= k_PARALLEL_MIN_HEIGHT;
+}
 
-Set::Set(const bdld::Datum& value, const Set* left, const Set* right)
-: d_value(value)
-, d_left(left)
-, d_right(right) {
-    setHeight(bsl::max(height(left), height(right)) + 1);
+// Run the specified 'forked' on the specified 'threadPool' while running the
+// specified 'local' on this thread, and return when both have finished. If
+// either throws an exception, rethrow it. If 'threadPool' does not accept the
+// job (e.g. because it is shutting down), run both on this thread.
+void Set::forkJoin(bdlmt::ThreadPool*           threadPool,
+                   const bsl::function<void()>& forked,
+                   const bsl::function<void()>& local) {
+    ForkedJob job(forked);
+    if (threadPool->enqueueJob(bsl::ref(job)) != 0) {
+        forked();
+        local();
+        return;
+    }
+
+    try {
+        local();
+    }
+    catch (...) {
+        // 'job' refers to this stack frame, so it must finish first.
+        job.abandon();
+        throw;
+    }
+    job.join();
 }
 
-void Set::setHeight(int height) {
-#ifdef BSLS_PLATFORM_CPU_32_BIT
-    d_height = height;
-#else
-    // Make sure that 'height' fits in six bits.
-    BSLS_ASSERT_OPT((0x3F & height) == height);
+unsigned Set::Transient::newOwner() {
+    // Tokens count up from one, and stop at the largest 'unsigned' rather than
+    // wrapping around, so no two transients ever share a token.
+    unsigned owner = s_nextOwner.loadRelaxed();
+    for (;;) {
+        if (owner == bsl::numeric_limits<unsigned>::max()) {
+            return 0;
+        }
+
+        const unsigned previous = s_nextOwner.testAndSwap(owner, owner + 1);
+        if (previous == owner) {
+            return owner;
+        }
+        owner = previous;
+    }
+}
 
-    // Bottom three bits go to the low end of 'd_right'. Next three bits go to
-    // the low end of 'd_left', i.e.
-    //
-    //     d_left bits:     _ _ _ _ _ ... a b c
-    //     d_right bits:    _ _ _ _ _ ... d e f
-    //     height bits:     ... _ _ a b c d e f
-    //
-    d_right = asPtr(asInt(d_right) | (height & 7));
-    d_left  = asPtr(asInt(d_left) | ((height >> 3) & 7));
-#endif
+Set::Transient::Transient(const Set* set, bslma::Allocator* allocator)
+: d_root(set)
+, d_owner(newOwner())
+, d_persisted(false)
+, d_allocator_p(allocator) {
+}
+
+const Set* Set::Transient::persist() {
+    // Forgetting the token is enough. Since tokens are never reused, no
+    // transient will modify the nodes owned by this one.
+    d_owner     = 0;
+    d_persisted = true;
+    return d_root;
+}
+
+bool Set::Transient::isTransient(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && datum.theUdt().type() ==
+                                UserDefinedTypes::e_SET_TRANSIENT + typeOffset;
+}
+
+Set::Transient* Set::Transient::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+Set::Transient* Set::Transient::access(const bdld::DatumUdt& udt) {
+    return static_cast<Transient*>(udt.data());
+}
+
+bdld::Datum Set::Transient::create(Transient* transient, int typeOffset) {
+    return bdld::Datum::createUdt(transient,
+                                  UserDefinedTypes::e_SET_TRANSIENT +
+                                      typeOffset);
 }
 
+// The following overloads instantiate the templates for the type-erased
+// 'Comparator'.
+
 const Set* Set::insert(const Set*         set,
                        const bdld::Datum& value,
                        const Comparator&  before,
                        bslma::Allocator*  allocator) {
-    if (Set::contains(set, value, before)) {
-        return set;
-    }
+    return insert<Comparator>(set, value, before, allocator);
+}
 
-    return insertNew(set, value, before, allocator);
+const Set* Set::fromRange(const bdld::Datum* begin,
+                          const bdld::Datum* end,
+                          const Comparator&  before,
+                          bslma::Allocator*  allocator) {
+    return fromRange<Comparator>(begin, end, before, allocator);
 }
 
 bool Set::contains(const Set*         set,
                    const bdld::Datum& value,
                    const Comparator&  before) {
-    if (!set) {
-        return false;
-    }
-
-    if (before(value, set->value())) {
-        return contains(set->left(), value, before);
-    }
-
-    if (before(set->value(), value)) {
-        return contains(set->right(), value, before);
-    }
-
-    return true;
+    return contains<Comparator>(set, value, before);
 }
 
 const Set* Set::remove(const Set*         set,
                        const bdld::Datum& value,
                        const Comparator&  before,
                        bslma::Allocator*  allocator) {
-    if (!Set::contains(set, value, before)) {
-        return set;
+    return remove<Comparator>(set, value, before, allocator);
+}
+
+const Set* Set::unite(const Set*         left,
+                      const Set*         right,
+                      const Comparator&  before,
+                      bslma::Allocator*  allocator,
+                      bdlmt::ThreadPool* threadPool) {
+    return unite<Comparator>(left, right, before, allocator, threadPool);
+}
+
+const Set* Set::intersect(const Set*         left,
+                          const Set*         right,
+                          const Comparator&  before,
+                          bslma::Allocator*  allocator,
+                          bdlmt::ThreadPool* threadPool) {
+    return intersect<Comparator>(left, right, before, allocator, threadPool);
+}
+
+const Set* Set::subtract(const Set*         left,
+                         const Set*         right,
+                         const Comparator&  before,
+                         bslma::Allocator*  allocator,
+                         bdlmt::ThreadPool* threadPool) {
+    return subtract<Comparator>(left, right, before, allocator, threadPool);
+}
+
+bool Set::isSubset(const Set*        subset,
+                   const Set*        superset,
+                   const Comparator& before) {
+    return isSubset<Comparator>(subset, superset, before);
+}
+
+void Set::Transient::insert(const bdld::Datum& value,
+                            const Comparator&  before) {
+    insert<Comparator>(value, before);
+}
+
+void Set::Transient::remove(const bdld::Datum& value,
+                            const Comparator&  before) {
+    remove<Comparator>(value, before);
+}
+
+const bdld::Datum& Set::nth(const Set* set, bsl::size_t index) {
+    for (;;) {
+        BSLS_ASSERT(index < size(set));
+
+        const bsl::size_t leftSize = size(set->left());
+        if (index == leftSize) {
+            return set->value();
+        }
+        if (index < leftSize) {
+            set = set->left();
+        }
+        else {
+            index -= leftSize + 1;
+            set = set->right();
+        }
     }
+}
 
-    return removeExisting(set, value, before, allocator);
+bsl::size_t Set::rank(const Set*         set,
+                      const bdld::Datum& value,
+                      const Comparator&  before) {
+    return rank<Comparator>(set, value, before);
+}
+
+bsl::size_t Set::countInRange(const Set*         set,
+                              const bdld::Datum& low,
+                              const bdld::Datum& high,
+                              const Comparator&  before) {
+    return countInRange<Comparator>(set, low, high, before);
+}
+
+const Set* Set::range(const Set*         set,
+                      const bdld::Datum& low,
+                      const bdld::Datum& high,
+                      const Comparator&  before,
+                      bslma::Allocator*  allocator) {
+    return range<Comparator>(set, low, high, before, allocator);
 }
 
 bdld::Datum Set::toList(const Set*        set,
@@ -373,6 +777,11 @@ bdld::Datum Set::toList(const Set*        set,
         elements, bdlb::ArrayUtil::end(elements), typeOffset, allocator);
 }
 
+bool Set::isSet(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() &&
+           datum.theUdt().type() == UserDefinedTypes::e_SET + typeOffset;
+}
+
 const Set* Set::access(const bdld::Datum& datum) {
     BSLS_ASSERT(datum.isUdt());
     return access(datum.theUdt());
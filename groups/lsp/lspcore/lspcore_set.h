@@ -10,7 +10,11 @@
 // 'Set' objects cache the maximum height of the subtrees below them (plus
 // one). On 64-bit systems, this height is stored in the lower bits of the
 // 'left' and 'right' pointer members of the 'Set'. On 32-bit systems, the
-// height is stored in its own integer.
+// height is stored in its own integer. Each 'Set' also stores the number of
+// elements in its subtree, so that the element at a given position, and the
+// position of a given element, can be found in O(log n) time. The count is
+// an 'unsigned', which leaves room for the owner token described below
+// without making the node any larger.
 //
 // 'Set' partitions its elements into equivalency classes based on a specified
 // comparator predicate 'before'. For elements 'a' and 'b':
@@ -20,14 +24,51 @@
 // - 'a' and 'b' are equivalent if neither 'before(a, b)' nor 'before(b, a)'.
 //
 // The comparator ('before') is an additional argument to functions that need
-// it.
+// it. Functions that take a comparator are templates on its type, so that a
+// comparator such as 'DatumUtil::LessThan' can be inlined into the tree
+// traversal, and each visited node costs one call to 'before' (or, for
+// 'DatumUtil::LessThan', one call to its three-way 'compare') rather than
+// two indirect calls through a 'bsl::function'. Each has a non-template
+// overload taking a type-erased 'Comparator', for use with user-supplied
+// comparators.
+//
+// The set operations 'unite', 'intersect', and 'subtract' are implemented in
+// terms of two primitives: "split," which divides a set into the elements
+// before and after a given value, and "join," which concatenates two sets
+// whose elements are separated by a given value, rebalancing along only one
+// spine. Following Blelloch, Ferizovic, and Sun, "Just Join for Parallel
+// Ordered Sets" (2016), each operation splits one operand by the root of the
+// other and recurses on the two halves, which takes O(m log(n/m + 1)) time
+// for operands of sizes 'm <= n'. Subtrees that the operation does not touch
+// are shared with the operands. Since the two recursive calls are
+// independent, they can run concurrently on a thread pool.
+//
+// A 'Set::Transient' builds a set by inserting and removing elements in place.
+// Each 'Set' node records the "owner" token of the transient that allocated
+// it, if any. A transient modifies the nodes that it owns directly, and
+// copies any other node before modifying it, so that the sets it started
+// from are unchanged. Once a node has been copied, later modifications reuse
+// the copy, so building a set of n elements by repeated insertion allocates
+// O(n) nodes, rather than the O(n log n) nodes that repeated 'Set::insert'
+// allocates. 'Set::Transient::persist' ends the transient, after which none
+// of its nodes are ever modified again, and the result is an ordinary set.
+// Owner tokens are never reused.
 
 #include <bdld_datum.h>
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
 #include <bsl_functional.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+#include <bsls_assert.h>
 #include <bsls_platform.h>
 #include <bsls_types.h>
+#include <lspcore_datumutil.h>
 
 namespace BloombergLP {
+namespace bdlmt {
+class ThreadPool;
+}  // namespace bdlmt
 namespace bslma {
 class Allocator;
 }  // namespace bslma
@@ -35,6 +76,7 @@ class Allocator;
 
 namespace lspcore {
 namespace bdld  = BloombergLP::bdld;
+namespace bdlmt = BloombergLP::bdlmt;
 namespace bslma = BloombergLP::bslma;
 namespace bsls  = BloombergLP::bsls;
 
@@ -42,6 +84,8 @@ class Set {
     bdld::Datum d_value;
     const Set*  d_left;
     const Set*  d_right;
+    unsigned    d_size;   // number of elements in this subtree
+    unsigned    d_owner;  // token of the owning 'Transient', or zero
 
 #ifdef BSLS_PLATFORM_CPU_32_BIT
     int d_height;
@@ -52,41 +96,399 @@ class Set {
 
     void setHeight(int);
 
+    Set(const bdld::Datum& value,
+        const Set*         left,
+        const Set*         right,
+        unsigned           owner);
+
+    // Replace the children of this node with the specified 'left' and
+    // 'right', and update its height and size accordingly.
+    void reset(const Set* left, const Set* right);
+
   public:
+    typedef bsl::function<bool(const bdld::Datum&, const bdld::Datum&)>
+        Comparator;
+
+    // 'Cursor' visits the elements of a 'Set' in order without allocating
+    // memory. The stack of ancestors has room for the tallest possible 'Set'.
+    class Cursor {
+        enum { k_MAX_HEIGHT = 64 };
+
+        const Set* d_stack[k_MAX_HEIGHT];
+        int        d_depth;
+
+        void pushLeftSpine(const Set*);
+
+      public:
+        explicit Cursor(const Set* set);
+
+        bool               done() const;
+        const bdld::Datum& value() const;
+        void               advance();
+    };
+
+    // 'Transient' is a set that is modified in place. The set returned by
+    // 'set' reflects modifications made afterward, so it must not be
+    // retained or combined with other sets until 'persist' is called. A
+    // 'Transient' is not safe to use concurrently.
+    class Transient {
+        const Set*        d_root;
+        unsigned          d_owner;      // zero if out of tokens or persisted
+        bool              d_persisted;
+        bslma::Allocator* d_allocator_p;
+
+        // Return a token that no other 'Transient' has, or return zero if
+        // there are none left.
+        static unsigned newOwner();
+
+      public:
+        // Create a transient having the elements of the specified 'set'.
+        // 'set' itself is not modified.
+        Transient(const Set* set, bslma::Allocator*);
+
+        // The behavior of 'insert' and 'remove' is undefined if 'persist' has
+        // been called.
+        template <typename COMPARATOR>
+        void insert(const bdld::Datum& value, const COMPARATOR& before);
+        void insert(const bdld::Datum& value, const Comparator& before);
+
+        template <typename COMPARATOR>
+        void remove(const bdld::Datum& value, const COMPARATOR& before);
+        void remove(const bdld::Datum& value, const Comparator& before);
+
+        const Set* set() const;
+
+        // Return the set and end this transient, so that the returned set is
+        // never modified.
+        const Set* persist();
+
+        bool isPersisted() const;
+
+        static bool isTransient(const bdld::Datum&, int typeOffset);
+
+        static Transient* access(const bdld::Datum&);
+        static Transient* access(const bdld::DatumUdt&);
+
+        static bdld::Datum create(Transient* transient, int typeOffset);
+    };
+
     Set(const bdld::Datum& value, const Set* left, const Set* right);
 
     int        height() const;
     static int height(const Set*);
 
+    bsl::size_t        size() const;
+    static bsl::size_t size(const Set*);
+
     const bdld::Datum& value() const;
     const Set*         left() const;
     const Set*         right() const;
 
-    typedef bsl::function<bool(const bdld::Datum&, const bdld::Datum&)>
-        Comparator;
-
+    template <typename COMPARATOR>
+    static const Set* insert(const Set*         set,
+                             const bdld::Datum& value,
+                             const COMPARATOR&  before,
+                             bslma::Allocator*);
     static const Set* insert(const Set*         set,
                              const bdld::Datum& value,
                              const Comparator&  before,
                              bslma::Allocator*);
 
+    // Return a set of the values in the specified range '[begin, end)'. If
+    // several values are equivalent, the set contains the first of them, as
+    // if the values were inserted one at a time. The result is perfectly
+    // balanced, and is built using one allocation per element. Note that
+    // sorting is skipped if the range is already strictly increasing.
+    template <typename COMPARATOR>
+    static const Set* fromRange(const bdld::Datum* begin,
+                                const bdld::Datum* end,
+                                const COMPARATOR&  before,
+                                bslma::Allocator*);
+    static const Set* fromRange(const bdld::Datum* begin,
+                                const bdld::Datum* end,
+                                const Comparator&  before,
+                                bslma::Allocator*);
+
+    template <typename COMPARATOR>
+    static bool contains(const Set*         set,
+                         const bdld::Datum& value,
+                         const COMPARATOR&  before);
     static bool contains(const Set*         set,
                          const bdld::Datum& value,
                          const Comparator&  before);
 
+    template <typename COMPARATOR>
+    static const Set* remove(const Set*         set,
+                             const bdld::Datum& value,
+                             const COMPARATOR&  before,
+                             bslma::Allocator*);
     static const Set* remove(const Set*         set,
                              const bdld::Datum& value,
                              const Comparator&  before,
                              bslma::Allocator*);
 
+    // Return a set of the elements that are in the specified 'left' or the
+    // specified 'right'. Of two equivalent elements, the result contains the
+    // one from 'left'. If the specified 'threadPool' is not null, then work on
+    // large operands is divided among its threads, in which case the
+    // specified allocator and 'before' must be safe to use concurrently.
+    template <typename COMPARATOR>
+    static const Set* unite(const Set*         left,
+                            const Set*         right,
+                            const COMPARATOR&  before,
+                            bslma::Allocator*,
+                            bdlmt::ThreadPool* threadPool = 0);
+    static const Set* unite(const Set*         left,
+                            const Set*         right,
+                            const Comparator&  before,
+                            bslma::Allocator*,
+                            bdlmt::ThreadPool* threadPool = 0);
+
+    // Return a set of the elements of the specified 'left' that are
+    // equivalent to an element of the specified 'right'. Optionally specify
+    // a 'threadPool', as described for 'unite'.
+    template <typename COMPARATOR>
+    static const Set* intersect(const Set*         left,
+                                const Set*         right,
+                                const COMPARATOR&  before,
+                                bslma::Allocator*,
+                                bdlmt::ThreadPool* threadPool = 0);
+    static const Set* intersect(const Set*         left,
+                                const Set*         right,
+                                const Comparator&  before,
+                                bslma::Allocator*,
+                                bdlmt::ThreadPool* threadPool = 0);
+
+    // Return a set of the elements of the specified 'left' that are not
+    // equivalent to any element of the specified 'right'. Optionally specify
+    // a 'threadPool', as described for 'unite'.
+    template <typename COMPARATOR>
+    static const Set* subtract(const Set*         left,
+                               const Set*         right,
+                               const COMPARATOR&  before,
+                               bslma::Allocator*,
+                               bdlmt::ThreadPool* threadPool = 0);
+    static const Set* subtract(const Set*         left,
+                               const Set*         right,
+                               const Comparator&  before,
+                               bslma::Allocator*,
+                               bdlmt::ThreadPool* threadPool = 0);
+
+    // Return whether every element of the specified 'subset' is equivalent to
+    // an element of the specified 'superset'. This function does not
+    // allocate memory.
+    template <typename COMPARATOR>
+    static bool isSubset(const Set*        subset,
+                         const Set*        superset,
+                         const COMPARATOR& before);
+    static bool isSubset(const Set*        subset,
+                         const Set*        superset,
+                         const Comparator& before);
+
+    // Return the element of the specified 'set' at the specified zero-based
+    // 'index' in order. The behavior is undefined unless 'index < size(set)'.
+    static const bdld::Datum& nth(const Set* set, bsl::size_t index);
+
+    // Return the number of elements of the specified 'set' that are before
+    // the specified 'value', which is the index of 'value' if 'set' contains
+    // it.
+    template <typename COMPARATOR>
+    static bsl::size_t rank(const Set*         set,
+                            const bdld::Datum& value,
+                            const COMPARATOR&  before);
+    static bsl::size_t rank(const Set*         set,
+                            const bdld::Datum& value,
+                            const Comparator&  before);
+
+    // Return the number of elements of the specified 'set' that are not
+    // before the specified 'low' and are before the specified 'high'.
+    template <typename COMPARATOR>
+    static bsl::size_t countInRange(const Set*         set,
+                                    const bdld::Datum& low,
+                                    const bdld::Datum& high,
+                                    const COMPARATOR&  before);
+    static bsl::size_t countInRange(const Set*         set,
+                                    const bdld::Datum& low,
+                                    const bdld::Datum& high,
+                                    const Comparator&  before);
+
+    // Return a set of the elements of the specified 'set' that are not
+    // before the specified 'low' and are before the specified 'high'. The
+    // result shares all but O(log n) of its nodes with 'set'.
+    template <typename COMPARATOR>
+    static const Set* range(const Set*         set,
+                            const bdld::Datum& low,
+                            const bdld::Datum& high,
+                            const COMPARATOR&  before,
+                            bslma::Allocator*);
+    static const Set* range(const Set*         set,
+                            const bdld::Datum& low,
+                            const bdld::Datum& high,
+                            const Comparator&  before,
+                            bslma::Allocator*);
+
     static bdld::Datum toList(const Set* set,
                               int        typeOffset,
                               bslma::Allocator*);
 
+    static bool isSet(const bdld::Datum&, int typeOffset);
+
     static const Set* access(const bdld::Datum&);
     static const Set* access(const bdld::DatumUdt&);
 
     static bdld::Datum create(const Set* set, int typeOffset);
+
+  private:
+    // Return a negative number, zero, or a positive number if the specified
+    // 'left' is before, equivalent to, or after the specified 'right',
+    // respectively, according to the specified 'before'.
+    template <typename COMPARATOR>
+    static int compare(const COMPARATOR&  before,
+                       const bdld::Datum& left,
+                       const bdld::Datum& right);
+    static int compare(const DatumUtil::LessThan& before,
+                       const bdld::Datum&         left,
+                       const bdld::Datum&         right);
+
+    // The following are implemented in the '.cpp' file, since they do not
+    // depend on the comparator. See the comments there.
+    static const Set* balanced(const bdld::Datum& value,
+                               const Set*         left,
+                               const Set*         right,
+                               bslma::Allocator*);
+    static bsl::pair<const Set*, const Set*> removalSubtree(
+        const Set*,
+        bslma::Allocator*);
+    static const Set* buildBalanced(const bdld::Datum* begin,
+                                    const bdld::Datum* end,
+                                    bslma::Allocator*);
+    static const Set* join(const Set*         left,
+                           const bdld::Datum& value,
+                           const Set*         right,
+                           bslma::Allocator*);
+    static const Set* rejoin(const Set* node,
+                             const Set* left,
+                             const Set* right,
+                             bslma::Allocator*);
+    static const Set* concatenate(const Set* left,
+                                  const Set* right,
+                                  bslma::Allocator*);
+    static bool       shouldFork(bdlmt::ThreadPool*,
+                                 const Set* first,
+                                 const Set* second);
+    static void       forkJoin(bdlmt::ThreadPool*,
+                               const bsl::function<void()>& forked,
+                               const bsl::function<void()>& local);
+
+    template <typename COMPARATOR>
+    static const Set* insertNew(const Set*         set,
+                                const bdld::Datum& value,
+                                const COMPARATOR&  before,
+                                bslma::Allocator*);
+
+    template <typename COMPARATOR>
+    static const Set* removeExisting(const Set*         set,
+                                     const bdld::Datum& value,
+                                     const COMPARATOR&  before,
+                                     bslma::Allocator*);
+
+    // The following are the in-place counterparts of 'insertNew' and
+    // 'removeExisting', and of the helpers in the '.cpp' file that they use.
+    // They modify nodes owned by the specified 'owner', and copy the rest.
+    static Set*       edit(const Set* set, unsigned owner, bslma::Allocator*);
+    static Set*       rotateRightOwned(const Set*        set,
+                                       unsigned          owner,
+                                       bslma::Allocator*);
+    static Set*       rotateLeftOwned(const Set*        set,
+                                      unsigned          owner,
+                                      bslma::Allocator*);
+    static const Set* balanceOwned(Set*              set,
+                                   unsigned          owner,
+                                   bslma::Allocator*);
+    static bsl::pair<const Set*, const Set*> removalSubtreeOwned(
+        const Set*,
+        unsigned owner,
+        bslma::Allocator*);
+
+    template <typename COMPARATOR>
+    static const Set* insertOwned(const Set*         set,
+                                  const bdld::Datum& value,
+                                  const COMPARATOR&  before,
+                                  unsigned           owner,
+                                  bslma::Allocator*);
+
+    template <typename COMPARATOR>
+    static const Set* removeOwned(const Set*         set,
+                                  const bdld::Datum& value,
+                                  const COMPARATOR&  before,
+                                  unsigned           owner,
+                                  bslma::Allocator*);
+
+    struct SplitResult {
+        const Set* before;  // elements before the value
+        const Set* found;   // node equivalent to the value, or null
+        const Set* after;   // elements after the value
+    };
+
+    template <typename COMPARATOR>
+    static SplitResult split(const Set*         set,
+                             const bdld::Datum& value,
+                             const COMPARATOR&  before,
+                             bslma::Allocator*);
+
+    // 'Apply' is a set operation bound to its arguments, so that it can be
+    // run as a job on a thread pool.
+    template <typename COMPARATOR>
+    struct Apply {
+        typedef const Set* Operation(const Set*,
+                                     const Set*,
+                                     const COMPARATOR&,
+                                     bslma::Allocator*,
+                                     bdlmt::ThreadPool*);
+
+        Operation*         operation;
+        const Set*         first;
+        const Set*         second;
+        const COMPARATOR*  before;
+        bslma::Allocator*  allocator;
+        bdlmt::ThreadPool* threadPool;
+        const Set**        result;
+
+        void operator()() const;
+    };
+
+    template <typename COMPARATOR>
+    static void applyToHalves(
+        typename Apply<COMPARATOR>::Operation* operation,
+        const Set**                            leftResult,
+        const Set*                             leftFirst,
+        const Set*                             leftSecond,
+        const Set**                            rightResult,
+        const Set*                             rightFirst,
+        const Set*                             rightSecond,
+        const COMPARATOR&                      before,
+        bslma::Allocator*,
+        bdlmt::ThreadPool* threadPool);
+
+    template <typename COMPARATOR>
+    static const Set* narrow(const Set*         set,
+                             const bdld::Datum* low,
+                             const bdld::Datum* high,
+                             const COMPARATOR&  before);
+
+    template <typename COMPARATOR>
+    static const Set* rangeWithin(const Set*         set,
+                                  const bdld::Datum* low,
+                                  const bdld::Datum* high,
+                                  const COMPARATOR&  before,
+                                  bslma::Allocator*);
+
+    template <typename COMPARATOR>
+    static bool isSubsetWithin(const Set*         subset,
+                               const Set*         superset,
+                               const bdld::Datum* low,
+                               const bdld::Datum* high,
+                               const COMPARATOR&  before);
 };
 
 #ifdef BSLS_PLATFORM_CPU_64_BIT
@@ -117,6 +519,18 @@ inline int Set::height(const Set* set) {
     return 0;
 }
 
+inline bsl::size_t Set::size() const {
+    return d_size;
+}
+
+inline bsl::size_t Set::size(const Set* set) {
+    if (set) {
+        return set->size();
+    }
+
+    return 0;
+}
+
 inline const bdld::Datum& Set::value() const {
     return d_value;
 }
@@ -139,6 +553,609 @@ inline const Set* Set::right() const {
 #endif
 }
 
+inline bool Set::Cursor::done() const {
+    return d_depth == 0;
+}
+
+inline const Set* Set::Transient::set() const {
+    return d_root;
+}
+
+inline bool Set::Transient::isPersisted() const {
+    return d_persisted;
+}
+
+template <typename COMPARATOR>
+int Set::compare(const COMPARATOR&  before,
+                 const bdld::Datum& left,
+                 const bdld::Datum& right) {
+    if (before(left, right)) {
+        return -1;
+    }
+    if (before(right, left)) {
+        return 1;
+    }
+    return 0;
+}
+
+inline int Set::compare(const DatumUtil::LessThan& before,
+                        const bdld::Datum&         left,
+                        const bdld::Datum&         right) {
+    return before.compare(left, right);
+}
+
+template <typename COMPARATOR>
+const Set* Set::insertNew(const Set*         set,
+                          const bdld::Datum& value,
+                          const COMPARATOR&  before,
+                          bslma::Allocator*  allocator) {
+    if (!set) {
+        return balanced(value, 0, 0, allocator);
+    }
+
+    const int comparison = compare(before, value, set->value());
+    if (comparison < 0) {
+        return balanced(set->value(),
+                        insertNew(set->left(), value, before, allocator),
+                        set->right(),
+                        allocator);
+    }
+
+    if (comparison > 0) {
+        return balanced(set->value(),
+                        set->left(),
+                        insertNew(set->right(), value, before, allocator),
+                        allocator);
+    }
+
+    return set;
+}
+
+template <typename COMPARATOR>
+const Set* Set::removeExisting(const Set*         set,
+                               const bdld::Datum& value,
+                               const COMPARATOR&  before,
+                               bslma::Allocator*  allocator) {
+    if (!set) {
+        return set;
+    }
+
+    const int comparison = compare(before, value, set->value());
+    if (comparison < 0) {
+        return balanced(set->value(),
+                        removeExisting(set->left(), value, before, allocator),
+                        set->right(),
+                        allocator);
+    }
+
+    if (comparison > 0) {
+        return balanced(
+            set->value(),
+            set->left(),
+            removeExisting(set->right(), value, before, allocator),
+            allocator);
+    }
+
+    // We found the node to remove. There are three cases:
+    // - No children? Return null.
+    // - One child? Return it.
+    // - Two children? Put your pants on.
+    if (!set->left() && !set->right()) {
+        return 0;
+    }
+    if (!set->left()) {
+        return set->right();
+    }
+    if (!set->right()) {
+        return set->left();
+    }
+
+    // We can pick either the in-order predecessor or the in-order successor.
+    // There's probably a clever choice that minimizes tree rotations, but
+    // let's just pick the in-order predecessor. That node will replace this
+    // one, and we reparent stuff so the tree remains correct, while
+    // rebalancing as needed.
+    const bsl::pair<const Set*, const Set*> results =
+        removalSubtree(set->left(), allocator);
+    const Set* const leftChild   = results.first;
+    const Set* const predecessor = results.second;
+    return balanced(predecessor->value(), leftChild, set->right(), allocator);
+}
+
+template <typename COMPARATOR>
+const Set* Set::insertOwned(const Set*         set,
+                            const bdld::Datum& value,
+                            const COMPARATOR&  before,
+                            unsigned           owner,
+                            bslma::Allocator*  allocator) {
+    if (!set) {
+        return new (*allocator) Set(value, 0, 0, owner);
+    }
+
+    // Note that 'edit' might return 'set' itself, so its children are read
+    // before 'reset' is called.
+    const int comparison = compare(before, value, set->value());
+    if (comparison < 0) {
+        Set* const node = edit(set, owner, allocator);
+        node->reset(insertOwned(set->left(), value, before, owner, allocator),
+                    set->right());
+        return balanceOwned(node, owner, allocator);
+    }
+
+    if (comparison > 0) {
+        Set* const node = edit(set, owner, allocator);
+        node->reset(
+            set->left(),
+            insertOwned(set->right(), value, before, owner, allocator));
+        return balanceOwned(node, owner, allocator);
+    }
+
+    return set;
+}
+
+template <typename COMPARATOR>
+const Set* Set::removeOwned(const Set*         set,
+                            const bdld::Datum& value,
+                            const COMPARATOR&  before,
+                            unsigned           owner,
+                            bslma::Allocator*  allocator) {
+    if (!set) {
+        return set;
+    }
+
+    const int comparison = compare(before, value, set->value());
+    if (comparison < 0) {
+        Set* const node = edit(set, owner, allocator);
+        node->reset(removeOwned(set->left(), value, before, owner, allocator),
+                    set->right());
+        return balanceOwned(node, owner, allocator);
+    }
+
+    if (comparison > 0) {
+        Set* const node = edit(set, owner, allocator);
+        node->reset(
+            set->left(),
+            removeOwned(set->right(), value, before, owner, allocator));
+        return balanceOwned(node, owner, allocator);
+    }
+
+    // As in 'removeExisting', but the in-order predecessor's value moves into
+    // this node rather than into a new one.
+    if (!set->left()) {
+        return set->right();
+    }
+    if (!set->right()) {
+        return set->left();
+    }
+
+    const bsl::pair<const Set*, const Set*> results =
+        removalSubtreeOwned(set->left(), owner, allocator);
+    Set* const node = edit(set, owner, allocator);
+    node->d_value   = results.second->value();
+    node->reset(results.first, set->right());
+    return balanceOwned(node, owner, allocator);
+}
+
+template <typename COMPARATOR>
+typename Set::SplitResult Set::split(const Set*         set,
+                                     const bdld::Datum& value,
+                                     const COMPARATOR&  before,
+                                     bslma::Allocator*  allocator) {
+    if (!set) {
+        const SplitResult result = { 0, 0, 0 };
+        return result;
+    }
+
+    const int comparison = compare(before, value, set->value());
+    if (comparison < 0) {
+        SplitResult result = split(set->left(), value, before, allocator);
+        result.after =
+            join(result.after, set->value(), set->right(), allocator);
+        return result;
+    }
+
+    if (comparison > 0) {
+        SplitResult result = split(set->right(), value, before, allocator);
+        result.before =
+            join(set->left(), set->value(), result.before, allocator);
+        return result;
+    }
+
+    const SplitResult result = { set->left(), set, set->right() };
+    return result;
+}
+
+template <typename COMPARATOR>
+void Set::Apply<COMPARATOR>::operator()() const {
+    *result = operation(first, second, *before, allocator, threadPool);
+}
+
+template <typename COMPARATOR>
+void Set::applyToHalves(typename Apply<COMPARATOR>::Operation* operation,
+                        const Set**                            leftResult,
+                        const Set*                             leftFirst,
+                        const Set*                             leftSecond,
+                        const Set**                            rightResult,
+                        const Set*                             rightFirst,
+                        const Set*                             rightSecond,
+                        const COMPARATOR&                      before,
+                        bslma::Allocator*                      allocator,
+                        bdlmt::ThreadPool*                     threadPool) {
+    if (shouldFork(threadPool, leftFirst, leftSecond)) {
+        // The forked job gets no thread pool of its own. See 'forkJoin'.
+        const Apply<COMPARATOR> forked = {
+            operation, leftFirst, leftSecond, &before, allocator, 0, leftResult
+        };
+        const Apply<COMPARATOR> local  = {
+            operation, rightFirst, rightSecond, &before,
+            allocator, threadPool, rightResult
+        };
+        forkJoin(threadPool, bsl::cref(forked), bsl::cref(local));
+        return;
+    }
+
+    *leftResult =
+        operation(leftFirst, leftSecond, before, allocator, threadPool);
+    *rightResult =
+        operation(rightFirst, rightSecond, before, allocator, threadPool);
+}
+
+template <typename COMPARATOR>
+const Set* Set::narrow(const Set*         set,
+                       const bdld::Datum* low,
+                       const bdld::Datum* high,
+                       const COMPARATOR&  before) {
+    // Return the subtree of 'set' that contains all of the elements of 'set'
+    // that are after the optional 'low' and before the optional 'high'.
+    while (set) {
+        if (low && !before(*low, set->value())) {
+            set = set->right();
+        }
+        else if (high && !before(set->value(), *high)) {
+            set = set->left();
+        }
+        else {
+            break;
+        }
+    }
+
+    return set;
+}
+
+template <typename COMPARATOR>
+const Set* Set::rangeWithin(const Set*         set,
+                            const bdld::Datum* low,
+                            const bdld::Datum* high,
+                            const COMPARATOR&  before,
+                            bslma::Allocator*  allocator) {
+    // Return the elements of 'set' that are not before the optional 'low'
+    // and are before the optional 'high'. Once a node is in the range, its
+    // left subtree is bounded only by 'low' and its right subtree only by
+    // 'high', so this visits O(log n) nodes. A subtree bounded by neither is
+    // shared whole.
+    if (!low && !high) {
+        return set;
+    }
+
+    while (set) {
+        if (low && before(set->value(), *low)) {
+            set = set->right();
+        }
+        else if (high && !before(set->value(), *high)) {
+            set = set->left();
+        }
+        else {
+            break;
+        }
+    }
+
+    if (!set) {
+        return 0;
+    }
+
+    return rejoin(set,
+                  rangeWithin(set->left(), low, 0, before, allocator),
+                  rangeWithin(set->right(), 0, high, before, allocator),
+                  allocator);
+}
+
+template <typename COMPARATOR>
+bool Set::isSubsetWithin(const Set*         subset,
+                         const Set*         superset,
+                         const bdld::Datum* low,
+                         const bdld::Datum* high,
+                         const COMPARATOR&  before) {
+    // Return whether every element of 'subset' is in 'superset', where every
+    // element of 'subset' is after the optional 'low' and before the optional
+    // 'high', and 'superset' is a subtree that contains every element of the
+    // original superset in that range. Each lookup begins at the subtree
+    // where the previous lookup left off, rather than at the root.
+    if (!subset) {
+        return true;
+    }
+
+    const bdld::Datum& value = subset->value();
+    const Set*         node  = superset;
+    while (node) {
+        const int comparison = compare(before, value, node->value());
+        if (comparison < 0) {
+            node = node->left();
+        }
+        else if (comparison > 0) {
+            node = node->right();
+        }
+        else {
+            break;
+        }
+    }
+
+    if (!node) {
+        return false;
+    }
+    if (node == subset) {
+        return true;  // shared subtree
+    }
+
+    return isSubsetWithin(subset->left(),
+                          narrow(superset, low, &value, before),
+                          low,
+                          &value,
+                          before) &&
+           isSubsetWithin(subset->right(),
+                          narrow(superset, &value, high, before),
+                          &value,
+                          high,
+                          before);
+}
+
+template <typename COMPARATOR>
+const Set* Set::insert(const Set*         set,
+                       const bdld::Datum& value,
+                       const COMPARATOR&  before,
+                       bslma::Allocator*  allocator) {
+    if (contains(set, value, before)) {
+        return set;
+    }
+
+    return insertNew(set, value, before, allocator);
+}
+
+template <typename COMPARATOR>
+const Set* Set::fromRange(const bdld::Datum* begin,
+                          const bdld::Datum* end,
+                          const COMPARATOR&  before,
+                          bslma::Allocator*  allocator) {
+    // Check whether the values are already strictly increasing, as they are
+    // when they come from another set, in which case we can build the tree
+    // directly from the input.
+    const bdld::Datum* iter = begin;
+    if (iter != end) {
+        for (++iter; iter != end && before(iter[-1], *iter); ++iter) {
+        }
+    }
+    if (iter == end) {
+        return buildBalanced(begin, end, allocator);
+    }
+
+    // Sort stably, so that the first of any equivalent values comes first,
+    // and then keep only the first of each run of equivalent values. Since
+    // the values are sorted, a value is equivalent to the last one kept if
+    // that one is not before it.
+    bsl::vector<bdld::Datum> values(begin, end);
+    bsl::stable_sort(values.begin(), values.end(), before);
+    bsl::size_t kept = 1;
+    for (bsl::size_t i = 1; i < values.size(); ++i) {
+        if (before(values[kept - 1], values[i])) {
+            values[kept++] = values[i];
+        }
+    }
+
+    return buildBalanced(values.data(), values.data() + kept, allocator);
+}
+
+template <typename COMPARATOR>
+bool Set::contains(const Set*         set,
+                   const bdld::Datum& value,
+                   const COMPARATOR&  before) {
+    while (set) {
+        const int comparison = compare(before, value, set->value());
+        if (comparison == 0) {
+            return true;
+        }
+        set = comparison < 0 ? set->left() : set->right();
+    }
+
+    return false;
+}
+
+template <typename COMPARATOR>
+const Set* Set::remove(const Set*         set,
+                       const bdld::Datum& value,
+                       const COMPARATOR&  before,
+                       bslma::Allocator*  allocator) {
+    if (!contains(set, value, before)) {
+        return set;
+    }
+
+    return removeExisting(set, value, before, allocator);
+}
+
+template <typename COMPARATOR>
+const Set* Set::unite(const Set*         left,
+                      const Set*         right,
+                      const COMPARATOR&  before,
+                      bslma::Allocator*  allocator,
+                      bdlmt::ThreadPool* threadPool) {
+    if (!left || left == right) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+
+    const SplitResult halves = split(right, left->value(), before, allocator);
+    const Set*        lower;
+    const Set*        upper;
+    applyToHalves<COMPARATOR>(&unite<COMPARATOR>,
+                              &lower,
+                              left->left(),
+                              halves.before,
+                              &upper,
+                              left->right(),
+                              halves.after,
+                              before,
+                              allocator,
+                              threadPool);
+
+    return rejoin(left, lower, upper, allocator);
+}
+
+template <typename COMPARATOR>
+const Set* Set::intersect(const Set*         left,
+                          const Set*         right,
+                          const COMPARATOR&  before,
+                          bslma::Allocator*  allocator,
+                          bdlmt::ThreadPool* threadPool) {
+    if (!left || !right) {
+        return 0;
+    }
+    if (left == right) {
+        return left;
+    }
+
+    const SplitResult halves = split(right, left->value(), before, allocator);
+    const Set*        lower;
+    const Set*        upper;
+    applyToHalves<COMPARATOR>(&intersect<COMPARATOR>,
+                              &lower,
+                              left->left(),
+                              halves.before,
+                              &upper,
+                              left->right(),
+                              halves.after,
+                              before,
+                              allocator,
+                              threadPool);
+
+    if (halves.found) {
+        return rejoin(left, lower, upper, allocator);
+    }
+
+    return concatenate(lower, upper, allocator);
+}
+
+template <typename COMPARATOR>
+const Set* Set::subtract(const Set*         left,
+                         const Set*         right,
+                         const COMPARATOR&  before,
+                         bslma::Allocator*  allocator,
+                         bdlmt::ThreadPool* threadPool) {
+    if (!left || left == right) {
+        return 0;
+    }
+    if (!right) {
+        return left;
+    }
+
+    const SplitResult halves = split(right, left->value(), before, allocator);
+    const Set*        lower;
+    const Set*        upper;
+    applyToHalves<COMPARATOR>(&subtract<COMPARATOR>,
+                              &lower,
+                              left->left(),
+                              halves.before,
+                              &upper,
+                              left->right(),
+                              halves.after,
+                              before,
+                              allocator,
+                              threadPool);
+
+    if (halves.found) {
+        return concatenate(lower, upper, allocator);
+    }
+
+    return rejoin(left, lower, upper, allocator);
+}
+
+template <typename COMPARATOR>
+bsl::size_t Set::rank(const Set*         set,
+                      const bdld::Datum& value,
+                      const COMPARATOR&  before) {
+    bsl::size_t result = 0;
+    while (set) {
+        const int comparison = compare(before, value, set->value());
+        if (comparison == 0) {
+            return result + size(set->left());
+        }
+        if (comparison < 0) {
+            set = set->left();
+        }
+        else {
+            result += size(set->left()) + 1;
+            set = set->right();
+        }
+    }
+
+    return result;
+}
+
+template <typename COMPARATOR>
+bsl::size_t Set::countInRange(const Set*         set,
+                              const bdld::Datum& low,
+                              const bdld::Datum& high,
+                              const COMPARATOR&  before) {
+    if (!before(low, high)) {
+        return 0;
+    }
+
+    return rank(set, high, before) - rank(set, low, before);
+}
+
+template <typename COMPARATOR>
+const Set* Set::range(const Set*         set,
+                      const bdld::Datum& low,
+                      const bdld::Datum& high,
+                      const COMPARATOR&  before,
+                      bslma::Allocator*  allocator) {
+    if (!before(low, high)) {
+        return 0;
+    }
+
+    return rangeWithin(set, &low, &high, before, allocator);
+}
+
+template <typename COMPARATOR>
+bool Set::isSubset(const Set*        subset,
+                   const Set*        superset,
+                   const COMPARATOR& before) {
+    if (subset == superset) {
+        return true;
+    }
+
+    return isSubsetWithin(subset, superset, 0, 0, before);
+}
+
+template <typename COMPARATOR>
+void Set::Transient::insert(const bdld::Datum& value,
+                            const COMPARATOR&  before) {
+    BSLS_ASSERT(!d_persisted);
+
+    if (!contains(d_root, value, before)) {
+        d_root = insertOwned(d_root, value, before, d_owner, d_allocator_p);
+    }
+}
+
+template <typename COMPARATOR>
+void Set::Transient::remove(const bdld::Datum& value,
+                            const COMPARATOR&  before) {
+    BSLS_ASSERT(!d_persisted);
+
+    if (contains(d_root, value, before)) {
+        d_root = removeOwned(d_root, value, before, d_owner, d_allocator_p);
+    }
+}
+
 }  // namespace lspcore
 
 #endif
@@ -0,0 +1,90 @@
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+#include <lspcore_setsequence.h>
+#include <lspcore_userdefinedtypes.h>
+
+using namespace BloombergLP;
+
+namespace lspcore {
+
+SetSequence::SetSequence(const Set* node, const SetSequence* next)
+: d_node(node)
+, d_next(next) {
+}
+
+const SetSequence* SetSequence::pushLeftSpine(const Set*         set,
+                                              const SetSequence* next,
+                                              bslma::Allocator*  allocator) {
+    // The least element of 'set' is at the bottom of its left spine, so
+    // that's where the sequence begins. Each node along the way comes after
+    // the whole of its left subtree.
+    for (; set; set = set->left()) {
+        next = new (*allocator) SetSequence(set, next);
+    }
+
+    return next;
+}
+
+SetSequence::Cursor::Cursor(const SetSequence* sequence)
+: d_sequence(sequence)
+, d_subtree(0)
+, d_inSubtree(false) {
+}
+
+const bdld::Datum& SetSequence::Cursor::value() const {
+    BSLS_ASSERT(!done());
+
+    return d_inSubtree ? d_subtree.value() : d_sequence->first();
+}
+
+void SetSequence::Cursor::advance() {
+    BSLS_ASSERT(!done());
+
+    if (d_inSubtree) {
+        d_subtree.advance();
+    }
+    else {
+        d_subtree   = Set::Cursor(d_sequence->d_node->right());
+        d_inSubtree = true;
+    }
+
+    if (d_subtree.done()) {
+        d_sequence  = d_sequence->d_next;
+        d_inSubtree = false;
+    }
+}
+
+const SetSequence* SetSequence::fromSet(const Set*        set,
+                                        bslma::Allocator* allocator) {
+    return pushLeftSpine(set, 0, allocator);
+}
+
+const SetSequence* SetSequence::rest(const SetSequence* sequence,
+                                     bslma::Allocator*  allocator) {
+    BSLS_ASSERT(sequence);
+
+    return pushLeftSpine(
+        sequence->d_node->right(), sequence->d_next, allocator);
+}
+
+bool SetSequence::isSetSequence(const bdld::Datum& datum, int typeOffset) {
+    return datum.isUdt() && datum.theUdt().type() ==
+                                UserDefinedTypes::e_SET_SEQUENCE + typeOffset;
+}
+
+const SetSequence* SetSequence::access(const bdld::Datum& datum) {
+    BSLS_ASSERT(datum.isUdt());
+    return access(datum.theUdt());
+}
+
+const SetSequence* SetSequence::access(const bdld::DatumUdt& udt) {
+    return static_cast<const SetSequence*>(udt.data());
+}
+
+bdld::Datum SetSequence::create(const SetSequence* sequence, int typeOffset) {
+    return bdld::Datum::createUdt(
+        const_cast<void*>(static_cast<const void*>(sequence)),
+        UserDefinedTypes::e_SET_SEQUENCE + typeOffset);
+}
+
+}  // namespace lspcore
@@ -0,0 +1,90 @@
+#ifndef INCLUDED_LSPCORE_SETSEQUENCE
+#define INCLUDED_LSPCORE_SETSEQUENCE
+
+// A set sequence is an immutable, lazily produced sequence of the elements of
+// a 'Set' in order. Whereas 'Set::toList' builds a list of every element up
+// front, a set sequence produces the next element only when its rest is
+// taken, so walking a sequence to its end allocates one 'SetSequence' node
+// per element in total, and an unfinished walk holds only O(log n) nodes.
+//
+// A set sequence is represented as a pointer to a 'SetSequence' node. A null
+// pointer denotes an empty sequence. A node refers to a 'Set' node, and the
+// sequence consists of the value of that 'Set' node, then the elements of its
+// right subtree, and then the sequence of the 'next' node. Sequences that
+// come from the same set share their tails.
+//
+// Native code that only needs to visit the elements should use 'Set::Cursor',
+// or 'SetSequence::Cursor' to visit the rest of a sequence, neither of which
+// allocates memory.
+
+#include <bdld_datum.h>
+#include <lspcore_set.h>
+
+namespace BloombergLP {
+namespace bslma {
+class Allocator;
+}  // namespace bslma
+}  // namespace BloombergLP
+
+namespace lspcore {
+namespace bdld  = BloombergLP::bdld;
+namespace bslma = BloombergLP::bslma;
+
+class SetSequence {
+    const Set*         d_node;
+    const SetSequence* d_next;
+
+    SetSequence(const Set* node, const SetSequence* next);
+
+    // Return the sequence of the elements of the specified 'set' followed by
+    // the specified 'next'.
+    static const SetSequence* pushLeftSpine(const Set*         set,
+                                            const SetSequence* next,
+                                            bslma::Allocator*);
+
+  public:
+    // 'Cursor' visits the elements of a 'SetSequence' in order without
+    // allocating memory.
+    class Cursor {
+        const SetSequence* d_sequence;
+        Set::Cursor        d_subtree;    // right subtree of 'd_sequence'
+        bool               d_inSubtree;  // whether 'd_subtree' is current
+
+      public:
+        explicit Cursor(const SetSequence* sequence);
+
+        bool               done() const;
+        const bdld::Datum& value() const;
+        void               advance();
+    };
+
+    // Return a sequence of the elements of the specified 'set' in order.
+    static const SetSequence* fromSet(const Set* set, bslma::Allocator*);
+
+    // Return the first element of this sequence.
+    const bdld::Datum& first() const;
+
+    // Return the elements of the specified 'sequence' after the first. The
+    // behavior is undefined if 'sequence' is empty.
+    static const SetSequence* rest(const SetSequence* sequence,
+                                   bslma::Allocator*);
+
+    static bool isSetSequence(const bdld::Datum&, int typeOffset);
+
+    static const SetSequence* access(const bdld::Datum&);
+    static const SetSequence* access(const bdld::DatumUdt&);
+
+    static bdld::Datum create(const SetSequence* sequence, int typeOffset);
+};
+
+inline const bdld::Datum& SetSequence::first() const {
+    return d_node->value();
+}
+
+inline bool SetSequence::Cursor::done() const {
+    return d_sequence == 0;
+}
+
+}  // namespace lspcore
+
+#endif
@@ -0,0 +1,98 @@
+#include <bdlb_bitutil.h>
+#include <bsl_cstdint.h>
+#include <bsl_cstring.h>
+#include <bsls_assert.h>
+#include <lspcore_cpuutil.h>
+#include <lspcore_stringutil.h>
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+#include <immintrin.h>
+#endif
+
+using namespace BloombergLP;
+
+namespace lspcore {
+namespace {
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+// Search the specified 'text' of the specified 'length' bytes for the
+// specified 'delimiter' of the specified 'size' bytes, beginning at the
+// specified '*position' and testing 32 positions at a time for as long as
+// every candidate in the block fits within 'text'. Return the index of the
+// first occurrence found. Otherwise, load into '*position' the first
+// position not tested and return 'bsl::string_view::npos'.
+LSPCORE_CPUUTIL_TARGET("avx2")
+bsl::size_t findAvx2(bsl::size_t* position,
+                     const char*  text,
+                     bsl::size_t  length,
+                     const char*  delimiter,
+                     bsl::size_t  size) {
+    const __m256i first = _mm256_set1_epi8(delimiter[0]);
+    const __m256i last  = _mm256_set1_epi8(delimiter[size - 1]);
+
+    bsl::size_t i = *position;
+    for (; i + size - 1 + 32 <= length; i += 32) {
+        const __m256i firstBlock = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(text + i));
+        const __m256i lastBlock = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(text + i + size - 1));
+        bsl::uint32_t candidates = bsl::uint32_t(
+            _mm256_movemask_epi8(_mm256_and_si256(
+                _mm256_cmpeq_epi8(first, firstBlock),
+                _mm256_cmpeq_epi8(last, lastBlock))));
+
+        for (; candidates; candidates &= candidates - 1) {
+            const bsl::size_t candidate =
+                i + bdlb::BitUtil::numTrailingUnsetBits(candidates);
+            if (bsl::memcmp(text + candidate, delimiter, size) == 0) {
+                return candidate;
+            }
+        }
+    }
+
+    *position = i;
+    return bsl::string_view::npos;
+}
+#endif
+
+}  // namespace
+
+bsl::size_t StringUtil::find(const bsl::string_view& text,
+                             const bsl::string_view& delimiter,
+                             bsl::size_t             position) {
+    BSLS_ASSERT(!delimiter.empty());
+
+    const bsl::size_t size = delimiter.size();
+    if (position > text.size() || text.size() - position < size) {
+        return bsl::string_view::npos;
+    }
+
+#ifdef LSPCORE_CPUUTIL_X86_TARGETS
+    if (CpuUtil::hasAvx2()) {
+        const bsl::size_t found = findAvx2(
+            &position, text.data(), text.size(), delimiter.data(), size);
+        if (found != bsl::string_view::npos) {
+            return found;
+        }
+    }
+#endif
+
+    // The last position at which the delimiter could begin is 'limit - 1'.
+    const char* const begin = text.data();
+    const char* const limit = begin + (text.size() - size + 1);
+    for (const char* candidate = begin + position; candidate < limit;
+         ++candidate) {
+        candidate = static_cast<const char*>(
+            bsl::memchr(candidate, delimiter[0], limit - candidate));
+        if (!candidate) {
+            break;
+        }
+        if (bsl::memcmp(candidate, delimiter.data(), size) == 0) {
+            return candidate - begin;
+        }
+    }
+
+    return bsl::string_view::npos;
+}
+
+}  // namespace lspcore
@@ -0,0 +1,26 @@
+#ifndef INCLUDED_LSPCORE_STRINGUTIL
+#define INCLUDED_LSPCORE_STRINGUTIL
+
+#include <bsl_cstddef.h>
+#include <bsl_string_view.h>
+
+namespace lspcore {
+
+// 'StringUtil' searches strings for delimiters. Where the processor supports
+// them, AVX2 instructions are used to test 32 candidate positions at a time,
+// comparing the first and last bytes of the delimiter at each position, and
+// only then comparing whole delimiters. Otherwise 'memchr' finds candidate
+// positions by the first byte of the delimiter.
+struct StringUtil {
+    // Return the index of the first occurrence of the specified 'delimiter'
+    // in the specified 'text' at or after the specified 'position', or
+    // 'bsl::string_view::npos' if there is none. The behavior is undefined
+    // if 'delimiter' is empty.
+    static bsl::size_t find(const bsl::string_view& text,
+                            const bsl::string_view& delimiter,
+                            bsl::size_t             position = 0);
+};
+
+}  // namespace lspcore
+
+#endif
@@ -12,11 +12,28 @@ struct UserDefinedTypes {
         e_PROCEDURE,
         e_NATIVE_PROCEDURE,
         e_SET,
-        e_BUILTIN
+        e_BUILTIN,
+        e_HASH_MAP,
+        e_HASH_SET,
+        e_BTREE_SET,
+        e_INT_SET,
+        e_INT_MAP,
+        e_SET_SEQUENCE,
+        e_SET_TRANSIENT,
+        e_RRB_VECTOR,
+        e_DEQUE,
+        e_PACKED_VECTOR,
+        e_ROPE,
+        e_RECORD_TYPE,
+        e_RECORD,
+        e_RECORD_ACCESSOR,
+        e_HASH_TABLE,
+        e_MUTABLE_VECTOR,
+        e_QUASIQUOTE
         // don't forget to update 'k_COUNT'
     };
 
-    static const bsl::size_t k_COUNT = bsl::size_t(e_BUILTIN) + 1;
+    static const bsl::size_t k_COUNT = bsl::size_t(e_QUASIQUOTE) + 1;
 };
 
 }  // namespace lspcore